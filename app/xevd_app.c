@@ -33,8 +33,6 @@
 #include "xevd_app_util.h"
 #include "xevd_app_args.h"
 
-#define MAX_BS_BUF                 16*1024*1024 /* byte */
-
 static void print_usage(void)
 {
     int i;
@@ -49,63 +47,6 @@ static void print_usage(void)
     }
 }
 
-static int read_bitstream(FILE * fp, int * pos, unsigned char * bs_buf)
-{
-    int ret, read_size, bs_size;
-    unsigned char nalu_len_buf[4], b = 0;
-    XEVD_INFO info;
-
-    bs_size = 0;
-    read_size = 0;
-
-    if(!fseek(fp, *pos, SEEK_SET))
-    {
-        /* read size first */
-        if(XEVD_NAL_UNIT_LENGTH_BYTE == fread(nalu_len_buf, 1, XEVD_NAL_UNIT_LENGTH_BYTE, fp))
-        {
-            ret = xevd_info(nalu_len_buf, XEVD_NAL_UNIT_LENGTH_BYTE, 1, &info);
-            if (XEVD_FAILED(ret)) {
-                logv0("Cannot get bitstream information\n");
-                return -1;
-            }
-            bs_size = info.nalu_len;
-
-            if(bs_size <= 0)
-            {
-                logv0("Invalid bitstream size![%d]\n", bs_size);
-                return -1;
-            }
-
-            while(bs_size)
-            {
-                /* read byte */
-                if (1 != fread(&b, 1, 1, fp))
-                {
-                    logv0("Cannot read bitstream!\n");
-                    return -1;
-                }
-                bs_buf[read_size] = b;
-                read_size++;
-                bs_size--;
-            }
-        }
-        else
-        {
-            if(feof(fp)) {logv2("End of file\n");}
-            else {logv0("Cannot read bitstream size!\n")};
-
-            return -1;
-        }
-    }
-    else
-    {
-        logv0("Cannot seek bitstream!\n");
-        return -1;
-    }
-
-    return read_size;
-}
-
 static void print_stat(XEVD_STAT * stat, int ret)
 {
     int i, j;
@@ -186,6 +127,30 @@ static int set_extra_config(XEVD id)
         }
     }
 
+    if(op_lf_pipeline)
+    {
+        value = 1;
+        size = 4;
+        ret = xevd_config(id, XEVD_CFG_SET_LOOP_FILTER_PIPELINE, &value, &size);
+        if(XEVD_FAILED(ret))
+        {
+            logv0("failed to set config for loop filter pipeline\n");
+            return -1;
+        }
+    }
+
+    if(op_au_mode)
+    {
+        value = 1;
+        size = 4;
+        ret = xevd_config(id, XEVD_CFG_SET_AU_MODE, &value, &size);
+        if(XEVD_FAILED(ret))
+        {
+            logv0("failed to set config for access unit mode\n");
+            return -1;
+        }
+    }
+
     return 0;
 }
 
@@ -239,6 +204,18 @@ static int get_extra_config(XEVD id)
     }
     switch(color_space)
     {
+    case XEVD_CS_YCBCR400:
+        logv2("color_space = XEVD_CS_YCBCR400\n");
+        break;
+    case XEVD_CS_YCBCR420:
+        logv2("color_space = XEVD_CS_YCBCR420\n");
+        break;
+    case XEVD_CS_YCBCR422:
+        logv2("color_space = XEVD_CS_YCBCR422\n");
+        break;
+    case XEVD_CS_YCBCR444:
+        logv2("color_space = XEVD_CS_YCBCR444\n");
+        break;
     case XEVD_CS_YCBCR400_10LE:
         logv2("color_space = XEVD_CS_YCBCR400_10LE\n");
         break;
@@ -346,19 +323,269 @@ static int write_y4m_frame_header(char * fname)
 
 static int write_dec_img(XEVD id, char * fname, XEVD_IMGB * img, XEVD_IMGB * imgb_t, int flag_y4m)
 {
-    imgb_cpy(imgb_t, img);
+    /* without --output-format, the pictures are converted here */
+    if(imgb_t)
+    {
+        imgb_cpy(imgb_t, img);
+        img = imgb_t;
+    }
     if (flag_y4m)
     {
         if(write_y4m_frame_header(op_fname_out)) return -1;
     }
-    if(imgb_write(op_fname_out, imgb_t)) return -1;
+    if(imgb_write(op_fname_out, img)) return -1;
     return 0;
 }
 
+/* names of XEVD_PERF_XXX and XEVD_TL_XXX */
+static const char * stage_name[XEVD_TL_NUM] =
+{
+    "parse", "entropy", "recon", "deblock", "alf", "dra", "pad", "md5", "output",
+    "wait", "join", "decode"
+};
+
+static FILE * fp_tl = NULL;
+
+/* XEVD_CFG_SET_TIMELINE callback: append the events to the Chrome trace */
+static void tl_write(void * user, const XEVD_TL_EVENT * ev, int cnt)
+{
+    int i;
+
+    for(i = 0; i < cnt; i++, ev++)
+    {
+        fprintf(fp_tl, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+            "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"arg\":%d}}",
+            stage_name[ev->type], ev->thread, ev->beg / 1000.0, (ev->end - ev->beg) / 1000.0, ev->arg);
+    }
+}
+
+/* write the decoding threads as a Chrome / Perfetto trace to op_fname_tl */
+static int tl_open(XEVD id, int threads)
+{
+    XEVD_TIMELINE tl;
+    int           i, size;
+
+    fp_tl = fopen(op_fname_tl, "w");
+    if(fp_tl == NULL)
+    {
+        logv0("ERROR: cannot create a timeline file\n");
+        return -1;
+    }
+    fprintf(fp_tl, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(fp_tl, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"xevd\"}}");
+    for(i = 0; i < threads; i++)
+    {
+        fprintf(fp_tl, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s %d\"}}", i, i ? "worker" : "decoder", i);
+    }
+
+    tl.fn = tl_write;
+    tl.user = NULL;
+    size = sizeof(XEVD_TIMELINE);
+    if(XEVD_FAILED(xevd_config(id, XEVD_CFG_SET_TIMELINE, &tl, &size)))
+    {
+        logv0("failed to set config for timeline\n");
+        return -1;
+    }
+    return 0;
+}
+
+static void tl_close(void)
+{
+    if(fp_tl == NULL) return;
+    fprintf(fp_tl, "\n]}\n");
+    fclose(fp_tl);
+    fp_tl = NULL;
+}
+
+static int cmp_ll(const void * a, const void * b)
+{
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_ms(long long * lat, int cnt, int pct)
+{
+    int idx;
+    if(cnt <= 0) return 0;
+    idx = (cnt * pct + 99) / 100 - 1;
+    if(idx < 0) idx = 0;
+    return lat[idx] / 1e6;
+}
+
+/* decode the preloaded bitstream op_bench times without writing any output
+   and print the performance as JSON */
+static int run_bench(BS_READER * bs_rdr, XEVD_CDSC * cdsc)
+{
+    XEVD               id;
+    XEVD_BITB          bitb;
+    XEVD_IMGB        * imgb;
+    XEVD_STAT          stat;
+    XEVD_THREAD_STAT   ts, ts_sum;
+    XEVD_PERF_STATS    ps;
+    long long          stage_sum[XEVD_PERF_NUM];
+    unsigned char    * bs_buf = NULL;
+    long long        * lat = NULL;
+    long long          t_beg, t_pass, t_dec, t, t_tot = 0, ttff_first = 0, ttff_sum = 0;
+    int                lat_cnt = 0, lat_max = 0, frames = 0;
+    int                bs_size, bs_hdr_size, ret, size, pass, i, bumping;
+    int                passes, ret_bench = 0;
+    double             dec, busy, wait;
+
+    memset(&ts_sum, 0, sizeof(XEVD_THREAD_STAT));
+    memset(stage_sum, 0, sizeof(stage_sum));
+
+    for(pass = 0; pass < op_bench; pass++)
+    {
+        t_beg = xevd_clk_nsec();
+        t_pass = -1;
+        t_dec = 0;
+        bumping = 0;
+
+        id = xevd_create(cdsc, NULL);
+        if(id == NULL)
+        {
+            logv0("ERROR: cannot create XEVD decoder\n");
+            return -1;
+        }
+        if(set_extra_config(id))
+        {
+            logv0("ERROR: cannot set extra configurations\n");
+            xevd_delete(id);
+            return -1;
+        }
+        i = 1;
+        size = sizeof(int);
+        xevd_config(id, XEVD_CFG_SET_PERF_STATS, &i, &size);
+
+        while(1)
+        {
+            memset(&stat, 0, sizeof(XEVD_STAT));
+            if(!bumping)
+            {
+                bs_size = bs_reader_next(bs_rdr, &bs_buf, &bs_hdr_size);
+                if(bs_size <= 0)
+                {
+                    bumping = 1;
+                    continue;
+                }
+                bitb.addr = bs_buf;
+                bitb.ssize = bs_size;
+                bitb.ts[XEVD_TS_DTS] = 0;
+
+                t = xevd_clk_nsec();
+                ret = xevd_decode(id, &bitb, &stat);
+                t_dec += xevd_clk_nsec() - t;
+                if(XEVD_FAILED(ret))
+                {
+                    print_stat(&stat, ret);
+                    ret_bench = -1;
+                    break;
+                }
+                if(stat.fnum < 0) continue;
+
+                /* latency of a frame: decoding time since the previous frame */
+                if(lat_cnt == lat_max)
+                {
+                    lat_max = lat_max ? lat_max * 2 : 256;
+                    lat = (long long *)realloc(lat, sizeof(long long) * lat_max);
+                    if(lat == NULL)
+                    {
+                        logv0("ERROR: cannot allocate latency samples\n");
+                        xevd_delete(id);
+                        return -1;
+                    }
+                }
+                lat[lat_cnt++] = t_dec;
+                t_dec = 0;
+            }
+
+            ret = xevd_pull(id, &imgb);
+            if(ret == XEVD_ERR_UNEXPECTED && bumping) break;
+            if(XEVD_FAILED(ret))
+            {
+                logv0("failed to pull the decoded image\n");
+                ret_bench = -1;
+                break;
+            }
+            if(imgb)
+            {
+                if(t_pass < 0) t_pass = xevd_clk_nsec() - t_beg;
+                imgb->release(imgb);
+                frames++;
+            }
+        }
+
+        size = sizeof(XEVD_THREAD_STAT);
+        if(XEVD_SUCCEEDED(xevd_config(id, XEVD_CFG_GET_THREAD_STAT, &ts, &size)))
+        {
+            ts_sum.threads = ts.threads;
+            ts_sum.dec_cycles += ts.dec_cycles;
+            for(i = 0; i < ts.threads; i++)
+            {
+                ts_sum.busy_cycles[i] += ts.busy_cycles[i];
+                ts_sum.wait_cycles[i] += ts.wait_cycles[i];
+            }
+        }
+        size = sizeof(XEVD_PERF_STATS);
+        if(XEVD_SUCCEEDED(xevd_config(id, XEVD_CFG_GET_PERF_STATS, &ps, &size)))
+        {
+            for(i = 0; i < XEVD_PERF_NUM; i++) stage_sum[i] += ps.cycles[i];
+        }
+        xevd_delete(id);
+
+        t_tot += xevd_clk_nsec() - t_beg;
+        if(t_pass < 0) t_pass = 0;
+        if(pass == 0) ttff_first = t_pass;
+        ttff_sum += t_pass;
+
+        bs_reader_rewind(bs_rdr);
+        if(ret_bench) break;
+    }
+    passes = ret_bench ? pass + 1 : op_bench;
+    if(ret_bench == 0 && lat_cnt > 0) qsort(lat, lat_cnt, sizeof(long long), cmp_ll);
+
+    printf("{\n");
+    printf("  \"passes\": %d,\n", passes);
+    printf("  \"threads\": %d,\n", cdsc->threads);
+    printf("  \"frames\": %d,\n", frames);
+    printf("  \"total_ms\": %.3f,\n", t_tot / 1e6);
+    printf("  \"fps\": %.3f,\n", t_tot > 0 ? frames * 1e9 / t_tot : 0);
+    printf("  \"latency_ms\": {\"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f},\n",
+        percentile_ms(lat, lat_cnt, 50), percentile_ms(lat, lat_cnt, 95),
+        percentile_ms(lat, lat_cnt, 99), percentile_ms(lat, lat_cnt, 100));
+    printf("  \"ttff_ms\": {\"first\": %.3f, \"mean\": %.3f},\n",
+        ttff_first / 1e6, ttff_sum / 1e6 / passes);
+    printf("  \"peak_rss_bytes\": %lld,\n", xevd_peak_rss());
+    printf("  \"stage_time\": {");
+    dec = ts_sum.dec_cycles > 0 ? (double)ts_sum.dec_cycles : 1;
+    for(i = 0; i < XEVD_PERF_NUM; i++)
+    {
+        /* thread time of each stage, relative to the time in xevd_decode() */
+        printf("%s\"%s\": %.4f", i ? ", " : "", stage_name[i], stage_sum[i] / dec);
+    }
+    printf("},\n");
+    printf("  \"thread_time\": [");
+    for(i = 0; i < ts_sum.threads; i++)
+    {
+        /* fractions of the time spent in xevd_decode() */
+        busy = ts_sum.busy_cycles[i] / dec;
+        wait = ts_sum.wait_cycles[i] / dec;
+        printf("%s\n    {\"thread\": %d, \"busy\": %.4f, \"wait\": %.4f, \"idle\": %.4f}",
+            i ? "," : "", i, busy, wait, busy + wait < 1 ? 1 - busy - wait : 0);
+    }
+    printf("\n  ]\n");
+    printf("}\n");
+
+    if(lat) free(lat);
+    return ret_bench;
+}
+
 int main(int argc, const char **argv)
 {
     STATES             state = STATE_DECODING;
     unsigned char    * bs_buf = NULL;
+    BS_READER          bs_rdr;
     XEVD               id = NULL;
     XEVD_CDSC          cdsc;
     XEVD_BITB           bitb;
@@ -369,10 +596,9 @@ int main(int argc, const char **argv)
     int                ret, proc_ret;
     XEVD_CLK            clk_beg, clk_tot;
     int                bs_cnt, pic_cnt;
-    int                bs_size, bs_read_pos = 0;
+    int                bs_size, bs_hdr_size = 0;
     int                al_w, al_h;
     int                act_w = 0, act_h = 0;
-    FILE             * fp_bs = NULL;
     int                decod_frames = 0;
     int                is_y4m = 0;
     int                dim_changed = 0;
@@ -389,10 +615,12 @@ int main(int argc, const char **argv)
         return -1;
     }
 
+    /* keep the JSON report of the benchmark alone on stdout by default */
+    if(op_bench > 0 && !op_flag[OP_FLAG_VERBOSE]) op_verbose = VERBOSE_0;
+
     logv1("eXtra-fast Essential Video Decoder\n");
     /* open input bitstream */
-    fp_bs = fopen(op_fname_inp, "rb");
-    if(fp_bs == NULL)
+    if(bs_reader_open(&bs_rdr, op_fname_inp, op_start_code, op_bench > 0))
     {
         logv0("ERROR: cannot open bitstream file = %s\n", op_fname_inp);
         print_usage();
@@ -438,13 +666,47 @@ int main(int argc, const char **argv)
         fclose(fp);
     }
 
-    bs_buf = malloc(MAX_BS_BUF);
-    if(bs_buf == NULL)
+    memset(&cdsc, 0, sizeof(XEVD_CDSC));
+    cdsc.threads = (int)op_threads;
+    if(op_flag[OP_FLAG_ISA])
     {
-        logv0("ERROR: cannot allocate bit buffer, size=%d\n", MAX_BS_BUF);
-        return -1;
+        if(!strcmp(op_isa, "c")) cdsc.isa = XEVD_ISA_C;
+        else if(!strcmp(op_isa, "sse")) cdsc.isa = XEVD_ISA_SSE;
+        else if(!strcmp(op_isa, "avx2")) cdsc.isa = XEVD_ISA_AVX2;
+        else if(!strcmp(op_isa, "neon")) cdsc.isa = XEVD_ISA_NEON;
+        else
+        {
+            logv0("ERROR: unknown instruction set, %s\n", op_isa);
+            print_usage();
+            return -1;
+        }
+    }
+
+    if(op_flag[OP_FLAG_OUT_FORMAT])
+    {
+        if(!strcmp(op_out_format, "i420")) cdsc.out_cs = XEVD_CS_YCBCR420;
+        else if(!strcmp(op_out_format, "nv12")) cdsc.out_cs = XEVD_CS_NV12;
+        else if(!strcmp(op_out_format, "p010")) cdsc.out_cs = XEVD_CS_P010;
+        else
+        {
+            logv0("ERROR: unknown output format, %s\n", op_out_format);
+            print_usage();
+            return -1;
+        }
+        if(is_y4m && cdsc.out_cs != XEVD_CS_YCBCR420)
+        {
+            logv0("ERROR: y4m output supports only the i420 output format\n");
+            return -1;
+        }
+        op_out_bit_depth = XEVD_CS_GET_BIT_DEPTH(cdsc.out_cs);
+    }
+
+    if(op_bench > 0)
+    {
+        proc_ret = run_bench(&bs_rdr, &cdsc);
+        bs_reader_close(&bs_rdr);
+        return proc_ret;
     }
-    cdsc.threads = (int)op_threads;
 
     id = xevd_create(&cdsc, NULL);
     if(id == NULL)
@@ -457,6 +719,11 @@ int main(int argc, const char **argv)
         logv0("ERROR: cannot set extra configurations\n");
         return -1;
     }
+    if(op_flag[OP_FLAG_FNAME_TL] && tl_open(id, cdsc.threads > 1 ? cdsc.threads : 1))
+    {
+        xevd_delete(id);
+        return -1;
+    }
 
     pic_cnt = 0;
     clk_tot = 0;
@@ -470,7 +737,7 @@ int main(int argc, const char **argv)
         {
             memset(&stat, 0, sizeof(XEVD_STAT));
 
-            bs_size = read_bitstream(fp_bs, &bs_read_pos, bs_buf);
+            bs_size = bs_reader_next(&bs_rdr, &bs_buf, &bs_hdr_size);
 
             if (bs_size <= 0)
             {
@@ -479,8 +746,7 @@ int main(int argc, const char **argv)
                 continue;
             }
 
-            bs_read_pos += (XEVD_NAL_UNIT_LENGTH_BYTE + bs_size);
-            stat.read += XEVD_NAL_UNIT_LENGTH_BYTE;
+            stat.read += bs_hdr_size;
             bitb.addr = bs_buf;
             bitb.ssize = bs_size;
 
@@ -509,10 +775,10 @@ int main(int argc, const char **argv)
                 goto END;
             }
 
-            if(stat.read - XEVD_NAL_UNIT_LENGTH_BYTE != bs_size)
+            if(stat.read - bs_hdr_size != bs_size)
             {
                 logv0("\t=> different reading of bitstream (in:%d, read:%d)\n",
-                    bs_size, stat.read - XEVD_NAL_UNIT_LENGTH_BYTE);
+                    bs_size, stat.read - bs_hdr_size);
             }
 
             /* print extra config */
@@ -562,7 +828,7 @@ int main(int argc, const char **argv)
             if(op_flag[OP_FLAG_FNAME_OUT])
             {
 
-                if(imgb_t == NULL || dim_changed)
+                if(cdsc.out_cs == XEVD_CS_UNKNOWN && (imgb_t == NULL || dim_changed))
                 {
                     if(imgb_t)
                     {
@@ -625,9 +891,9 @@ END:
     logv1_line(NULL);
 
     if(id) xevd_delete(id);
+    tl_close();
     if(imgb_t) imgb_free(imgb_t);
-    if(fp_bs) fclose(fp_bs);
-    if(bs_buf) free(bs_buf);
+    bs_reader_close(&bs_rdr);
 
     return proc_ret;
 }
@@ -320,8 +320,15 @@ static char op_fname_out[256] = "\0";
 static int  op_max_frm_num = 0;
 static int  op_threads = 1; /* Default value */
 static int  op_use_pic_signature = 0;
+static int  op_lf_pipeline = 0;
+static int  op_au_mode = 0;
+static char op_isa[16] = "\0";
 static int  op_out_bit_depth = 8; /* default value */
 static int  op_out_chroma_format = 1;
+static int  op_start_code = 0;
+static int  op_bench = 0;
+static char op_fname_tl[256] = "\0";
+static char op_out_format[16] = "\0";
 
 typedef enum _STATES
 {
@@ -339,6 +346,13 @@ typedef enum _OP_FLAGS
     OP_FLAG_OUT_BIT_DEPTH,
     OP_FLAG_VERBOSE,
     OP_THREADS,
+    OP_FLAG_LF_PIPELINE,
+    OP_FLAG_AU_MODE,
+    OP_FLAG_ISA,
+    OP_FLAG_START_CODE,
+    OP_FLAG_BENCH,
+    OP_FLAG_FNAME_TL,
+    OP_FLAG_OUT_FORMAT,
     OP_FLAG_MAX
 
 } OP_FLAGS;
@@ -386,6 +400,47 @@ static XEVD_ARGS_OPTION options[] = \
         &op_flag[OP_FLAG_OUT_BIT_DEPTH], &op_out_bit_depth,
         "output bitdepth (8(default), 10) "
     },
+    {
+        XEVD_ARGS_NO_KEY,  "lf-pipeline", XEVD_ARGS_VAL_TYPE_NONE,
+        &op_flag[OP_FLAG_LF_PIPELINE], &op_lf_pipeline,
+        "deblock, ALF and pad CTU rows while the picture is reconstructed"
+    },
+    {
+        XEVD_ARGS_NO_KEY,  "au-mode", XEVD_ARGS_VAL_TYPE_NONE,
+        &op_flag[OP_FLAG_AU_MODE], &op_au_mode,
+        "decode the slices of a picture together once all of them are read"
+    },
+    {
+        XEVD_ARGS_NO_KEY,  "isa", XEVD_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_ISA], op_isa,
+        "instruction set of the decoding kernels (c, sse, avx2, neon)\n"
+        "\t default: the best one supported by the CPU"
+    },
+    {
+        XEVD_ARGS_NO_KEY,  "start-code", XEVD_ARGS_VAL_TYPE_NONE,
+        &op_flag[OP_FLAG_START_CODE], &op_start_code,
+        "input NAL units are delimited by start codes (00 00 01) instead of\n"
+        "\t 4-byte length prefixes. EVC has no emulation prevention, so this\n"
+        "\t only works for payloads without 00 00 01"
+    },
+    {
+        XEVD_ARGS_NO_KEY,  "bench", XEVD_ARGS_VAL_TYPE_INTEGER,
+        &op_flag[OP_FLAG_BENCH], &op_bench,
+        "decode the bitstream N times from memory without writing output\n"
+        "\t and print fps, frame latency and thread usage as JSON"
+    },
+    {
+        XEVD_ARGS_NO_KEY,  "timeline", XEVD_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_FNAME_TL], op_fname_tl,
+        "file name of the timeline of the decoding threads, in Chrome trace\n"
+        "\t JSON for chrome://tracing or ui.perfetto.dev"
+    },
+    {
+        XEVD_ARGS_NO_KEY,  "output-format", XEVD_ARGS_VAL_TYPE_STRING,
+        &op_flag[OP_FLAG_OUT_FORMAT], op_out_format,
+        "let the decoder output the pictures in i420 (8-bit), nv12 or p010\n"
+        "\t instead of converting them to --output-bit-depth"
+    },
     { 0, "", XEVD_ARGS_VAL_TYPE_NONE, NULL, NULL, "" } /* termination */
 
 };
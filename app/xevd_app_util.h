@@ -150,6 +150,46 @@ static XEVD_CLK xevd_clk_from(XEVD_CLK from) \
 #define xevd_clk_sec(clk)  \
     ((int)((clk + (XEVD_CLK_PER_SEC/2))/XEVD_CLK_PER_SEC))
 
+/* monotonic clock in nanoseconds for per-frame measurements */
+#if defined(_WIN64) || defined(_WIN32)
+#include <psapi.h>
+static long long xevd_clk_nsec(void)
+{
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER t;
+    if(freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (long long)((double)t.QuadPart * 1e9 / (double)freq.QuadPart);
+}
+
+/* peak resident set size of the process in bytes */
+static long long xevd_peak_rss(void)
+{
+    PROCESS_MEMORY_COUNTERS pmc;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return -1;
+    return (long long)pmc.PeakWorkingSetSize;
+}
+#else
+#include <sys/resource.h>
+static long long xevd_clk_nsec(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+static long long xevd_peak_rss(void)
+{
+    struct rusage ru;
+    if(getrusage(RUSAGE_SELF, &ru)) return -1;
+#if __APPLE__
+    return (long long)ru.ru_maxrss;
+#else
+    return (long long)ru.ru_maxrss * 1024;
+#endif
+}
+#endif
+
 #define XEVDA_CLIP(n,min,max) (((n)>(max))? (max) : (((n)<(min))? (min) : (n)))
 /* rounded right shift */
 #define XEVDA_RRSHIFT(v, s) ((s>0)? (((v) + (1<<((s) - 1))) >> (s)):(v))
@@ -221,7 +261,7 @@ static int imgb_read(FILE * fp, XEVD_IMGB * img)
 static int imgb_write(char * fname, XEVD_IMGB * img)
 {
     unsigned char * p8;
-    int             i, j, bd;
+    int             i, j, bd, spl;
     int             cs_w_off, cs_h_off;
     FILE          * fp;
 
@@ -283,9 +323,11 @@ static int imgb_write(char * fname, XEVD_IMGB * img)
             p8 += img->s[i];
         }
 
+        /* the chroma plane of NV12 and P010 interleaves Cb and Cr */
+        spl = (i && img->np == 2) ? 2 : 1;
         for(j = 0; j < th; j++)
         {
-            fwrite(p8 + tcl * bd, tw * bd, 1, fp);
+            fwrite(p8 + tcl * bd * spl, tw * bd * spl, 1, fp);
             p8 += img->s[i];
         }
     }
@@ -796,4 +838,225 @@ XEVD_IMGB * imgb_alloc(int w, int h, int cs)
 }
 
 
+/* Bitstream reader: the input file is memory-mapped (or loaded once when
+   mapping is not possible) and NAL units are handed out as pointers into
+   it. NAL units are read in the length-prefixed EVC format, or delimited by
+   start codes on request. EVC has no emulation prevention, so the latter
+   splits a NAL unit wherever its payload contains 00 00 01 */
+#if defined(_WIN64) || defined(_WIN32)
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+typedef struct _BS_READER
+{
+    unsigned char * buf;
+    long long       size;
+    long long       pos;
+    int             mapped;
+    int             start_code; /* start code delimited NAL units */
+#if defined(_WIN64) || defined(_WIN32)
+    HANDLE          map;
+#endif
+} BS_READER;
+
+static int bs_reader_load(BS_READER * r, const char * fname)
+{
+    FILE          * fp;
+    unsigned char * t;
+    long long       alloc = 1 << 20;
+    size_t          read_size;
+
+    fp = fopen(fname, "rb");
+    if(fp == NULL) return -1;
+
+    r->buf = NULL;
+    r->size = 0;
+    while(1)
+    {
+        t = (unsigned char *)realloc(r->buf, (size_t)alloc);
+        if(t == NULL) break;
+        r->buf = t;
+        read_size = fread(r->buf + r->size, 1, (size_t)(alloc - r->size), fp);
+        r->size += read_size;
+        if(r->size < alloc) break;
+        alloc <<= 1;
+    }
+    fclose(fp);
+    return (t == NULL) ? -1 : 0;
+}
+
+static int bs_reader_map(BS_READER * r, const char * fname)
+{
+#if defined(_WIN64) || defined(_WIN32)
+    HANDLE        file;
+    LARGE_INTEGER size;
+
+    file = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                       FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if(file == INVALID_HANDLE_VALUE) return -1;
+    if(!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return -1;
+    }
+    r->map = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if(r->map == NULL) return -1;
+
+    r->buf = (unsigned char *)MapViewOfFile(r->map, FILE_MAP_READ, 0, 0, 0);
+    if(r->buf == NULL)
+    {
+        CloseHandle(r->map);
+        return -1;
+    }
+    r->size = size.QuadPart;
+#else
+    int         fd;
+    struct stat st;
+    void      * addr;
+
+    fd = open(fname, O_RDONLY);
+    if(fd < 0) return -1;
+    if(fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    {
+        close(fd);
+        return -1;
+    }
+    addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(addr == MAP_FAILED) return -1;
+
+#if defined(MADV_SEQUENTIAL)
+    madvise(addr, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+    r->buf = (unsigned char *)addr;
+    r->size = st.st_size;
+#endif
+    r->mapped = 1;
+    return 0;
+}
+
+static void bs_reader_close(BS_READER * r)
+{
+    if(r->buf)
+    {
+        if(r->mapped)
+        {
+#if defined(_WIN64) || defined(_WIN32)
+            UnmapViewOfFile(r->buf);
+            CloseHandle(r->map);
+#else
+            munmap(r->buf, (size_t)r->size);
+#endif
+        }
+        else
+        {
+            free(r->buf);
+        }
+    }
+    memset(r, 0, sizeof(BS_READER));
+}
+
+/* preload reads the whole file into memory instead of mapping it, so that
+   no page fault is taken while decoding */
+static int bs_reader_open(BS_READER * r, const char * fname, int start_code, int preload)
+{
+    memset(r, 0, sizeof(BS_READER));
+
+    if((preload || bs_reader_map(r, fname)) && bs_reader_load(r, fname))
+    {
+        bs_reader_close(r);
+        return -1;
+    }
+
+    r->start_code = start_code;
+    return 0;
+}
+
+static void bs_reader_rewind(BS_READER * r)
+{
+    r->pos = 0;
+}
+
+/* position of the next 00 00 01, or end. a NAL unit is shorter than 2 GB,
+   so the search does not need to go further than that */
+static unsigned char * bs_find_start_code(unsigned char * p, unsigned char * end)
+{
+    int n, i;
+
+    n = (end - p < 0x7FFFFFFF) ? (int)(end - p) : 0x7FFFFFFF;
+    i = xevd_find_start_code(p, n);
+    return i < n ? p + i : end;
+}
+
+/* returns size of the next NAL unit and its address in *nalu, or -1 at the
+   end of stream. *hdr is set to the number of bytes preceding the NAL unit */
+static int bs_reader_next(BS_READER * r, unsigned char ** nalu, int * hdr)
+{
+    unsigned char * beg, * cur, * end, * nxt;
+    long long       left;
+    XEVD_INFO       info;
+    int             ret, size;
+
+    left = r->size - r->pos;
+    cur = r->buf + r->pos;
+    if(left <= 0)
+    {
+        logv2("End of file\n");
+        return -1;
+    }
+
+    if(!r->start_code)
+    {
+        if(left < XEVD_NAL_UNIT_LENGTH_BYTE)
+        {
+            logv0("Cannot read bitstream size!\n");
+            return -1;
+        }
+        ret = xevd_info(cur, XEVD_NAL_UNIT_LENGTH_BYTE, 1, &info);
+        if(XEVD_FAILED(ret))
+        {
+            logv0("Cannot get bitstream information\n");
+            return -1;
+        }
+        size = info.nalu_len;
+        if(size <= 0 || size > left - XEVD_NAL_UNIT_LENGTH_BYTE)
+        {
+            logv0("Invalid bitstream size![%d]\n", size);
+            return -1;
+        }
+        *hdr = XEVD_NAL_UNIT_LENGTH_BYTE;
+        *nalu = cur + XEVD_NAL_UNIT_LENGTH_BYTE;
+        r->pos += XEVD_NAL_UNIT_LENGTH_BYTE + size;
+        return size;
+    }
+
+    end = r->buf + r->size;
+    beg = bs_find_start_code(cur, end);
+    if(beg == end)
+    {
+        logv2("End of file\n");
+        return -1;
+    }
+    beg += 3;
+    nxt = bs_find_start_code(beg, end);
+    r->pos = nxt - r->buf;
+
+    /* drop trailing_zero_8bits and the leading zero of a 4-byte start code */
+    while(nxt > beg && nxt[-1] == 0) nxt--;
+
+    if(nxt - beg > 0x7FFFFFFF)
+    {
+        logv0("Invalid bitstream size!\n");
+        return -1;
+    }
+    *hdr = (int)(beg - cur);
+    *nalu = beg;
+    return (int)(nxt - beg);
+}
+
 #endif /* _XEVD_APP_UTIL_H_ */
@@ -0,0 +1,1003 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+   /*
+      Redistribution and use in source and binary forms, with or without
+      modification, are permitted provided that the following conditions are met:
+
+      - Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+      - Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+      - Neither the name of the copyright owner, nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+      AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+      IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+      ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+      LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+      CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+      SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+      INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+      CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+      ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+      POSSIBILITY OF SUCH DAMAGE.
+   */
+
+/* Micro-benchmark of the kernels dispatched through the decoder context.
+   Every kernel table is filled by the same platform initialization the
+   decoder uses, once per instruction set level available on the machine.
+   Each kernel is run on random input for the block sizes and bit depths it
+   is used with; the output is checked against the C level and the cost is
+   reported as JSON on stdout. Returns non-zero if any output differs. */
+
+#include "xevdm_def.h"
+#include "xevdm_df.h"
+#include "xevdm_alf.h"
+#include "xevdm_tbl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if X86_SSE
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#define BENCH_ISA_NUM      4 /* C, SSE, AVX2, NEON; index is XEVD_ISA_XXX - 1 */
+#define BENCH_PELS_DEFAULT (1 << 16)
+#define BENCH_REPEAT       3
+
+#define BENCH_STRIDE       (MAX_CU_SIZE * 2)
+#define BENCH_PLANE        (BENCH_STRIDE * BENCH_STRIDE)
+#define BENCH_ORG          (BENCH_STRIDE * (MAX_CU_SIZE / 2) + (MAX_CU_SIZE / 2))
+#define BENCH_COEF_RANGE   8192 /* keeps every stage of the inverse transforms in 16 bits */
+
+static const char * bench_isa_name[BENCH_ISA_NUM] = {"c", "sse", "avx2", "neon"};
+
+typedef void (*BENCH_RECON)(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth);
+
+typedef struct _BENCH_ISA
+{
+    int          avail;
+    XEVDM_CTX  * mctx;
+    /* reconstruction is dispatched by the baseline profile only */
+    BENCH_RECON  fn_recon;
+} BENCH_ISA;
+
+static BENCH_ISA bench_isa[BENCH_ISA_NUM];
+
+/* options */
+static int          bench_pels = BENCH_PELS_DEFAULT;
+static int          bench_time = 1;
+static const char * bench_filter = NULL;
+
+/* state of the report */
+static int bench_cnt = 0;
+static int bench_mismatch = 0;
+
+/* buffers shared by all kernels */
+static pel  buf_ref[BENCH_PLANE];
+static pel  buf_ref2[BENCH_PLANE];
+static pel  buf_dst[BENCH_PLANE];
+static pel  buf_org[BENCH_PLANE];
+static s16  buf_coef[MAX_CU_DIM];
+static s32  buf_tmp[MAX_CU_DIM];
+static pel  buf_ipred[(MAX_CU_SIZE >> 1) * (MAX_CU_SIZE >> 1) * IPD_CNT]; /* one block per mode */
+static u8 * buf_out[BENCH_ISA_NUM];
+
+/* timer: TSC on x86, the virtual counter on AArch64, otherwise clock() */
+static u64 bench_clk(void)
+{
+#if X86_SSE
+    return (u64)__rdtsc();
+#elif ARM_NEON && defined(__aarch64__)
+    u64 t;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#else
+    return (u64)clock();
+#endif
+}
+
+static const char * bench_clk_name(void)
+{
+#if X86_SSE
+    return "tsc";
+#elif ARM_NEON && defined(__aarch64__)
+    return "cntvct";
+#else
+    return "clock";
+#endif
+}
+
+static u32 bench_rand_state = 0x12345678;
+
+static u32 bench_rand(void)
+{
+    /* xorshift32, same sequence on every platform */
+    bench_rand_state ^= bench_rand_state << 13;
+    bench_rand_state ^= bench_rand_state >> 17;
+    bench_rand_state ^= bench_rand_state << 5;
+    return bench_rand_state;
+}
+
+static void bench_fill_pel(pel * buf, int size, int bit_depth)
+{
+    int i, max = (1 << bit_depth) - 1;
+
+    for(i = 0; i < size; i++)
+    {
+        buf[i] = (pel)(bench_rand() & max);
+    }
+}
+
+/* smooth area with a step in the middle so that the filters are applied */
+static void bench_fill_edge(pel * buf, int size, int bit_depth)
+{
+    int i, max = (1 << bit_depth) - 1, base, step, noise;
+
+    base = bench_rand() & max;
+    step = (int)(bench_rand() % 24) << (bit_depth - 8);
+    noise = 1 + ((int)(bench_rand() & 7) << (bit_depth - 8));
+    for(i = 0; i < size; i++)
+    {
+        int v = base + (((i % BENCH_STRIDE) >= BENCH_STRIDE / 2 || (i / BENCH_STRIDE) >= BENCH_STRIDE / 2) ? step : 0);
+        v += (int)(bench_rand() % (2 * noise + 1)) - noise;
+        buf[i] = (pel)XEVD_CLIP3(0, max, v);
+    }
+}
+
+/* sparse block of w x h coefficients; as in the bitstream, only the
+   low-frequency 32x32 part of a 64-point transform can be non-zero */
+static void bench_fill_coef(s16 * buf, int w, int h, int range)
+{
+    int i, j;
+
+    for(i = 0; i < h; i++) for(j = 0; j < w; j++)
+    {
+        buf[i * w + j] = (i >= 32 || j >= 32 || (bench_rand() & 3)) ? 0 :
+            (s16)((int)(bench_rand() % (2 * range + 1)) - range);
+    }
+}
+
+typedef struct _BENCH_ARG
+{
+    int    w;
+    int    h;
+    int    bit_depth;
+    int    idx; /* table index or mode */
+    int    opt; /* kernel specific option */
+    void * out; /* output compared between levels */
+    int    out_size;
+    void * ref; /* expected output, NULL to compare with the C level */
+} BENCH_ARG;
+
+/* prepares the (in-place) output, then runs the kernel once */
+typedef void (*BENCH_PREP)(BENCH_ARG * a);
+typedef void (*BENCH_RUN)(BENCH_ISA * isa, BENCH_ARG * a);
+
+static void bench_do(const char * kernel, const char * variant, BENCH_ARG * a, int pels,
+                     BENCH_PREP prep, BENCH_RUN run)
+{
+    int    i, r, n, iter, exact;
+    u64    t, best[BENCH_ISA_NUM];
+    double cpp_c = 0;
+
+    if(bench_filter && strstr(kernel, bench_filter) == NULL) return;
+
+    iter = XEVD_MAX(1, bench_pels / XEVD_MAX(1, pels));
+
+    for(i = 0; i < BENCH_ISA_NUM; i++)
+    {
+        if(!bench_isa[i].avail) continue;
+
+        if(prep) prep(a);
+        run(&bench_isa[i], a);
+        memcpy(buf_out[i], a->out, a->out_size);
+
+        best[i] = (u64)-1;
+        for(r = 0; bench_time && r < BENCH_REPEAT; r++)
+        {
+            t = bench_clk();
+            for(n = 0; n < iter; n++)
+            {
+                run(&bench_isa[i], a);
+            }
+            t = bench_clk() - t;
+            best[i] = XEVD_MIN(best[i], t);
+        }
+    }
+
+    for(i = 0; i < BENCH_ISA_NUM; i++)
+    {
+        double cpp;
+
+        if(!bench_isa[i].avail) continue;
+
+        exact = !memcmp(buf_out[i], a->ref ? a->ref : buf_out[0], a->out_size);
+        if(!exact) bench_mismatch++;
+
+        cpp = bench_time ? (double)best[i] / ((double)iter * pels) : 0;
+        if(i == 0) cpp_c = cpp;
+
+        printf("%s    {\"kernel\": \"%s\", \"variant\": \"%s\", \"w\": %d, \"h\": %d, \"bit_depth\": %d, "
+               "\"isa\": \"%s\", \"bitexact\": %s, \"cycles_per_pixel\": %.4f, \"speedup\": %.2f}",
+               bench_cnt ? ",\n" : "", kernel, variant, a->w, a->h, a->bit_depth,
+               bench_isa_name[i], exact ? "true" : "false", cpp, cpp > 0 ? cpp_c / cpp : 0);
+        bench_cnt++;
+    }
+}
+
+static const int bench_bit_depth[] =
+{
+#if XEVD_PEL_8BIT
+    8
+#else
+    8, 10
+#endif
+};
+#define BENCH_BD_NUM ((int)(sizeof(bench_bit_depth) / sizeof(bench_bit_depth[0])))
+
+static const char * bench_mc_name[2][2] = {{"00", "0n"}, {"n0", "nn"}};
+
+/* motion compensation *******************************************************/
+static void run_mc_l(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int dx = a->idx >> 1, dy = a->idx & 1;
+    isa->mctx->bctx.fn_mc_l[dx][dy](buf_ref + BENCH_ORG, (dx ? 5 : 0) + (a->opt << 4), (dy ? 11 : 0), BENCH_STRIDE,
+                                    a->w, buf_dst, a->w, a->h, a->bit_depth, tbl_mc_l_coeff_main[0]);
+}
+
+static void run_mc_c(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int dx = a->idx >> 1, dy = a->idx & 1;
+    isa->mctx->bctx.fn_mc_c[dx][dy](buf_ref + BENCH_ORG, (dx ? 13 : 0) + (a->opt << 5), (dy ? 22 : 0), BENCH_STRIDE,
+                                    a->w, buf_dst, a->w, a->h, a->bit_depth, tbl_mc_c_coeff_main[0]);
+}
+
+static void run_dmvr_mc_l(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int dx = a->idx >> 1, dy = a->idx & 1;
+    isa->mctx->fn_dmvr_mc_l[dx][dy](buf_ref + BENCH_ORG, (dx ? 7 : 0), (dy ? 3 : 0), BENCH_STRIDE,
+                                    a->w, buf_dst, a->w, a->h, a->bit_depth, tbl_mc_l_coeff_main[0]);
+}
+
+static void run_dmvr_mc_c(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int dx = a->idx >> 1, dy = a->idx & 1;
+    isa->mctx->fn_dmvr_mc_c[dx][dy](buf_ref + BENCH_ORG, (dx ? 9 : 0), (dy ? 27 : 0), BENCH_STRIDE,
+                                    a->w, buf_dst, a->w, a->h, a->bit_depth, tbl_mc_c_coeff_main[0]);
+}
+
+static void run_bl_mc_l(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int dx = a->idx >> 1, dy = a->idx & 1;
+    isa->mctx->fn_bl_mc_l[dx][dy](buf_ref + BENCH_ORG, (dx ? 4 : 0), (dy ? 12 : 0), BENCH_STRIDE,
+                                  a->w, buf_dst, a->w, a->h, a->bit_depth);
+}
+
+/* the prediction is averaged in place as in xevd_mc() */
+static void prep_average(BENCH_ARG * a)
+{
+    memcpy(buf_dst, buf_ref, a->out_size);
+}
+
+static void run_average(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    isa->mctx->bctx.fn_average_no_clip(buf_dst, buf_ref2, buf_dst, a->w, a->w, a->w, a->w, a->h, a->bit_depth);
+}
+
+static void bench_mc(void)
+{
+    static const int size_l[] = {4, 8, 16, 32, 64, 128};
+    static const int size_c[] = {2, 4, 8, 16, 32, 64};
+    static const int size_dmvr[] = {8, 12, 16, 20};
+    BENCH_ARG a;
+    int b, i, j, k;
+
+    for(b = 0; b < BENCH_BD_NUM; b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bench_bit_depth[b];
+        a.out = buf_dst;
+        bench_fill_pel(buf_ref, BENCH_PLANE, a.bit_depth);
+        bench_fill_pel(buf_ref2, BENCH_PLANE, a.bit_depth);
+
+        for(k = 0; k < 4; k++)
+        {
+            a.idx = k;
+            for(i = 0; i < 6; i++) for(j = 0; j < 6; j++)
+            {
+                a.w = size_l[i];
+                a.h = size_l[j];
+                a.out_size = a.w * a.h * sizeof(pel);
+                bench_do("mc_l", bench_mc_name[k >> 1][k & 1], &a, a.w * a.h, NULL, run_mc_l);
+
+                a.w = size_c[i];
+                a.h = size_c[j];
+                a.out_size = a.w * a.h * sizeof(pel);
+                bench_do("mc_c", bench_mc_name[k >> 1][k & 1], &a, a.w * a.h, NULL, run_mc_c);
+            }
+            for(i = 0; i < 4; i++) for(j = 0; j < 4; j++)
+            {
+                a.w = size_dmvr[i];
+                a.h = size_dmvr[j];
+                a.out_size = a.w * a.h * sizeof(pel);
+                bench_do("dmvr_mc_l", bench_mc_name[k >> 1][k & 1], &a, a.w * a.h, NULL, run_dmvr_mc_l);
+                bench_do("bl_mc_l", bench_mc_name[k >> 1][k & 1], &a, a.w * a.h, NULL, run_bl_mc_l);
+
+                a.w = size_dmvr[i] >> 1;
+                a.h = size_dmvr[j] >> 1;
+                a.out_size = a.w * a.h * sizeof(pel);
+                bench_do("dmvr_mc_c", bench_mc_name[k >> 1][k & 1], &a, a.w * a.h, NULL, run_dmvr_mc_c);
+            }
+        }
+
+        for(i = 0; i < 6; i++) for(j = 0; j < 6; j++)
+        {
+            a.w = size_l[i];
+            a.h = size_l[j];
+            a.out_size = a.w * a.h * sizeof(pel);
+            bench_do("average_no_clip", "-", &a, a.w * a.h, prep_average, run_average);
+        }
+    }
+}
+
+/* DMVR bilateral cost *******************************************************/
+#if X86_SSE && !XEVD_PEL_8BIT
+static int bench_sad_out[2];
+
+static void run_dmvr_sad(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    s16 delta = (s16)(a->opt - 64);
+
+    if(isa == &bench_isa[XEVD_ISA_C - 1])
+    {
+        bench_sad_out[0] = xevdm_dmvr_sad(a->w, a->h, buf_ref, buf_ref2, BENCH_STRIDE, BENCH_STRIDE, delta, a->bit_depth);
+    }
+    else
+    {
+        bench_sad_out[0] = dmvr_sad_mr_16b_sse(a->w, a->h, buf_ref, buf_ref2, BENCH_STRIDE, BENCH_STRIDE, delta, a->bit_depth);
+    }
+}
+
+static void bench_dmvr_sad(void)
+{
+    static const int size[] = {8, 16, 32, 64};
+    BENCH_ARG a;
+    int b, i, j;
+
+    for(b = 0; b < BENCH_BD_NUM; b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bench_bit_depth[b];
+        a.out = bench_sad_out;
+        a.out_size = sizeof(int);
+        bench_fill_pel(buf_ref, BENCH_PLANE, a.bit_depth + 1);
+        bench_fill_pel(buf_ref2, BENCH_PLANE, a.bit_depth);
+
+        for(i = 0; i < 4; i++) for(j = 0; j < 4; j++)
+        {
+            a.w = size[i];
+            a.h = size[j];
+            a.opt = bench_rand() & 127;
+            bench_do("dmvr_sad_mr", "-", &a, a.w * a.h, NULL, run_dmvr_sad);
+        }
+    }
+}
+#endif
+
+/* inverse transforms ********************************************************/
+static void run_itxb(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int log2_w = XEVD_CONV_LOG2(a->w), log2_h = XEVD_CONV_LOG2(a->h);
+    const XEVD_ITXB * itxb = *isa->mctx->bctx.fn_itxb;
+
+    itxb[log2_h - 1](buf_coef, buf_tmp, 0, a->w, 0);
+    itxb[log2_w - 1](buf_tmp, buf_dst, 7 + 12 - (a->bit_depth - 8), a->h, 1);
+}
+
+static void run_itx(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int log2_w = XEVD_CONV_LOG2(a->w), log2_h = XEVD_CONV_LOG2(a->h);
+    XEVD_ITX * itx = *isa->mctx->fn_itx;
+
+    itx[log2_h - 1](buf_coef, (s16 *)buf_tmp, 7, a->w);
+    itx[log2_w - 1]((s16 *)buf_tmp, (s16 *)buf_dst, 12 - (a->bit_depth - 8), a->h);
+}
+
+static void bench_itx(void)
+{
+    BENCH_ARG a;
+    int b, i, j;
+    char variant[16];
+
+    for(b = 0; b < BENCH_BD_NUM; b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bench_bit_depth[b];
+        a.out = buf_dst;
+
+        for(i = 1; i <= MAX_TR_LOG2; i++) for(j = 1; j <= MAX_TR_LOG2; j++)
+        {
+            a.w = 1 << i;
+            a.h = 1 << j;
+            bench_fill_coef(buf_coef, a.w, a.h, BENCH_COEF_RANGE);
+            a.out_size = a.w * a.h * sizeof(s16);
+            sprintf(variant, "%dx%d", a.w, a.h);
+            bench_do("itxb", variant, &a, a.w * a.h, NULL, run_itxb);
+            bench_do("itx", variant, &a, a.w * a.h, NULL, run_itx);
+        }
+    }
+}
+
+/* sparse coefficient storage ************************************************/
+static XEVD_CU_DATA bench_cu_data;
+static int          bench_cu_ofs[N_C];
+static s16          buf_level[MAX_TR_DIM];
+static s16          buf_resi[MAX_TR_DIM];
+static int          bench_dq_scale;
+
+static const char * bench_itdq_name[3] = {"base", "dct", "iqt"};
+
+/* parsed levels are stored with xevd_coef_pack() and expanded before the
+   inverse transform, which skips the dequantization and the transform of
+   DC-only blocks; the residual must match dequantizing and transforming the
+   dense block with the C kernels */
+static int bench_dq_shift(BENCH_ARG * a)
+{
+    int log2_w = XEVD_CONV_LOG2(a->w), log2_h = XEVD_CONV_LOG2(a->h);
+
+    return QUANT_IQUANT_SHIFT - QUANT_SHIFT - (MAX_TX_DYNAMIC_RANGE - a->bit_depth - ((log2_w + log2_h) >> 1)) +
+           (((log2_w + log2_h) & 1) ? 8 : 0);
+}
+
+static void ref_itdq(BENCH_ARG * a)
+{
+    XEVDM_CTX * mctx = bench_isa[0].mctx;
+    int log2_w = XEVD_CONV_LOG2(a->w), log2_h = XEVD_CONV_LOG2(a->h);
+    int shift = bench_dq_shift(a);
+    int i, max_x = 0, max_y = 0;
+
+    memcpy(buf_resi, buf_level, a->w * a->h * sizeof(s16));
+    xevd_dquant(buf_resi, log2_w, log2_h, bench_dq_scale, shift ? 1 << (shift - 1) : 0, (u8)shift);
+
+    if(a->idx)
+    {
+        for(i = 0; i < a->w * a->h; i++)
+        {
+            if(buf_resi[i] == 0) continue;
+            max_x = XEVD_MAX(max_x, i % a->w);
+            max_y = XEVD_MAX(max_y, i / a->w);
+        }
+        xevdm_itrans_ats_intra((XEVD_CTX *)mctx, buf_resi, log2_w, log2_h, (u8)(a->idx - 1),
+                               a->w - 1 - max_x, a->h - 1 - max_y, a->bit_depth);
+    }
+    else if(a->opt == 2)
+    {
+        (*mctx->fn_itx)[log2_h - 1](buf_resi, (s16 *)buf_tmp, 7, a->w);
+        (*mctx->fn_itx)[log2_w - 1]((s16 *)buf_tmp, buf_resi, 12 - (a->bit_depth - 8), a->h);
+    }
+    else
+    {
+        (*mctx->bctx.fn_itxb)[log2_h - 1](buf_resi, buf_tmp, 0, a->w, 0);
+        (*mctx->bctx.fn_itxb)[log2_w - 1](buf_tmp, buf_resi, 7 + 12 - (a->bit_depth - 8), a->h, 1);
+    }
+}
+
+static void run_itdq(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int log2_w = XEVD_CONV_LOG2(a->w), log2_h = XEVD_CONV_LOG2(a->h);
+
+    bench_cu_data.coef_cnt = 0;
+    xevd_coef_pack(&bench_cu_data, 0, Y_C, buf_level, a->w * a->h);
+    xevd_coef_unpack(&bench_cu_data, 0, Y_C, buf_coef, a->w * a->h);
+
+    if(a->opt == 0)
+    {
+        xevd_itdq(&isa->mctx->bctx, buf_coef, log2_w, log2_h, bench_dq_scale, a->bit_depth);
+    }
+    else
+    {
+        xevdm_itdq(&isa->mctx->bctx, buf_coef, log2_w, log2_h, bench_dq_scale, a->opt == 2,
+                   a->idx != 0, (u8)(a->idx ? a->idx - 1 : 0), a->bit_depth);
+    }
+}
+
+static void bench_itdq_do(BENCH_ARG * a, int dc)
+{
+    char variant[32];
+    int  qp = (int)(bench_rand() % (52 + 6 * (a->bit_depth - 8)));
+    int  range, ns_scale = ((XEVD_CONV_LOG2(a->w) + XEVD_CONV_LOG2(a->h)) & 1) ? 181 : 1;
+
+    bench_dq_scale = (a->opt == 2 ? xevd_tbl_dq_scale : xevd_tbl_dq_scale_b)[qp % 6] << (qp / 6);
+    /* levels whose dequantized values stay in the range the kernels are checked with */
+    range = (int)XEVD_MIN(1024, XEVD_MAX(1, ((s64)BENCH_COEF_RANGE << bench_dq_shift(a)) / ((s64)bench_dq_scale * ns_scale)));
+    if(dc)
+    {
+        memset(buf_level, 0, a->w * a->h * sizeof(s16));
+        buf_level[0] = (s16)((bench_rand() & 1) ? 1 + (int)(bench_rand() % range) : -1 - (int)(bench_rand() % range));
+    }
+    else
+    {
+        bench_fill_coef(buf_level, a->w, a->h, range);
+    }
+    ref_itdq(a);
+
+    a->out_size = a->w * a->h * sizeof(s16);
+    if(a->idx) sprintf(variant, "ats%d_%s", a->idx - 1, dc ? "dc" : "sparse");
+    else sprintf(variant, "%s_%s", bench_itdq_name[a->opt], dc ? "dc" : "sparse");
+    bench_do("itdq", variant, a, a->w * a->h, NULL, run_itdq);
+}
+
+static void bench_itdq(void)
+{
+    BENCH_ARG a;
+    int b, i, j, k, dc;
+
+    bench_cu_data.coef_ofs[Y_C] = bench_cu_ofs;
+
+    for(b = 0; b < BENCH_BD_NUM; b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bench_bit_depth[b];
+        a.out = buf_coef;
+        a.ref = buf_resi;
+
+        for(i = 1; i <= MAX_TR_LOG2; i++) for(j = 1; j <= MAX_TR_LOG2; j++) for(dc = 0; dc < 2; dc++)
+        {
+            a.w = 1 << i;
+            a.h = 1 << j;
+            for(a.opt = 0; a.opt < 3; a.opt++)
+            {
+                bench_itdq_do(&a, dc);
+            }
+            /* intra ATS is used for 4x4 to 32x32 luma blocks */
+            if(i < 2 || j < 2 || i > 5 || j > 5) continue;
+            for(k = 0; k < 4; k++)
+            {
+                a.opt = 2;
+                a.idx = k + 1;
+                bench_itdq_do(&a, dc);
+            }
+            a.idx = 0;
+        }
+    }
+
+    xevd_mfree_fast(bench_cu_data.coef);
+    memset(&bench_cu_data, 0, sizeof(bench_cu_data));
+}
+
+/* reconstruction ************************************************************/
+static void run_recon(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    isa->fn_recon(buf_coef, buf_ref, a->opt, a->w, a->h, BENCH_STRIDE, buf_dst, a->bit_depth);
+}
+
+static void bench_recon(void)
+{
+    static const int size[] = {2, 4, 8, 16, 32, 64, 128};
+    BENCH_ARG a;
+    int b, i, j, k;
+
+    for(b = 0; b < BENCH_BD_NUM; b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bench_bit_depth[b];
+        a.out = buf_dst;
+        bench_fill_pel(buf_ref, BENCH_PLANE, a.bit_depth);
+        for(i = 0; i < MAX_CU_DIM; i++)
+        {
+            buf_coef[i] = (s16)((int)(bench_rand() % (2 << a.bit_depth)) - (1 << a.bit_depth));
+        }
+
+        for(k = 0; k < 2; k++) for(i = 0; i < 7; i++) for(j = 0; j < 7; j++)
+        {
+            a.w = size[i];
+            a.h = size[j];
+            a.opt = k;
+            a.out_size = BENCH_STRIDE * a.h * sizeof(pel);
+            memset(buf_dst, 0, a.out_size);
+            bench_do("recon", k ? "coef" : "copy", &a, a.w * a.h, NULL, run_recon);
+        }
+    }
+}
+
+/* intra prediction **********************************************************/
+static pel * bench_nb[3];
+
+static void run_ipred_ang(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    int ipm;
+
+    for(ipm = IPD_BI + 1; ipm < IPD_CNT; ipm++)
+    {
+        if(ipm == IPD_VER || ipm == IPD_HOR) continue;
+        isa->mctx->bctx.fn_ipred_ang(bench_nb[0], bench_nb[1], bench_nb[2], (u16)a->opt,
+                                     buf_ipred + a->w * a->h * ipm, a->w, a->h, ipm, a->bit_depth);
+    }
+}
+
+static void run_ipred_bi(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    isa->mctx->bctx.fn_ipred_bi(bench_nb[0], bench_nb[1], bench_nb[2], (u16)a->opt, buf_dst, a->w, a->h, a->bit_depth);
+}
+
+static void run_ipred_plane(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    isa->mctx->bctx.fn_ipred_plane(bench_nb[0], bench_nb[1], bench_nb[2], (u16)a->opt, buf_dst, a->w, a->h, a->bit_depth);
+}
+
+static void bench_ipred(void)
+{
+    static const int size[] = {2, 4, 8, 16, 32, 64};
+    BENCH_ARG a;
+    int b, i, j, nmode = IPD_CNT - IPD_BI - 3;
+
+    for(b = 0; b < BENCH_BD_NUM; b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bench_bit_depth[b];
+        a.out = buf_dst;
+        bench_fill_pel(buf_ref, BENCH_PLANE, a.bit_depth);
+
+        for(i = 0; i < 6; i++) for(j = 0; j < 6; j++)
+        {
+            a.w = size[i];
+            a.h = size[j];
+            if(a.w > a.h * 16 || a.h > a.w * 16) continue;
+
+            bench_nb[0] = buf_ref + 2;
+            bench_nb[1] = buf_ref + MAX_CU_SIZE * 3 + a.h;
+            bench_nb[2] = buf_ref + MAX_CU_SIZE * 6 + 2;
+            a.opt = bench_rand() & 3;
+
+            a.out = buf_ipred;
+            a.out_size = a.w * a.h * IPD_CNT * sizeof(pel);
+            memset(buf_ipred, 0, a.out_size);
+            bench_do("ipred_ang", "-", &a, a.w * a.h * nmode, NULL, run_ipred_ang);
+
+            a.out = buf_dst;
+            a.out_size = a.w * a.h * sizeof(pel);
+            bench_do("ipred_bi", "-", &a, a.w * a.h, NULL, run_ipred_bi);
+            if(a.w >= 4 && a.h >= 4)
+            {
+                bench_do("ipred_plane", "-", &a, a.w * a.h, NULL, run_ipred_plane);
+            }
+        }
+    }
+}
+
+/* deblocking ****************************************************************/
+static void prep_dbk(BENCH_ARG * a)
+{
+    memcpy(buf_dst, buf_org, sizeof(buf_dst));
+}
+
+static pel * bench_edge(void)
+{
+    /* the edge is at the middle of the buffer */
+    return buf_dst + (BENCH_STRIDE / 2) * BENCH_STRIDE + (BENCH_STRIDE / 2);
+}
+
+static void run_dbk(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    (*isa->mctx->bctx.fn_dbk)[a->idx](bench_edge(), a->opt, BENCH_STRIDE, a->bit_depth - 8, 1);
+}
+
+static void run_dbk_chroma(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    pel * u = bench_edge();
+    (*isa->mctx->bctx.fn_dbk_chroma)[a->idx](u, u + 8 * BENCH_STRIDE, a->opt, a->opt + 1, BENCH_STRIDE,
+                                             a->bit_depth - 8, a->w);
+}
+
+/* filter parameters derived as in xevdm_df.c */
+static int bench_addb_bs, bench_addb_alpha, bench_addb_beta, bench_addb_c;
+
+static void run_dbk_addb(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    (*isa->mctx->fn_dbk_addb)[a->idx](bench_edge(), BENCH_STRIDE, bench_addb_bs, bench_addb_alpha, bench_addb_beta,
+                                      bench_addb_c, a->bit_depth - 8, a->w);
+}
+
+static void run_dbk_addb_chroma(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    (*isa->mctx->fn_dbk_addb_chroma)[a->idx](bench_edge(), BENCH_STRIDE, bench_addb_bs, bench_addb_alpha, bench_addb_beta,
+                                             bench_addb_c + (1 << XEVD_MAX(0, a->bit_depth - 9)), a->bit_depth - 8, a->w);
+}
+
+static void bench_dbk(void)
+{
+    static const char * dir_name[DBK_MAX] = {"ver", "hor"};
+    BENCH_ARG a;
+    int b, d, i, k, sh, idx;
+
+    for(b = 0; b < BENCH_BD_NUM; b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bench_bit_depth[b];
+        a.out = buf_dst;
+        a.out_size = sizeof(buf_dst);
+        sh = a.bit_depth - 8;
+
+        for(d = 0; d < DBK_MAX; d++)
+        {
+            a.idx = d;
+            for(k = 0; k < 8; k++)
+            {
+                bench_fill_edge(buf_org, BENCH_PLANE, a.bit_depth);
+
+                a.w = a.h = MIN_CU_SIZE;
+                a.opt = (1 + (int)(bench_rand() % 20)) << sh;
+                bench_do("dbk", dir_name[d], &a, MIN_CU_SIZE * 4, prep_dbk, run_dbk);
+
+                /* a.w carries chroma_format_idc */
+                for(i = 1; i <= 3; i++)
+                {
+                    a.w = i;
+                    bench_do("dbk_chroma", dir_name[d], &a, MIN_CU_SIZE * 4, prep_dbk, run_dbk_chroma);
+                }
+
+                idx = (int)(bench_rand() % 52);
+                bench_addb_bs = 1 + (int)(bench_rand() % 4);
+                bench_addb_alpha = ALPHA_TABLE[idx] << sh;
+                bench_addb_beta = BETA_TABLE[idx] << sh;
+                bench_addb_c = CLIP_TAB[idx][bench_addb_bs] << XEVD_MAX(0, a.bit_depth - 9);
+
+                a.w = a.h = MIN_CU_SIZE;
+                bench_do("dbk_addb", dir_name[d], &a, MIN_CU_SIZE * 6, prep_dbk, run_dbk_addb);
+
+                /* 4:2:0 and 4:4:4 edge lengths */
+                for(i = MIN_CU_SIZE >> 1; i <= MIN_CU_SIZE; i <<= 1)
+                {
+                    a.w = a.h = i;
+                    bench_do("dbk_addb_chroma", dir_name[d], &a, i * 4, prep_dbk, run_dbk_addb_chroma);
+                }
+            }
+        }
+    }
+}
+
+/* adaptive loop filter ******************************************************/
+#define BENCH_ALF_PAD 8
+
+static u8     bench_alf_cls[MAX_CU_SIZE][MAX_CU_SIZE];
+static u8   * bench_alf_cls_row[MAX_CU_SIZE];
+static short  bench_alf_coef[MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF];
+
+static void prep_alf_cls(BENCH_ARG * a)
+{
+    memset(bench_alf_cls, 0, sizeof(bench_alf_cls));
+}
+
+static void run_alf_cls(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    AREA blk = {0, 0, a->w, a->h};
+    isa->mctx->fn_alf_cls_blk(bench_alf_cls_row, buf_org + BENCH_ALF_PAD * BENCH_STRIDE + BENCH_ALF_PAD,
+                              BENCH_STRIDE, &blk, a->bit_depth + 4, a->bit_depth);
+}
+
+static void run_alf_flt(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    AREA       blk = {0, 0, a->w, a->h};
+    CLIP_RANGE clip = {0, (1 << a->bit_depth) - 1, a->bit_depth, 0};
+    int        off = BENCH_ALF_PAD * BENCH_STRIDE + BENCH_ALF_PAD;
+
+    if(a->idx)
+    {
+        isa->mctx->fn_alf_flt5_blk(bench_alf_cls_row, buf_dst + off, BENCH_STRIDE, buf_org + off, BENCH_STRIDE,
+                                   &blk, 1, bench_alf_coef, &clip);
+    }
+    else
+    {
+        isa->mctx->fn_alf_flt7_blk(bench_alf_cls_row, buf_dst + off, BENCH_STRIDE, buf_org + off, BENCH_STRIDE,
+                                   &blk, 0, bench_alf_coef, &clip);
+    }
+}
+
+static void bench_alf(void)
+{
+    static const int size[] = {4, 8, 16, 32, 64, 128};
+    BENCH_ARG a;
+    int b, i, j;
+
+    for(i = 0; i < MAX_CU_SIZE; i++)
+    {
+        bench_alf_cls_row[i] = bench_alf_cls[i];
+    }
+
+    for(b = 0; b < BENCH_BD_NUM; b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bench_bit_depth[b];
+        bench_fill_pel(buf_org, BENCH_PLANE, a.bit_depth);
+
+        for(i = 0; i < MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF; i++)
+        {
+            bench_alf_coef[i] = (short)((int)(bench_rand() % 256) - 128);
+        }
+        for(i = 0; i < MAX_NUM_ALF_CLASSES; i++)
+        {
+            bench_alf_coef[i * MAX_NUM_ALF_LUMA_COEFF + MAX_NUM_ALF_LUMA_COEFF - 1] = (short)(512 - bench_rand() % 200);
+        }
+
+        a.out = bench_alf_cls;
+        a.out_size = sizeof(bench_alf_cls);
+        /* classification is done on blocks of CLASSIFICATION_BLK_SIZE at most */
+        for(i = 0; size[i] <= CLASSIFICATION_BLK_SIZE; i++) for(j = 0; size[j] <= CLASSIFICATION_BLK_SIZE; j++)
+        {
+            a.w = size[i];
+            a.h = size[j];
+            bench_do("alf_cls", "-", &a, a.w * a.h, prep_alf_cls, run_alf_cls);
+        }
+
+        /* random class and transpose index per sample */
+        for(i = 0; i < MAX_CU_SIZE; i++) for(j = 0; j < MAX_CU_SIZE; j++)
+        {
+            bench_alf_cls[i][j] = (u8)(bench_rand() & 0x7f);
+        }
+
+        for(i = 0; i < 6; i++) for(j = 0; j < 6; j++)
+        {
+            a.w = size[i];
+            a.h = size[j];
+            a.out = buf_dst;
+            a.out_size = sizeof(buf_dst);
+            memset(buf_dst, 0, sizeof(buf_dst));
+            a.idx = 0;
+            bench_do("alf_flt", "7x7", &a, a.w * a.h, NULL, run_alf_flt);
+            a.idx = 1;
+            bench_do("alf_flt", "5x5", &a, a.w * a.h, NULL, run_alf_flt);
+        }
+    }
+}
+
+/* output conversion *********************************************************/
+static const char * bench_out_name[XEVD_OUT_NUM] = {"8b", "16b", "uv_8b", "uv_16b"};
+
+/* rows of w samples to 8-bit or P010 output, with the parameters of out_conv() */
+static void run_out(BENCH_ISA * isa, BENCH_ARG * a)
+{
+    XEVD_OUT fn = (*isa->mctx->bctx.fn_out)[a->idx];
+    int p010 = (a->idx == XEVD_OUT_16B || a->idx == XEVD_OUT_UV_16B);
+    int shr = p010 ? XEVD_MAX(a->bit_depth - 10, 0) : a->bit_depth - 8;
+    int shl = p010 ? 16 - (a->bit_depth - shr) : 0;
+    int max = (1 << (a->bit_depth - shr)) - 1;
+    int s_dst = a->w * 2 * (int)sizeof(u16);
+    int j;
+
+    for(j = 0; j < a->h; j++)
+    {
+        fn(buf_ref + j * BENCH_STRIDE, buf_ref2 + j * BENCH_STRIDE, (u8 *)buf_dst + j * s_dst, a->w, shr, shl, max);
+    }
+}
+
+/* clears the whole row pitch so that writes past w show up as mismatches */
+static void prep_out(BENCH_ARG * a)
+{
+    memset(buf_dst, 0, a->out_size);
+}
+
+static void bench_out(void)
+{
+    /* odd widths and widths around the SIMD steps exercise the C tails */
+    static const int size[] = {1, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 65, 129, 255};
+#if XEVD_PEL_8BIT
+    static const int bit_depth[] = {8};
+#else
+    static const int bit_depth[] = {8, 10, 12};
+#endif
+    BENCH_ARG a;
+    int b, i, k;
+
+    for(b = 0; b < (int)(sizeof(bit_depth) / sizeof(bit_depth[0])); b++)
+    {
+        memset(&a, 0, sizeof(a));
+        a.bit_depth = bit_depth[b];
+        a.out = buf_dst;
+        a.h = 16;
+        bench_fill_pel(buf_ref, BENCH_PLANE, a.bit_depth);
+        bench_fill_pel(buf_ref2, BENCH_PLANE, a.bit_depth);
+
+        for(k = 0; k < XEVD_OUT_NUM; k++) for(i = 0; i < (int)(sizeof(size) / sizeof(size[0])); i++)
+        {
+            a.idx = k;
+            a.w = size[i];
+            a.out_size = a.w * 2 * (int)sizeof(u16) * a.h;
+            bench_do("out", bench_out_name[k], &a, a.w * a.h, prep_out, run_out);
+        }
+    }
+}
+
+/*****************************************************************************/
+static void print_usage(void)
+{
+    fprintf(stderr,
+        "usage: xevd_kernel_bench [options]\n"
+        "  -k <name>  only kernels whose name contains <name>\n"
+        "  -p <pels>  pixels processed per measurement (default %d)\n"
+        "  -c         check bit-exactness only, no timing\n", BENCH_PELS_DEFAULT);
+}
+
+int main(int argc, const char ** argv)
+{
+    int i, isa;
+
+    for(i = 1; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "-k") && i + 1 < argc) bench_filter = argv[++i];
+        else if(!strcmp(argv[i], "-p") && i + 1 < argc) bench_pels = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "-c")) bench_time = 0;
+        else
+        {
+            print_usage();
+            return -1;
+        }
+    }
+
+    for(isa = XEVD_ISA_C; isa <= XEVD_ISA_NEON; isa++)
+    {
+        BENCH_ISA * b = &bench_isa[isa - 1];
+
+        if(xevd_isa_select(isa) != isa) continue;
+
+        b->mctx = (XEVDM_CTX *)calloc(1, sizeof(XEVDM_CTX));
+        buf_out[isa - 1] = (u8 *)malloc(XEVD_MAX(sizeof(buf_dst), sizeof(buf_ipred)));
+        if(b->mctx == NULL || buf_out[isa - 1] == NULL)
+        {
+            fprintf(stderr, "cannot allocate memory\n");
+            return -1;
+        }
+        b->mctx->bctx.cdsc.isa = isa;
+        xevdm_platform_init((XEVD_CTX *)b->mctx);
+
+        b->fn_recon = xevd_recon;
+#if X86_SSE
+        if(isa == XEVD_ISA_SSE) b->fn_recon = xevd_recon_sse;
+        if(isa == XEVD_ISA_AVX2) b->fn_recon = xevd_recon_avx;
+#elif ARM_NEON && !XEVD_PEL_8BIT
+        if(isa == XEVD_ISA_NEON) b->fn_recon = xevd_recon_neon;
+#endif
+        b->avail = 1;
+    }
+
+    printf("{\n  \"timer\": \"%s\",\n  \"isa\": [", bench_clk_name());
+    for(i = 0, isa = 0; i < BENCH_ISA_NUM; i++)
+    {
+        if(bench_isa[i].avail) printf("%s\"%s\"", isa++ ? ", " : "", bench_isa_name[i]);
+    }
+    printf("],\n  \"results\": [\n");
+
+    bench_mc();
+#if X86_SSE && !XEVD_PEL_8BIT
+    bench_dmvr_sad();
+#endif
+    bench_itx();
+    bench_itdq();
+    bench_recon();
+    bench_ipred();
+    bench_dbk();
+    bench_alf();
+    bench_out();
+
+    printf("\n  ],\n  \"mismatches\": %d\n}\n", bench_mismatch);
+
+    for(i = 0; i < BENCH_ISA_NUM; i++)
+    {
+        if(!bench_isa[i].avail) continue;
+        free(bench_isa[i].mctx);
+        free(buf_out[i]);
+    }
+
+    return bench_mismatch ? -1 : 0;
+}
@@ -88,6 +88,8 @@ extern "C"
 #define XEVD_CF_YCBCR444                13 /* YCBCR 444*/
 #define XEVD_CF_YCBCR422N               XEVD_CF_YCBCR422
 #define XEVD_CF_YCBCR422W               18 /* YCBCR422 wide chroma */
+#define XEVD_CF_YCBCR420_NV12           19 /* YCbCr 420, Y plane and a plane of interleaved Cb and Cr */
+#define XEVD_CF_YCBCR420_P010           20 /* NV12 in 16-bit words, samples in the upper 10 bits */
 
 /* macro for color space */
 #define XEVD_CS_GET_FORMAT(cs)           (((cs) >> 0) & 0xFF)
@@ -113,11 +115,20 @@ extern "C"
 #define XEVD_CS_YCBCR420_12LE            XEVD_CS_SET(XEVD_CF_YCBCR420, 12, 0)
 #define XEVD_CS_YCBCR400_14LE            XEVD_CS_SET(XEVD_CF_YCBCR400, 14, 0)
 #define XEVD_CS_YCBCR420_14LE            XEVD_CS_SET(XEVD_CF_YCBCR420, 14, 0)
+/* output only (XEVD_CDSC out_cs): two planes, w[1] and h[1] of the second one
+   count Cb/Cr pairs */
+#define XEVD_CS_NV12                     XEVD_CS_SET(XEVD_CF_YCBCR420_NV12, 8, 0)
+#define XEVD_CS_P010                     XEVD_CS_SET(XEVD_CF_YCBCR420_P010, 10, 0)
 
 /*****************************************************************************
 * config types for decoder
 *****************************************************************************/
 #define XEVD_CFG_SET_USE_PIC_SIGNATURE  (301)
+#define XEVD_CFG_SET_LOOP_FILTER_PIPELINE (302) /* int: deblock, ALF and pad CTU rows during reconstruction (main profile, single tile) */
+#define XEVD_CFG_SET_PERF_STATS         (303) /* int: collect XEVD_CFG_GET_PERF_STATS counters (off by default), resets them */
+#define XEVD_CFG_SET_TIMELINE           (304) /* XEVD_TIMELINE: deliver timeline events (off by default), NULL fn stops */
+#define XEVD_CFG_SET_OUTPUT_CS          (305) /* int: color space of the pulled pictures, as out_cs of XEVD_CDSC */
+#define XEVD_CFG_SET_AU_MODE            (306) /* int: keep the slices of a picture and decode them together on the threads (main profile) */
 #define XEVD_CFG_GET_CODEC_BIT_DEPTH    (401)
 #define XEVD_CFG_GET_WIDTH              (402)
 #define XEVD_CFG_GET_HEIGHT             (403)
@@ -125,6 +136,19 @@ extern "C"
 #define XEVD_CFG_GET_CODED_HEIGHT       (405)
 #define XEVD_CFG_GET_COLOR_SPACE        (406)
 #define XEVD_CFG_GET_MAX_CODING_DELAY   (407)
+#define XEVD_CFG_GET_WAIT_CYCLES        (408) /* long long: time threads spent blocked on dependencies */
+#define XEVD_CFG_GET_ISA                (409) /* int: instruction set of the kernels (XEVD_ISA_XXX) */
+#define XEVD_CFG_GET_THREAD_STAT        (410) /* XEVD_THREAD_STAT: time split of the decoding threads */
+#define XEVD_CFG_GET_PERF_STATS         (411) /* XEVD_PERF_STATS: time spent in each decoding stage */
+
+/*****************************************************************************
+ * instruction set of the decoding kernels
+ *****************************************************************************/
+#define XEVD_ISA_AUTO                    (0) /* best one supported by the CPU */
+#define XEVD_ISA_C                       (1)
+#define XEVD_ISA_SSE                     (2) /* SSE4.1 */
+#define XEVD_ISA_AVX2                    (3)
+#define XEVD_ISA_NEON                    (4)
 
 
 /*****************************************************************************
@@ -314,12 +338,49 @@ typedef struct _XEVD_BITB
 
 } XEVD_BITB;
 
+/*****************************************************************************
+ * picture buffer allocator of the application
+ *
+ * fn_alloc provides the sample planes of a decoded picture. the decoder fills
+ * in cs, np, w, h, aw, ah and padl/padr/padu/padb of the given imgb, and the
+ * minimum stride (s) and elevation (e) of every plane in bytes. fn_alloc sets
+ * a[] to the first sample of every plane, with the padding inside the buffer
+ * around it, and may enlarge s (as a multiple of the sample size) and e.
+ * baddr, bsize, ndata and pdata are left to the application. planes and
+ * strides aligned to XEVD_IMGB_ALIGN bytes are recommended.
+ * fn_free is called with the same imgb once both the decoder and the
+ * application have released it, possibly after xevd_delete().
+ *****************************************************************************/
+#define XEVD_IMGB_ALIGN                 (64)
+
+typedef struct _XEVD_IMGB_ALLOC
+{
+    /* returns XEVD_OK when the planes are set */
+    int              (*fn_alloc)(void * user, XEVD_IMGB * imgb);
+    void             (*fn_free)(void * user, XEVD_IMGB * imgb);
+    /* passed to fn_alloc and fn_free */
+    void             * user;
+} XEVD_IMGB_ALLOC;
+
 /*****************************************************************************
  * description for creating of decoder
  *****************************************************************************/
 typedef struct _XEVD_CDSC
 {
     int            threads; /* number of thread */
+    /* instruction set of the kernels (XEVD_ISA_XXX); XEVD_ISA_AUTO takes
+       the XEVD_ISA environment variable (c, sse, avx2 or neon) if set,
+       otherwise the best one of the CPU. a level the CPU lacks is lowered */
+    int            isa;
+    /* allocator of the decoded pictures (DPB and output); the decoder
+       allocates them itself when fn_alloc is NULL */
+    XEVD_IMGB_ALLOC imgb_alloc;
+    /* color space of the pictures of xevd_pull(): XEVD_CS_UNKNOWN (0) for the
+       planes of the decoder, or XEVD_CS_YCBCR420 (8-bit), XEVD_CS_NV12 or
+       XEVD_CS_P010, converted with the cropping and the DRA mapping applied.
+       4:0:0 streams get neutral chroma; 4:2:2 and 4:4:4 ones fail in
+       xevd_pull() with XEVD_ERR_UNSUPPORTED_COLORSPACE */
+    int            out_cs;
 } XEVD_CDSC;
 
 /*****************************************************************************
@@ -347,6 +408,147 @@ typedef struct _XEVD_STAT
     int            refpic[2][16];
 } XEVD_STAT;
 
+/*****************************************************************************
+ * NAL units of an access unit (xevd_decode_au)
+ *****************************************************************************/
+/* XEVD_NAL_UNIT_LENGTH_BYTE bytes of big-endian size before each NAL unit.
+   this is the EVC bitstream format and the recommended one */
+#define XEVD_NALU_FMT_LENGTH             (0)
+/* NAL units delimited by 00 00 01 start codes. EVC has no emulation
+   prevention, so a NAL unit whose payload contains 00 00 01 is split there
+   and fails to decode; use it only for streams known to be free of it */
+#define XEVD_NALU_FMT_START_CODE         (1)
+
+typedef struct _XEVD_NALU_STAT
+{
+    /* byte offset of the NAL unit in the buffer, after the size or start code */
+    int            offset;
+    /* byte size of the NAL unit */
+    int            size;
+    /* return value of decoding the NAL unit, as of xevd_decode() */
+    int            ret;
+    XEVD_STAT      stat;
+} XEVD_NALU_STAT;
+
+/*****************************************************************************
+ * time split of the decoding threads (XEVD_CFG_GET_THREAD_STAT)
+ * all values are cumulative since xevd_create(), in the same clock cycles
+ *****************************************************************************/
+typedef struct _XEVD_THREAD_STAT
+{
+    /* number of threads, including the one calling xevd_decode() */
+    int            threads;
+    /* time spent in xevd_decode() */
+    long long      dec_cycles;
+    /* per thread (0 is the calling thread): time running decoding work */
+    long long      busy_cycles[XEVD_MAX_TASK_CNT];
+    /* per thread: time blocked on CTU dependencies or joining other threads */
+    long long      wait_cycles[XEVD_MAX_TASK_CNT];
+} XEVD_THREAD_STAT;
+
+/*****************************************************************************
+ * decoding stages of XEVD_PERF_STATS
+ *****************************************************************************/
+#define XEVD_PERF_PARSE                 0 /* NAL unit, parameter set and slice headers */
+#define XEVD_PERF_ENTROPY               1 /* CTU syntax */
+#define XEVD_PERF_RECON                 2 /* prediction and reconstruction of CTUs */
+#define XEVD_PERF_DEBLOCK               3
+#define XEVD_PERF_ALF                   4
+#define XEVD_PERF_DRA                   5 /* DRA mapping of the output pictures */
+#define XEVD_PERF_PAD                   6 /* padding of the reference pictures */
+#define XEVD_PERF_MD5                   7 /* picture signature check */
+#define XEVD_PERF_OUTPUT                8 /* bumping of the output pictures */
+#define XEVD_PERF_NUM                   9
+
+/*****************************************************************************
+ * per-stage decoding time (XEVD_CFG_GET_PERF_STATS)
+ * values are in the clock cycles of XEVD_THREAD_STAT, counted since the last
+ * XEVD_CFG_SET_PERF_STATS. the time of a stage is summed over the threads
+ * running it, so stages decoded in parallel can add up to more than the
+ * elapsed time
+ *****************************************************************************/
+typedef struct _XEVD_PERF_STATS
+{
+    /* counters are being collected */
+    int            on;
+    /* number of pictures completed */
+    int            pics;
+    /* number of threads, including the one calling xevd_decode() */
+    int            threads;
+    /* cumulative time of each stage (XEVD_PERF_XXX) */
+    long long      cycles[XEVD_PERF_NUM];
+    /* time of each stage for the last completed picture. the MD5 check and
+       output of a picture happen after it is completed and are counted with
+       the next one */
+    long long      pic_cycles[XEVD_PERF_NUM];
+    /* per thread (0 is the calling thread): time blocked on CTU dependencies */
+    long long      wait_cycles[XEVD_MAX_TASK_CNT];
+    /* per pool thread: time waited for its task to finish */
+    long long      join_cycles[XEVD_MAX_TASK_CNT];
+} XEVD_PERF_STATS;
+
+/*****************************************************************************
+ * timeline events (XEVD_CFG_SET_TIMELINE)
+ * the type of an event is one of the XEVD_PERF_XXX stages or of the types
+ * below. events are recorded per thread and delivered to the callback by the
+ * thread calling xevd_decode() and xevd_pull(), at the end of those calls
+ *****************************************************************************/
+#define XEVD_TL_WAIT            (XEVD_PERF_NUM + 0) /* blocked on a CTU or on reference rows */
+#define XEVD_TL_JOIN            (XEVD_PERF_NUM + 1) /* waiting for the pool threads of a tile */
+#define XEVD_TL_DECODE          (XEVD_PERF_NUM + 2) /* one xevd_decode() call */
+#define XEVD_TL_NUM             (XEVD_PERF_NUM + 3)
+
+typedef struct _XEVD_TL_EVENT
+{
+    /* XEVD_PERF_XXX or XEVD_TL_XXX */
+    int            type;
+    /* 0 is the thread calling xevd_decode() */
+    int            thread;
+    /* tile, CTU or CTU row index, or NAL unit type of XEVD_TL_DECODE.
+       -1 when not applicable */
+    int            arg;
+    /* nanoseconds since the timeline was enabled */
+    long long      beg;
+    long long      end;
+} XEVD_TL_EVENT;
+
+typedef void (*XEVD_FN_TL)(void * user, const XEVD_TL_EVENT * ev, int cnt);
+
+typedef struct _XEVD_TIMELINE
+{
+    XEVD_FN_TL     fn;
+    void         * user;
+} XEVD_TIMELINE;
+
+/*****************************************************************************
+ * asynchronous decoding (xevd_async_start)
+ * a driver thread of the decoder decodes the NAL units given to
+ * xevd_submit() in order and delivers the output pictures to fn_out, or to
+ * xevd_receive() when fn_out is NULL. callbacks are called from the driver
+ * thread
+ *****************************************************************************/
+/* default number of NAL units waiting for decoding */
+#define XEVD_ASYNC_IN_CNT                (16)
+/* default number of pictures waiting for xevd_receive() */
+#define XEVD_ASYNC_OUT_CNT               (8)
+
+typedef struct _XEVD_ASYNC
+{
+    /* capacity of the input queue, XEVD_ASYNC_IN_CNT if 0 */
+    int            in_cnt;
+    /* capacity of the output queue, XEVD_ASYNC_OUT_CNT if 0 */
+    int            out_cnt;
+    /* called after decoding every NAL unit with the submitted bitb, whose
+       addr points to the copy of the bitstream, and the result of
+       xevd_decode(). can be NULL */
+    void         (*fn_nalu)(void * user, XEVD_BITB * bitb, int ret, XEVD_STAT * stat);
+    /* called with every output picture, to be released by the application,
+       and with NULL after the last one. when NULL, pictures are queued for
+       xevd_receive() */
+    void         (*fn_out)(void * user, XEVD_IMGB * imgb);
+    void         * user;
+} XEVD_ASYNC;
+
 /*****************************************************************************
  * brief information of bitstream
  *****************************************************************************/
@@ -369,9 +571,38 @@ typedef void  * XEVD;
 XEVD XEVD_EXPORT xevd_create(XEVD_CDSC * cdsc, int * err);
 void XEVD_EXPORT xevd_delete(XEVD id);
 int  XEVD_EXPORT xevd_decode(XEVD id, XEVD_BITB * bitb, XEVD_STAT * stat);
+/* decode all the NAL units of bitb (an access unit or more) in fmt
+   (XEVD_NALU_FMT_XXX). nstat gets the result of every NAL unit; *nstat_cnt is
+   its capacity on input and the number of NAL units decoded on output.
+   stops at the first NAL unit failing, or with XEVD_ERR_REACHED_MAX when
+   nstat is full. the main profile decodes the slices of a picture together
+   as with XEVD_CFG_SET_AU_MODE */
+int  XEVD_EXPORT xevd_decode_au(XEVD id, XEVD_BITB * bitb, int fmt, XEVD_NALU_STAT * nstat, int * nstat_cnt);
 int  XEVD_EXPORT xevd_pull(XEVD id, XEVD_IMGB ** img);
 int  XEVD_EXPORT xevd_config(XEVD id, int cfg, void * buf, int * size);
 int  XEVD_EXPORT xevd_info(void * bits, int bits_size, int is_annexb, XEVD_INFO * info);
+/* offset of the first start code (00 00 01) in the size bytes at buf, or size
+   when there is none */
+int  XEVD_EXPORT xevd_find_start_code(void * buf, int size);
+/* start asynchronous decoding. until xevd_async_stop(), xevd_decode(),
+   xevd_decode_au(), xevd_pull() and xevd_config() must not be called, and
+   xevd_submit() and xevd_receive() are called from a single thread */
+int  XEVD_EXPORT xevd_async_start(XEVD id, XEVD_ASYNC * async);
+/* queue a NAL unit for decoding. the bitstream is copied, so bitb can be
+   reused on return. NULL bitb ends the stream: the remaining pictures are
+   output and no more NAL units are accepted. when the input queue is full,
+   waits if wait is nonzero and the output queue has room, and returns
+   XEVD_ERR_REACHED_MAX otherwise. returns the first decoding error once it
+   has happened */
+int  XEVD_EXPORT xevd_submit(XEVD id, XEVD_BITB * bitb, int wait);
+/* get the next output picture, when fn_out is NULL. when none is ready,
+   waits if wait is nonzero and NAL units are left to decode, and returns
+   XEVD_OK_OUT_NOT_AVAILABLE otherwise. returns XEVD_OK_NO_MORE_FRM after the
+   last picture of an ended stream */
+int  XEVD_EXPORT xevd_receive(XEVD id, XEVD_IMGB ** imgb, int wait);
+/* stop asynchronous decoding, dropping the NAL units and pictures still
+   queued. returns the first decoding error, if any */
+int  XEVD_EXPORT xevd_async_stop(XEVD id);
 
 #ifdef __cplusplus
 } /* extern "C" */
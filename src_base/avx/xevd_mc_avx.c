@@ -32,7 +32,7 @@
 #include "xevd_mc_sse.h"
 #include "xevd_mc_avx.h"
 
-#if X86_SSE
+#if X86_SSE && !XEVD_PEL_8BIT
 
 void mc_filter_l_8pel_horz_clip_avx(s16 *ref,
     int src_stride,
@@ -1376,7 +1376,7 @@ static void mc_filter_l_6pel_vert_clip_avx(s16 *ref,
     }
 }
 
-void xevd_mc_l_n0_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_l_n0_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dx = gmv_x & 15;
     ref += (gmv_y >> 4) * s_ref + (gmv_x >> 4) - 3;
@@ -1384,10 +1384,10 @@ void xevd_mc_l_n0_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    mc_filter_l_8pel_horz_clip_avx(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
+    mc_filter_l_8pel_horz_clip_avx(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
 }
 
-void xevd_mc_l_0n_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_l_0n_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dy = gmv_y & 15;
     ref += ((gmv_y >> 4) - 3) * s_ref + (gmv_x >> 4);
@@ -1395,10 +1395,10 @@ void xevd_mc_l_0n_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    mc_filter_l_8pel_vert_clip_avx(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
+    mc_filter_l_8pel_vert_clip_avx(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
 }
 
-void xevd_mc_l_nn_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_l_nn_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*(MAX_CU_SIZE + MC_IBUF_PAD_L)];
     int         dx, dy;
@@ -1414,8 +1414,8 @@ void xevd_mc_l_nn_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    mc_filter_l_8pel_horz_no_clip_avx(ref, s_ref, buf, w, tbl_mc_l_coeff[dx], w, (h + 7), offset1, shift1);
-    mc_filter_l_8pel_vert_clip_avx(buf, w, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, offset2, shift2);
+    mc_filter_l_8pel_horz_no_clip_avx(ref, s_ref, buf, w, MC_L_COEF(coef, dx), w, (h + 7), offset1, shift1);
+    mc_filter_l_8pel_vert_clip_avx(buf, w, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, offset2, shift2);
 }
 
 
@@ -1832,7 +1832,7 @@ static void mc_filter_c_4pel_vert_avx(s16 *ref,
     }
 }
 
-void xevd_mc_c_n0_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_n0_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int  dx = gmv_x & 31;
     ref += (gmv_y >> 5) * s_ref + (gmv_x >> 5) - 1;
@@ -1840,10 +1840,10 @@ void xevd_mc_c_n0_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    mc_filter_c_4pel_horz_avx(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+    mc_filter_c_4pel_horz_avx(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
 }
 
-void xevd_mc_c_0n_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_0n_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dy = gmv_y & 31;
     ref += ((gmv_y >> 5) - 1) * s_ref + (gmv_x >> 5);
@@ -1851,10 +1851,10 @@ void xevd_mc_c_0n_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    mc_filter_c_4pel_vert_avx(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+    mc_filter_c_4pel_vert_avx(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
 }
 
-void xevd_mc_c_nn_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_nn_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16 buf[(MAX_CU_SIZE + MC_IBUF_PAD_C)*MAX_CU_SIZE];
     int dx, dy;
@@ -1870,8 +1870,8 @@ void xevd_mc_c_nn_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    mc_filter_c_4pel_horz_avx(ref, s_ref, buf, w, tbl_mc_c_coeff[dx], w, (h + 3), min, max, offset1, shift1, 0);
-    mc_filter_c_4pel_vert_avx(buf, w, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, offset2, shift2, 1);
+    mc_filter_c_4pel_horz_avx(ref, s_ref, buf, w, MC_C_COEF(coef, dx), w, (h + 3), min, max, offset1, shift1, 0);
+    mc_filter_c_4pel_vert_avx(buf, w, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, offset2, shift2, 1);
 }
 
 XEVD_MC_L xevd_tbl_mc_l_avx[2][2] =
@@ -1899,3 +1899,280 @@ XEVD_MC_C xevd_tbl_mc_c_avx[2][2] =
 };
 
 #endif /* X86_SSE */
+
+#if X86_SSE && XEVD_PEL_8BIT
+/* 8-bit samples: 16 horizontal or 32 vertical outputs per step, the columns
+   left over at the right of a block go to the SSE filters */
+#define MC_SFT_NN_S2_8B        12 /* XEVD_MAX(8, 20 - bit_depth) */
+
+static const s8 mc_shuf_8b_avx[4][16] =
+{
+    {0, 1, 1, 2, 2, 3, 3, 4, 4,  5,  5,  6,  6,  7,  7,  8},
+    {2, 3, 3, 4, 4, 5, 5, 6, 6,  7,  7,  8,  8,  9,  9, 10},
+    {4, 5, 5, 6, 6, 7, 7, 8, 8,  9,  9, 10, 10, 11, 11, 12},
+    {6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14}
+};
+
+/* the low lane holds the bytes from p and the high lane those from
+   p + taps - 1, so that 16 outputs never read beyond their last tap */
+static void mc_horz_init_8b_avx(const s16 * coef, int taps, __m256i * m, __m256i * c)
+{
+    __m128i m0;
+    int k;
+
+    for(k = 0; k < (taps >> 1); k++)
+    {
+        m0 = _mm_loadu_si128((const __m128i *)mc_shuf_8b_avx[k]);
+        m[k] = _mm256_inserti128_si256(_mm256_castsi128_si256(m0), _mm_add_epi8(m0, _mm_set1_epi8((s8)(9 - taps))), 1);
+        c[k] = _mm256_set1_epi16((s16)(((u16)(u8)coef[2 * k + 1] << 8) | (u8)coef[2 * k]));
+    }
+}
+
+static __inline __m256i mc_horz_sum_8b_avx(const pel * p, const __m256i * m, const __m256i * c, int taps)
+{
+    __m256i s, sum;
+    int k;
+
+    s = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+                                _mm_loadu_si128((const __m128i *)(p + taps - 1)), 1);
+    sum = _mm256_maddubs_epi16(_mm256_shuffle_epi8(s, m[0]), c[0]);
+    for(k = 1; k < (taps >> 1); k++)
+    {
+        sum = _mm256_add_epi16(sum, _mm256_maddubs_epi16(_mm256_shuffle_epi8(s, m[k]), c[k]));
+    }
+    return sum;
+}
+
+static void mc_filter_horz_8b_avx(pel *ref, int s_ref, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h)
+{
+    __m256i m[4], c[4], sum;
+    int w16 = w & ~15;
+    int i, j;
+
+    mc_horz_init_8b_avx(coef, taps, m, c);
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w16; j += 16)
+        {
+            sum = _mm256_srai_epi16(mc_horz_sum_8b_avx(ref + i * s_ref + j, m, c, taps), MAC_SFT_N0);
+            sum = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+            _mm_storeu_si128((__m128i *)(pred + i * s_pred + j), _mm256_castsi256_si128(sum));
+        }
+    }
+    if(w16 < w)
+    {
+        xevd_mc_filter_horz_8b_sse(ref + w16, s_ref, pred + w16, s_pred, coef, taps, w - w16, h);
+    }
+}
+
+static void mc_filter_horz_s16_8b_avx(pel *ref, int s_ref, s16 *buf, int s_buf, const s16 *coef, int taps, int w, int h)
+{
+    __m256i m[4], c[4];
+    int w16 = w & ~15;
+    int i, j;
+
+    mc_horz_init_8b_avx(coef, taps, m, c);
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w16; j += 16)
+        {
+            _mm256_storeu_si256((__m256i *)(buf + i * s_buf + j), mc_horz_sum_8b_avx(ref + i * s_ref + j, m, c, taps));
+        }
+    }
+    if(w16 < w)
+    {
+        xevd_mc_filter_horz_s16_8b_sse(ref + w16, s_ref, buf + w16, s_buf, coef, taps, w - w16, h);
+    }
+}
+
+static void mc_filter_vert_8b_avx(pel *ref, int s_ref, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h)
+{
+    __m256i c[4], r[8], lo, hi;
+    int w32 = w & ~31;
+    pel *p, *q;
+    int i, j, k;
+
+    for(k = 0; k < (taps >> 1); k++)
+    {
+        c[k] = _mm256_set1_epi16((s16)(((u16)(u8)coef[2 * k + 1] << 8) | (u8)coef[2 * k]));
+    }
+
+    for(j = 0; j < w32; j += 32)
+    {
+        p = ref + j;
+        q = pred + j;
+
+        for(k = 0; k < taps - 1; k++)
+        {
+            r[k] = _mm256_loadu_si256((const __m256i *)p);
+            p += s_ref;
+        }
+        for(i = 0; i < h; i++)
+        {
+            r[taps - 1] = _mm256_loadu_si256((const __m256i *)p);
+
+            lo = _mm256_maddubs_epi16(_mm256_unpacklo_epi8(r[0], r[1]), c[0]);
+            hi = _mm256_maddubs_epi16(_mm256_unpackhi_epi8(r[0], r[1]), c[0]);
+            for(k = 2; k < taps; k += 2)
+            {
+                lo = _mm256_add_epi16(lo, _mm256_maddubs_epi16(_mm256_unpacklo_epi8(r[k], r[k + 1]), c[k >> 1]));
+                hi = _mm256_add_epi16(hi, _mm256_maddubs_epi16(_mm256_unpackhi_epi8(r[k], r[k + 1]), c[k >> 1]));
+            }
+            for(k = 0; k < taps - 1; k++)
+            {
+                r[k] = r[k + 1];
+            }
+
+            /* the in-lane unpack and pack cancel out, the columns stay in order */
+            lo = _mm256_srai_epi16(lo, MAC_SFT_0N);
+            hi = _mm256_srai_epi16(hi, MAC_SFT_0N);
+            _mm256_storeu_si256((__m256i *)q, _mm256_packus_epi16(lo, hi));
+            p += s_ref;
+            q += s_pred;
+        }
+    }
+    if(w32 < w)
+    {
+        xevd_mc_filter_vert_8b_sse(ref + w32, s_ref, pred + w32, s_pred, coef, taps, w - w32, h);
+    }
+}
+
+static void mc_filter_vert_s16_8b_avx(s16 *buf, int s_buf, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h)
+{
+    __m256i c[4], r[8], lo, hi;
+    __m256i offset = _mm256_set1_epi32(1 << (MC_SFT_NN_S2_8B - 1));
+    int w16 = w & ~15;
+    s16 *p;
+    pel *q;
+    int i, j, k;
+
+    for(k = 0; k < (taps >> 1); k++)
+    {
+        c[k] = _mm256_set1_epi32((int)(((u32)(u16)coef[2 * k + 1] << 16) | (u16)coef[2 * k]));
+    }
+
+    for(j = 0; j < w16; j += 16)
+    {
+        p = buf + j;
+        q = pred + j;
+
+        for(k = 0; k < taps - 1; k++)
+        {
+            r[k] = _mm256_loadu_si256((const __m256i *)p);
+            p += s_buf;
+        }
+        for(i = 0; i < h; i++)
+        {
+            r[taps - 1] = _mm256_loadu_si256((const __m256i *)p);
+
+            lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(r[0], r[1]), c[0]);
+            hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(r[0], r[1]), c[0]);
+            for(k = 2; k < taps; k += 2)
+            {
+                lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(r[k], r[k + 1]), c[k >> 1]));
+                hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(r[k], r[k + 1]), c[k >> 1]));
+            }
+            for(k = 0; k < taps - 1; k++)
+            {
+                r[k] = r[k + 1];
+            }
+
+            lo = _mm256_srai_epi32(_mm256_add_epi32(lo, offset), MC_SFT_NN_S2_8B);
+            hi = _mm256_srai_epi32(_mm256_add_epi32(hi, offset), MC_SFT_NN_S2_8B);
+            lo = _mm256_packs_epi32(lo, hi);
+            lo = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, lo), 0x08);
+            _mm_storeu_si128((__m128i *)q, _mm256_castsi256_si128(lo));
+            p += s_buf;
+            q += s_pred;
+        }
+    }
+    if(w16 < w)
+    {
+        xevd_mc_filter_vert_s16_8b_sse(buf + w16, s_buf, pred + w16, s_pred, coef, taps, w - w16, h);
+    }
+}
+
+void xevd_mc_l_n0_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    int dx = gmv_x & 15;
+    ref += (gmv_y >> MC_PRECISION) * s_ref + (gmv_x >> MC_PRECISION) - 3;
+
+    mc_filter_horz_8b_avx(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dx), 8, w, h);
+}
+
+void xevd_mc_l_0n_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    int dy = gmv_y & 15;
+    ref += ((gmv_y >> MC_PRECISION) - 3) * s_ref + (gmv_x >> MC_PRECISION);
+
+    mc_filter_vert_8b_avx(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dy), 8, w, h);
+}
+
+void xevd_mc_l_nn_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*MAX_CU_SIZE];
+    int         dx, dy;
+
+    dx = gmv_x & 15;
+    dy = gmv_y & 15;
+    ref += ((gmv_y >> MC_PRECISION) - 3) * s_ref + (gmv_x >> MC_PRECISION) - 3;
+
+    mc_filter_horz_s16_8b_avx(ref, s_ref, buf, w, MC_L_COEF(coef, dx), 8, w, h + 7);
+    mc_filter_vert_s16_8b_avx(buf, w, pred, s_pred, MC_L_COEF(coef, dy), 8, w, h);
+}
+
+void xevd_mc_c_n0_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    int dx = gmv_x & 31;
+    ref += (gmv_y >> (MC_PRECISION + 1)) * s_ref + (gmv_x >> (MC_PRECISION + 1)) - 1;
+
+    mc_filter_horz_8b_avx(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dx), 4, w, h);
+}
+
+void xevd_mc_c_0n_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    int dy = gmv_y & 31;
+    ref += ((gmv_y >> (MC_PRECISION + 1)) - 1) * s_ref + (gmv_x >> (MC_PRECISION + 1));
+
+    mc_filter_vert_8b_avx(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dy), 4, w, h);
+}
+
+void xevd_mc_c_nn_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_C)*MAX_CU_SIZE];
+    int         dx, dy;
+
+    dx = gmv_x & 31;
+    dy = gmv_y & 31;
+    ref += ((gmv_y >> (MC_PRECISION + 1)) - 1) * s_ref + (gmv_x >> (MC_PRECISION + 1)) - 1;
+
+    mc_filter_horz_s16_8b_avx(ref, s_ref, buf, w, MC_C_COEF(coef, dx), 4, w, h + 3);
+    mc_filter_vert_s16_8b_avx(buf, w, pred, s_pred, MC_C_COEF(coef, dy), 4, w, h);
+}
+
+XEVD_MC_L xevd_tbl_mc_l_avx[2][2] =
+{
+    {
+        xevd_mc_l_00_sse, /* dx == 0 && dy == 0 */
+        xevd_mc_l_0n_avx  /* dx == 0 && dy != 0 */
+    },
+    {
+        xevd_mc_l_n0_avx, /* dx != 0 && dy == 0 */
+        xevd_mc_l_nn_avx  /* dx != 0 && dy != 0 */
+    }
+};
+
+XEVD_MC_C xevd_tbl_mc_c_avx[2][2] =
+{
+    {
+        xevd_mc_c_00_sse, /* dx == 0 && dy == 0 */
+        xevd_mc_c_0n_avx  /* dx == 0 && dy != 0 */
+    },
+    {
+        xevd_mc_c_n0_avx, /* dx != 0 && dy == 0 */
+        xevd_mc_c_nn_avx  /* dx != 0 && dy != 0 */
+    }
+};
+#endif /* X86_SSE && XEVD_PEL_8BIT */
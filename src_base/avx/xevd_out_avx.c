@@ -0,0 +1,145 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevd_out_avx.h"
+
+#if X86_SSE && !XEVD_PEL_8BIT
+
+static void out_8b_avx(pel *u, pel *v, void *dst, int w, int shr, int shl, int max)
+{
+    u8 *d = (u8 *)dst;
+    __m256i add = _mm256_set1_epi16(shr ? 1 << (shr - 1) : 0);
+    __m128i sft = _mm_cvtsi32_si128(shr);
+    __m256i s0, s1;
+    int i;
+
+    for(i = 0; i + 32 <= w; i += 32)
+    {
+        s0 = _mm256_loadu_si256((__m256i *)(u + i));
+        s1 = _mm256_loadu_si256((__m256i *)(u + i + 16));
+        s0 = _mm256_sra_epi16(_mm256_add_epi16(s0, add), sft);
+        s1 = _mm256_sra_epi16(_mm256_add_epi16(s1, add), sft);
+        /* the pack works within 128-bit lanes */
+        s0 = _mm256_permute4x64_epi64(_mm256_packus_epi16(s0, s1), 0xD8);
+        _mm256_storeu_si256((__m256i *)(d + i), s0);
+    }
+    if(i < w)
+    {
+        xevd_tbl_out_sse[XEVD_OUT_8B](u + i, NULL, d + i, w - i, shr, shl, max);
+    }
+}
+
+static void out_16b_avx(pel *u, pel *v, void *dst, int w, int shr, int shl, int max)
+{
+    u16 *d = (u16 *)dst;
+    __m256i add = _mm256_set1_epi16(shr ? 1 << (shr - 1) : 0);
+    __m128i sft = _mm_cvtsi32_si128(shr);
+    __m128i sfl = _mm_cvtsi32_si128(shl);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i mx = _mm256_set1_epi16(max);
+    __m256i s0;
+    int i;
+
+    for(i = 0; i + 16 <= w; i += 16)
+    {
+        s0 = _mm256_loadu_si256((__m256i *)(u + i));
+        s0 = _mm256_sra_epi16(_mm256_add_epi16(s0, add), sft);
+        s0 = _mm256_min_epi16(_mm256_max_epi16(s0, zero), mx);
+        _mm256_storeu_si256((__m256i *)(d + i), _mm256_sll_epi16(s0, sfl));
+    }
+    if(i < w)
+    {
+        xevd_tbl_out_sse[XEVD_OUT_16B](u + i, NULL, d + i, w - i, shr, shl, max);
+    }
+}
+
+static void out_uv_8b_avx(pel *u, pel *v, void *dst, int w, int shr, int shl, int max)
+{
+    u8 *d = (u8 *)dst;
+    __m256i add = _mm256_set1_epi16(shr ? 1 << (shr - 1) : 0);
+    __m128i sft = _mm_cvtsi32_si128(shr);
+    __m256i s0, s1;
+    int i;
+
+    for(i = 0; i + 16 <= w; i += 16)
+    {
+        s0 = _mm256_loadu_si256((__m256i *)(u + i));
+        s1 = _mm256_loadu_si256((__m256i *)(v + i));
+        s0 = _mm256_sra_epi16(_mm256_add_epi16(s0, add), sft);
+        s1 = _mm256_sra_epi16(_mm256_add_epi16(s1, add), sft);
+        /* lanes of pairs 0-3|8-11 and 4-7|12-15 pack back into order */
+        s0 = _mm256_packus_epi16(_mm256_unpacklo_epi16(s0, s1), _mm256_unpackhi_epi16(s0, s1));
+        _mm256_storeu_si256((__m256i *)(d + 2 * i), s0);
+    }
+    if(i < w)
+    {
+        xevd_tbl_out_sse[XEVD_OUT_UV_8B](u + i, v + i, d + 2 * i, w - i, shr, shl, max);
+    }
+}
+
+static void out_uv_16b_avx(pel *u, pel *v, void *dst, int w, int shr, int shl, int max)
+{
+    u16 *d = (u16 *)dst;
+    __m256i add = _mm256_set1_epi16(shr ? 1 << (shr - 1) : 0);
+    __m128i sft = _mm_cvtsi32_si128(shr);
+    __m128i sfl = _mm_cvtsi32_si128(shl);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i mx = _mm256_set1_epi16(max);
+    __m256i s0, s1, t0, t1;
+    int i;
+
+    for(i = 0; i + 16 <= w; i += 16)
+    {
+        s0 = _mm256_loadu_si256((__m256i *)(u + i));
+        s1 = _mm256_loadu_si256((__m256i *)(v + i));
+        s0 = _mm256_sra_epi16(_mm256_add_epi16(s0, add), sft);
+        s1 = _mm256_sra_epi16(_mm256_add_epi16(s1, add), sft);
+        s0 = _mm256_sll_epi16(_mm256_min_epi16(_mm256_max_epi16(s0, zero), mx), sfl);
+        s1 = _mm256_sll_epi16(_mm256_min_epi16(_mm256_max_epi16(s1, zero), mx), sfl);
+        t0 = _mm256_unpacklo_epi16(s0, s1);
+        t1 = _mm256_unpackhi_epi16(s0, s1);
+        _mm256_storeu_si256((__m256i *)(d + 2 * i), _mm256_permute2x128_si256(t0, t1, 0x20));
+        _mm256_storeu_si256((__m256i *)(d + 2 * i + 16), _mm256_permute2x128_si256(t0, t1, 0x31));
+    }
+    if(i < w)
+    {
+        xevd_tbl_out_sse[XEVD_OUT_UV_16B](u + i, v + i, d + 2 * i, w - i, shr, shl, max);
+    }
+}
+
+const XEVD_OUT xevd_tbl_out_avx[XEVD_OUT_NUM] =
+{
+    out_8b_avx,
+    out_16b_avx,
+    out_uv_8b_avx,
+    out_uv_16b_avx
+};
+
+#endif /* X86_SSE && !XEVD_PEL_8BIT */
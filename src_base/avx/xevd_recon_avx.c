@@ -30,6 +30,8 @@
 
 #include "xevd_recon_avx.h"
 
+#if X86_SSE && !XEVD_PEL_8BIT
+
 void xevd_recon_avx(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth)
 {
     int i, j;
@@ -484,3 +486,38 @@ void xevd_recon_avx(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_r
         }
     }
 }
+
+#endif /* X86_SSE && !XEVD_PEL_8BIT */
+
+#if X86_SSE && XEVD_PEL_8BIT
+/* 8-bit samples: 32 samples per step, other widths go to the SSE version */
+void xevd_recon_avx(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth)
+{
+    __m256i p0, p1;
+    int i, j;
+
+    if (is_coef == 0 || (cuw & 31))
+    {
+        xevd_recon_sse(coef, pred, is_coef, cuw, cuh, s_rec, rec, bit_depth);
+        return;
+    }
+
+    for (i = 0; i < cuh; i++)
+    {
+        for (j = 0; j < cuw; j += 32)
+        {
+            p0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(pred + j)));
+            p1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(pred + j + 16)));
+            p0 = _mm256_add_epi16(p0, _mm256_loadu_si256((__m256i*)(coef + j)));
+            p1 = _mm256_add_epi16(p1, _mm256_loadu_si256((__m256i*)(coef + j + 16)));
+            /* the in-lane pack interleaves 64-bit quarters of p0 and p1 */
+            p0 = _mm256_permute4x64_epi64(_mm256_packus_epi16(p0, p1), 0xD8);
+            _mm256_storeu_si256((__m256i*)(rec + j), p0);
+        }
+        coef += cuw;
+        pred += cuw;
+        rec += s_rec;
+    }
+}
+
+#endif /* X86_SSE && XEVD_PEL_8BIT */
@@ -30,6 +30,8 @@
 
 #include "xevd_dbk_neon.h"
 
+#if ARM_NEON && !XEVD_PEL_8BIT
+
 void deblock_scu_hor_neon(pel *buf, int st, int stride, int bit_depth_minus8, int chroma_format_idc)
 {
     //size assumed 4x4
@@ -104,7 +106,7 @@ void deblock_scu_hor_chroma_neon(pel *u, pel *v, int st_u, int st_v, int stride,
 {
     int size;
 
-    size = MIN_CU_SIZE >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc));
+    size = MIN_CU_SIZE >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc));
 
     int16x8_t Au, Bu, Cu, Du, Av, Bv, Cv, Dv, AA, BB, CC, DD;
     int16x8_t t1, t2;
@@ -441,3 +443,4 @@ const XEVD_DBK_CH xevd_tbl_dbk_chroma_neon[2] =
     deblock_scu_hor_chroma_neon
 };
 
+#endif /* ARM_NEON && !XEVD_PEL_8BIT */
@@ -33,7 +33,7 @@
 #include "xevd_mc_neon.h"
 #include <assert.h>
 
-#if ARM_NEON
+#if ARM_NEON && !XEVD_PEL_8BIT
 
 #define vmadd_s16(a, b)\
     vpaddq_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b)), vmull_s16(vget_high_s16(a), vget_high_s16(b)));
@@ -1416,7 +1416,7 @@ void xevd_mc_filter_c_4pel_vert_neon(s16* ref,
 }
 
 
-void xevd_mc_l_00_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth)
+void xevd_mc_l_00_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
     gmv_x >>= 4;
@@ -1470,7 +1470,7 @@ void xevd_mc_l_00_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pe
     }
 }
 
-void xevd_mc_l_n0_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth)
+void xevd_mc_l_n0_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dx = gmv_x & 15;
     ref += (gmv_y >> 4) * s_ref + (gmv_x >> 4) - 3;
@@ -1478,10 +1478,10 @@ void xevd_mc_l_n0_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pe
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_l_8pel_horz_clip_neon(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
+    xevd_mc_filter_l_8pel_horz_clip_neon(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
 }
 
-void xevd_mc_l_0n_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth)
+void xevd_mc_l_0n_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dy = gmv_y & 15;
     ref += ((gmv_y >> 4) - 3) * s_ref + (gmv_x >> 4);
@@ -1489,10 +1489,10 @@ void xevd_mc_l_0n_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pe
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_l_8pel_vert_clip_neon(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
+    xevd_mc_filter_l_8pel_vert_clip_neon(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
 }
 
-void xevd_mc_l_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_l_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L) * (MAX_CU_SIZE + MC_IBUF_PAD_L)];
     int         dx, dy;
@@ -1508,14 +1508,14 @@ void xevd_mc_l_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_l_8pel_horz_no_clip_neon(ref, s_ref, buf, w, tbl_mc_l_coeff[dx], w, (h + 7), offset1, shift1);
-    xevd_mc_filter_l_8pel_vert_clip_neon(buf, w, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, offset2, shift2);
+    xevd_mc_filter_l_8pel_horz_no_clip_neon(ref, s_ref, buf, w, MC_L_COEF(coef, dx), w, (h + 7), offset1, shift1);
+    xevd_mc_filter_l_8pel_vert_clip_neon(buf, w, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, offset2, shift2);
 }
 
 /****************************************************************************
  * motion compensation for chroma
  ****************************************************************************/
-void xevd_mc_c_n0_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_c_n0_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int  dx = gmv_x & 31;
     ref += (gmv_y >> 5) * s_ref + (gmv_x >> 5) - 1;
@@ -1523,10 +1523,10 @@ void xevd_mc_c_n0_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_c_4pel_horz_neon(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+    xevd_mc_filter_c_4pel_horz_neon(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
 }
 
-void xevd_mc_c_0n_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_c_0n_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dy = gmv_y & 31;
     ref += ((gmv_y >> 5) - 1) * s_ref + (gmv_x >> 5);
@@ -1534,10 +1534,10 @@ void xevd_mc_c_0n_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_c_4pel_vert_neon(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+    xevd_mc_filter_c_4pel_vert_neon(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
 }
 
-void xevd_mc_c_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_c_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16 buf[(MAX_CU_SIZE + MC_IBUF_PAD_C) * MAX_CU_SIZE];
     int dx, dy;
@@ -1553,8 +1553,8 @@ void xevd_mc_c_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_c_4pel_horz_neon(ref, s_ref, buf, w, tbl_mc_c_coeff[dx], w, (h + 3), min, max, offset1, shift1, 0);
-    xevd_mc_filter_c_4pel_vert_neon(buf, w, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, offset2, shift2, 1);
+    xevd_mc_filter_c_4pel_horz_neon(ref, s_ref, buf, w, MC_C_COEF(coef, dx), w, (h + 3), min, max, offset1, shift1, 0);
+    xevd_mc_filter_c_4pel_vert_neon(buf, w, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, offset2, shift2, 1);
 }
 
 XEVD_MC_L xevd_tbl_mc_l_neon[2][2] =
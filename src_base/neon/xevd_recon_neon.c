@@ -30,6 +30,8 @@
 
 #include "xevd_recon_neon.h"
 
+#if ARM_NEON && !XEVD_PEL_8BIT
+
 void xevd_recon_neon(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth)
 {
     int i, j;
@@ -366,3 +368,5 @@ void xevd_recon_neon(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_
         }
     }
 }
+
+#endif /* ARM_NEON && !XEVD_PEL_8BIT */
@@ -30,14 +30,25 @@
 
 #include "xevd_dbk_sse.h"
 
+#if X86_SSE
+
+/* 4 samples in 16-bit lanes */
+#if XEVD_PEL_8BIT
+#define DBK_LOAD4(p)          _mm_cvtepu8_epi16(xevd_load_4b(p))
+#define DBK_STORE4(p, v)      xevd_store_4b((p), _mm_packus_epi16((v), (v)))
+#else
+#define DBK_LOAD4(p)          _mm_loadl_epi64((__m128i*)(p))
+#define DBK_STORE4(p, v)      _mm_storel_epi64((__m128i*)(p), (v))
+#endif
+
 void deblock_scu_hor_sse(pel *buf, int st, int stride, int bit_depth_minus8, int chroma_format_idc)
 {
     //size assumed 4x4
     __m128i AA, BB, CC, DD;
-    AA = _mm_loadl_epi64((__m128i*)&buf[-2 * stride]);
-    BB = _mm_loadl_epi64((__m128i*)&buf[-stride]);
-    CC = _mm_loadl_epi64((__m128i*)&buf[0]);
-    DD = _mm_loadl_epi64((__m128i*)&buf[stride]);
+    AA = DBK_LOAD4(&buf[-2 * stride]);
+    BB = DBK_LOAD4(&buf[-stride]);
+    CC = DBK_LOAD4(&buf[0]);
+    DD = DBK_LOAD4(&buf[stride]);
 
     __m128i t1, t2;
     __m128i d, abs_d, sign, clip, sst;
@@ -85,17 +96,17 @@ void deblock_scu_hor_sse(pel *buf, int st, int stride, int bit_depth_minus8, int
     tmp = _mm_max_epi16(zero, DD);
     DD = _mm_min_epi16(tmp, MAX);
 
-    _mm_storel_epi64((__m128i*)&buf[-2 * stride], AA);
-    _mm_storel_epi64((__m128i*)&buf[-stride], BB);
-    _mm_storel_epi64((__m128i*)&buf[0], CC);
-    _mm_storel_epi64((__m128i*)&buf[stride], DD);
+    DBK_STORE4(&buf[-2 * stride], AA);
+    DBK_STORE4(&buf[-stride], BB);
+    DBK_STORE4(&buf[0], CC);
+    DBK_STORE4(&buf[stride], DD);
 }
 
 void deblock_scu_hor_chroma_sse(pel *u, pel *v, int st_u, int st_v, int stride, int bit_depth_minus8, int chroma_format_idc)
 {
     int size;
 
-    size = MIN_CU_SIZE >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc));
+    size = MIN_CU_SIZE >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc));
 
     __m128i Au = _mm_setzero_si128();
     __m128i Bu = _mm_setzero_si128();
@@ -110,17 +121,17 @@ void deblock_scu_hor_chroma_sse(pel *u, pel *v, int st_u, int st_v, int stride,
 
     if (st_u)
     {
-        Au = _mm_loadl_epi64((__m128i*)&u[-2 * stride]);
-        Bu = _mm_loadl_epi64((__m128i*)&u[-stride]);
-        Cu = _mm_loadl_epi64((__m128i*)&u[0]);
-        Du = _mm_loadl_epi64((__m128i*)&u[stride]);
+        Au = DBK_LOAD4(&u[-2 * stride]);
+        Bu = DBK_LOAD4(&u[-stride]);
+        Cu = DBK_LOAD4(&u[0]);
+        Du = DBK_LOAD4(&u[stride]);
     }
     if (st_v)
     {
-        Av = _mm_loadl_epi64((__m128i*)&v[-2 * stride]);
-        Bv = _mm_loadl_epi64((__m128i*)&v[-stride]);
-        Cv = _mm_loadl_epi64((__m128i*)&v[0]);
-        Dv = _mm_loadl_epi64((__m128i*)&v[stride]);
+        Av = DBK_LOAD4(&v[-2 * stride]);
+        Bv = DBK_LOAD4(&v[-stride]);
+        Cv = DBK_LOAD4(&v[0]);
+        Dv = DBK_LOAD4(&v[stride]);
     }
 
     if (!st_u || !st_v) {
@@ -182,8 +193,8 @@ void deblock_scu_hor_chroma_sse(pel *u, pel *v, int st_u, int st_v, int stride,
         }
         else if (size == 4)
         {
-            _mm_storel_epi64((__m128i*)&u[-stride], BB);
-            _mm_storel_epi64((__m128i*)&u[0], CC);
+            DBK_STORE4(&u[-stride], BB);
+            DBK_STORE4(&u[0], CC);
         }
 
     }
@@ -198,8 +209,8 @@ void deblock_scu_hor_chroma_sse(pel *u, pel *v, int st_u, int st_v, int stride,
         }
         else if (size == 4)
         {
-            _mm_storel_epi64((__m128i*)&v[-stride], Bv);
-            _mm_storel_epi64((__m128i*)&v[0], Cv);
+            DBK_STORE4(&v[-stride], Bv);
+            DBK_STORE4(&v[0], Cv);
         }
 
     }
@@ -209,10 +220,10 @@ void deblock_scu_ver_sse(pel *buf, int st, int stride, int bit_depth_minus8, int
 {
     //size assumes 4x4
     __m128i AA, BB, CC, DD;
-    AA = _mm_loadl_epi64((__m128i*)&buf[-2]);
-    BB = _mm_loadl_epi64((__m128i*)&buf[stride - 2]);
-    CC = _mm_loadl_epi64((__m128i*)&buf[2 * stride - 2]);
-    DD = _mm_loadl_epi64((__m128i*)&buf[3 * stride - 2]);
+    AA = DBK_LOAD4(&buf[-2]);
+    BB = DBK_LOAD4(&buf[stride - 2]);
+    CC = DBK_LOAD4(&buf[2 * stride - 2]);
+    DD = DBK_LOAD4(&buf[3 * stride - 2]);
 
     __m128i t1, t2;
     t1 = _mm_unpacklo_epi16(AA, BB);
@@ -274,10 +285,10 @@ void deblock_scu_ver_sse(pel *buf, int st, int stride, int bit_depth_minus8, int
     CC = _mm_unpackhi_epi32(t1, t2);
     DD = _mm_srli_si128(CC, 8);
 
-    _mm_storel_epi64((__m128i*)&buf[-2], AA);
-    _mm_storel_epi64((__m128i*)&buf[stride - 2], BB);
-    _mm_storel_epi64((__m128i*)&buf[2 * stride - 2], CC);
-    _mm_storel_epi64((__m128i*)&buf[3 * stride - 2], DD);
+    DBK_STORE4(&buf[-2], AA);
+    DBK_STORE4(&buf[stride - 2], BB);
+    DBK_STORE4(&buf[2 * stride - 2], CC);
+    DBK_STORE4(&buf[3 * stride - 2], DD);
 }
 
 void deblock_scu_ver_chroma_sse(pel *u, pel *v, int st_u, int st_v, int stride, int bit_depth_minus8, int chroma_format_idc)
@@ -294,13 +305,13 @@ void deblock_scu_ver_chroma_sse(pel *u, pel *v, int st_u, int st_v, int stride,
 
         if (st_u)
         {
-            AA = _mm_loadl_epi64((__m128i*)&u[-2]);
-            BB = _mm_loadl_epi64((__m128i*)&u[stride - 2]);
+            AA = DBK_LOAD4(&u[-2]);
+            BB = DBK_LOAD4(&u[stride - 2]);
         }
         if (st_v)
         {
-            CC = _mm_loadl_epi64((__m128i*)&v[-2]);
-            DD = _mm_loadl_epi64((__m128i*)&v[stride - 2]);
+            CC = DBK_LOAD4(&v[-2]);
+            DD = DBK_LOAD4(&v[stride - 2]);
         }
 
         if (!st_u || !st_v) {
@@ -357,13 +368,13 @@ void deblock_scu_ver_chroma_sse(pel *u, pel *v, int st_u, int st_v, int stride,
 
         if (st_u)
         {
-            _mm_storel_epi64((__m128i*)&u[-2], AA);
-            _mm_storel_epi64((__m128i*)&u[stride - 2], BB);
+            DBK_STORE4(&u[-2], AA);
+            DBK_STORE4(&u[stride - 2], BB);
         }
         if (st_v)
         {
-            _mm_storel_epi64((__m128i*)&v[-2], CC);
-            _mm_storel_epi64((__m128i*)&v[stride - 2], DD);
+            DBK_STORE4(&v[-2], CC);
+            DBK_STORE4(&v[stride - 2], DD);
         }
     }
     else if (size == 4)
@@ -437,3 +448,4 @@ const XEVD_DBK_CH xevd_tbl_dbk_chroma_sse[2] =
     deblock_scu_hor_chroma_sse
 };
 
+#endif /* X86_SSE */
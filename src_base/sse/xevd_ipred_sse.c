@@ -0,0 +1,184 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevd_ipred_sse.h"
+
+#if X86_SSE && !XEVD_PEL_8BIT
+
+#define ADI_4T_FILTER_BITS                 7
+#define ADI_4T_FILTER_OFFSET              (1<<(ADI_4T_FILTER_BITS-1))
+
+static int ipred_ang_run_sse(pel *dst, const pel *src, int d, const int *filter, int n, int bit_depth)
+{
+    const __m128i f01 = _mm_set1_epi32((filter[1] << 16) | (filter[0] & 0xFFFF));
+    const __m128i f23 = _mm_set1_epi32((filter[3] << 16) | (filter[2] & 0xFFFF));
+    const __m128i offset = _mm_set1_epi32(ADI_4T_FILTER_OFFSET);
+    const __m128i max = _mm_set1_epi16((1 << bit_depth) - 1);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i s0, s1, s2, s3, lo, hi;
+    int k;
+
+    for(k = 0; k + 8 <= n; k += 8)
+    {
+        s0 = _mm_loadu_si128((const __m128i *)(src + k - d));
+        s1 = _mm_loadu_si128((const __m128i *)(src + k));
+        s2 = _mm_loadu_si128((const __m128i *)(src + k + d));
+        s3 = _mm_loadu_si128((const __m128i *)(src + k + 2 * d));
+
+        lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(s0, s1), f01), _mm_madd_epi16(_mm_unpacklo_epi16(s2, s3), f23));
+        hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(s0, s1), f01), _mm_madd_epi16(_mm_unpackhi_epi16(s2, s3), f23));
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, offset), ADI_4T_FILTER_BITS);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, offset), ADI_4T_FILTER_BITS);
+
+        _mm_storeu_si128((__m128i *)(dst + k), _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(lo, hi), zero), max));
+    }
+    for(; k + 4 <= n; k += 4)
+    {
+        s0 = _mm_loadl_epi64((const __m128i *)(src + k - d));
+        s1 = _mm_loadl_epi64((const __m128i *)(src + k));
+        s2 = _mm_loadl_epi64((const __m128i *)(src + k + d));
+        s3 = _mm_loadl_epi64((const __m128i *)(src + k + 2 * d));
+
+        lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(s0, s1), f01), _mm_madd_epi16(_mm_unpacklo_epi16(s2, s3), f23));
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, offset), ADI_4T_FILTER_BITS);
+
+        _mm_storel_epi64((__m128i *)(dst + k), _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(lo, lo), zero), max));
+    }
+    return k;
+}
+
+void xevd_ipred_ang_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int ipm, int bit_depth)
+{
+    xevd_ipred_ang_seg(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth, ipred_ang_run_sse);
+}
+
+void xevd_ipred_bi_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth)
+{
+    static const int tbl_wc[6] = {-1, 341, 205, 114, 60, 31};
+    const int ishift_x = xevd_tbl_log2[w];
+    const int ishift_y = xevd_tbl_log2[h];
+    const int ishift = XEVD_MIN(ishift_x, ishift_y);
+    const int ishift_xy = ishift_x + ishift_y + 1;
+    const int rev = (avail_lr == LR_01);
+    const __m128i sx = _mm_cvtsi32_si128(ishift_x);
+    const __m128i sy = _mm_cvtsi32_si128(ishift_y);
+    const __m128i sxy = _mm_cvtsi32_si128(ishift_xy);
+    const __m128i offset = _mm_set1_epi32(1 << (ishift_x + ishift_y));
+    const __m128i max = _mm_set1_epi16((1 << bit_depth) - 1);
+    const __m128i zero = _mm_setzero_si128();
+    int ref_up[MAX_CU_SIZE], up[MAX_CU_SIZE];
+    pel *src_side;
+    int a, b, c, wc, wt, x, y;
+
+    if(avail_lr == LR_11 || w < 4)
+    {
+        xevd_ipred_bi(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+        return;
+    }
+
+    /* the left or, with only the right available, the right column */
+    src_side = rev ? src_ri : src_le;
+    a = rev ? src_up[-1] : src_up[w];
+    b = src_side[h];
+    wc = tbl_wc[ishift_x > ishift_y ? ishift_x - ishift_y : ishift_y - ishift_x];
+    c = (w == h) ? (a + b + 1) >> 1 : (((a << ishift_x) + (b << ishift_y)) * wc + (1 << (ishift + 9))) >> (ishift + 10);
+    wt = (c << 1) - a - b;
+
+    for(x = 0; x < w; x++)
+    {
+        up[x] = b - src_up[x];
+        ref_up[x] = src_up[x] << ishift_y;
+    }
+
+    for(y = 0; y < h; y++)
+    {
+        /* horizontal weights run from the side column, (x + 1) and x or (w - x) and (w - 1 - x) */
+        const __m128i side = _mm_set1_epi32(src_side[y] << ishift_x);
+        const __m128i side_d = _mm_set1_epi32(a - src_side[y]);
+        const __m128i wy = _mm_set1_epi32(y * wt);
+
+        for(x = 0; x < w; x += 4)
+        {
+            __m128i idx = _mm_add_epi32(_mm_set1_epi32(x), _mm_setr_epi32(0, 1, 2, 3));
+            __m128i k1 = rev ? _mm_sub_epi32(_mm_set1_epi32(w), idx) : _mm_add_epi32(idx, _mm_set1_epi32(1));
+            __m128i k2 = rev ? _mm_sub_epi32(_mm_set1_epi32(w - 1), idx) : idx;
+            __m128i ru = _mm_add_epi32(_mm_loadu_si128((__m128i *)(ref_up + x)), _mm_loadu_si128((__m128i *)(up + x)));
+            __m128i predx = _mm_add_epi32(side, _mm_mullo_epi32(k1, side_d));
+            __m128i sum;
+
+            _mm_storeu_si128((__m128i *)(ref_up + x), ru);
+
+            sum = _mm_add_epi32(_mm_sll_epi32(predx, sy), _mm_sll_epi32(ru, sx));
+            sum = _mm_add_epi32(sum, _mm_add_epi32(_mm_mullo_epi32(k2, wy), offset));
+            sum = _mm_sra_epi32(sum, sxy);
+            sum = _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(sum, sum), zero), max);
+            _mm_storel_epi64((__m128i *)(dst + x), sum);
+        }
+        dst += w;
+    }
+}
+
+void xevd_ipred_plane_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth)
+{
+    const __m128i max = _mm_set1_epi16((1 << bit_depth) - 1);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i grad, v0, v1;
+    int base, b, c, x, y;
+
+    if(w < 8)
+    {
+        xevd_ipred_plane(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+        return;
+    }
+
+    xevd_ipred_plane_param(src_le, src_up, src_ri, avail_lr, w, h, &base, &b, &c);
+
+    /* with the right column the rows run from x = w - 1 */
+    if(avail_lr == LR_01 || avail_lr == LR_11)
+    {
+        base += (w - 1) * b;
+        b = -b;
+    }
+    grad = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(b));
+
+    for(y = 0; y < h; y++)
+    {
+        for(x = 0; x < w; x += 8)
+        {
+            v0 = _mm_add_epi32(_mm_set1_epi32(base + x * b), grad);
+            v1 = _mm_add_epi32(_mm_set1_epi32(base + (x + 4) * b), grad);
+            v0 = _mm_packs_epi32(_mm_srai_epi32(v0, 5), _mm_srai_epi32(v1, 5));
+            _mm_storeu_si128((__m128i *)(dst + x), _mm_min_epi16(_mm_max_epi16(v0, zero), max));
+        }
+        base += c;
+        dst += w;
+    }
+}
+#endif /* X86_SSE && !XEVD_PEL_8BIT */
@@ -33,7 +33,7 @@
 #include "xevd_mc_sse.h"
 #include <assert.h>
 
-#if X86_SSE
+#if X86_SSE && !XEVD_PEL_8BIT
 /****************************************************************************
  * motion compensation for luma
  ****************************************************************************/
@@ -2101,7 +2101,7 @@ void xevd_mc_filter_c_4pel_vert_sse(s16 *ref,
 
 
 
-void xevd_mc_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -2160,7 +2160,7 @@ void xevd_mc_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel
 
 
 void xevd_mc_l_n0_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h
-,int bit_depth)
+,int bit_depth, const s16 * coef)
 {
     int dx;
 
@@ -2172,13 +2172,13 @@ void xevd_mc_l_n0_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel
 
     int min = 0;
 
-    xevd_mc_filter_l_8pel_horz_clip_sse(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
+    xevd_mc_filter_l_8pel_horz_clip_sse(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
 }
 
 
 
 void xevd_mc_l_0n_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h
-,int bit_depth)
+,int bit_depth, const s16 * coef)
 {
     int  dy;
 
@@ -2191,13 +2191,13 @@ void xevd_mc_l_0n_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel
 
     int min = 0;
 
-    xevd_mc_filter_l_8pel_vert_clip_sse(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
+    xevd_mc_filter_l_8pel_vert_clip_sse(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
 
 }
 
 
 void xevd_mc_l_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h
-,int bit_depth)
+,int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*(MAX_CU_SIZE + MC_IBUF_PAD_L)];
     int         dx, dy;
@@ -2214,15 +2214,15 @@ void xevd_mc_l_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
 
     int max = ((1 << bit_depth) - 1);
     int min = 0;
-    xevd_mc_filter_l_8pel_horz_no_clip_sse(ref, s_ref, buf, w, tbl_mc_l_coeff[dx], w, (h + 7), offset1, shift1);
-    xevd_mc_filter_l_8pel_vert_clip_sse(buf, w, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, offset2, shift2);
+    xevd_mc_filter_l_8pel_horz_no_clip_sse(ref, s_ref, buf, w, MC_L_COEF(coef, dx), w, (h + 7), offset1, shift1);
+    xevd_mc_filter_l_8pel_vert_clip_sse(buf, w, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, offset2, shift2);
 }
 
 /****************************************************************************
  * motion compensation for chroma
  ****************************************************************************/
 
-void xevd_mc_c_00_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -2276,7 +2276,7 @@ void xevd_mc_c_00_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
         }
     }
 }
-void xevd_mc_c_n0_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_n0_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int       dx;
 
@@ -2286,11 +2286,11 @@ void xevd_mc_c_n0_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_c_4pel_horz_sse(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+    xevd_mc_filter_c_4pel_horz_sse(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
 
 }
 
-void xevd_mc_c_0n_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_0n_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int  dy;
 
@@ -2299,11 +2299,11 @@ void xevd_mc_c_0n_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_c_4pel_vert_sse(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+    xevd_mc_filter_c_4pel_vert_sse(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
 
 }
 
-void xevd_mc_c_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_C)*MAX_CU_SIZE];
     int         dx, dy;
@@ -2319,9 +2319,9 @@ void xevd_mc_c_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_c_4pel_horz_sse(ref, s_ref, buf, w, tbl_mc_c_coeff[dx],
+    xevd_mc_filter_c_4pel_horz_sse(ref, s_ref, buf, w, MC_C_COEF(coef, dx),
         w, (h + 3), min, max, offset1, shift1, 0);
-    xevd_mc_filter_c_4pel_vert_sse(buf, w, pred, s_pred, tbl_mc_c_coeff[dy],
+    xevd_mc_filter_c_4pel_vert_sse(buf, w, pred, s_pred, MC_C_COEF(coef, dy),
         w, h, min, max, offset2, shift2, 1);
 
 }
@@ -2352,3 +2352,389 @@ XEVD_MC_C xevd_tbl_mc_c_sse[2][2] =
 };
 
 #endif
+
+#if X86_SSE && XEVD_PEL_8BIT
+/****************************************************************************
+ * motion compensation for 8-bit samples
+ *
+ * The taps of all interpolation tables fit in a signed byte and the sum of
+ * their magnitudes is below 128, so a row of taps applied to unsigned bytes
+ * with _mm_maddubs_epi16 cannot leave the 16-bit range. Loads and stores
+ * cover exactly the samples read and written by the C kernels, as blocks
+ * next to the picture border have no more padding than that.
+ ****************************************************************************/
+#define MC_SFT_NN_S2_8B        12 /* XEVD_MAX(8, 20 - bit_depth) */
+
+/* shuffles gathering the byte pairs of taps (2k, 2k+1) for 8 outputs */
+static const s8 mc_shuf_8b[4][16] =
+{
+    {0, 1, 1, 2, 2, 3, 3, 4, 4,  5,  5,  6,  6,  7,  7,  8},
+    {2, 3, 3, 4, 4, 5, 5, 6, 6,  7,  7,  8,  8,  9,  9, 10},
+    {4, 5, 5, 6, 6, 7, 7, 8, 8,  9,  9, 10, 10, 11, 11, 12},
+    {6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14}
+};
+
+/* tap pairs as signed bytes for _mm_maddubs_epi16 */
+static void mc_coef_8b(const s16 * coef, int taps, __m128i * c)
+{
+    int k;
+
+    for(k = 0; k < (taps >> 1); k++)
+    {
+        c[k] = _mm_set1_epi16((s16)(((u16)(u8)coef[2 * k + 1] << 8) | (u8)coef[2 * k]));
+    }
+}
+
+/* tap pairs as signed words for _mm_madd_epi16 */
+static void mc_coef_16b(const s16 * coef, int taps, __m128i * c)
+{
+    int k;
+
+    for(k = 0; k < (taps >> 1); k++)
+    {
+        c[k] = _mm_set1_epi32((int)(((u32)(u16)coef[2 * k + 1] << 16) | (u16)coef[2 * k]));
+    }
+}
+
+/* the first len bytes at p, len = n + taps - 1 for n outputs of a row */
+static __inline __m128i mc_load_row_8b(const pel * p, int len)
+{
+    switch(len)
+    {
+    case 15:
+        return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p), _mm_srli_si128(_mm_loadl_epi64((const __m128i *)(p + 7)), 1));
+    case 11:
+        return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p), _mm_srli_si128(_mm_loadl_epi64((const __m128i *)(p + 3)), 5));
+    case 9:
+        return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p), _mm_srli_si128(_mm_loadl_epi64((const __m128i *)(p + 1)), 7));
+    case 7:
+        return _mm_unpacklo_epi32(xevd_load_4b(p), _mm_srli_si128(xevd_load_4b(p + 3), 1));
+    default: /* 5 */
+        return _mm_unpacklo_epi32(xevd_load_4b(p), _mm_srli_si128(xevd_load_4b(p + 1), 3));
+    }
+}
+
+static __inline __m128i mc_load_8b(const pel * p, int n)
+{
+    switch(n)
+    {
+    case 16: return _mm_loadu_si128((const __m128i *)p);
+    case 8:  return _mm_loadl_epi64((const __m128i *)p);
+    case 4:  return xevd_load_4b(p);
+    default: return xevd_load_2b(p);
+    }
+}
+
+static __inline void mc_store_8b(pel * p, __m128i v, int n)
+{
+    switch(n)
+    {
+    case 16: _mm_storeu_si128((__m128i *)p, v); break;
+    case 8:  _mm_storel_epi64((__m128i *)p, v); break;
+    case 4:  xevd_store_4b(p, v); break;
+    default: xevd_store_2b(p, v); break;
+    }
+}
+
+static __inline __m128i mc_load_16b(const s16 * p, int n)
+{
+    switch(n)
+    {
+    case 8:  return _mm_loadu_si128((const __m128i *)p);
+    case 4:  return _mm_loadl_epi64((const __m128i *)p);
+    default: return xevd_load_4b(p);
+    }
+}
+
+static __inline void mc_store_16b(s16 * p, __m128i v, int n)
+{
+    switch(n)
+    {
+    case 8:  _mm_storeu_si128((__m128i *)p, v); break;
+    case 4:  _mm_storel_epi64((__m128i *)p, v); break;
+    default: xevd_store_4b(p, v); break;
+    }
+}
+
+/* 16-bit sums of up to 8 horizontal outputs from the bytes in s */
+static __inline __m128i mc_horz_sum_8b(__m128i s, const __m128i * m, const __m128i * c, int taps)
+{
+    __m128i sum = _mm_maddubs_epi16(_mm_shuffle_epi8(s, m[0]), c[0]);
+    int k;
+
+    for(k = 1; k < (taps >> 1); k++)
+    {
+        sum = _mm_add_epi16(sum, _mm_maddubs_epi16(_mm_shuffle_epi8(s, m[k]), c[k]));
+    }
+    return sum;
+}
+
+static __inline int mc_chunk_8b(int w, int max)
+{
+    return (w >= max) ? max : (w >= 8) ? 8 : (w >= 4) ? 4 : 2;
+}
+
+void xevd_mc_filter_horz_8b_sse(pel *ref, int s_ref, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h)
+{
+    __m128i m[4], c[4], sum;
+    int i, j, k, n;
+
+    for(k = 0; k < (taps >> 1); k++)
+    {
+        m[k] = _mm_loadu_si128((const __m128i *)mc_shuf_8b[k]);
+    }
+    mc_coef_8b(coef, taps, c);
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += n)
+        {
+            n = mc_chunk_8b(w - j, 8);
+            sum = mc_horz_sum_8b(mc_load_row_8b(ref + j, n + taps - 1), m, c, taps);
+            sum = _mm_srai_epi16(sum, MAC_SFT_N0);
+            mc_store_8b(pred + j, _mm_packus_epi16(sum, sum), n);
+        }
+        ref += s_ref;
+        pred += s_pred;
+    }
+}
+
+/* first stage of the 2D filter, unclipped 16-bit output */
+void xevd_mc_filter_horz_s16_8b_sse(pel *ref, int s_ref, s16 *buf, int s_buf, const s16 *coef, int taps, int w, int h)
+{
+    __m128i m[4], c[4];
+    int i, j, k, n;
+
+    for(k = 0; k < (taps >> 1); k++)
+    {
+        m[k] = _mm_loadu_si128((const __m128i *)mc_shuf_8b[k]);
+    }
+    mc_coef_8b(coef, taps, c);
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += n)
+        {
+            n = mc_chunk_8b(w - j, 8);
+            mc_store_16b(buf + j, mc_horz_sum_8b(mc_load_row_8b(ref + j, n + taps - 1), m, c, taps), n);
+        }
+        ref += s_ref;
+        buf += s_buf;
+    }
+}
+
+void xevd_mc_filter_vert_8b_sse(pel *ref, int s_ref, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h)
+{
+    __m128i c[4], r[8], lo, hi;
+    pel *p, *q;
+    int i, j, k, n;
+
+    mc_coef_8b(coef, taps, c);
+
+    for(j = 0; j < w; j += n)
+    {
+        n = mc_chunk_8b(w - j, 16);
+        p = ref + j;
+        q = pred + j;
+
+        for(k = 0; k < taps - 1; k++)
+        {
+            r[k] = mc_load_8b(p, n);
+            p += s_ref;
+        }
+        for(i = 0; i < h; i++)
+        {
+            r[taps - 1] = mc_load_8b(p, n);
+
+            lo = _mm_maddubs_epi16(_mm_unpacklo_epi8(r[0], r[1]), c[0]);
+            hi = _mm_maddubs_epi16(_mm_unpackhi_epi8(r[0], r[1]), c[0]);
+            for(k = 2; k < taps; k += 2)
+            {
+                lo = _mm_add_epi16(lo, _mm_maddubs_epi16(_mm_unpacklo_epi8(r[k], r[k + 1]), c[k >> 1]));
+                hi = _mm_add_epi16(hi, _mm_maddubs_epi16(_mm_unpackhi_epi8(r[k], r[k + 1]), c[k >> 1]));
+            }
+            for(k = 0; k < taps - 1; k++)
+            {
+                r[k] = r[k + 1];
+            }
+
+            lo = _mm_srai_epi16(lo, MAC_SFT_0N);
+            hi = _mm_srai_epi16(hi, MAC_SFT_0N);
+            mc_store_8b(q, _mm_packus_epi16(lo, hi), n);
+            p += s_ref;
+            q += s_pred;
+        }
+    }
+}
+
+/* second stage of the 2D filter, on the 16-bit output of the first one */
+void xevd_mc_filter_vert_s16_8b_sse(s16 *buf, int s_buf, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h)
+{
+    __m128i c[4], r[8], lo, hi;
+    __m128i offset = _mm_set1_epi32(1 << (MC_SFT_NN_S2_8B - 1));
+    s16 *p;
+    pel *q;
+    int i, j, k, n;
+
+    mc_coef_16b(coef, taps, c);
+
+    for(j = 0; j < w; j += n)
+    {
+        n = mc_chunk_8b(w - j, 8);
+        p = buf + j;
+        q = pred + j;
+
+        for(k = 0; k < taps - 1; k++)
+        {
+            r[k] = mc_load_16b(p, n);
+            p += s_buf;
+        }
+        for(i = 0; i < h; i++)
+        {
+            r[taps - 1] = mc_load_16b(p, n);
+
+            lo = _mm_madd_epi16(_mm_unpacklo_epi16(r[0], r[1]), c[0]);
+            hi = _mm_madd_epi16(_mm_unpackhi_epi16(r[0], r[1]), c[0]);
+            for(k = 2; k < taps; k += 2)
+            {
+                lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(r[k], r[k + 1]), c[k >> 1]));
+                hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(r[k], r[k + 1]), c[k >> 1]));
+            }
+            for(k = 0; k < taps - 1; k++)
+            {
+                r[k] = r[k + 1];
+            }
+
+            lo = _mm_srai_epi32(_mm_add_epi32(lo, offset), MC_SFT_NN_S2_8B);
+            hi = _mm_srai_epi32(_mm_add_epi32(hi, offset), MC_SFT_NN_S2_8B);
+            lo = _mm_packs_epi32(lo, hi);
+            mc_store_8b(q, _mm_packus_epi16(lo, lo), n);
+            p += s_buf;
+            q += s_pred;
+        }
+    }
+}
+
+void xevd_average_16b_no_clip_sse(pel *src, pel *ref, pel *dst, int s_src, int s_ref, int s_dst, int wd, int ht, int bit_depth)
+{
+    int i, j, n;
+
+    for(i = 0; i < ht; i++)
+    {
+        for(j = 0; j < wd; j += n)
+        {
+            n = mc_chunk_8b(wd - j, 16);
+            mc_store_8b(dst + j, _mm_avg_epu8(mc_load_8b(src + j, n), mc_load_8b(ref + j, n)), n);
+        }
+        src += s_src;
+        ref += s_ref;
+        dst += s_dst;
+    }
+}
+
+static void mc_copy_8b(pel *ref, int s_ref, pel *pred, int s_pred, int w, int h)
+{
+    int i;
+
+    for(i = 0; i < h; i++)
+    {
+        xevd_mcpy(pred, ref, w);
+        ref += s_ref;
+        pred += s_pred;
+    }
+}
+
+void xevd_mc_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    ref += (gmv_y >> MC_PRECISION) * s_ref + (gmv_x >> MC_PRECISION);
+    mc_copy_8b(ref, s_ref, pred, s_pred, w, h);
+}
+
+void xevd_mc_l_n0_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    int dx = gmv_x & 15;
+    ref += (gmv_y >> MC_PRECISION) * s_ref + (gmv_x >> MC_PRECISION) - 3;
+
+    xevd_mc_filter_horz_8b_sse(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dx), 8, w, h);
+}
+
+void xevd_mc_l_0n_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    int dy = gmv_y & 15;
+    ref += ((gmv_y >> MC_PRECISION) - 3) * s_ref + (gmv_x >> MC_PRECISION);
+
+    xevd_mc_filter_vert_8b_sse(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dy), 8, w, h);
+}
+
+void xevd_mc_l_nn_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*MAX_CU_SIZE];
+    int         dx, dy;
+
+    dx = gmv_x & 15;
+    dy = gmv_y & 15;
+    ref += ((gmv_y >> MC_PRECISION) - 3) * s_ref + (gmv_x >> MC_PRECISION) - 3;
+
+    xevd_mc_filter_horz_s16_8b_sse(ref, s_ref, buf, w, MC_L_COEF(coef, dx), 8, w, h + 7);
+    xevd_mc_filter_vert_s16_8b_sse(buf, w, pred, s_pred, MC_L_COEF(coef, dy), 8, w, h);
+}
+
+void xevd_mc_c_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    ref += (gmv_y >> (MC_PRECISION + 1)) * s_ref + (gmv_x >> (MC_PRECISION + 1));
+    mc_copy_8b(ref, s_ref, pred, s_pred, w, h);
+}
+
+void xevd_mc_c_n0_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    int dx = gmv_x & 31;
+    ref += (gmv_y >> (MC_PRECISION + 1)) * s_ref + (gmv_x >> (MC_PRECISION + 1)) - 1;
+
+    xevd_mc_filter_horz_8b_sse(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dx), 4, w, h);
+}
+
+void xevd_mc_c_0n_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    int dy = gmv_y & 31;
+    ref += ((gmv_y >> (MC_PRECISION + 1)) - 1) * s_ref + (gmv_x >> (MC_PRECISION + 1));
+
+    xevd_mc_filter_vert_8b_sse(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dy), 4, w, h);
+}
+
+void xevd_mc_c_nn_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
+{
+    s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_C)*MAX_CU_SIZE];
+    int         dx, dy;
+
+    dx = gmv_x & 31;
+    dy = gmv_y & 31;
+    ref += ((gmv_y >> (MC_PRECISION + 1)) - 1) * s_ref + (gmv_x >> (MC_PRECISION + 1)) - 1;
+
+    xevd_mc_filter_horz_s16_8b_sse(ref, s_ref, buf, w, MC_C_COEF(coef, dx), 4, w, h + 3);
+    xevd_mc_filter_vert_s16_8b_sse(buf, w, pred, s_pred, MC_C_COEF(coef, dy), 4, w, h);
+}
+
+XEVD_MC_L xevd_tbl_mc_l_sse[2][2] =
+{
+    {
+        xevd_mc_l_00_sse, /* dx == 0 && dy == 0 */
+        xevd_mc_l_0n_sse  /* dx == 0 && dy != 0 */
+    },
+    {
+        xevd_mc_l_n0_sse, /* dx != 0 && dy == 0 */
+        xevd_mc_l_nn_sse  /* dx != 0 && dy != 0 */
+    }
+};
+
+XEVD_MC_C xevd_tbl_mc_c_sse[2][2] =
+{
+    {
+        xevd_mc_c_00_sse, /* dx == 0 && dy == 0 */
+        xevd_mc_c_0n_sse  /* dx == 0 && dy != 0 */
+    },
+    {
+        xevd_mc_c_n0_sse, /* dx != 0 && dy == 0 */
+        xevd_mc_c_nn_sse  /* dx != 0 && dy != 0 */
+    }
+};
+#endif /* X86_SSE && XEVD_PEL_8BIT */
@@ -35,9 +35,15 @@
 extern XEVD_MC_L xevd_tbl_mc_l_sse[2][2];
 extern XEVD_MC_C xevd_tbl_mc_c_sse[2][2];
 
-void xevd_average_16b_no_clip_sse(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref, int s_dst, int wd, int ht, int bit_depth);
-void xevd_mc_c_00_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth);
-void xevd_mc_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth);
+void xevd_average_16b_no_clip_sse(pel *src, pel *ref, pel *dst, int s_src, int s_ref, int s_dst, int wd, int ht, int bit_depth);
+void xevd_mc_c_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef);
+void xevd_mc_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef);
+#if XEVD_PEL_8BIT
+void xevd_mc_filter_horz_8b_sse(pel *ref, int s_ref, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h);
+void xevd_mc_filter_horz_s16_8b_sse(pel *ref, int s_ref, s16 *buf, int s_buf, const s16 *coef, int taps, int w, int h);
+void xevd_mc_filter_vert_8b_sse(pel *ref, int s_ref, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h);
+void xevd_mc_filter_vert_s16_8b_sse(s16 *buf, int s_buf, pel *pred, int s_pred, const s16 *coef, int taps, int w, int h);
+#endif
 #endif
 void xevd_mc_filter_l_8pel_horz_clip_sse(s16 *ref,
     int src_stride,
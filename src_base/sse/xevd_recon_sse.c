@@ -30,6 +30,8 @@
 
 #include "xevd_recon_sse.h"
 
+#if X86_SSE && !XEVD_PEL_8BIT
+
 void xevd_recon_sse(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth)
 {
     int i, j;
@@ -351,3 +353,61 @@ void xevd_recon_sse(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_r
         }
     }
 }
+
+#endif /* X86_SSE && !XEVD_PEL_8BIT */
+
+#if X86_SSE && XEVD_PEL_8BIT
+/* 8-bit samples: the residual is added in 16 bits and the saturating pack
+   does the clipping to [0, 255] */
+void xevd_recon_sse(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth)
+{
+    __m128i p0, p1;
+    int i, j;
+
+    if (is_coef == 0) /* just copy pred to rec */
+    {
+        for (i = 0; i < cuh; i++)
+        {
+            xevd_mcpy(rec, pred, cuw);
+            pred += cuw;
+            rec += s_rec;
+        }
+        return;
+    }
+
+    for (i = 0; i < cuh; i++)
+    {
+        for (j = 0; j + 16 <= cuw; j += 16)
+        {
+            p0 = _mm_loadu_si128((__m128i*)(pred + j));
+            p1 = _mm_unpackhi_epi8(p0, _mm_setzero_si128());
+            p0 = _mm_cvtepu8_epi16(p0);
+            p0 = _mm_add_epi16(p0, _mm_loadu_si128((__m128i*)(coef + j)));
+            p1 = _mm_add_epi16(p1, _mm_loadu_si128((__m128i*)(coef + j + 8)));
+            _mm_storeu_si128((__m128i*)(rec + j), _mm_packus_epi16(p0, p1));
+        }
+        if (j + 8 <= cuw)
+        {
+            p0 = _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)(pred + j)));
+            p0 = _mm_add_epi16(p0, _mm_loadu_si128((__m128i*)(coef + j)));
+            _mm_storel_epi64((__m128i*)(rec + j), _mm_packus_epi16(p0, p0));
+            j += 8;
+        }
+        if (j + 4 <= cuw)
+        {
+            p0 = _mm_cvtepu8_epi16(xevd_load_4b(pred + j));
+            p0 = _mm_add_epi16(p0, _mm_loadl_epi64((__m128i*)(coef + j)));
+            xevd_store_4b(rec + j, _mm_packus_epi16(p0, p0));
+            j += 4;
+        }
+        for (; j < cuw; j++)
+        {
+            rec[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, (s16)(coef[j] + pred[j]));
+        }
+        coef += cuw;
+        pred += cuw;
+        rec += s_rec;
+    }
+}
+
+#endif /* X86_SSE && XEVD_PEL_8BIT */
@@ -63,6 +63,7 @@ static XEVD_CTX * ctx_alloc(void)
 
 static void ctx_free(XEVD_CTX * ctx)
 {
+    xevd_out_free(ctx);
     xevd_mfree(ctx->sei_pend);
     xevd_mfree_fast(ctx);
 }
@@ -71,10 +72,13 @@ static XEVD_CORE * core_alloc(void)
 {
     XEVD_CORE * core;
 
-    core = (XEVD_CORE*)xevd_malloc_fast(sizeof(XEVD_CORE));
+    int size = XEVD_CORE_BUF_OFS(XEVD_CORE);
+
+    core = (XEVD_CORE*)xevd_malloc_fast(size + sizeof(XEVD_CORE_BUF));
 
     xevd_assert_rv(core, NULL);
-    xevd_mset_x64a(core, 0, sizeof(XEVD_CORE));
+    xevd_mset_x64a(core, 0, size + sizeof(XEVD_CORE_BUF));
+    xevd_core_buf_set(core, (XEVD_CORE_BUF *)((u8 *)core + size));
 
     return core;
 }
@@ -159,9 +163,10 @@ int xevd_delete_cu_data(XEVD_CU_DATA* cu_data, int log2_cuw, int log2_cuh)
 
     for (i = 0; i < N_C; i++)
     {
-        xevd_free_1d((void**)&cu_data->coef[i], (pixel_cnt >> (!!(i) * 2)) * sizeof(s16));
+        xevd_free_1d((void**)&cu_data->coef_ofs[i], size_32b);
         xevd_free_1d((void**)&cu_data->reco[i], (pixel_cnt >> (!!(i) * 2)) * sizeof(pel));
     }
+    xevd_free_1d((void**)&cu_data->coef, cu_data->coef_size * sizeof(s16));
 
     return XEVD_OK;
 }
@@ -242,6 +247,18 @@ static int sequence_init(XEVD_CTX * ctx, XEVD_SPS * sps)
     int size;
     int ret;
 
+#if XEVD_PEL_8BIT
+    /* pictures are stored in 8-bit samples */
+    if(sps->bit_depth_luma_minus8 != 0 || sps->bit_depth_chroma_minus8 != 0)
+    {
+        xevd_trace("bit depth over 8 is not supported by 8-bit sample build\n");
+        return XEVD_ERR_UNSUPPORTED;
+    }
+#endif
+
+    ctx->mc_l_coef = xevd_tbl_mc_l_coeff[0];
+    ctx->mc_c_coef = xevd_tbl_mc_c_coeff[0];
+
     if(sps->pic_width_in_luma_samples != ctx->w || sps->pic_height_in_luma_samples != ctx->h)
     {
         /* resolution was changed */
@@ -336,10 +353,15 @@ static int sequence_init(XEVD_CTX * ctx, XEVD_SPS * sps)
     ctx->pa.fn_free = xevd_picbuf_free;
     ctx->pa.w = ctx->w;
     ctx->pa.h = ctx->h;
-    ctx->pa.pad_l = PIC_PAD_SIZE_L;
-    ctx->pa.pad_c = PIC_PAD_SIZE_L >> (XEVD_GET_CHROMA_H_SHIFT(sps->chroma_format_idc));
+    /* motion compensation emulates the picture edges, so reference pictures
+       are not padded and only carry a guard band */
+    ctx->pa.pad_l = PIC_GUARD_SIZE_L;
+    ctx->pa.pad_c = PIC_GUARD_SIZE_L >> (XEVD_GET_CHROMA_H_SHIFT(sps->chroma_format_idc));
+    ctx->ref_pad_l = 0;
+    ctx->ref_pad_c = 0;
     ctx->ref_pic_gap_length = (int)pow(2.0, sps->log2_ref_pic_gap_length);
     ctx->pa.idc = sps->chroma_format_idc;
+    ctx->pa.imgb_alloc = ctx->cdsc.imgb_alloc.fn_alloc ? &ctx->cdsc.imgb_alloc : NULL;
 
     ret = xevd_picman_init(&ctx->dpm, MAX_PB_SIZE, XEVD_MAX_NUM_REF_PICS, &ctx->pa);
     xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
@@ -382,6 +404,9 @@ static int slice_init(XEVD_CTX * ctx, XEVD_CORE * core, XEVD_SH * sh)
     core->y_lcu = 0;
     core->x_pel = 0;
     core->y_pel = 0;
+    core->sh = sh;
+    core->refp = ctx->refp;
+    core->num_refp = ctx->dpm.num_refp;
 
     core->qp_y = ctx->sh.qp + 6 * ctx->sps->bit_depth_luma_minus8;
     core->qp_u = xevd_qp_chroma_dynamic[0][sh->qp_u] + 6 * ctx->sps->bit_depth_chroma_minus8;
@@ -637,42 +662,17 @@ static int cu_init(XEVD_CTX *ctx, XEVD_CORE *core, int x, int y, int cuw, int cu
     return XEVD_OK;
 }
 
-static void coef_rect_to_series(XEVD_CTX * ctx, s16 *coef_src[N_C], int x, int y, int cuw, int cuh, s16 coef_dst[N_C][MAX_CU_DIM], XEVD_CORE * core)
+static void coef_rect_to_series(XEVD_CTX * ctx, XEVD_CU_DATA * cu_data, int x, int y, int cuw, int cuh, s16 coef_dst[N_C][MAX_CU_DIM])
 {
-    int i, j, sidx, didx;
+    int cup = ((y & (ctx->max_cuwh - 1)) << (ctx->log2_max_cuwh - MIN_CU_LOG2 * 2)) + ((x & (ctx->max_cuwh - 1)) >> MIN_CU_LOG2);
 
-    sidx = (x&(ctx->max_cuwh - 1)) + ((y&(ctx->max_cuwh - 1)) << ctx->log2_max_cuwh);
-    didx = 0;
-
-    for (j = 0; j < cuh; j++)
-    {
-        for (int k = 0; k < cuw; k++)
-        {
-            coef_dst[Y_C][k + didx] = coef_src[Y_C][k + sidx];
-        }
-        didx += cuw;
-        sidx += ctx->max_cuwh;
-    }
+    xevd_coef_unpack(cu_data, cup, Y_C, coef_dst[Y_C], cuw * cuh);
 
-    x >>= (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc));
-    y >>= (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc));
     cuw >>= (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc));
     cuh >>= (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc));
 
-    sidx = (x&((ctx->max_cuwh >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) - 1)) + ((y&((ctx->max_cuwh >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))) - 1)) << (ctx->log2_max_cuwh - (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))));
-
-    didx = 0;
-
-    for (j = 0; j < cuh; j++)
-    {
-        for (int k = 0; k < cuw; k++)
-        {
-            coef_dst[U_C][k + didx] = coef_src[U_C][k + sidx];
-            coef_dst[V_C][k + didx] = coef_src[V_C][k + sidx];
-        }
-        didx += cuw;
-        sidx += (ctx->max_cuwh >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc)));
-    }
+    xevd_coef_unpack(cu_data, cup, U_C, coef_dst[U_C], cuw * cuh);
+    xevd_coef_unpack(cu_data, cup, V_C, coef_dst[V_C], cuw * cuh);
 }
 
 static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int log2_cuw, int log2_cuh, int cup)
@@ -697,7 +697,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
     /* inverse transform and dequantization */
     if(core->pred_mode != MODE_SKIP)
     {
-        coef_rect_to_series(ctx, cu_data->coef, x, y, cuw, cuh, core->coef, core);
+        coef_rect_to_series(ctx, cu_data, x, y, cuw, cuh, core->coef);
         xevd_lc_itdq(ctx, core);
     }
 
@@ -723,7 +723,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
                 xevd_get_inter_motion(ctx, core);
             }
         }
-        xevd_mc(x, y, ctx->w, ctx->h, cuw, cuh, core->refi, core->mv, ctx->refp, core->pred, ctx->poc.poc_val
+        xevd_mc(ctx, x, y, ctx->w, ctx->h, cuw, cuh, core->refi, core->mv, ctx->refp, core->pred, ctx->poc.poc_val
             , ctx->sps->bit_depth_luma_minus8 + 8, ctx->sps->bit_depth_chroma_minus8 + 8, ctx->sps->chroma_format_idc);
 
         xevd_set_dec_info(ctx, core);
@@ -755,7 +755,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
     return XEVD_OK;
 }
 
-static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud);
+static int copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud);
 
 static int xevd_entropy_dec_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int log2_cuw, int log2_cuh, int cud)
 {
@@ -791,7 +791,8 @@ static int xevd_entropy_dec_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y,
     ret = xevd_eco_cu(ctx, core);
     xevd_assert_g(ret == XEVD_OK, ERR);
 
-    copy_to_cu_data(ctx, core, cud);
+    ret = copy_to_cu_data(ctx, core, cud);
+    xevd_assert_g(ret == XEVD_OK, ERR);
 
     xevd_set_dec_info(ctx, core);
 
@@ -806,10 +807,10 @@ ERR:
     return ret;
 }
 
-static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
+static int copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
 {
     XEVD_CU_DATA *cu_data;
-    int idx, size;
+    int idx, size, ret;
     int log2_cuw, log2_cuh;
     int x_in_lcu = core->x - (core->x_lcu << ctx->log2_max_cuwh);
     int y_in_lcu = core->y - (core->y_lcu << ctx->log2_max_cuwh);
@@ -821,20 +822,17 @@ static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
     cu_data = &ctx->map_cu_data[core->lcu_num];
 
 
-    /* copy coef */
-    size = core->cuw * sizeof(s16);
-    s16* dst_coef = cu_data->coef[Y_C] + (y_in_lcu << ctx->log2_max_cuwh) + x_in_lcu;
-    s16* src_coef = core->coef[Y_C];
-    for (int j = 0; j < core->cuh; j++)
-    {
-        xevd_mcpy(dst_coef, src_coef, size);
-        dst_coef += ctx->max_cuwh;
-        src_coef += core->cuw;
-    }
-
     /* copy mode info */
     idx = (y_in_lcu << (ctx->log2_max_cuwh - MIN_CU_LOG2 * 2)) + (x_in_lcu >> MIN_CU_LOG2);
 
+    /* pack nonzero coef */
+    cu_data->coef_ofs[Y_C][idx] = -1;
+    if (core->is_coef[Y_C])
+    {
+        ret = xevd_coef_pack(cu_data, idx, Y_C, core->coef[Y_C], core->cuw * core->cuh);
+        xevd_assert_rv(ret == XEVD_OK, ret);
+    }
+
     cu_data->pred_mode[idx] = core->pred_mode;
     cu_data->skip_flag[idx] = core->skip_flag;
     cu_data->nnz[Y_C][idx] = core->is_coef[Y_C];
@@ -878,22 +876,17 @@ static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
         cu_data->mvd[idx][REFP_1][MV_Y] = core->mvd[REFP_1][MV_Y];
     }
 
-    size = (core->cuw >> 1) * sizeof(s16);
+    size = (core->cuw >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) * (core->cuh >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc)));
     for (int c = U_C; c <= V_C; c++)
     {
-        s16* dst_coef = cu_data->coef[c] + (y_in_lcu << (ctx->log2_max_cuwh - 2)) + (x_in_lcu >> 1);
-        s16* src_coef = core->coef[c];
-        for (int j = 0; j < core->cuh >> 1; j++)
+        cu_data->coef_ofs[c][idx] = -1;
+        if (core->is_coef[c])
         {
-            xevd_mcpy(dst_coef, src_coef, size);
-            dst_coef += ctx->max_cuwh >> 1;
-            src_coef += core->cuw >> 1;
+            ret = xevd_coef_pack(cu_data, idx, c, core->coef[c], size);
+            xevd_assert_rv(ret == XEVD_OK, ret);
         }
     }
 
-    /* copy mode info */
-    idx = (y_in_lcu << (ctx->log2_max_cuwh - MIN_CU_LOG2 * 2)) + (x_in_lcu >> MIN_CU_LOG2);
-
     cu_data->pred_mode_chroma[idx] = core->pred_mode;
     cu_data->nnz[U_C][idx] = core->is_coef[U_C];
     cu_data->nnz[V_C][idx] = core->is_coef[V_C];
@@ -912,7 +905,7 @@ static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
     {
         cu_data->ipm[1][idx] = core->ipm[1];
     }
-
+    return XEVD_OK;
 }
 
 static int xevd_entropy_decode_tree(XEVD_CTX * ctx, XEVD_CORE * core, int x0, int y0, int log2_cuw, int log2_cuh, int cup, int cud
@@ -1121,7 +1114,9 @@ int xevd_deblock(void * arg)
     int          tile_idx;
     int          filter_across_boundary = core->filter_across_boundary;
     int          i, j;
+    u64          t_perf;
 
+    XEVD_PERF_BEG(ctx, t_perf);
     tile_idx = 0;
     ctx->pic->pic_deblock_alpha_offset = ctx->sh.sh_deblock_alpha_offset;
     ctx->pic->pic_deblock_beta_offset = ctx->sh.sh_deblock_beta_offset;
@@ -1213,7 +1208,7 @@ int xevd_deblock(void * arg)
                 core->lcu_num = core->x_lcu + core->y_lcu * ctx->w_lcu;
                 if (core->y_lcu != 0)
                 {
-                    xevd_spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu], THREAD_TERMINATED);
+                    xevd_spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu], THREAD_TERMINATED, &ctx->wait_cycles[core->thread_idx]);
                 }
                 for (j = t_scu; j < b_scu; j++)
                 {
@@ -1239,6 +1234,7 @@ int xevd_deblock(void * arg)
             core->x_lcu = 0;
         }
     }
+    XEVD_PERF_END(ctx, core->thread_idx, XEVD_PERF_DEBLOCK, t_perf);
     return XEVD_OK;
 }
 
@@ -1417,9 +1413,11 @@ int xevd_tile_eco(void * arg)
     int         col_bd = 0;
     int         lcu_cnt_in_tile = 0;
     int         tile_idx;
+    u64         t_perf;
 
     xevd_assert(arg != NULL);
 
+    XEVD_PERF_BEG(ctx, t_perf);
     tile_idx = 0;
     col_bd = 0;
 
@@ -1435,6 +1433,7 @@ int xevd_tile_eco(void * arg)
         int split_allow[6] = { 0, 0, 0, 0, 0, 1 };
         xevd_assert_rv(core->lcu_num < ctx->f_lcu, XEVD_ERR_UNEXPECTED);
         core->split_mode = &ctx->map_split[core->lcu_num];
+        ctx->map_cu_data[core->lcu_num].coef_cnt = 0;
 
         //Recursion to do entropy decoding for the entire CTU
         ret = xevd_entropy_decode_tree(ctx, core, core->x_pel, core->y_pel, ctx->log2_max_cuwh, ctx->log2_max_cuwh, 0, 0, bs, sbac, 1
@@ -1461,7 +1460,7 @@ int xevd_tile_eco(void * arg)
         update_core_loc_param(ctx, core);
     }
 
-
+    XEVD_TL_END(ctx, core->thread_idx, XEVD_PERF_ENTROPY, core->tile_num, t_perf);
     return XEVD_OK;
 ERR:
     return ret;
@@ -1476,6 +1475,7 @@ int xevd_ctu_row_rec_mt(void * arg)
     int         ret;
     int         lcu_cnt_in_tile = 0;
     int         tile_idx;
+    u64         t_perf, wait_beg;
 
     xevd_assert(arg != NULL);
 
@@ -1490,19 +1490,25 @@ int xevd_ctu_row_rec_mt(void * arg)
     //LCU decoding with in a tile
     while (ctx->tile[0].f_ctb > 0)
     {
+        wait_beg = ctx->wait_cycles[core->thread_idx];
         if(ctx->tc.task_num_in_tile[0] > 2)
         {
-            xevd_spinlock_wait(&ctx->sync_row[core->y_lcu], THREAD_TERMINATED);
+            xevd_spinlock_wait(&ctx->sync_row[core->y_lcu], THREAD_TERMINATED, &ctx->wait_cycles[core->thread_idx]);
         }
-        if (core->y_lcu != sp_y_lcu && core->x_lcu < (sp_x_lcu + ctx->tile[0].w_ctb - 1))
+        if (core->y_lcu != sp_y_lcu)
         {
-            /* up-right CTB */
-            xevd_spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED);
+            /* up-right CTB, or the one above in the last column of the tile */
+            int x_ofs = core->x_lcu < (sp_x_lcu + ctx->tile[0].w_ctb - 1) ? 1 : 0;
+            xevd_spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + x_ofs], THREAD_TERMINATED, &ctx->wait_cycles[core->thread_idx]);
         }
         xevd_assert_rv(core->lcu_num < ctx->f_lcu, XEVD_ERR_UNEXPECTED);
 
+        XEVD_TL_BLOCKED(ctx, core->thread_idx, core->lcu_num, wait_beg);
+
+        XEVD_PERF_BEG(ctx, t_perf);
         ret = xevd_recon_tree(ctx, core, (core->x_lcu << ctx->log2_max_cuwh), (core->y_lcu << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0);
         xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
+        XEVD_TL_END(ctx, core->thread_idx, XEVD_PERF_RECON, core->lcu_num, t_perf);
 
         xevd_threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
         xevd_threadsafe_decrement(ctx->sync_block, (volatile s32 *)&ctx->tile[0].f_ctb);
@@ -1531,14 +1537,16 @@ int xevd_tile_mt(void * arg)
     XEVD_CTX   * ctx = core->ctx;
     int          res, ret = XEVD_OK;
     int          thread_idx = core->thread_idx + ctx->tc.tile_task_num;
+    u64          t_perf;
     xevd_mset((void *)ctx->sync_row, 0, ctx->tile[0].h_ctb * sizeof(ctx->sync_row[0]));
     if (ctx->tc.task_num_in_tile[0] > 2)
     {
         for (int thread_cnt = 1; thread_cnt < ctx->tc.task_num_in_tile[0]; thread_cnt++)
         {
-            if (thread_cnt < ctx->tile[0].h_ctb)
+            /* thread_cnt reconstructs the rows from thread_cnt - 1 */
+            if (thread_cnt <= ctx->tile[0].h_ctb)
             {
-                xevd_mcpy(ctx->core_mt[thread_idx], core, sizeof(XEVD_CORE));
+                xevd_core_copy(ctx->core_mt[thread_idx], core);
                 ctx->core_mt[thread_idx]->x_lcu = ((ctx->tile[0].ctba_rs_first) % ctx->w_lcu);               //entry point lcu's x location
                 ctx->core_mt[thread_idx]->y_lcu = ((ctx->tile[0].ctba_rs_first) / ctx->w_lcu) + thread_cnt - 1; // entry point lcu's y location //MULTICORE_ENT_RECON
                 ctx->core_mt[thread_idx]->lcu_num = ctx->core_mt[thread_idx]->y_lcu * ctx->w_lcu + ctx->core_mt[thread_idx]->x_lcu;
@@ -1549,10 +1557,11 @@ int xevd_tile_mt(void * arg)
         }
         ret = xevd_tile_eco(arg);
         xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
+        XEVD_PERF_BEG(ctx, t_perf);
         thread_idx = core->thread_idx + ctx->tc.tile_task_num;
         for (int thread_cnt = 1; thread_cnt < ctx->tc.task_num_in_tile[0]; thread_cnt++)
         {
-            if (thread_cnt < ctx->tile[0].h_ctb)
+            if (thread_cnt <= ctx->tile[0].h_ctb)
             {
                 ctx->tc.join(ctx->thread_pool[thread_idx], &res);
                 if (XEVD_FAILED(res))
@@ -1562,6 +1571,7 @@ int xevd_tile_mt(void * arg)
             }
             thread_idx += ctx->tc.tile_task_num;
         }
+        XEVD_TL_END(ctx, core->thread_idx, XEVD_TL_JOIN, core->tile_num, t_perf);
     }
     else
     {
@@ -1573,7 +1583,7 @@ int xevd_tile_mt(void * arg)
     {
         if (thread_cnt < ctx->tile[0].h_ctb)
         {
-            xevd_mcpy(ctx->core_mt[thread_idx], core, sizeof(XEVD_CORE));
+            xevd_core_copy(ctx->core_mt[thread_idx], core);
             ctx->core_mt[thread_idx]->x_lcu = ((ctx->tile[0].ctba_rs_first) % ctx->w_lcu);               //entry point lcu's x location
             ctx->core_mt[thread_idx]->y_lcu = ((ctx->tile[0].ctba_rs_first) / ctx->w_lcu) + thread_cnt; // entry point lcu's y location
             ctx->core_mt[thread_idx]->lcu_num = ctx->core_mt[thread_idx]->y_lcu * ctx->w_lcu + ctx->core_mt[thread_idx]->x_lcu;
@@ -1588,6 +1598,7 @@ int xevd_tile_mt(void * arg)
     core->lcu_num = core->y_lcu*ctx->w_lcu + core->x_lcu;
     xevd_ctu_row_rec_mt(arg);
 
+    XEVD_PERF_BEG(ctx, t_perf);
     thread_idx = core->thread_idx + ctx->tc.tile_task_num;
     for (int thread_cnt = 1; thread_cnt < ctx->tc.task_num_in_tile[0]; thread_cnt++)
     {
@@ -1601,6 +1612,7 @@ int xevd_tile_mt(void * arg)
         }
         thread_idx += ctx->tc.tile_task_num;
         }
+    XEVD_TL_END(ctx, core->thread_idx, XEVD_TL_JOIN, core->tile_num, t_perf);
     }
     return ret;
 }
@@ -1626,7 +1638,7 @@ int xevd_dec_slice(XEVD_CTX * ctx, XEVD_CORE * core)
     xevd_mcpy(&sbac_temp, sbac, sizeof(XEVD_SBAC));
     ctx->sh.qp_prev_eco = ctx->sh.qp;
 
-    xevd_mcpy(ctx->core_mt[0], core, sizeof(XEVD_CORE));
+    xevd_core_copy(ctx->core_mt[0], core);
     core_mt = ctx->core_mt[0];
 
     core_mt->ctx = ctx;
@@ -1731,9 +1743,13 @@ int xevd_create_cu_data(XEVD_CU_DATA *cu_data, int log2_cuw, int log2_cuh)
 
     for(i = 0; i < N_C; i++)
     {
-        xevd_malloc_1d((void**)&cu_data->coef[i], (pixel_cnt >> (!!(i)* 2)) * sizeof(s16));
+        xevd_malloc_1d((void**)&cu_data->coef_ofs[i], size_32b);
         xevd_malloc_1d((void**)&cu_data->reco[i], (pixel_cnt >> (!!(i)* 2)) * sizeof(pel));
     }
+    /* sparse coef grows on demand while parsing */
+    cu_data->coef_size = pixel_cnt >> 1;
+    cu_data->coef_cnt = 0;
+    xevd_malloc_1d((void**)&cu_data->coef, cu_data->coef_size * sizeof(s16));
     return XEVD_OK;
 }
 
@@ -1791,7 +1807,9 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
     XEVD_SH   *sh = &ctx->sh;
     XEVD_NALU *nalu = &ctx->nalu;
     int        ret;
+    u64        t_perf;
 
+    XEVD_PERF_BEG(ctx, t_perf);
     ret = XEVD_OK;
     /* set error status */
     ctx->bs_err = bitb->err;
@@ -1878,6 +1896,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
             slice_num = 0;
         }
         ctx->slice_num = slice_num;
+        ctx->core->slice_num = slice_num;
         slice_num++;
 
         /* initialize reference pictures */
@@ -1901,6 +1920,8 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
             xevd_mset_x64a(ctx->map_mv, 0, size);
         }
 
+        XEVD_PERF_END(ctx, 0, XEVD_PERF_PARSE, t_perf);
+
         /* decode slice layer */
         ret = ctx->fn_dec_slice(ctx, ctx->core);
         xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
@@ -1921,6 +1942,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
             {
                 core_mt = ctx->core_mt[j];
                 core_mt->ctx = ctx;
+                core_mt->thread_idx = j;
                 core_mt->y_lcu = j;
                 core_mt->x_lcu = 0;
                 core_mt->deblock_is_hor = 1;
@@ -1932,6 +1954,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
 
             core_mt = ctx->core_mt[0];
             core_mt->ctx = ctx;
+            core_mt->thread_idx = 0;
             core_mt->y_lcu = 0;
             core_mt->x_lcu = 0;
             core_mt->deblock_is_hor = 1;
@@ -1952,6 +1975,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
 
                 core_mt = ctx->core_mt[j];
                 core_mt->ctx = ctx;
+                core_mt->thread_idx = j;
                 core_mt->y_lcu = j;
                 core_mt->x_lcu = 0;
                 core_mt->deblock_is_hor = 0;
@@ -1962,6 +1986,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
             }
             core_mt = ctx->core_mt[0];
             core_mt->ctx = ctx;
+            core_mt->thread_idx = 0;
             core_mt->y_lcu = 0;
             core_mt->x_lcu = 0;
             core_mt->deblock_is_hor = 0;
@@ -1977,11 +2002,17 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
         if (ctx->num_ctb == 0)
         {
             /* expand pixels to padding area */
-            ctx->fn_picbuf_expand(ctx, ctx->pic);
+            if (ctx->ref_pad_l)
+            {
+                XEVD_PERF_BEG(ctx, t_perf);
+                ctx->fn_picbuf_expand(ctx, ctx->pic);
+                XEVD_PERF_END(ctx, 0, XEVD_PERF_PAD, t_perf);
+            }
 
             /* put decoded picture to DPB */
             ret = xevd_picman_put_pic(&ctx->dpm, ctx->pic, ctx->nalu.nal_unit_type_plus1 - 1 == XEVD_NUT_IDR, ctx->poc.poc_val, ctx->nalu.nuh_temporal_id, 1, ctx->refp, ctx->slice_ref_flag, ctx->ref_pic_gap_length);
             xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
+            xevd_perf_pic_done(ctx);
         }
 
         if(ctx->pic_cnt == 0) {
@@ -2010,12 +2041,15 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
     else if (nalu->nal_unit_type_plus1 - 1 == XEVD_NUT_SEI)
     {
         ret = xevd_eco_sei(ctx, bs);
+        XEVD_PERF_END(ctx, 0, XEVD_PERF_PARSE, t_perf);
 
         if (ctx->pic_sign_exist)
         {
             if (ctx->use_pic_sign)
             {
+                XEVD_PERF_BEG(ctx, t_perf);
                 ret = xevd_picbuf_check_signature(ctx->pic, ctx->pic_sign, ctx->sps->bit_depth_luma_minus8 + 8);
+                XEVD_PERF_END(ctx, 0, XEVD_PERF_MD5, t_perf);
                 ctx->pic_sign_exist = 0;
             }
             else
@@ -2028,6 +2062,11 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
     {
         assert(!"wrong NALU type");
     }
+    if (nalu->nal_unit_type_plus1 - 1 >= XEVD_NUT_SPS && nalu->nal_unit_type_plus1 - 1 != XEVD_NUT_SEI)
+    {
+        /* parameter sets; slices and SEI have stopped the clock already */
+        XEVD_PERF_END(ctx, 0, XEVD_PERF_PARSE, t_perf);
+    }
 
     make_stat(ctx, nalu->nal_unit_type_plus1 - 1, stat);
 
@@ -2043,9 +2082,11 @@ int xevd_pull_frm(XEVD_CTX *ctx, XEVD_IMGB **imgb)
 {
     int ret;
     XEVD_PIC *pic;
+    u64 t_perf;
 
     *imgb = NULL;
 
+    XEVD_PERF_BEG(ctx, t_perf);
     pic = xevd_picman_out_pic(&ctx->dpm, &ret);
 
     if(pic)
@@ -2067,73 +2108,77 @@ int xevd_pull_frm(XEVD_CTX *ctx, XEVD_IMGB **imgb)
                 (*imgb)->w[i] = (*imgb)->aw[i] - (ctx->sps->picture_crop_left_offset + ctx->sps->picture_crop_right_offset) * cs_offset;
             }
         }
+        if(ctx->cdsc.out_cs != XEVD_CS_UNKNOWN)
+        {
+            ret = xevd_out_pull(ctx, imgb, NULL, NULL);
+        }
+        XEVD_PERF_END(ctx, 0, XEVD_PERF_OUTPUT, t_perf);
     }
     return ret;
 }
 
 int xevd_platform_init(XEVD_CTX *ctx)
 {
+    ctx->isa = xevd_isa_select(ctx->cdsc.isa);
+
+    ctx->fn_mc_l = xevd_tbl_mc_l;
+    ctx->fn_mc_c = xevd_tbl_mc_c;
+    ctx->fn_average_no_clip = &xevd_average_16b_no_clip;
+    ctx->fn_out = &xevd_tbl_out;
+    ctx->fn_itxb   = &xevd_tbl_itxb;
+    ctx->fn_recon = &xevd_recon;
+    ctx->fn_ipred_ang = ipred_ang;
+    ctx->fn_ipred_bi = xevd_ipred_bi;
+    ctx->fn_ipred_plane = xevd_ipred_plane;
+    ctx->fn_dbk = &xevd_tbl_dbk;
+    ctx->fn_dbk_chroma = &xevd_tbl_dbk_chroma;
 
 #if ARM_NEON
-    xevd_func_mc_l = xevd_tbl_mc_l_neon;
-    xevd_func_mc_c = xevd_tbl_mc_c_neon;
-    xevd_func_average_no_clip = &xevd_average_16b_no_clip_neon;
-    ctx->fn_itxb   = &xevd_tbl_itxb_neon;
-    ctx->fn_recon = &xevd_recon_neon;
-    ctx->fn_dbk = &xevd_tbl_dbk_neon;
-    ctx->fn_dbk_chroma = &xevd_tbl_dbk_chroma_neon;
-
-
-#else
-#if X86_SSE
-    int check_cpu, support_sse, support_avx, support_avx2;
-
-    check_cpu = xevd_check_cpu_info();
-    support_sse = (check_cpu >> 1) & 1;
-    support_avx = check_cpu & 1;
-    support_avx2 = (check_cpu >> 2) & 1;
-
-    if (support_avx2)
+    if (ctx->isa == XEVD_ISA_NEON)
+    {
+        ctx->fn_itxb   = &xevd_tbl_itxb_neon;
+#if !XEVD_PEL_8BIT
+        ctx->fn_mc_l = xevd_tbl_mc_l_neon;
+        ctx->fn_mc_c = xevd_tbl_mc_c_neon;
+        ctx->fn_average_no_clip = &xevd_average_16b_no_clip_neon;
+        ctx->fn_recon = &xevd_recon_neon;
+        ctx->fn_dbk = &xevd_tbl_dbk_neon;
+        ctx->fn_dbk_chroma = &xevd_tbl_dbk_chroma_neon;
+#endif
+    }
+#elif X86_SSE
+    if (ctx->isa == XEVD_ISA_AVX2)
     {
-        xevd_func_mc_l = xevd_tbl_mc_l_avx;
-        xevd_func_mc_c = xevd_tbl_mc_c_avx;
-        xevd_func_average_no_clip = &xevd_average_16b_no_clip_sse;
         ctx->fn_itxb   = &xevd_tbl_itxb_avx;
+        ctx->fn_mc_l = xevd_tbl_mc_l_avx;
+        ctx->fn_mc_c = xevd_tbl_mc_c_avx;
+        ctx->fn_average_no_clip = &xevd_average_16b_no_clip_sse;
         ctx->fn_recon = &xevd_recon_avx;
         ctx->fn_dbk = &xevd_tbl_dbk_sse;
         ctx->fn_dbk_chroma = &xevd_tbl_dbk_chroma_sse;
+#if !XEVD_PEL_8BIT
+        ctx->fn_ipred_ang = xevd_ipred_ang_sse;
+        ctx->fn_ipred_bi = xevd_ipred_bi_sse;
+        ctx->fn_ipred_plane = xevd_ipred_plane_sse;
+        ctx->fn_out = &xevd_tbl_out_avx;
+#endif
     }
-    else if (support_sse)
+    else if (ctx->isa == XEVD_ISA_SSE)
     {
-        xevd_func_mc_l = xevd_tbl_mc_l_sse;
-        xevd_func_mc_c = xevd_tbl_mc_c_sse;
-        xevd_func_average_no_clip = &xevd_average_16b_no_clip_sse;
         ctx->fn_itxb   = &xevd_tbl_itxb_sse;
+        ctx->fn_mc_l = xevd_tbl_mc_l_sse;
+        ctx->fn_mc_c = xevd_tbl_mc_c_sse;
+        ctx->fn_average_no_clip = &xevd_average_16b_no_clip_sse;
         ctx->fn_recon = &xevd_recon_sse;
         ctx->fn_dbk = &xevd_tbl_dbk_sse;
         ctx->fn_dbk_chroma = &xevd_tbl_dbk_chroma_sse;
-    }
-    else
-    {
-        xevd_func_mc_l = xevd_tbl_mc_l;
-        xevd_func_mc_c = xevd_tbl_mc_c;
-        xevd_func_average_no_clip = &xevd_average_16b_no_clip;
-        ctx->fn_itxb   = &xevd_tbl_itxb;
-        ctx->fn_recon = &xevd_recon;
-        ctx->fn_dbk = &xevd_tbl_dbk;
-        ctx->fn_dbk_chroma = &xevd_tbl_dbk_chroma;
-    }
-#else
-    {
-        xevd_func_mc_l = xevd_tbl_mc_l;
-        xevd_func_mc_c = xevd_tbl_mc_c;
-        xevd_func_average_no_clip = &xevd_average_16b_no_clip;
-        ctx->fn_itxb   = &xevd_tbl_itxb;
-        ctx->fn_recon = &xevd_recon;
-        ctx->fn_dbk = &xevd_tbl_dbk;
-        ctx->fn_dbk_chroma = &xevd_tbl_dbk_chroma;
-    }
+#if !XEVD_PEL_8BIT
+        ctx->fn_ipred_ang = xevd_ipred_ang_sse;
+        ctx->fn_ipred_bi = xevd_ipred_bi_sse;
+        ctx->fn_ipred_plane = xevd_ipred_plane_sse;
+        ctx->fn_out = &xevd_tbl_out_sse;
 #endif
+    }
 #endif
 
     ctx->fn_ready         = xevd_ready;
@@ -2171,6 +2216,9 @@ XEVD xevd_create(XEVD_CDSC * cdsc, int * err)
     xevd_assert_gv(ctx != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
     xevd_mcpy(&ctx->cdsc, cdsc, sizeof(XEVD_CDSC));
     xevd_assert_gv(!(cdsc->threads > XEVD_MAX_TASK_CNT), ret, XEVD_ERR_THREAD_ALLOCATION, ERR);
+    xevd_assert_gv(cdsc->isa >= XEVD_ISA_AUTO && cdsc->isa <= XEVD_ISA_NEON, ret, XEVD_ERR_INVALID_ARGUMENT, ERR);
+    xevd_assert_gv(!cdsc->imgb_alloc.fn_alloc == !cdsc->imgb_alloc.fn_free, ret, XEVD_ERR_INVALID_ARGUMENT, ERR);
+    xevd_assert_gv(XEVD_SUCCEEDED(xevd_out_cs_check(cdsc->out_cs)), ret, XEVD_ERR_UNSUPPORTED_COLORSPACE, ERR);
     ret = xevd_init_thread_controller(&ctx->tc, cdsc->threads);
     xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
 
@@ -2248,7 +2296,9 @@ void xevd_delete(XEVD id)
     XEVD_CTX *ctx;
     XEVD_ID_TO_CTX_R(id, ctx);
 
+    if(ctx->async) xevd_async_stop(id);
     sequence_deinit(ctx);
+    xevd_tl_set(ctx, NULL);
 
     if (ctx->sync_block)
     {
@@ -2294,6 +2344,20 @@ int xevd_config(XEVD id, int cfg, void * buf, int * size)
         ctx->use_pic_sign = (*((int *)buf)) ? 1 : 0;
         break;
 
+    case XEVD_CFG_SET_PERF_STATS:
+        xevd_perf_reset(ctx, (*((int *)buf)) ? 1 : 0);
+        break;
+
+    case XEVD_CFG_SET_TIMELINE:
+        xevd_assert_rv(*size == sizeof(XEVD_TIMELINE), XEVD_ERR_INVALID_ARGUMENT);
+        return xevd_tl_set(ctx, (XEVD_TIMELINE *)buf);
+
+    case XEVD_CFG_SET_OUTPUT_CS:
+        xevd_assert_rv(*size == sizeof(int), XEVD_ERR_INVALID_ARGUMENT);
+        xevd_assert_rv(XEVD_SUCCEEDED(xevd_out_cs_check(*((int *)buf))), XEVD_ERR_UNSUPPORTED_COLORSPACE);
+        ctx->cdsc.out_cs = *((int *)buf);
+        break;
+
     /* get config ************************************************************/
     case XEVD_CFG_GET_CODEC_BIT_DEPTH:
         xevd_assert_rv(*size == sizeof(int), XEVD_ERR_INVALID_ARGUMENT);
@@ -2334,6 +2398,30 @@ int xevd_config(XEVD id, int cfg, void * buf, int * size)
         *((int *)buf) = ctx->max_coding_delay;
         break;
 
+    case XEVD_CFG_GET_WAIT_CYCLES:
+        xevd_assert_rv(*size == sizeof(long long), XEVD_ERR_INVALID_ARGUMENT);
+        *((long long *)buf) = 0;
+        for(t0 = 0; t0 < XEVD_MAX_TASK_CNT; t0++)
+        {
+            *((long long *)buf) += (long long)ctx->wait_cycles[t0];
+        }
+        break;
+
+    case XEVD_CFG_GET_ISA:
+        xevd_assert_rv(*size == sizeof(int), XEVD_ERR_INVALID_ARGUMENT);
+        *((int *)buf) = ctx->isa;
+        break;
+
+    case XEVD_CFG_GET_THREAD_STAT:
+        xevd_assert_rv(*size == sizeof(XEVD_THREAD_STAT), XEVD_ERR_INVALID_ARGUMENT);
+        xevd_get_thread_stat(ctx, (XEVD_THREAD_STAT *)buf);
+        break;
+
+    case XEVD_CFG_GET_PERF_STATS:
+        xevd_assert_rv(*size == sizeof(XEVD_PERF_STATS), XEVD_ERR_INVALID_ARGUMENT);
+        xevd_get_perf_stats(ctx, (XEVD_PERF_STATS *)buf);
+        break;
+
     default:
         xevd_assert_rv(0, XEVD_ERR_UNSUPPORTED);
     }
@@ -2344,20 +2432,43 @@ int xevd_decode(XEVD id, XEVD_BITB * bitb, XEVD_STAT * stat)
 
 {
     XEVD_CTX *ctx;
+    u64       t0;
+    int       ret;
 
     XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
 
     xevd_assert_rv(ctx->fn_dec_cnk, XEVD_ERR_UNEXPECTED);
 
-    return ctx->fn_dec_cnk(ctx, bitb, stat);
+    t0 = xevd_get_cycles();
+    ret = ctx->fn_dec_cnk(ctx, bitb, stat);
+    if(ctx->perf_on & XEVD_PERF_TL)
+    {
+        xevd_tl_add(ctx, 0, XEVD_TL_DECODE, ctx->nalu.nal_unit_type_plus1 - 1, t0, xevd_get_cycles());
+        xevd_tl_flush(ctx);
+    }
+    ctx->dec_cycles += xevd_get_cycles() - t0;
+    return ret;
+}
+
+int xevd_decode_au(XEVD id, XEVD_BITB * bitb, int fmt, XEVD_NALU_STAT * nstat, int * nstat_cnt)
+{
+    XEVD_CTX *ctx;
+
+    XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
+    xevd_assert_rv(bitb && nstat && nstat_cnt, XEVD_ERR_INVALID_ARGUMENT);
+
+    return xevd_decode_nalus(id, bitb, fmt, nstat, nstat_cnt);
 }
 
 int xevd_pull(XEVD id, XEVD_IMGB ** img)
 {
     XEVD_CTX *ctx;
+    int       ret;
 
     XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
     xevd_assert_rv(ctx->fn_pull, XEVD_ERR_UNKNOWN);
 
-    return ctx->fn_pull(ctx, img);
+    ret = ctx->fn_pull(ctx, img);
+    xevd_tl_flush(ctx);
+    return ret;
 }
@@ -0,0 +1,334 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevd_def.h"
+
+/* convert XEVD into XEVD_CTX with return value if assert on */
+#define XEVD_ID_TO_CTX_RV(id, ctx, ret) \
+    xevd_assert_rv((id), (ret)); \
+    (ctx) = (XEVD_CTX *)id; \
+    xevd_assert_rv((ctx)->magic == XEVD_MAGIC_CODE, (ret));
+
+#define ASYNC_SLOT(cnt, idx)    ((int)((u32)(idx) % (u32)(cnt)))
+
+static void async_err(XEVD_ASYNC_CTX * a, int ret)
+{
+    if(a->ret == XEVD_OK)
+    {
+        xevd_threadsafe_assign(&a->ret, ret);
+    }
+}
+
+/* hand a picture, or NULL at the end of stream, to the application. waits
+   for room in the output queue; pictures are dropped once stopping */
+static void async_out(XEVD_ASYNC_CTX * a, XEVD_IMGB * imgb)
+{
+    int cnt = a->cfg.out_cnt;
+
+    if(a->cfg.fn_out && !xevd_threadsafe_read(&a->abort))
+    {
+        a->cfg.fn_out(a->cfg.user, imgb);
+        return;
+    }
+    while(a->cfg.fn_out == NULL && !xevd_threadsafe_read(&a->abort) &&
+          a->out_wr - xevd_threadsafe_read(&a->out_rd) >= cnt)
+    {
+        xevd_progress_wait(&a->out_rd, a->out_wr - cnt + 1, NULL);
+    }
+    if(a->cfg.fn_out || xevd_threadsafe_read(&a->abort))
+    {
+        if(imgb) imgb->release(imgb);
+        return;
+    }
+    a->out[ASYNC_SLOT(cnt, a->out_wr)] = imgb;
+    xevd_threadsafe_assign(&a->out_wr, a->out_wr + 1);
+    xevd_threadsafe_assign(&a->seq, a->seq + 1);
+}
+
+/* release the pictures not received yet */
+static void async_drop(XEVD_ASYNC_CTX * a)
+{
+    XEVD_IMGB * imgb;
+    int         i, end = xevd_threadsafe_read(&a->out_wr);
+
+    for(i = a->out_rd; i != end; i++)
+    {
+        imgb = a->out[ASYNC_SLOT(a->cfg.out_cnt, i)];
+        if(imgb) imgb->release(imgb);
+    }
+    xevd_threadsafe_assign(&a->out_rd, end);
+}
+
+static int async_driver(void * arg)
+{
+    XEVD_CTX       * ctx = (XEVD_CTX *)arg;
+    XEVD_ASYNC_CTX * a = ctx->async;
+    XEVD_ASYNC_IN  * in;
+    XEVD_STAT        stat;
+    XEVD_IMGB      * imgb;
+    int              ret;
+
+    while(1)
+    {
+        xevd_progress_wait(&a->in_wr, a->in_rd + 1, NULL);
+        in = a->in + ASYNC_SLOT(a->cfg.in_cnt, a->in_rd);
+        if(in->size < 0) break;
+
+        if(!xevd_threadsafe_read(&a->abort))
+        {
+            xevd_mset(&stat, 0, sizeof(XEVD_STAT));
+            in->bitb.addr = in->buf;
+            in->bitb.ssize = in->size;
+            ret = xevd_decode(ctx->id, &in->bitb, &stat);
+            if(a->cfg.fn_nalu)
+            {
+                a->cfg.fn_nalu(a->cfg.user, &in->bitb, ret, &stat);
+            }
+            if(XEVD_FAILED(ret))
+            {
+                async_err(a, ret);
+            }
+            else if(stat.fnum >= 0)
+            {
+                imgb = NULL;
+                ret = xevd_pull(ctx->id, &imgb);
+                if(XEVD_FAILED(ret)) async_err(a, ret);
+                else if(imgb) async_out(a, imgb);
+            }
+        }
+        xevd_threadsafe_assign(&a->in_rd, a->in_rd + 1);
+        xevd_threadsafe_assign(&a->seq, a->seq + 1);
+    }
+
+    /* end of stream: bump out the remaining pictures */
+    while(!xevd_threadsafe_read(&a->abort))
+    {
+        imgb = NULL;
+        ret = xevd_pull(ctx->id, &imgb);
+        if(ret == XEVD_ERR_UNEXPECTED) break;
+        if(XEVD_FAILED(ret))
+        {
+            async_err(a, ret);
+            break;
+        }
+        if(imgb) async_out(a, imgb);
+    }
+    async_out(a, NULL);
+    xevd_threadsafe_assign(&a->in_rd, a->in_rd + 1);
+    xevd_threadsafe_assign(&a->seq, a->seq + 1);
+    return a->ret;
+}
+
+static void async_free(XEVD_ASYNC_CTX * a)
+{
+    int i;
+
+    if(a->in)
+    {
+        for(i = 0; i < a->cfg.in_cnt; i++)
+        {
+            xevd_mfree(a->in[i].buf);
+        }
+        xevd_mfree(a->in);
+    }
+    xevd_mfree(a->out);
+    xevd_mfree(a);
+}
+
+int xevd_async_start(XEVD id, XEVD_ASYNC * async)
+{
+    XEVD_CTX       * ctx;
+    XEVD_ASYNC_CTX * a;
+    int              ret;
+
+    XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
+    xevd_assert_rv(async != NULL, XEVD_ERR_INVALID_ARGUMENT);
+    xevd_assert_rv(async->in_cnt >= 0 && async->out_cnt >= 0, XEVD_ERR_INVALID_ARGUMENT);
+    xevd_assert_rv(ctx->async == NULL, XEVD_ERR_UNEXPECTED);
+
+    a = (XEVD_ASYNC_CTX *)xevd_malloc(sizeof(XEVD_ASYNC_CTX));
+    xevd_assert_rv(a != NULL, XEVD_ERR_OUT_OF_MEMORY);
+    xevd_mset(a, 0, sizeof(XEVD_ASYNC_CTX));
+
+    a->cfg = *async;
+    if(a->cfg.in_cnt == 0) a->cfg.in_cnt = XEVD_ASYNC_IN_CNT;
+    if(a->cfg.out_cnt == 0) a->cfg.out_cnt = XEVD_ASYNC_OUT_CNT;
+
+    a->in = (XEVD_ASYNC_IN *)xevd_malloc(sizeof(XEVD_ASYNC_IN) * a->cfg.in_cnt);
+    xevd_assert_gv(a->in != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
+    xevd_mset(a->in, 0, sizeof(XEVD_ASYNC_IN) * a->cfg.in_cnt);
+    a->out = (XEVD_IMGB **)xevd_malloc(sizeof(XEVD_IMGB *) * a->cfg.out_cnt);
+    xevd_assert_gv(a->out != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
+
+    /* the driver thread calls xevd_decode(), which keeps using the pool of
+       the decoder for its tiles and CTU rows */
+    xevd_init_thread_controller(&a->tc, 1);
+    a->thread = a->tc.create(&a->tc, 0);
+    xevd_assert_gv(a->thread != NULL, ret, XEVD_ERR_UNKNOWN, ERR);
+
+    ctx->async = a;
+    ret = a->tc.run(a->thread, async_driver, ctx);
+    if(ret != THREAD_SUCCESS)
+    {
+        ctx->async = NULL;
+        a->tc.release(&a->thread);
+        ret = XEVD_ERR_UNKNOWN;
+        goto ERR;
+    }
+    return XEVD_OK;
+
+ERR:
+    xevd_dinit_thread_controller(&a->tc);
+    async_free(a);
+    return ret;
+}
+
+int xevd_submit(XEVD id, XEVD_BITB * bitb, int wait)
+{
+    XEVD_CTX       * ctx;
+    XEVD_ASYNC_CTX * a;
+    XEVD_ASYNC_IN  * in;
+    int              seq, ret;
+
+    XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
+    a = ctx->async;
+    xevd_assert_rv(a != NULL && !a->eos, XEVD_ERR_UNEXPECTED);
+
+    ret = xevd_threadsafe_read(&a->ret);
+    if(XEVD_FAILED(ret)) return ret;
+
+    while(1)
+    {
+        seq = xevd_threadsafe_read(&a->seq);
+        if(a->in_wr - xevd_threadsafe_read(&a->in_rd) < a->cfg.in_cnt) break;
+        /* the driver thread may be blocked on the output queue */
+        if(!wait || (a->cfg.fn_out == NULL &&
+           xevd_threadsafe_read(&a->out_wr) - a->out_rd >= a->cfg.out_cnt))
+        {
+            return XEVD_ERR_REACHED_MAX;
+        }
+        xevd_progress_wait(&a->seq, seq + 1, NULL);
+    }
+
+    in = a->in + ASYNC_SLOT(a->cfg.in_cnt, a->in_wr);
+    if(bitb == NULL)
+    {
+        in->size = -1;
+        a->eos = 1;
+    }
+    else
+    {
+        xevd_assert_rv(bitb->addr != NULL && bitb->ssize > 0, XEVD_ERR_INVALID_ARGUMENT);
+        if(in->buf_size < bitb->ssize)
+        {
+            xevd_mfree(in->buf);
+            in->buf_size = 0;
+            in->buf = (u8 *)xevd_malloc(bitb->ssize);
+            xevd_assert_rv(in->buf != NULL, XEVD_ERR_OUT_OF_MEMORY);
+            in->buf_size = bitb->ssize;
+        }
+        xevd_mcpy(in->buf, bitb->addr, bitb->ssize);
+        in->bitb = *bitb;
+        in->size = bitb->ssize;
+    }
+    xevd_threadsafe_assign(&a->in_wr, a->in_wr + 1);
+    return XEVD_OK;
+}
+
+int xevd_receive(XEVD id, XEVD_IMGB ** imgb, int wait)
+{
+    XEVD_CTX       * ctx;
+    XEVD_ASYNC_CTX * a;
+    int              seq;
+
+    XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
+    xevd_assert_rv(imgb != NULL, XEVD_ERR_INVALID_ARGUMENT);
+    a = ctx->async;
+    xevd_assert_rv(a != NULL && a->cfg.fn_out == NULL, XEVD_ERR_UNEXPECTED);
+
+    *imgb = NULL;
+    if(a->out_eos) return XEVD_OK_NO_MORE_FRM;
+
+    while(1)
+    {
+        seq = xevd_threadsafe_read(&a->seq);
+        if(xevd_threadsafe_read(&a->out_wr) != a->out_rd) break;
+        /* nothing left that could produce a picture */
+        if(!wait || xevd_threadsafe_read(&a->in_rd) == a->in_wr)
+        {
+            return XEVD_OK_OUT_NOT_AVAILABLE;
+        }
+        xevd_progress_wait(&a->seq, seq + 1, NULL);
+    }
+
+    *imgb = a->out[ASYNC_SLOT(a->cfg.out_cnt, a->out_rd)];
+    if(*imgb == NULL)
+    {
+        a->out_eos = 1;
+        return XEVD_OK_NO_MORE_FRM;
+    }
+    xevd_threadsafe_assign(&a->out_rd, a->out_rd + 1);
+    return XEVD_OK;
+}
+
+int xevd_async_stop(XEVD id)
+{
+    XEVD_CTX       * ctx;
+    XEVD_ASYNC_CTX * a;
+    XEVD_ASYNC_IN  * in;
+    int              ret, res;
+
+    XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
+    a = ctx->async;
+    xevd_assert_rv(a != NULL, XEVD_ERR_UNEXPECTED);
+
+    /* the driver thread skips the queued NAL units and drops its pictures
+       from now on. dropping the queued ones unblocks it */
+    xevd_threadsafe_assign(&a->abort, 1);
+    async_drop(a);
+
+    if(!a->eos)
+    {
+        xevd_progress_wait(&a->in_rd, a->in_wr - a->cfg.in_cnt + 1, NULL);
+        in = a->in + ASYNC_SLOT(a->cfg.in_cnt, a->in_wr);
+        in->size = -1;
+        a->eos = 1;
+        xevd_threadsafe_assign(&a->in_wr, a->in_wr + 1);
+    }
+    a->tc.join(a->thread, &res);
+    a->tc.release(&a->thread);
+    xevd_dinit_thread_controller(&a->tc);
+    async_drop(a);
+
+    ret = a->ret;
+    ctx->async = NULL;
+    async_free(a);
+    return ret;
+}
@@ -0,0 +1,70 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _XEVD_ASYNC_H_
+#define _XEVD_ASYNC_H_
+
+/* NAL unit waiting in the input queue. size is -1 for the end of stream */
+typedef struct _XEVD_ASYNC_IN
+{
+    XEVD_BITB               bitb;
+    u8                    * buf;
+    int                     buf_size;
+    int                     size;
+} XEVD_ASYNC_IN;
+
+/* state of xevd_async_start(). in_xxx and out_xxx are monotonic counters of
+   queue slots: xxx_wr is advanced by the producer and xxx_rd by the consumer
+   only */
+typedef struct _XEVD_ASYNC_CTX
+{
+    XEVD_ASYNC              cfg;
+    THREAD_CONTROLLER       tc;
+    POOL_THREAD             thread;
+    XEVD_ASYNC_IN         * in;
+    XEVD_IMGB            ** out;
+    volatile int            in_wr;
+    volatile int            in_rd;
+    volatile int            out_wr;
+    volatile int            out_rd;
+    /* advanced by the driver thread whenever it frees an input slot or
+       queues an output picture */
+    volatile int            seq;
+    /* set by xevd_async_stop() */
+    volatile int            abort;
+    /* end of stream submitted */
+    int                     eos;
+    /* end of stream returned by xevd_receive() */
+    int                     out_eos;
+    /* first error of decoding */
+    volatile int            ret;
+} XEVD_ASYNC_CTX;
+
+#endif /* _XEVD_ASYNC_H_ */
@@ -49,8 +49,8 @@ void xevd_bsr_init(XEVD_BSR * bs, u8 * buf, int size, XEVD_BSR_FN_FLUSH fn_flush
 
 int xevd_bsr_flush(XEVD_BSR * bs, int byte)
 {
-    int    shift = 24, remained;
-    u32 code = 0;
+    int    shift = 56, remained;
+    u64 code = 0;
 
     xevd_assert(byte);
 
@@ -69,7 +69,7 @@ int xevd_bsr_flush(XEVD_BSR * bs, int byte)
     bs->cur += byte;
     while(byte)
     {
-        code |= *(bs->cur - byte) << shift;
+        code |= (u64)*(bs->cur - byte) << shift;
         byte--;
         shift -= 8;
     }
@@ -77,15 +77,15 @@ int xevd_bsr_flush(XEVD_BSR * bs, int byte)
     return 0;
 }
 
-int xevd_bsr_clz_in_code(u32 code)
+int xevd_bsr_clz_in_code(u64 code)
 {
     int clz, bits4, shift;
 
-    if(code == 0) return 32; /* to protect infinite loop */
+    if(code == 0) return 64; /* to protect infinite loop */
 
     bits4 = 0;
     clz = 0;
-    shift = 28;
+    shift = 60;
 
     while(bits4 == 0 && shift >= 0)
     {
@@ -105,17 +105,17 @@ void xevd_bsr_read_trace(XEVD_BSR * bs, u32 * val, char * name, int size)
 
     if (bs->leftbits < size)
     {
-        code = bs->code >> (32 - size);
+        code = (u32)(bs->code >> (64 - size));
         size -= bs->leftbits;
 
-        if (bs->fn_flush(bs, 4))
+        if (bs->fn_flush(bs, 8))
         {
             xevd_trace("already reached the end of bitstream\n");
             *val = (u32)-1;
             return;
         }
     }
-    code |= bs->code >> (32 - size);
+    code |= (u32)(bs->code >> (64 - size));
 
     XEVD_BSR_SKIP_CODE(bs, size);
 
@@ -135,13 +135,13 @@ void xevd_bsr_read1_trace(XEVD_BSR * bs, u32 * val, char * name)
     int code;
     if (bs->leftbits == 0)
     {
-        if (bs->fn_flush(bs, 4))
+        if (bs->fn_flush(bs, 8))
         {
             xevd_trace("already reached the end of bitstream\n");
             return;
         }
     }
-    code = (int)(bs->code >> 31);
+    code = (int)(bs->code >> 63);
 
     bs->code <<= 1;
     bs->leftbits -= 1;
@@ -159,7 +159,7 @@ void xevd_bsr_read_ue_trace(XEVD_BSR * bs, u32 * val, char * name)
 {
     int clz, len;
 
-    if ((bs->code >> 31) == 1)
+    if ((bs->code >> 63) == 1)
     {
         /* early termination.
         we don't have to worry about leftbits == 0 case, because if the bs->code
@@ -182,7 +182,7 @@ void xevd_bsr_read_ue_trace(XEVD_BSR * bs, u32 * val, char * name)
     {
         clz = bs->leftbits;
 
-        bs->fn_flush(bs, 4);
+        bs->fn_flush(bs, 8);
     }
 
     len = xevd_bsr_clz_in_code(bs->code);
@@ -243,17 +243,17 @@ void xevd_bsr_read(XEVD_BSR * bs, u32 * val, int size)
 
     if (bs->leftbits < size)
     {
-        code = bs->code >> (32 - size);
+        code = (u32)(bs->code >> (64 - size));
         size -= bs->leftbits;
 
-        if (bs->fn_flush(bs, 4))
+        if (bs->fn_flush(bs, 8))
         {
             xevd_trace("already reached the end of bitstream\n");
             *val = (u32)-1;
             return;
         }
     }
-    code |= bs->code >> (32 - size);
+    code |= (u32)(bs->code >> (64 - size));
 
     XEVD_BSR_SKIP_CODE(bs, size);
 
@@ -265,13 +265,13 @@ void xevd_bsr_read1(XEVD_BSR * bs, u32 * val)
     int code;
     if (bs->leftbits == 0)
     {
-        if (bs->fn_flush(bs, 4))
+        if (bs->fn_flush(bs, 8))
         {
             xevd_trace("already reached the end of bitstream\n");
             return;
         }
     }
-    code = (int)(bs->code >> 31);
+    code = (int)(bs->code >> 63);
 
     bs->code <<= 1;
     bs->leftbits -= 1;
@@ -283,7 +283,7 @@ void xevd_bsr_read_ue(XEVD_BSR * bs, u32 * val)
 {
     int clz, len;
 
-    if((bs->code >> 31) == 1)
+    if((bs->code >> 63) == 1)
     {
         /* early termination.
         we don't have to worry about leftbits == 0 case, because if the bs->code
@@ -299,7 +299,7 @@ void xevd_bsr_read_ue(XEVD_BSR * bs, u32 * val)
     {
         clz = bs->leftbits;
 
-        bs->fn_flush(bs, 4);
+        bs->fn_flush(bs, 8);
     }
 
     len = xevd_bsr_clz_in_code(bs->code);
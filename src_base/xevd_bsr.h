@@ -39,8 +39,8 @@ typedef int (*XEVD_BSR_FN_FLUSH)(XEVD_BSR *bs, int byte);
 
 struct _XEVD_BSR
 {
-    /* temporary read code buffer */
-    u32                code;
+    /* temporary read code buffer (MSB aligned, up to 8 bytes) */
+    u64                code;
     /* left bits count in code */
     int                leftbits;
     /*! address of current bitstream position */
@@ -59,10 +59,10 @@ struct _XEVD_BSR
     void             * pdata[4];
 };
 
+/* size is 32 at most, so the 64-bit code can always be shifted */
 #define XEVD_BSR_SKIP_CODE(bs, size) \
     xevd_assert((bs)->leftbits >= (size)); \
-    if((size) == 32) {(bs)->code = 0; (bs)->leftbits = 0;} \
-    else           {(bs)->code <<= (size); (bs)->leftbits -= (size);}
+    (bs)->code <<= (size); (bs)->leftbits -= (size);
 
 /*! Is bitstream byte aligned? */
 #define XEVD_BSR_IS_BYTE_ALIGN(bs) ((((bs)->leftbits & 0x7) == 0) ? 1: 0)
@@ -72,7 +72,7 @@ struct _XEVD_BSR
 
 void xevd_bsr_init(XEVD_BSR * bs, u8 * buf, int size, XEVD_BSR_FN_FLUSH fn_flush);
 int xevd_bsr_flush(XEVD_BSR * bs, int byte);
-int xevd_bsr_clz_in_code(u32 code);
+int xevd_bsr_clz_in_code(u64 code);
 #if TRACE_HLS
 #define xevd_bsr_read(A, B, C) xevd_bsr_read_trace(A, B, #B, C)
 void xevd_bsr_read_trace(XEVD_BSR * bs, u32 * val, char * name, int size);
@@ -92,4 +92,25 @@ void xevd_bsr_read_ue(XEVD_BSR * bs, u32 * val);
 void xevd_bsr_read_se(XEVD_BSR * bs, s32 * val);
 #endif
 
+/* read size (1 ~ 32) bits; no function call is made while the bits are in
+   the code, which suits the renormalization of the arithmetic decoder */
+static __inline u32 xevd_bsr_read_bits(XEVD_BSR * bs, int size)
+{
+    u32 code;
+
+    if(bs->leftbits < size)
+    {
+#if TRACE_HLS
+        xevd_bsr_read_trace(bs, &code, 0, size);
+#else
+        xevd_bsr_read(bs, &code, size);
+#endif
+        return code;
+    }
+    code = (u32)(bs->code >> (64 - size));
+    bs->code <<= size;
+    bs->leftbits -= size;
+    return code;
+}
+
 #endif /* _XEVD_BSR_H_ */
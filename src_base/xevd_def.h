@@ -157,7 +157,11 @@ extern int fp_trace_started;
 /* For debugging (END) */
 
 #define PEL2BYTE(pel,cs)                      ((pel)*(((XEVD_CS_GET_BIT_DEPTH(cs)) + 7)>>3))
+#if XEVD_PEL_8BIT
+#define STRIDE_IMGB2PIC(s_imgb)            (s_imgb)
+#else
 #define STRIDE_IMGB2PIC(s_imgb)            ((s_imgb)>>1)
+#endif
 
 #define Y_C                                0  /* Y luma */
 #define U_C                                1  /* Cb Chroma */
@@ -210,6 +214,11 @@ extern int fp_trace_started;
 
 #define PIC_PAD_SIZE_L                     (MAX_CU_SIZE + 16)
 #define PIC_PAD_SIZE_C                     (PIC_PAD_SIZE_L >> 1)
+/* border allocated around pictures that are not padded: motion compensation
+   emulates the picture edges, so it only covers the over-read of the SIMD
+   interpolation kernels */
+#define PIC_GUARD_SIZE_L                   16
+#define PIC_GUARD_SIZE_C                   (PIC_GUARD_SIZE_L >> 1)
 
 /* number of MVP candidates */
 #if INCREASE_MVP_NUM
@@ -233,6 +242,13 @@ extern int fp_trace_started;
 #define MAX_NUM_TILES_ROW                  22
 #define MAX_NUM_TILES_COL                  20
 
+/* u64 counters per thread in XEVD_CTX.perf_cycles (XEVD_TL_NUM, padded) */
+#define XEVD_PERF_ROW                      16
+
+/* bits of XEVD_CTX.perf_on */
+#define XEVD_PERF_COUNT                    1 /* XEVD_CFG_SET_PERF_STATS */
+#define XEVD_PERF_TL                    2 /* XEVD_CFG_SET_TIMELINE */
+
 /* Neighboring block availability flag bits */
 #define AVAIL_BIT_UP                       0
 #define AVAIL_BIT_LE                       1
@@ -362,6 +378,29 @@ typedef void(*XEVD_ITXB)(void* coef, void* t, int shift, int line, int step);
 
 typedef void(*XEVD_DBK)(pel *buf, int st, int stride, int bit_depth_minus8, int chroma_format_idc);
 typedef void(*XEVD_DBK_CH)(pel *u, pel *v, int st_u, int st_v, int stride, int bit_depth_minus8, int chroma_format_idc);
+
+/*****************************************************************************
+* Motion compensation
+*****************************************************************************/
+/* coef: interpolation filter table, the taps of fractional phase f being
+   MC_L_COEF(coef, f) or MC_C_COEF(coef, f) */
+typedef void(*XEVD_MC_L) (pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef);
+typedef void(*XEVD_MC_C) (pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef);
+typedef void (*XEVD_AVG_NO_CLIP)(pel *src, pel *ref, pel *dst, int s_src, int s_ref, int s_dst, int wd, int ht, int bit_depth);
+
+/*****************************************************************************
+* Output conversion
+*****************************************************************************/
+/* converts a row of w samples to clip((s + rnd) >> shr, 0, max) << shl; the
+   UV kernels interleave the samples of u and v, the others ignore v */
+typedef void(*XEVD_OUT)(pel *u, pel *v, void *dst, int w, int shr, int shl, int max);
+#define XEVD_OUT_8B                       0
+#define XEVD_OUT_16B                      1
+#define XEVD_OUT_UV_8B                    2
+#define XEVD_OUT_UV_16B                   3
+#define XEVD_OUT_NUM                      4
+/* number of converted output pictures kept for reuse */
+#define XEVD_OUT_POOL_SIZE                8
 /*****************************************************************************
  * reference index
  *****************************************************************************/
@@ -701,7 +740,8 @@ struct _PICBUF_ALLOCATOR
     /* arbitrary address, if needs */
     void            *pdata[4];
     int              idc;
-
+    /* allocator of the sample planes given by the application, if any */
+    const XEVD_IMGB_ALLOC *imgb_alloc;
 };
 
 /*****************************************************************************
@@ -1185,7 +1225,13 @@ typedef struct _XEVD_CU_DATA
     u8  *ats_inter_info;
     u32 *map_cu_mode;
     s8  *depth;
-    s16 *coef[N_C];
+    /* nonzero coefficients of the CUs in this LCU; each CU component is
+       stored at coef_ofs[c][cup] as a count followed by (position, level)
+       pairs, and coef_ofs is -1 when the component has no coefficient */
+    s16 *coef;
+    int  coef_size;
+    int  coef_cnt;
+    int *coef_ofs[N_C];
     pel *reco[N_C];
 } XEVD_CU_DATA;
 
@@ -1198,16 +1244,30 @@ typedef struct _XEVD_TIME_STAMP
 
 #include "xevd_bsr.h"
 
+/* per-thread CU scratch buffers, owned by one core and never copied */
+typedef struct _XEVD_CORE_BUF
+{
+    s16            coef[N_C][MAX_CU_DIM];
+    pel            pred[2][N_C][MAX_CU_DIM];
+    pel            nb[N_C][N_REF][MAX_CU_SIZE * 3];
+    s16            eif_tmp_buffer[(MAX_CU_SIZE + 2) * (MAX_CU_SIZE + 2)];
+} XEVD_CORE_BUF;
+
+/* scratch buffers follow the core in its allocation, cache line aligned */
+#define XEVD_CORE_BUF_OFS(type)  ((int)((sizeof(type) + 63) & ~63))
+
 typedef struct _XEVD_CORE
 {
     /************** current CU **************/
+    /* scratch buffers of this core */
+    XEVD_CORE_BUF *buf;
     /* coefficient buffer of current CU */
-    s16            coef[N_C][MAX_CU_DIM];
+    s16         (* coef)[MAX_CU_DIM];
     /* pred buffer of current CU */
     /* [1] is used for bi-pred. */
-    pel            pred[2][N_C][MAX_CU_DIM];
+    pel         (* pred)[N_C][MAX_CU_DIM];
     /* neighbor pixel buffer for intra prediction */
-    pel            nb[N_C][N_REF][MAX_CU_SIZE * 3];
+    pel         (* nb)[N_REF][MAX_CU_SIZE * 3];
     /* reference index for current CU */
     s8             refi[REFP_NUM];
     /* motion vector for current CU */
@@ -1267,7 +1327,7 @@ typedef struct _XEVD_CORE
     void          *pf;
 
     /* temporal pixel buffer for inter prediction */
-    pel            eif_tmp_buffer[ (MAX_CU_SIZE + 2) * (MAX_CU_SIZE + 2) ];
+    s16          * eif_tmp_buffer;
     u8             mvr_idx;
     /* history-based motion vector prediction candidate list */
     XEVD_HISTORY_BUFFER     history_buffer;
@@ -1283,6 +1343,12 @@ typedef struct _XEVD_CORE
     XEVD_BSR      * bs;
     XEVD_SBAC    * sbac;
     XEVD_CTX     * ctx;
+    /* slice being decoded: header, reference picture lists, number of
+       reference pictures in the lists and slice number */
+    XEVD_SH       * sh;
+    XEVD_REFP    (* refp)[REFP_NUM];
+    u8            * num_refp;
+    int            slice_num;
     u8             skip_flag;
     int            cuw, cuh;
     u16            x;
@@ -1404,6 +1470,10 @@ struct _XEVD_CTX
     int                     ref_pic_gap_length;
     /* picture buffer allocator */
     PICBUF_ALLOCATOR        pa;
+    /* border of valid padded samples around reference pictures (luma and
+       chroma); 0 when the DPB is not padded */
+    int                     ref_pad_l;
+    int                     ref_pad_c;
     /* bitstream has an error? */
     u8                      bs_err;
     /* reference picture (0: foward, 1: backward) */
@@ -1442,6 +1512,30 @@ struct _XEVD_CTX
     int                     parallel_rows; //Number of parallel rows which can be encoded
     volatile s32          * sync_flag;
     volatile s32          * sync_row;
+    /* time each worker spent blocked in xevd_spinlock_wait/xevd_progress_wait */
+    u64                     wait_cycles[XEVD_MAX_TASK_CNT];
+    /* time spent in xevd_decode() */
+    u64                     dec_cycles;
+    /* per-stage counters of XEVD_CFG_GET_PERF_STATS, collected when perf_on
+       has XEVD_PERF_COUNT. each thread adds to its own row, padded to a cache
+       line pair */
+    int                     perf_on;
+    int                     perf_pics;
+    u64                     perf_cycles[XEVD_MAX_TASK_CNT][XEVD_PERF_ROW];
+    /* sums of perf_cycles when the last picture was completed */
+    u64                     perf_pic_beg[XEVD_PERF_NUM];
+    u64                     perf_pic[XEVD_PERF_NUM];
+    /* wait and join cycles when the counters were reset */
+    u64                     perf_wait_beg[XEVD_MAX_TASK_CNT];
+    u64                     perf_join_beg[XEVD_MAX_TASK_CNT];
+    /* timeline events of XEVD_CFG_SET_TIMELINE, recorded when perf_on has
+       XEVD_PERF_TL: one ring per thread */
+    struct _XEVD_TL_RING  * tl_ring;
+    XEVD_TIMELINE           tl;
+    u64                     tl_cycles0;
+    u64                     tl_nsec0;
+    /* state of xevd_async_start(), NULL when not running */
+    struct _XEVD_ASYNC_CTX * async;
     SYNC_OBJ                sync_block; //has to be initialized at context creation and has to be released on context destruction
     /* mximum number of coding delay */
     s32                     max_coding_delay;
@@ -1464,8 +1558,20 @@ struct _XEVD_CTX
     void (* fn_picbuf_expand)(XEVD_CTX * ctx, XEVD_PIC * pic);
     const XEVD_ITXB ( * fn_itxb)[MAX_TR_LOG2];
     void  ( * fn_recon) (s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec,int bit_depth);
+    void  ( * fn_ipred_ang)(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int ipm, int bit_depth);
+    void  ( * fn_ipred_bi)(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth);
+    void  ( * fn_ipred_plane)(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth);
     const XEVD_DBK (*fn_dbk)[2];
     const XEVD_DBK_CH(*fn_dbk_chroma)[2];
+    XEVD_MC_L            (*fn_mc_l)[2];
+    XEVD_MC_C            (*fn_mc_c)[2];
+    /* interpolation filter tables of the active SPS, given to fn_mc_l/c */
+    const s16             * mc_l_coef;
+    const s16             * mc_c_coef;
+    XEVD_AVG_NO_CLIP        fn_average_no_clip;
+    const XEVD_OUT        (*fn_out)[XEVD_OUT_NUM];
+    /* instruction set of the kernels above (XEVD_ISA_XXX) */
+    int                     isa;
     /* platform specific data, if needed */
     void                  * pf;
 
@@ -1477,6 +1583,10 @@ struct _XEVD_CTX
     int                     sei_pend_size;
     int                     sei_pend_cap;
     int                     sei_pend_num;
+    /* pictures converted to cdsc.out_cs, and a row of mapped samples */
+    XEVD_IMGB             * out_pool[XEVD_OUT_POOL_SIZE];
+    pel                   * out_row;
+    int                     out_row_size;
 };
 
 
@@ -1492,6 +1602,8 @@ int  xevd_dec_slice(XEVD_CTX * ctx, XEVD_CORE * core);
 
 
 #include "xevd_util.h"
+#include "xevd_timeline.h"
+#include "xevd_async.h"
 #include "xevd_eco.h"
 #include "xevd_picman.h"
 
@@ -1505,13 +1617,17 @@ int  xevd_dec_slice(XEVD_CTX * ctx, XEVD_CORE * core);
 #include "xevd_mc.h"
 #include "xevd_eco.h"
 #include "xevd_df.h"
+#include "xevd_out.h"
 #if defined(X86)
 #include "xevd_mc_sse.h"
 #include "xevd_mc_avx.h"
+#include "xevd_out_sse.h"
+#include "xevd_out_avx.h"
 #include "xevd_itdq_sse.h"
 #include "xevd_itdq_avx.h"
 #include "xevd_recon_avx.h"
 #include "xevd_recon_sse.h"
+#include "xevd_ipred_sse.h"
 #include "xevd_dbk_sse.h"
 #elif defined(ARM)
 #include "xevd_mc_neon.h"
@@ -32,6 +32,14 @@
 #include "xevd_tbl.h"
 #include <math.h>
 
+/* shifts renormalizing a range below 8192, indexed by (range >> 8); the range
+   never drops below 256 since the LPS range is clipped to 437 at least */
+static const u8 tbl_sbac_renorm_shift[32] =
+{
+    5, 5, 4, 4, 3, 3, 3, 3, 2, 2, 2, 2, 2, 2, 2, 2,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+};
+
 u32 xevd_sbac_decode_bin(XEVD_BSR * bs, XEVD_SBAC * sbac, SBAC_CTX_MODEL * model)
 {
     u32 bin, lps, t0;
@@ -79,15 +87,11 @@ u32 xevd_sbac_decode_bin(XEVD_BSR * bs, XEVD_SBAC * sbac, SBAC_CTX_MODEL * model
         *model = (state << 1) + mps;
     }
 
-    while(sbac->range < 8192)
+    if(sbac->range < 8192)
     {
-        sbac->range <<= 1;
-#if TRACE_HLS
-        xevd_bsr_read1_trace(bs, &t0, 0);
-#else
-        xevd_bsr_read1(bs, &t0);
-#endif
-        sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
+        t0 = tbl_sbac_renorm_shift[sbac->range >> 8];
+        sbac->range <<= t0;
+        sbac->value = ((sbac->value << t0) | xevd_bsr_read_bits(bs, t0)) & 0xFFFF;
     }
 
     return bin;
@@ -95,7 +99,7 @@ u32 xevd_sbac_decode_bin(XEVD_BSR * bs, XEVD_SBAC * sbac, SBAC_CTX_MODEL * model
 
 static u32 sbac_decode_bin_ep(XEVD_BSR * bs, XEVD_SBAC * sbac)
 {
-    u32 bin, t0;
+    u32 bin;
 
     sbac->range >>= 1;
 
@@ -110,12 +114,7 @@ static u32 sbac_decode_bin_ep(XEVD_BSR * bs, XEVD_SBAC * sbac)
     }
 
     sbac->range <<= 1;
-#if TRACE_HLS
-    xevd_bsr_read1_trace(bs, &t0, 0);
-#else
-    xevd_bsr_read1(bs, &t0);
-#endif
-    sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
+    sbac->value = ((sbac->value << 1) | xevd_bsr_read_bits(bs, 1)) & 0xFFFF;
 
     return bin;
 }
@@ -148,60 +147,135 @@ u32 xevd_sbac_decode_bin_trm(XEVD_BSR * bs, XEVD_SBAC * sbac)
     else
     {
         bin = 0;
-        while(sbac->range < 8192)
+        if(sbac->range < 8192)
         {
-            sbac->range <<= 1;
-#if TRACE_HLS
-            xevd_bsr_read1_trace(bs, &t0, 0);
-#else
-            xevd_bsr_read1(bs, &t0);
-#endif
-            sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
+            t0 = tbl_sbac_renorm_shift[sbac->range >> 8];
+            sbac->range <<= t0;
+            sbac->value = ((sbac->value << t0) | xevd_bsr_read_bits(bs, t0)) & 0xFFFF;
         }
     }
 
     return bin;
 }
 
-static u32 sbac_read_unary_sym_ep(XEVD_BSR * bs, XEVD_SBAC * sbac, u32 max_val)
+/* Bypass bins keep range/2 as divisor, so n bins are a long division of
+   (value << n | next n bits) by (range/2 << n) done with compare and subtract */
+u32 xevd_sbac_decode_bins_ep(XEVD_BSR *bs, XEVD_SBAC *sbac, int num_bin)
 {
-    u32 t32u;
-    u32 symbol;
-    int counter = 0;
+    u32 r, v, scaled, bins = 0;
+    int n;
 
-    symbol = sbac_decode_bin_ep(bs, sbac); counter++;
+    if(num_bin <= 0)
+    {
+        return 0;
+    }
 
-    if(symbol == 0)
+    if(sbac->value >= (sbac->range & ~1))
     {
-        return symbol;
+        /* out of interval (corrupted stream), keep the per-bin result */
+        while(num_bin--)
+        {
+            bins = (bins << 1) | sbac_decode_bin_ep(bs, sbac);
+        }
+        return bins;
     }
 
-    symbol = 0;
-    do
+    r = sbac->range >> 1;
+    v = sbac->value;
+    sbac->range = r << 1;
+
+    while(num_bin > 0)
     {
-        if(counter == (int)max_val) t32u = 0;
-        else t32u = sbac_decode_bin_ep(bs, sbac);
-        counter++;
-        symbol++;
-    } while(t32u);
+        n = XEVD_MIN(num_bin, 16);
+        v = (v << n) | (xevd_bsr_read_bits(bs, n) & ((1 << n) - 1));
+        scaled = r << n;
+        num_bin -= n;
 
-    return symbol;
+        while(n--)
+        {
+            bins <<= 1;
+            if(v >= scaled)
+            {
+                v -= scaled;
+                bins |= 1;
+            }
+            scaled >>= 1;
+        }
+    }
+    sbac->value = v;
+
+    return bins;
 }
 
-static u32 sbac_decode_bins_ep(XEVD_BSR *bs, XEVD_SBAC *sbac, int num_bin)
+/* Counts bypass bins until one equal to term (consumed) or max bins.
+   Bits are peeked from the bitstream cache and only used ones are skipped */
+u32 xevd_sbac_decode_unary_ep(XEVD_BSR *bs, XEVD_SBAC *sbac, u32 term, u32 max)
 {
-    int bin = 0;
-    u32 value = 0;
+    u32 r, v, scaled, bin, cnt = 0;
+    int n, k, peek;
+
+    if(max == 0)
+    {
+        return 0;
+    }
+
+    if(sbac->value >= (sbac->range & ~1))
+    {
+        /* out of interval (corrupted stream), keep the per-bin result */
+        while(sbac_decode_bin_ep(bs, sbac) != term && ++cnt < max);
+        return cnt;
+    }
+
+    r = sbac->range >> 1;
+    v = sbac->value;
+    sbac->range = r << 1;
 
-    for(bin = num_bin - 1; bin >= 0; bin--)
+    while(1)
     {
-        if(sbac_decode_bin_ep(bs, sbac))
+        n = XEVD_MIN(bs->leftbits, 16);
+        if((u32)n > max - cnt) n = (int)(max - cnt);
+
+        peek = n > 0;
+        if(peek)
+        {
+            v = (v << n) | (u32)(bs->code >> (64 - n));
+        }
+        else
+        {
+            n = 1;
+            v = (v << 1) | (xevd_bsr_read_bits(bs, 1) & 1);
+        }
+        scaled = r << n;
+
+        for(k = 1; k <= n; k++)
         {
-            value += (1 << bin);
+            bin = v >= scaled;
+            if(bin) v -= scaled;
+            scaled >>= 1;
+
+            if(bin == term || ++cnt == max)
+            {
+                break;
+            }
+        }
+
+        if(k <= n)
+        {
+            v >>= n - k;
+            if(peek)
+            {
+                XEVD_BSR_SKIP_CODE(bs, k);
+            }
+            break;
+        }
+        if(peek)
+        {
+            XEVD_BSR_SKIP_CODE(bs, n);
         }
     }
+    sbac->value = v;
 
-    return value;
+    return cnt;
 }
 
 static u32 sbac_read_unary_sym(XEVD_BSR * bs, XEVD_SBAC * sbac, SBAC_CTX_MODEL * model, u32 num_ctx)
@@ -445,12 +519,9 @@ int xevd_eco_refi(XEVD_BSR * bs, XEVD_SBAC * sbac, int num_refp)
             if(num_refp > 2 && xevd_sbac_decode_bin(bs, sbac, c->refi + 1))
             {
                 ref_num++;
-                for(; ref_num < num_refp - 1; ref_num++)
+                if(ref_num < num_refp - 1)
                 {
-                    if(!sbac_decode_bin_ep(bs, sbac))
-                    {
-                        break;
-                    }
+                    ref_num += xevd_sbac_decode_unary_ep(bs, sbac, 0, num_refp - 1 - ref_num);
                 }
                 return ref_num;
             }
@@ -529,26 +600,15 @@ static u32 xevd_eco_abs_mvd(XEVD_BSR *bs, XEVD_SBAC *sbac, SBAC_CTX_MODEL *model
 
     if(code == 0)
     {
-        len = 0;
-
-        while(!(code & 1))
+        len = 1;
+        code = xevd_sbac_decode_bin(bs, sbac, model);
+        if(!code)
         {
-            if(len == 0)
-                code = xevd_sbac_decode_bin(bs, sbac, model);
-            else
-                code = sbac_decode_bin_ep(bs, sbac);
-            len++;
+            /* zeros up to and including the terminating one */
+            len += xevd_sbac_decode_unary_ep(bs, sbac, 1, (u32)-1) + 1;
         }
         val = (1 << len) - 1;
-
-        while(len != 0)
-        {
-            if(len == 0)
-                code = xevd_sbac_decode_bin(bs, sbac, model);
-            else
-                code = sbac_decode_bin_ep(bs, sbac);
-            val += (code << (--len));
-        }
+        val += xevd_sbac_decode_bins_ep(bs, sbac, len);
     }
 
     return val;
@@ -743,7 +803,6 @@ int xevd_eco_coef(XEVD_CTX * ctx, XEVD_CORE * core)
 void xevd_eco_sbac_reset(XEVD_BSR * bs, u8 slice_type, u8 slice_qp)
 {
     int i;
-    u32 t0;
     XEVD_SBAC    * sbac;
     XEVD_SBAC_CTX * sbac_ctx;
 
@@ -752,16 +811,7 @@ void xevd_eco_sbac_reset(XEVD_BSR * bs, u8 slice_type, u8 slice_qp)
 
     /* Initialization of the internal variables */
     sbac->range = 16384;
-    sbac->value = 0;
-    for(i = 0; i < 14; i++)
-    {
-#if TRACE_HLS
-        xevd_bsr_read1_trace(bs, &t0, 0);
-#else
-        xevd_bsr_read1(bs, &t0);
-#endif
-        sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
-    }
+    sbac->value = xevd_bsr_read_bits(bs, 14);
 
     xevd_mset(sbac_ctx, 0x00, sizeof(XEVD_SBAC_CTX));
 
@@ -802,10 +852,10 @@ static int intra_mode_read_trunc_binary(int max_symbol, XEVD_SBAC * sbac, XEVD_B
 
     b = max_symbol - val;
     assert(b < val);
-    ipm = sbac_decode_bins_ep(bs, sbac, threshold);
+    ipm = xevd_sbac_decode_bins_ep(bs, sbac, threshold);
     if(ipm >= val - b)
     {
-        t0 = sbac_decode_bins_ep(bs, sbac, 1);
+        t0 = xevd_sbac_decode_bins_ep(bs, sbac, 1);
         ipm <<= 1;
         ipm += t0;
         ipm -= (val - b);
@@ -859,7 +909,7 @@ int xevd_eco_intra_dir(XEVD_BSR * bs, XEVD_SBAC * sbac, u8 mpm[2], u8 mpm_ext[8]
         if(pims_flag)
         {
             int pims_idx;
-            pims_idx = sbac_decode_bins_ep(bs, sbac, 3); /* intra_luma_pred_pims_idx */
+            pims_idx = xevd_sbac_decode_bins_ep(bs, sbac, 3); /* intra_luma_pred_pims_idx */
             ipm = mpm_ext[pims_idx];
         }
         else
@@ -892,7 +942,7 @@ int xevd_eco_intra_dir_c(XEVD_BSR * bs, XEVD_SBAC * sbac, u8 ipm_l)
     t0 = xevd_sbac_decode_bin(bs, sbac, sbac->ctx.intra_chroma_pred_mode);
     if(t0 == 0)
     {
-        ipm = sbac_read_unary_sym_ep(bs, sbac, IPD_CHROMA_CNT - 1);
+        ipm = xevd_sbac_decode_unary_ep(bs, sbac, 0, IPD_CHROMA_CNT - 1);
         ipm++;
         if(chk_bypass &&  ipm >= ipm_l) ipm++;
     }
@@ -38,6 +38,8 @@
 
 u32  xevd_sbac_decode_bin(XEVD_BSR *bs, XEVD_SBAC *sbac, SBAC_CTX_MODEL *model);
 u32  xevd_sbac_decode_bin_trm(XEVD_BSR *bs, XEVD_SBAC *sbac);
+u32  xevd_sbac_decode_bins_ep(XEVD_BSR *bs, XEVD_SBAC *sbac, int num_bin);
+u32  xevd_sbac_decode_unary_ep(XEVD_BSR *bs, XEVD_SBAC *sbac, u32 term, u32 max);
 int  xevd_eco_nalu(XEVD_BSR * bs, XEVD_NALU * nalu);
 int  xevd_eco_sps(XEVD_BSR * bs, XEVD_SPS * sps);
 int  xevd_eco_pps(XEVD_BSR * bs, XEVD_SPS * sps, XEVD_PPS * pps);
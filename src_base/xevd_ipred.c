@@ -66,7 +66,7 @@ void xevd_get_nbr_b(int x, int y, int cuw, int cuh, pel *src, int s_src, u16 ava
         }
         else
         {
-            xevd_mset_16b(up + i * unit_size, 1 << (bit_depth - 1), unit_size);
+            xevd_mset_pel(up + i * unit_size, 1 << (bit_depth - 1), unit_size);
         }
     }
 
@@ -85,7 +85,7 @@ void xevd_get_nbr_b(int x, int y, int cuw, int cuh, pel *src, int s_src, u16 ava
         }
         else
         {
-            xevd_mset_16b(left + i * unit_size, 1 << (bit_depth - 1), unit_size);
+            xevd_mset_pel(left + i * unit_size, 1 << (bit_depth - 1), unit_size);
             src += (s_src * unit_size);
         }
     }
@@ -160,9 +160,7 @@ void ipred_dc_b(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, i
     }
 }
 
-void xevd_ipred_plane(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h
-    , int bit_depth
-)
+void xevd_ipred_plane_param(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, int w, int h, int *base, int *grad_x, int *grad_y)
 {
     pel *rsrc;
     int  coef_h = 0, coef_v = 0;
@@ -173,7 +171,7 @@ void xevd_ipred_plane(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *
     int  ib_shift[6] = {7, 10, 11, 15, 19, 23};
     int  idx_w = xevd_tbl_log2[w] < 2 ? 0 : xevd_tbl_log2[w] - 2;
     int  idx_h = xevd_tbl_log2[h] < 2 ? 0 : xevd_tbl_log2[h] - 2;
-    int  im_h, is_h, im_v, is_v, temp, temp2;
+    int  im_h, is_h, im_v, is_v;
 
     im_h = ib_mult[idx_w];
     is_h = ib_shift[idx_w];
@@ -195,23 +193,6 @@ void xevd_ipred_plane(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *
         }
 
         a = (src_ri[h - 1] + src_up[0]) << 4;
-        b = ((coef_h << 5) * im_h + (1 << (is_h - 1))) >> is_h;
-        c = ((coef_v << 5) * im_v + (1 << (is_v - 1))) >> is_v;
-
-        temp = a - (h2 - 1) * c - (w2 - 1) * b + 16;
-
-        for(y = 0; y < h; y++)
-        {
-            temp2 = temp;
-            for(x = w - 1; x >= 0; x--)
-            {
-
-                dst[x] = XEVD_CLIP3(0, (1 << bit_depth) - 1, temp2 >> 5);
-
-                temp2 += b;
-            }
-            temp += c; dst += w;
-        }
     }
     else
     {
@@ -228,11 +209,41 @@ void xevd_ipred_plane(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *
         }
 
         a = (src_le[h - 1] + src_up[w - 1]) << 4;
-        b = ((coef_h << 5) * im_h + (1 << (is_h - 1))) >> is_h;
-        c = ((coef_v << 5) * im_v + (1 << (is_v - 1))) >> is_v;
+    }
+    b = ((coef_h << 5) * im_h + (1 << (is_h - 1))) >> is_h;
+    c = ((coef_v << 5) * im_v + (1 << (is_v - 1))) >> is_v;
 
-        temp = a - (h2 - 1) * c - (w2 - 1) * b + 16;
+    *base = a - (h2 - 1) * c - (w2 - 1) * b + 16;
+    *grad_x = b;
+    *grad_y = c;
+}
 
+void xevd_ipred_plane(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h
+    , int bit_depth
+)
+{
+    int  b, c, x, y;
+    int  temp, temp2;
+
+    xevd_ipred_plane_param(src_le, src_up, src_ri, avail_lr, w, h, &temp, &b, &c);
+
+    if(avail_lr == LR_01 || avail_lr == LR_11)
+    {
+        for(y = 0; y < h; y++)
+        {
+            temp2 = temp;
+            for(x = w - 1; x >= 0; x--)
+            {
+
+                dst[x] = XEVD_CLIP3(0, (1 << bit_depth) - 1, temp2 >> 5);
+
+                temp2 += b;
+            }
+            temp += c; dst += w;
+        }
+    }
+    else
+    {
         for(y = 0; y < h; y++)
         {
             temp2 = temp;
@@ -374,7 +385,7 @@ void xevd_ipred_bi(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst
 #define ADI_4T_FILTER_BITS                 7
 #define ADI_4T_FILTER_OFFSET              (1<<(ADI_4T_FILTER_BITS-1))
 
-static __inline pel ipred_ang_val(pel * src_up, pel * src_le, pel * src_ri, u16 avail_lr, int ipm, int i, int j, int w, int pos_min, int pos_max, int h
+pel xevd_ipred_ang_val(pel * src_up, pel * src_le, pel * src_ri, u16 avail_lr, int ipm, int i, int j, int w, int pos_min, int pos_max, int h
     , int bit_depth)
 {
     int offset;
@@ -389,7 +400,7 @@ static __inline pel ipred_ang_val(pel * src_up, pel * src_le, pel * src_ri, u16
     int num_selections = 0;
     int use_x = 0;
     int p, pn, pn_n1, pn_p2;
-    pel temp_pel = 0;
+    s16 temp_pel = 0;
     int refpos = 0; 
 
     x = INT_MAX;
@@ -578,7 +589,92 @@ void ipred_ang(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, in
     {
         for(i = 0; i < w; i++)
         {
-            dst[i] = ipred_ang_val(src_up, src_le, src_ri, avail_lr, ipm, i, j, w, pos_min, pos_max, h, bit_depth);
+            dst[i] = xevd_ipred_ang_val(src_up, src_le, src_ri, avail_lr, ipm, i, j, w, pos_min, pos_max, h, bit_depth);
+        }
+        dst += w;
+    }
+}
+
+void xevd_ipred_ang_seg(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int ipm, int bit_depth, XEVD_IPRED_ANG_RUN fn_run)
+{
+    const int * mt = xevd_tbl_ipred_dxdy[ipm];
+    const int pos_max = w + h - 1;
+    const int pos_min = -1;
+    const int avail_ri = (avail_lr == LR_01 || avail_lr == LR_11);
+    int i, j, n, t, offset;
+
+    if(ipm > IPD_HOR)
+    {
+        pel tmp[MAX_CU_SIZE * MAX_CU_SIZE];
+
+        if(avail_ri)
+        {
+            ipred_ang(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+            return;
+        }
+
+        /* every column takes one filter on the left reference, predict transposed */
+        for(i = 0; i < w; i++)
+        {
+            GET_REF_POS(mt[1], i + 1, t, offset);
+            n = XEVD_MIN(h, pos_max - 1 - t);
+            j = n > 0 ? fn_run(tmp + i * h, src_le + t, 1, xevd_tbl_ipred_adi[offset], n, bit_depth) : 0;
+            for(; j < h; j++)
+            {
+                tmp[i * h + j] = xevd_ipred_ang_val(src_up, src_le, src_ri, avail_lr, ipm, i, j, w, pos_min, pos_max, h, bit_depth);
+            }
+        }
+        for(j = 0; j < h; j++)
+        {
+            for(i = 0; i < w; i++)
+            {
+                dst[i] = tmp[i * h + j];
+            }
+            dst += w;
+        }
+        return;
+    }
+
+    /* the samples of a row taken from the upper reference share one filter */
+    for(j = 0; j < h; j++)
+    {
+        int beg, end, d;
+        pel * src;
+
+        GET_REF_POS(mt[0], j + 1, t, offset);
+        if(ipm < IPD_VER)
+        {
+            beg = 0;
+            end = XEVD_MIN(w, pos_max - 1 - t);
+            if(avail_ri)
+            {
+                end = XEVD_MIN(end, w - t);
+            }
+            src = src_up + t;
+            d = 1;
+        }
+        else
+        {
+            for(beg = t + 1; beg < w; beg++)
+            {
+                if(j < ((beg + 1) * mt[1]) >> 10) break;
+            }
+            end = w;
+            src = src_up - t;
+            d = -1;
+        }
+
+        for(i = 0; i < beg && i < w; i++)
+        {
+            dst[i] = xevd_ipred_ang_val(src_up, src_le, src_ri, avail_lr, ipm, i, j, w, pos_min, pos_max, h, bit_depth);
+        }
+        if(end > beg)
+        {
+            i = beg + fn_run(dst + beg, src + beg, d, xevd_tbl_ipred_adi[offset], end - beg, bit_depth);
+        }
+        for(; i < w; i++)
+        {
+            dst[i] = xevd_ipred_ang_val(src_up, src_le, src_ri, avail_lr, ipm, i, j, w, pos_min, pos_max, h, bit_depth);
         }
         dst += w;
     }
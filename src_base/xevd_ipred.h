@@ -58,6 +58,15 @@ void xevd_get_mpm_b(int x_scu, int y_scu, int cuw, int cuh, u32 * map_scu,u8 *co
 int  xevd_get_dc(const int numerator, const int w, const int h);
 void xevd_ipred_vert(pel *src_le, pel *src_up, pel * src_ri, u16 avail_lr, pel *dst, int w, int h);
 void xevd_ipred_plane(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth);
+/* row 0 start value and per sample gradients of the plane predictor, in 1/32 */
+void xevd_ipred_plane_param(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, int w, int h, int *base, int *grad_x, int *grad_y);
 void xevd_ipred_bi(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int bit_depth);
 void ipred_ang(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int ipm, int bit_depth);
+/* angular prediction of the sample in column i and row j */
+/* filters n samples along a run of the reference, taps at src[-d], src[0], src[d] and src[2d];
+   returns the count done, the remaining ones are predicted per sample */
+typedef int (*XEVD_IPRED_ANG_RUN)(pel *dst, const pel *src, int d, const int *filter, int n, int bit_depth);
+/* angular prediction with the runs sharing one filter handed to fn_run */
+void xevd_ipred_ang_seg(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int ipm, int bit_depth, XEVD_IPRED_ANG_RUN fn_run);
+pel  xevd_ipred_ang_val(pel * src_up, pel * src_le, pel * src_ri, u16 avail_lr, int ipm, int i, int j, int w, int pos_min, int pos_max, int h, int bit_depth);
 #endif /* _XEVD_IPRED_H_ */
@@ -491,6 +491,21 @@ void xevd_dquant(s16 *coef, int log2_w, int log2_h, int scale, s32 offset, u8 sh
 }
 
 
+/* inverse transform of a block whose only nonzero coefficient is DC: every
+   basis starts with 64, so both stages reduce to a single uniform value */
+static void xevd_itrans_dc(s16 *coef, int log2_w, int log2_h, int bit_depth)
+{
+    int i;
+    int shift = ITX_SHIFT1 + ITX_SHIFT2(bit_depth);
+    s64 dc = ((s64)(64 * 64) * coef[0] + (1 << (shift - 1))) >> shift;
+    s16 val = ITX_CLIP(dc);
+
+    for(i = 0; i < (1 << (log2_w + log2_h)); i++)
+    {
+        coef[i] = val;
+    }
+}
+
 void xevd_itdq(XEVD_CTX * ctx, s16 *coef, int log2_w, int log2_h, int scale, int bit_depth)
 {
     s32 offset;
@@ -499,8 +514,6 @@ void xevd_itdq(XEVD_CTX * ctx, s16 *coef, int log2_w, int log2_h, int scale, int
     int log2_size = (log2_w + log2_h) >> 1;
     const int ns_shift = ((log2_w + log2_h) & 1) ? 8 : 0;
 
-    int skip_w = 1 << log2_w;
-    int skip_h = 1 << log2_h;
     int max_x = 0;
     int max_y = 0;
     s16* coef_tmp = coef;
@@ -514,8 +527,7 @@ void xevd_itdq(XEVD_CTX * ctx, s16 *coef, int log2_w, int log2_h, int scale, int
     shift += ns_shift;
     offset = (shift == 0) ? 0 : (1 << (shift - 1));
 
-    xevd_dquant(coef, log2_w, log2_h, scale, offset, shift);
-
+    /* a zero level stays zero after dequantization */
     for (j = 0; j < cuh; j++)
     {
         for (i = 0; i < cuw; i++)
@@ -535,12 +547,17 @@ void xevd_itdq(XEVD_CTX * ctx, s16 *coef, int log2_w, int log2_h, int scale, int
         coef_tmp += cuw;
     }
 
-    skip_w = cuw - 1 - max_x;
-    skip_h = cuh - 1 - max_y;
+    if (max_x == 0 && max_y == 0)
+    {
+        s64 lev = (coef[0] * (scale * (s64)(ns_shift ? 181 : 1)) + offset) >> shift;
+        coef[0] = (s16)XEVD_CLIP(lev, -32768, 32767);
+        xevd_itrans_dc(coef, log2_w, log2_h, bit_depth);
+        return;
+    }
 
+    xevd_dquant(coef, log2_w, log2_h, scale, offset, shift);
     xevd_itrans(ctx, coef, log2_w, log2_h, bit_depth);
 }
-
 void xevd_sub_block_itdq(XEVD_CTX * ctx, s16 coef[N_C][MAX_CU_DIM], int log2_cuw, int log2_cuh, u8 qp_y, u8 qp_u, u8 qp_v, int flag[N_C]
                        , int nnz_sub[N_C][MAX_SUB_TB_NUM], int bit_depth, int chroma_format_idc)
 {
@@ -72,11 +72,6 @@
 
 
 
-XEVD_MC_L (*xevd_func_mc_l)[2];
-XEVD_MC_C (*xevd_func_mc_c)[2];
-XEVD_AVG_NO_CLIP xevd_func_average_no_clip;
-
-
 s16 xevd_tbl_mc_l_coeff[16][8] =
 {
     {  0, 0,   0, 64,  0,   0,  0,  0 },
@@ -134,15 +129,11 @@ s16 xevd_tbl_mc_c_coeff[32][4] =
 };
 
 
-s16 (*tbl_mc_l_coeff)[8] = xevd_tbl_mc_l_coeff;
-s16 (*tbl_mc_c_coeff)[4] = xevd_tbl_mc_c_coeff;
-
-
 /****************************************************************************
  * motion compensation for luma
  ****************************************************************************/
 
-void xevd_average_16b_no_clip(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref, int s_dst, int wd, int ht
+void xevd_average_16b_no_clip(pel *src, pel *ref, pel *dst, int s_src, int s_ref, int s_dst, int wd, int ht
     , int bit_depth
 )
 {
@@ -166,7 +157,7 @@ void xevd_average_16b_no_clip(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref
 }
 
 
-void xevd_mc_l_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_l_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -188,7 +179,7 @@ void xevd_mc_l_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pr
 }
 
 void xevd_mc_l_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h
-,int bit_depth)
+,int bit_depth, const s16 * coef)
 {
     int i, j, dx;
     s32 pt;
@@ -200,7 +191,7 @@ void xevd_mc_l_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pr
     {
         for (j = 0; j < w; j++)
         {
-            pt = MAC_8TAP_N0(tbl_mc_l_coeff[dx], ref[j], ref[j + 1], ref[j + 2], ref[j + 3], ref[j + 4], ref[j + 5], ref[j + 6], ref[j + 7]);
+            pt = MAC_8TAP_N0(MC_L_COEF(coef, dx), ref[j], ref[j + 1], ref[j + 2], ref[j + 3], ref[j + 4], ref[j + 5], ref[j + 6], ref[j + 7]);
     
             pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
     
@@ -213,7 +204,7 @@ void xevd_mc_l_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pr
 
 
 void xevd_mc_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h
-,int bit_depth)
+,int bit_depth, const s16 * coef)
 {
     int i, j, dy;
     s32 pt;
@@ -227,7 +218,7 @@ void xevd_mc_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pr
     {
     for (j = 0; j < w; j++)
     {
-        pt = MAC_8TAP_0N(tbl_mc_l_coeff[dy], ref[j], ref[s_ref + j], ref[s_ref * 2 + j], ref[s_ref * 3 + j], ref[s_ref * 4 + j], ref[s_ref * 5 + j], ref[s_ref * 6 + j], ref[s_ref * 7 + j]);
+        pt = MAC_8TAP_0N(MC_L_COEF(coef, dy), ref[j], ref[s_ref + j], ref[s_ref * 2 + j], ref[s_ref * 3 + j], ref[s_ref * 4 + j], ref[s_ref * 5 + j], ref[s_ref * 6 + j], ref[s_ref * 7 + j]);
         pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
 
     }
@@ -237,8 +228,8 @@ void xevd_mc_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pr
 }
 
 
-void xevd_mc_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h
-,int bit_depth)
+void xevd_mc_l_nn(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h
+,int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*(MAX_CU_SIZE + MC_IBUF_PAD_L)];
     s16        *b;
@@ -261,7 +252,7 @@ void xevd_mc_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
         for (j = 0; j < w; j++)
         {
     
-            b[j] = MAC_8TAP_NN_S1(tbl_mc_l_coeff[dx], ref[j], ref[j + 1], ref[j + 2], ref[j + 3], ref[j + 4], ref[j + 5], ref[j + 6], ref[j + 7],offset1, shift1);
+            b[j] = MAC_8TAP_NN_S1(MC_L_COEF(coef, dx), ref[j], ref[j + 1], ref[j + 2], ref[j + 3], ref[j + 4], ref[j + 5], ref[j + 6], ref[j + 7],offset1, shift1);
     
         }
         ref += s_ref;
@@ -274,7 +265,7 @@ void xevd_mc_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
         for (j = 0; j < w; j++)
         {
     
-            pt = MAC_8TAP_NN_S2(tbl_mc_l_coeff[dy], b[j], b[j + w], b[j + w * 2], b[j + w * 3], b[j + w * 4], b[j + w * 5], b[j + w * 6], b[j + w * 7], offset2, shift2);
+            pt = MAC_8TAP_NN_S2(MC_L_COEF(coef, dy), b[j], b[j + w], b[j + w * 2], b[j + w * 3], b[j + w * 4], b[j + w * 5], b[j + w * 6], b[j + w * 7], offset2, shift2);
             pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
     
         }
@@ -287,7 +278,7 @@ void xevd_mc_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
 /****************************************************************************
  * motion compensation for chroma
  ****************************************************************************/
-void xevd_mc_c_00(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -308,7 +299,7 @@ void xevd_mc_c_00(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
 
 }
 
-void xevd_mc_c_n0(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int       i, j, dx;
     s32       pt;
@@ -321,7 +312,7 @@ void xevd_mc_c_n0(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
     {
         for (j = 0; j < w; j++)
         {
-            pt = MAC_4TAP_N0(tbl_mc_c_coeff[dx], ref[j], ref[j + 1], ref[j + 2], ref[j + 3]);
+            pt = MAC_4TAP_N0(MC_C_COEF(coef, dx), ref[j], ref[j + 1], ref[j + 2], ref[j + 3]);
 
             pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
 
@@ -332,7 +323,7 @@ void xevd_mc_c_n0(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
 
 }
 
-void xevd_mc_c_0n(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j, dy;
     s32       pt;
@@ -345,7 +336,7 @@ void xevd_mc_c_0n(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
     {
         for (j = 0; j < w; j++)
         {
-            pt = MAC_4TAP_0N(tbl_mc_c_coeff[dy], ref[j], ref[s_ref + j], ref[s_ref * 2 + j], ref[s_ref * 3 + j]);
+            pt = MAC_4TAP_0N(MC_C_COEF(coef, dy), ref[j], ref[s_ref + j], ref[s_ref * 2 + j], ref[s_ref * 3 + j]);
 
             pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
 
@@ -357,7 +348,7 @@ void xevd_mc_c_0n(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
 
 }
 
-void xevd_mc_c_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_c_nn(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_C)*MAX_CU_SIZE];
     s16        *b;
@@ -381,7 +372,7 @@ void xevd_mc_c_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
         for (j = 0; j < w; j++)
         {
 
-            b[j] = MAC_4TAP_NN_S1(tbl_mc_c_coeff[dx], ref[j], ref[j + 1], ref[j + 2], ref[j + 3], offset1, shift1);
+            b[j] = MAC_4TAP_NN_S1(MC_C_COEF(coef, dx), ref[j], ref[j + 1], ref[j + 2], ref[j + 3], offset1, shift1);
 
         }
         ref += s_ref;
@@ -395,7 +386,7 @@ void xevd_mc_c_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pr
         {
 
 
-            pt = MAC_4TAP_NN_S2(tbl_mc_c_coeff[dy], b[j], b[j + w], b[j + 2 * w], b[j + 3 * w], offset2, shift2);
+            pt = MAC_4TAP_NN_S2(MC_C_COEF(coef, dy), b[j], b[j + w], b[j + 2 * w], b[j + 3 * w], offset2, shift2);
             pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
 
 
@@ -432,6 +423,51 @@ XEVD_MC_C xevd_tbl_mc_c[2][2] =
 };
 
 
+/* run the interpolation kernel fn with the filter table coef on the block
+   at (gmv_x, gmv_y) given in 1/(1 << prec) sample units. when the tap
+   support of the block reaches beyond the valid border (pad) of the
+   reference plane, the block is taken from a local copy of the reference
+   area whose out-of-picture samples repeat the nearest picture edge sample,
+   as the padding would */
+void xevd_mc_blk(XEVD_MC_L fn, const s16 * coef, pel *ref, int s_ref, int pic_w, int pic_h, int pad, int prec, int tap
+               , int gmv_x, int gmv_y, int s_pred, pel *pred, int w, int h, int bit_depth)
+{
+    pel   buf[MC_EMU_BUF_W * MC_EMU_BUF_H];
+    pel * src, * dst;
+    int   x0, y0, bw, bh, l, r, i, j;
+
+    x0 = (gmv_x >> prec) - (tap >> 1) + 1;
+    y0 = (gmv_y >> prec) - (tap >> 1) + 1;
+    bw = w + tap - 1;
+    bh = h + tap - 1;
+
+    if(x0 >= -pad && y0 >= -pad && x0 + bw <= pic_w + pad && y0 + bh <= pic_h + pad)
+    {
+        fn(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, coef);
+        return;
+    }
+
+    /* columns [0, l) lie left of the picture, [r, bw) right of it */
+    l = XEVD_CLIP3(0, bw, -x0);
+    r = XEVD_CLIP3(l, bw, pic_w - x0);
+
+    dst = buf;
+    for(i = 0; i < bh; i++)
+    {
+        src = ref + XEVD_CLIP3(0, pic_h - 1, y0 + i) * s_ref;
+        for(j = 0; j < l; j++) dst[j] = src[0];
+        if(r > l) xevd_mcpy(dst + l, src + x0 + l, (r - l) * sizeof(pel));
+        for(j = r; j < bw; j++) dst[j] = src[pic_w - 1];
+        dst += MC_EMU_BUF_W;
+    }
+
+    /* keep the fractional phase, the integer position is the copy origin */
+    gmv_x = (gmv_x & ((1 << prec) - 1)) + (((tap >> 1) - 1) << prec);
+    gmv_y = (gmv_y & ((1 << prec) - 1)) + (((tap >> 1) - 1) << prec);
+
+    fn(buf, gmv_x, gmv_y, MC_EMU_BUF_W, s_pred, pred, w, h, bit_depth, coef);
+}
+
 void xevd_mv_clip(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16 mv[REFP_NUM][MV_D], s16(*mv_t)[MV_D])
 {
     int min_clip[MV_D], max_clip[MV_D];
@@ -466,7 +502,7 @@ void xevd_mv_clip(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP
     }
 }
 
-void xevd_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[REFP_NUM][N_C][MAX_CU_DIM]
+void xevd_mc(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[REFP_NUM][N_C][MAX_CU_DIM]
            , int poc_c,  int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc) 
 {
     XEVD_PIC    *ref_pic;
@@ -498,13 +534,13 @@ void xevd_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM]
         qpel_gmv_x = (x << 2) + mv_t[REFP_0][MV_X];
         qpel_gmv_y = (y << 2) + mv_t[REFP_0][MV_Y];
 
-        xevd_mc_l(mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
-                , ref_pic->s_l, w, pred[0][Y_C], w, h, bit_depth_luma);
-        xevd_mc_c(mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic->u, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
-                , ref_pic->s_c, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), pred[0][U_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+        xevd_mc_l(ctx, mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
+                , w, pred[0][Y_C], w, h, bit_depth_luma);
+        xevd_mc_c(ctx, mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic, ref_pic->u, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
+                , w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), pred[0][U_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                 , h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
-        xevd_mc_c(mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic->v, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
-                , ref_pic->s_c, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), pred[0][V_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+        xevd_mc_c(ctx, mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic, ref_pic->v, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
+                , w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), pred[0][V_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                 , h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
         bidx++;
     }
@@ -526,13 +562,13 @@ void xevd_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM]
         qpel_gmv_y = (y << 2) + mv_t[REFP_1][MV_Y];
 
 
-        xevd_mc_l(mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
-                , ref_pic->s_l, w, pred[bidx][Y_C], w, h, bit_depth_luma);
-        xevd_mc_c(mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic->u, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
-                , ref_pic->s_c, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), pred[bidx][U_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+        xevd_mc_l(ctx, mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
+                , w, pred[bidx][Y_C], w, h, bit_depth_luma);
+        xevd_mc_c(ctx, mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic, ref_pic->u, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
+                , w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), pred[bidx][U_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                 , h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
-        xevd_mc_c(mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic->v, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
-                , ref_pic->s_c, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), pred[bidx][V_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+        xevd_mc_c(ctx, mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic, ref_pic->v, (qpel_gmv_x << 2), (qpel_gmv_y << 2)
+                , w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), pred[bidx][V_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                 , h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
         bidx++;
     }
@@ -543,15 +579,15 @@ void xevd_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM]
         s32 center_cost[2] = { 1 << 30, 1 << 30 };
 
         //only if the references are located on opposite sides of the current frame
-        xevd_func_average_no_clip(pred[0][Y_C], pred[1][Y_C], pred[0][Y_C], w, w, w, w, h, bit_depth_luma);
+        ctx->fn_average_no_clip(pred[0][Y_C], pred[1][Y_C], pred[0][Y_C], w, w, w, w, h, bit_depth_luma);
 
         if (chroma_format_idc)
         {
              w >>= (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc));
              h >>= (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc));
 
-            xevd_func_average_no_clip(pred[0][U_C], pred[1][U_C], pred[0][U_C], w, w, w, w, h, bit_depth_chroma);
-            xevd_func_average_no_clip(pred[0][V_C], pred[1][V_C], pred[0][V_C], w, w, w, w, h, bit_depth_chroma);
+            ctx->fn_average_no_clip(pred[0][U_C], pred[1][U_C], pred[0][U_C], w, w, w, w, h, bit_depth_chroma);
+            ctx->fn_average_no_clip(pred[0][V_C], pred[1][V_C], pred[0][V_C], w, w, w, w, h, bit_depth_chroma);
         }
      }
 }
@@ -44,41 +44,42 @@
 #define MC_IBUF_PAD_BL         2
 
 
-typedef void(*XEVD_MC_L) (pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth);
-typedef void(*XEVD_MC_C) (pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth);
-typedef void (*XEVD_AVG_NO_CLIP)(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref, int s_dst, int wd, int ht, int bit_depth);
-
-extern s16 (*tbl_mc_l_coeff)[8];
 extern s16 xevd_tbl_mc_l_coeff[16][8];
-
-extern s16 (*tbl_mc_c_coeff)[4];
 extern s16 xevd_tbl_mc_c_coeff[32][4];
 
+/* taps of fractional phase f in a luma (8-tap) or chroma (4-tap) filter table */
+#define MC_L_COEF(coef, f)     ((coef) + ((f) << 3))
+#define MC_C_COEF(coef, f)     ((coef) + ((f) << 2))
+
 extern XEVD_MC_L xevd_tbl_mc_l[2][2];
 extern XEVD_MC_C xevd_tbl_mc_c[2][2];
 
-
-extern XEVD_MC_L (*xevd_func_mc_l)[2];
-extern XEVD_MC_C (*xevd_func_mc_c)[2];
-extern XEVD_AVG_NO_CLIP xevd_func_average_no_clip;
-
-
-#define xevd_mc_l(ori_mv_x, ori_mv_y, ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth) \
-    (xevd_func_mc_l[((ori_mv_x) | ((ori_mv_x)>>1) | ((ori_mv_x)>>2) | ((ori_mv_x)>>3)) & 0x1])\
-        [((ori_mv_y) | ((ori_mv_y)>>1) | ((ori_mv_y)>>2) | ((ori_mv_y)>>3)) & 0x1]\
-        (ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth)
-
-#define xevd_mc_c(ori_mv_x, ori_mv_y, ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth) \
-    (xevd_func_mc_c[((ori_mv_x) | ((ori_mv_x)>>1) | ((ori_mv_x)>>2)| ((ori_mv_x)>>3) | ((ori_mv_x)>>4)) & 0x1]\
-        [((ori_mv_y) | ((ori_mv_y)>>1) | ((ori_mv_y)>>2) | ((ori_mv_y)>>3) | ((ori_mv_y)>>4)) & 0x1])\
-        (ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth)
-
-void xevd_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM]
+/* size of the local reference copy used for blocks reaching beyond the
+   valid border of the reference picture */
+#define MC_EMU_BUF_W           (MAX_CU_SIZE + MC_IBUF_PAD_L + PIC_GUARD_SIZE_L)
+#define MC_EMU_BUF_H           (MAX_CU_SIZE + MC_IBUF_PAD_L)
+
+/* MC kernels are taken from the decoder context */
+#define xevd_mc_l(ctx, ori_mv_x, ori_mv_y, pic, gmv_x, gmv_y, s_pred, pred, w, h, bit_depth) \
+    xevd_mc_blk((ctx)->fn_mc_l[((ori_mv_x) | ((ori_mv_x)>>1) | ((ori_mv_x)>>2) | ((ori_mv_x)>>3)) & 0x1]\
+        [((ori_mv_y) | ((ori_mv_y)>>1) | ((ori_mv_y)>>2) | ((ori_mv_y)>>3)) & 0x1],\
+        (ctx)->mc_l_coef, (pic)->y, (pic)->s_l, (pic)->w_l, (pic)->h_l, (ctx)->ref_pad_l, MC_PRECISION, 8,\
+        gmv_x, gmv_y, s_pred, pred, w, h, bit_depth)
+
+#define xevd_mc_c(ctx, ori_mv_x, ori_mv_y, pic, ref, gmv_x, gmv_y, s_pred, pred, w, h, bit_depth) \
+    xevd_mc_blk((ctx)->fn_mc_c[((ori_mv_x) | ((ori_mv_x)>>1) | ((ori_mv_x)>>2)| ((ori_mv_x)>>3) | ((ori_mv_x)>>4)) & 0x1]\
+        [((ori_mv_y) | ((ori_mv_y)>>1) | ((ori_mv_y)>>2) | ((ori_mv_y)>>3) | ((ori_mv_y)>>4)) & 0x1],\
+        (ctx)->mc_c_coef, ref, (pic)->s_c, (pic)->w_c, (pic)->h_c, (ctx)->ref_pad_c, MC_PRECISION + 1, 4,\
+        gmv_x, gmv_y, s_pred, pred, w, h, bit_depth)
+
+void xevd_mc_blk(XEVD_MC_L fn, const s16 * coef, pel *ref, int s_ref, int pic_w, int pic_h, int pad, int prec, int tap
+               , int gmv_x, int gmv_y, int s_pred, pel *pred, int w, int h, int bit_depth);
+void xevd_mc(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM]
            , pel pred[REFP_NUM][N_C][MAX_CU_DIM], int poc_c, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc);
 void xevd_mv_clip(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16 mv[REFP_NUM][MV_D], s16(*mv_t)[MV_D]);
-void xevd_average_16b_no_clip(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref, int s_dst, int wd, int ht, int bit_depth);
-void xevd_mc_l_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth);
-void xevd_mc_c_00(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth);
+void xevd_average_16b_no_clip(pel *src, pel *ref, pel *dst, int s_src, int s_ref, int s_dst, int wd, int ht, int bit_depth);
+void xevd_mc_l_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef);
+void xevd_mc_c_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef);
 
 
 
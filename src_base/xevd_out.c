@@ -0,0 +1,282 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevd_def.h"
+
+static void out_8b(pel *u, pel *v, void *dst, int w, int shr, int shl, int max)
+{
+    u8 *d = (u8 *)dst;
+    int add = shr ? 1 << (shr - 1) : 0;
+    int i, t;
+
+    for(i = 0; i < w; i++)
+    {
+        t = (u[i] + add) >> shr;
+        d[i] = (u8)XEVD_CLIP(t, 0, max);
+    }
+}
+
+static void out_16b(pel *u, pel *v, void *dst, int w, int shr, int shl, int max)
+{
+    u16 *d = (u16 *)dst;
+    int add = shr ? 1 << (shr - 1) : 0;
+    int i, t;
+
+    for(i = 0; i < w; i++)
+    {
+        t = (u[i] + add) >> shr;
+        d[i] = (u16)(XEVD_CLIP(t, 0, max) << shl);
+    }
+}
+
+static void out_uv_8b(pel *u, pel *v, void *dst, int w, int shr, int shl, int max)
+{
+    u8 *d = (u8 *)dst;
+    int add = shr ? 1 << (shr - 1) : 0;
+    int i, t0, t1;
+
+    for(i = 0; i < w; i++)
+    {
+        t0 = (u[i] + add) >> shr;
+        t1 = (v[i] + add) >> shr;
+        d[2 * i    ] = (u8)XEVD_CLIP(t0, 0, max);
+        d[2 * i + 1] = (u8)XEVD_CLIP(t1, 0, max);
+    }
+}
+
+static void out_uv_16b(pel *u, pel *v, void *dst, int w, int shr, int shl, int max)
+{
+    u16 *d = (u16 *)dst;
+    int add = shr ? 1 << (shr - 1) : 0;
+    int i, t0, t1;
+
+    for(i = 0; i < w; i++)
+    {
+        t0 = (u[i] + add) >> shr;
+        t1 = (v[i] + add) >> shr;
+        d[2 * i    ] = (u16)(XEVD_CLIP(t0, 0, max) << shl);
+        d[2 * i + 1] = (u16)(XEVD_CLIP(t1, 0, max) << shl);
+    }
+}
+
+const XEVD_OUT xevd_tbl_out[XEVD_OUT_NUM] =
+{
+    out_8b,
+    out_16b,
+    out_uv_8b,
+    out_uv_16b
+};
+
+int xevd_out_cs_check(int cs)
+{
+    return (cs == XEVD_CS_UNKNOWN || cs == XEVD_CS_YCBCR420 || cs == XEVD_CS_NV12 || cs == XEVD_CS_P010) ?
+        XEVD_OK : XEVD_ERR_UNSUPPORTED_COLORSPACE;
+}
+
+/* get a buffer for a converted output picture; the pooled buffers are
+   reused once the application has released them */
+static XEVD_IMGB * out_imgb_get(XEVD_CTX *ctx, int w, int h, int cs)
+{
+    XEVD_IMGB *imgb;
+    int i;
+
+    for(i = 0; i < XEVD_OUT_POOL_SIZE; i++)
+    {
+        imgb = ctx->out_pool[i];
+        if(imgb != NULL)
+        {
+            if(1 != imgb->getref(imgb))
+            {
+                continue; /* still used by the application */
+            }
+            if(imgb->cs == cs && imgb->w[0] == w && imgb->h[0] == h)
+            {
+                imgb->addref(imgb);
+                return imgb;
+            }
+            /* the sequence or the output format has changed */
+            imgb->release(imgb);
+        }
+        imgb = xevd_imgb_create(w, h, cs, XEVD_IMGB_OPT_NONE, NULL, NULL, ctx->pa.imgb_alloc);
+        ctx->out_pool[i] = imgb;
+        if(imgb != NULL)
+        {
+            imgb->addref(imgb);
+        }
+        return imgb;
+    }
+    /* every pooled buffer is in use */
+    return xevd_imgb_create(w, h, cs, XEVD_IMGB_OPT_NONE, NULL, NULL, ctx->pa.imgb_alloc);
+}
+
+static pel * out_src_row(XEVD_IMGB *src, int c, int x, int y, int w, XEVD_OUT_ROW fn_row, void *arg, pel *row)
+{
+    if(fn_row)
+    {
+        fn_row(arg, src, c, x, y, w, row);
+        return row;
+    }
+    return (pel *)((u8 *)src->a[c] + y * src->s[c]) + x;
+}
+
+/* converts the w x h area from (x, y) of the luma of src into dst */
+static void out_conv(XEVD_CTX *ctx, XEVD_IMGB *dst, XEVD_IMGB *src, int x, int y, int w, int h
+                   , XEVD_OUT_ROW fn_row, void *arg)
+{
+    const XEVD_OUT *fn = *ctx->fn_out;
+    int fmt = XEVD_CS_GET_FORMAT(dst->cs);
+    int p010 = (fmt == XEVD_CF_YCBCR420_P010);
+    int cw = (w + 1) >> 1, ch = (h + 1) >> 1;
+    int c, j, i, bd, shr, shl, max;
+    pel *u, *v;
+    u8 *d;
+
+    for(c = 0; c < 2; c++)
+    {
+        /* P010 keeps up to 10 bits, rounding deeper samples */
+        bd = c == Y_C ? ctx->internal_codec_bit_depth_luma : ctx->internal_codec_bit_depth_chroma;
+        shr = p010 ? XEVD_MAX(bd - 10, 0) : bd - 8;
+        shl = p010 ? 16 - (bd - shr) : 0;
+        max = (1 << (bd - shr)) - 1;
+
+        if(c == Y_C)
+        {
+            for(j = 0; j < h; j++)
+            {
+                u = out_src_row(src, Y_C, x, y + j, w, fn_row, arg, ctx->out_row);
+                fn[p010 ? XEVD_OUT_16B : XEVD_OUT_8B](u, NULL, (u8 *)dst->a[0] + j * dst->s[0], w, shr, shl, max);
+            }
+        }
+        else if(src->np == 1)
+        {
+            /* neutral chroma of 4:0:0 */
+            for(i = 1; i < dst->np; i++)
+            {
+                for(j = 0; j < ch; j++)
+                {
+                    d = (u8 *)dst->a[i] + j * dst->s[i];
+                    if(p010)
+                    {
+                        u16 *d16 = (u16 *)d;
+                        int k;
+                        for(k = 0; k < cw * 2; k++) d16[k] = 1 << 15;
+                    }
+                    else
+                    {
+                        xevd_mset(d, 128, fmt == XEVD_CF_YCBCR420 ? cw : cw * 2);
+                    }
+                }
+            }
+        }
+        else
+        {
+            for(j = 0; j < ch; j++)
+            {
+                u = out_src_row(src, U_C, x >> 1, (y >> 1) + j, cw, fn_row, arg, ctx->out_row);
+                v = out_src_row(src, V_C, x >> 1, (y >> 1) + j, cw, fn_row, arg, ctx->out_row + cw);
+                if(fmt == XEVD_CF_YCBCR420)
+                {
+                    fn[XEVD_OUT_8B](u, NULL, (u8 *)dst->a[1] + j * dst->s[1], cw, shr, shl, max);
+                    fn[XEVD_OUT_8B](v, NULL, (u8 *)dst->a[2] + j * dst->s[2], cw, shr, shl, max);
+                }
+                else
+                {
+                    fn[p010 ? XEVD_OUT_UV_16B : XEVD_OUT_UV_8B](u, v, (u8 *)dst->a[1] + j * dst->s[1], cw, shr, shl, max);
+                }
+            }
+        }
+    }
+}
+
+/* replaces *imgb, a picture of the decoder, by its conversion to
+   cdsc.out_cs. with fn_row, the samples are mapped row by row on the way */
+int xevd_out_pull(XEVD_CTX *ctx, XEVD_IMGB **imgb, XEVD_OUT_ROW fn_row, void *arg)
+{
+    XEVD_SPS  *sps = ctx->sps;
+    XEVD_IMGB *src = *imgb;
+    XEVD_IMGB *dst = NULL;
+    int unit = sps->chroma_format_idc ? 2 : 1; /* unit of the crop offsets */
+    int x = 0, y = 0, w = ctx->w, h = ctx->h;
+    int ret = XEVD_OK, i;
+
+    xevd_assert_gv(sps->chroma_format_idc <= 1, ret, XEVD_ERR_UNSUPPORTED_COLORSPACE, ERR);
+
+    if(sps->picture_cropping_flag)
+    {
+        x = sps->picture_crop_left_offset * unit;
+        y = sps->picture_crop_top_offset * unit;
+        w -= (sps->picture_crop_left_offset + sps->picture_crop_right_offset) * unit;
+        h -= (sps->picture_crop_top_offset + sps->picture_crop_bottom_offset) * unit;
+    }
+
+    if(fn_row && ctx->out_row_size < ctx->w + 2)
+    {
+        xevd_mfree(ctx->out_row);
+        ctx->out_row_size = 0;
+        ctx->out_row = (pel *)xevd_malloc(sizeof(pel) * (ctx->w + 2));
+        xevd_assert_gv(ctx->out_row != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
+        ctx->out_row_size = ctx->w + 2;
+    }
+
+    dst = out_imgb_get(ctx, w, h, ctx->cdsc.out_cs);
+    xevd_assert_gv(dst != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
+
+    out_conv(ctx, dst, src, x, y, w, h, fn_row, arg);
+
+    for(i = 0; i < XEVD_TS_NUM; i++)
+    {
+        dst->ts[i] = src->ts[i];
+    }
+    dst->imgb_active_aps_id = src->imgb_active_aps_id;
+    dst->imgb_active_pps_id = src->imgb_active_pps_id;
+    src->release(src);
+    *imgb = dst;
+    return XEVD_OK;
+
+ERR:
+    src->release(src);
+    *imgb = NULL;
+    return ret;
+}
+
+void xevd_out_free(XEVD_CTX *ctx)
+{
+    int i;
+
+    for(i = 0; i < XEVD_OUT_POOL_SIZE; i++)
+    {
+        /* buffers still held by the application are freed on their release */
+        if(ctx->out_pool[i]) ctx->out_pool[i]->release(ctx->out_pool[i]);
+        ctx->out_pool[i] = NULL;
+    }
+    xevd_mfree(ctx->out_row);
+    ctx->out_row = NULL;
+    ctx->out_row_size = 0;
+}
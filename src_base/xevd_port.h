@@ -48,7 +48,11 @@ typedef int32_t                 s32;
 typedef uint32_t                u32;
 typedef int64_t                 s64;
 typedef uint64_t                u64;
+#if XEVD_PEL_8BIT
+typedef u8                      pel;
+#else
 typedef s16                     pel;
+#endif
 typedef s32                     double_pel; 
 /*****************************************************************************
  * limit constant
@@ -93,6 +97,11 @@ static __inline void xevd_mset_16b(s16 * dst, s16 v, int cnt)
     for(i=0; i<cnt; i++)
         dst[i] = v;
 }
+#if XEVD_PEL_8BIT
+#define xevd_mset_pel(dst,v,cnt)   xevd_mset((dst), (v), (cnt))
+#else
+#define xevd_mset_pel(dst,v,cnt)   xevd_mset_16b((dst), (v), (cnt))
+#endif
 
 
 /*****************************************************************************
@@ -158,6 +167,33 @@ void xevd_trace_line(char * pre);
 #else
 #include <x86intrin.h>
 #endif
+
+/* unaligned accesses of 4 and 2 bytes, for kernels on narrow 8-bit blocks */
+static __inline __m128i xevd_load_4b(const void * p)
+{
+    int v;
+    memcpy(&v, p, 4);
+    return _mm_cvtsi32_si128(v);
+}
+
+static __inline __m128i xevd_load_2b(const void * p)
+{
+    u16 v;
+    memcpy(&v, p, 2);
+    return _mm_cvtsi32_si128(v);
+}
+
+static __inline void xevd_store_4b(void * p, __m128i v)
+{
+    int t = _mm_cvtsi128_si32(v);
+    memcpy(p, &t, 4);
+}
+
+static __inline void xevd_store_2b(void * p, __m128i v)
+{
+    u16 t = (u16)_mm_cvtsi128_si32(v);
+    memcpy(p, &t, 2);
+}
 #endif
 #endif /* ARM_NEON */
 
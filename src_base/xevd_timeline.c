@@ -0,0 +1,129 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevd_def.h"
+
+int xevd_tl_set(XEVD_CTX * ctx, XEVD_TIMELINE * tl)
+{
+    int i, cnt = XEVD_MAX(1, ctx->tc.max_task_cnt);
+
+    ctx->perf_on &= ~XEVD_PERF_TL;
+    if(tl == NULL || tl->fn == NULL)
+    {
+        xevd_mfree(ctx->tl_ring);
+        return XEVD_OK;
+    }
+
+    if(ctx->tl_ring == NULL)
+    {
+        ctx->tl_ring = (XEVD_TL_RING *)xevd_malloc(sizeof(XEVD_TL_RING) * cnt);
+        xevd_assert_rv(ctx->tl_ring != NULL, XEVD_ERR_OUT_OF_MEMORY);
+    }
+    for(i = 0; i < cnt; i++)
+    {
+        ctx->tl_ring[i].head = 0;
+        ctx->tl_ring[i].tail = 0;
+    }
+    ctx->tl = *tl;
+    ctx->tl_cycles0 = xevd_get_cycles();
+    ctx->tl_nsec0 = xevd_get_nsec();
+    ctx->perf_on |= XEVD_PERF_TL;
+    return XEVD_OK;
+}
+
+void xevd_tl_add(XEVD_CTX * ctx, int thread_idx, int type, int arg, u64 beg, u64 end)
+{
+    XEVD_TL_RING  * r = ctx->tl_ring + thread_idx;
+    XEVD_TL_EVENT * e;
+    u32                head = (u32)r->head;
+
+    if(head - (u32)xevd_threadsafe_read(&r->tail) >= XEVD_TL_RING_SIZE)
+    {
+        return;
+    }
+    e = r->ev + (head & (XEVD_TL_RING_SIZE - 1));
+    e->type = type;
+    e->thread = thread_idx;
+    e->arg = arg;
+    e->beg = (long long)beg;
+    e->end = (long long)end;
+
+    /* publish the event to xevd_tl_flush() */
+    xevd_threadsafe_assign(&r->head, (int)(head + 1));
+}
+
+void xevd_tl_wait(XEVD_CTX * ctx, int thread_idx, int arg, u64 wait_beg)
+{
+    u64 wait = ctx->wait_cycles[thread_idx] - wait_beg;
+    u64 now;
+
+    if(wait)
+    {
+        now = xevd_get_cycles();
+        xevd_tl_add(ctx, thread_idx, XEVD_TL_WAIT, arg, now - wait, now);
+    }
+}
+
+/* convert the pending events of every thread to nanoseconds and hand them to
+   the callback. the cycle counter is calibrated against the wall clock over
+   the whole time tracing has been on */
+void xevd_tl_flush(XEVD_CTX * ctx)
+{
+    XEVD_TL_RING  * r;
+    XEVD_TL_EVENT * e;
+    u64                cycles = xevd_get_cycles() - ctx->tl_cycles0;
+    u64                nsec = xevd_get_nsec() - ctx->tl_nsec0;
+    double             scale = cycles ? (double)nsec / (double)cycles : 0;
+    u32                head, tail, idx, cnt, i;
+    int                t;
+
+    if(!(ctx->perf_on & XEVD_PERF_TL)) return;
+
+    for(t = 0; t < XEVD_MAX(1, ctx->tc.max_task_cnt); t++)
+    {
+        r = ctx->tl_ring + t;
+        tail = (u32)r->tail;
+        head = (u32)xevd_threadsafe_read(&r->head);
+        while(tail != head)
+        {
+            idx = tail & (XEVD_TL_RING_SIZE - 1);
+            cnt = XEVD_MIN(head - tail, XEVD_TL_RING_SIZE - idx);
+            for(i = 0; i < cnt; i++)
+            {
+                e = r->ev + idx + i;
+                e->beg = (long long)((double)((u64)e->beg - ctx->tl_cycles0) * scale);
+                e->end = (long long)((double)((u64)e->end - ctx->tl_cycles0) * scale);
+            }
+            ctx->tl.fn(ctx->tl.user, r->ev + idx, (int)cnt);
+            tail += cnt;
+        }
+        xevd_threadsafe_assign(&r->tail, (int)tail);
+    }
+}
@@ -0,0 +1,57 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _XEVD_TIMELINE_H_
+#define _XEVD_TIMELINE_H_
+
+/* events per thread kept until the next xevd_tl_flush() */
+#define XEVD_TL_RING_SIZE                  (1 << 15)
+
+/* single-producer ring of one thread. begin and end times are in cycles
+   until the ring is flushed. events are dropped while it is full */
+typedef struct _XEVD_TL_RING
+{
+    XEVD_TL_EVENT           ev[XEVD_TL_RING_SIZE];
+    /* next slot to write, advanced by the owner thread only */
+    volatile int            head;
+    /* next slot to read, advanced by the flushing thread only */
+    volatile int            tail;
+} XEVD_TL_RING;
+
+int  xevd_tl_set(XEVD_CTX * ctx, XEVD_TIMELINE * tl);
+void xevd_tl_add(XEVD_CTX * ctx, int thread_idx, int type, int arg, u64 beg, u64 end);
+void xevd_tl_wait(XEVD_CTX * ctx, int thread_idx, int arg, u64 wait_beg);
+void xevd_tl_flush(XEVD_CTX * ctx);
+
+/* record the time thread_idx blocked since its wait counter was wait_beg */
+#define XEVD_TL_BLOCKED(ctx, thread_idx, arg, wait_beg) \
+    {if((ctx)->perf_on & XEVD_PERF_TL) xevd_tl_wait(ctx, thread_idx, arg, wait_beg);}
+
+#endif /* _XEVD_TIMELINE_H_ */
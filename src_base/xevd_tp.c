@@ -30,6 +30,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include "xevd_tp.h"
 #if defined(WIN32) || defined(WIN64)
 #include <windows.h>
@@ -40,6 +41,8 @@
 
 #define WINDOWS_MUTEX_SYNC 0
 
+static uint64_t sync_clock(void);
+
 #if !defined(WIN32) && !defined(WIN64) 
 
 typedef struct _THREAD_CTX
@@ -57,6 +60,8 @@ typedef struct _THREAD_CTX
     THREAD_STATUS t_status;
     THREAD_RESULT task_result;
     int thread_id;
+    uint64_t busy_cycles; //time spent running tasks
+    uint64_t join_cycles; //time callers waited for the result
 }THREAD_CTX;
 
 typedef struct _syncobject
@@ -72,6 +77,7 @@ void * run_worker_thread(void * arg)
     
     //member Initialization section
     THREAD_CTX * t_context = (THREAD_CTX *)arg;
+    uint64_t t0;
     if (!t_context)
     {
         return 0; //error handling, more like a fail safe mechanism
@@ -102,7 +108,9 @@ void * run_worker_thread(void * arg)
 
         //run the routine
         //worker thread state is running with entry function and arg set
+        t0 = sync_clock();
         t_context->task(t_context->t_arg);
+        t_context->busy_cycles += sync_clock() - t0;
 
         //signal the thread waiting on the result
         pthread_mutex_lock(&t_context->c_section);
@@ -170,6 +178,8 @@ POOL_THREAD  create_worker_thread(THREAD_CONTROLLER * tc, int thread_id)
     thread_context->t_status = THREAD_SUSPENDED;
     thread_context->task_result = THREAD_INVALID_STATE;
     thread_context->thread_id = thread_id;
+    thread_context->busy_cycles = 0;
+    thread_context->join_cycles = 0;
     
     //create the worker thread
     result = pthread_create(&thread_context->t_handle, &thread_context->tAttribute, run_worker_thread, (void*)(thread_context));
@@ -237,6 +247,7 @@ THREAD_RESULT  retrieve_thread_result(POOL_THREAD thread_id, int * res)
     }
 
     THREAD_RESULT  result = THREAD_SUCCESS;
+    uint64_t       t0 = sync_clock();
 
     pthread_mutex_lock(&t_context->c_section);
     while (THREAD_RUNNING == t_context->t_status)
@@ -246,6 +257,7 @@ THREAD_RESULT  retrieve_thread_result(POOL_THREAD thread_id, int * res)
 
     result = t_context->task_result;
     pthread_mutex_unlock(&t_context->c_section);
+    t_context->join_cycles += sync_clock() - t0;
     *res = result;
     return result;
 }
@@ -358,6 +370,8 @@ typedef struct _THREAD_CTX
     THREAD_STATUS t_status;
     THREAD_RESULT task_result;
     int thread_id;
+    uint64_t busy_cycles; //time spent running tasks
+    uint64_t join_cycles; //time callers waited for the result
 
 }THREAD_CTX;
 
@@ -379,6 +393,7 @@ unsigned int __stdcall run_worker_thread(void * arg)
     
     //member Initialization section
     THREAD_CTX * t_context = (THREAD_CTX *)arg;
+    uint64_t t0;
     if (!t_context)
     {
         return 0; //error handling, more like a fail safe mechanism
@@ -402,7 +417,9 @@ unsigned int __stdcall run_worker_thread(void * arg)
         LeaveCriticalSection(&t_context->c_section);
 
         //worker thread state is running with entry function and arg set
+        t0 = sync_clock();
         t_context->task(t_context->t_arg);
+        t_context->busy_cycles += sync_clock() - t0;
 
         //change the state to suspended/waiting
         EnterCriticalSection(&t_context->c_section);
@@ -456,6 +473,8 @@ POOL_THREAD  create_worker_thread(THREAD_CONTROLLER * tc, int thread_id)
     thread_context->t_status = THREAD_SUSPENDED;
     thread_context->task_result = THREAD_INVALID_STATE;
     thread_context->thread_id = thread_id;
+    thread_context->busy_cycles = 0;
+    thread_context->join_cycles = 0;
 
     thread_context->t_handle = (HANDLE)_beginthreadex(NULL, 0, run_worker_thread, (void *)thread_context,0, NULL); //create a thread store the handle and pass the handle to context
     if (!thread_context->t_handle)
@@ -525,6 +544,7 @@ THREAD_RESULT  retrieve_thread_result(POOL_THREAD thread_id, int * res)
     }
 
     THREAD_RESULT  result = THREAD_SUCCESS;
+    uint64_t       t0 = sync_clock();
 
     WaitForSingleObject(t_context->r_event, INFINITE);
 
@@ -532,6 +552,7 @@ THREAD_RESULT  retrieve_thread_result(POOL_THREAD thread_id, int * res)
     EnterCriticalSection(&t_context->c_section);
     result = t_context->task_result;
     LeaveCriticalSection(&t_context->c_section);
+    t_context->join_cycles += sync_clock() - t0;
     
     *res = result;
     return result;
@@ -692,23 +713,332 @@ THREAD_RESULT xevd_dinit_thread_controller(THREAD_CONTROLLER * tc)
     return THREAD_SUCCESS;
 }
 
-int xevd_spinlock_wait(volatile int * addr, int val)
+/******************************************************************************
+ * wait primitives
+ *
+ * a waiter first spins on an acquire load with a cpu pause hint, then yields
+ * its time slice for a while, and finally parks on one of a fixed set of
+ * condition variables chosen by hashing the watched address. writers only
+ * touch the condition variable when the bucket has parked waiters, so the
+ * uncontended path is a plain release store.
+ ******************************************************************************/
+#define SYNC_SPIN_CNT      1024 /* pause-spins before yielding */
+#define SYNC_YIELD_CNT     32   /* yields before parking */
+#define SYNC_BUCKET_BITS   6
+#define SYNC_BUCKET_NUM    (1 << SYNC_BUCKET_BITS)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SYNC_LOAD(p)       InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+#define SYNC_STORE(p, v)   InterlockedExchange((volatile LONG *)(p), (v))
+#define SYNC_ADD(p, v)     InterlockedExchangeAdd((volatile LONG *)(p), (v))
+#define SYNC_CAS(p, o, v)  (InterlockedCompareExchange((volatile LONG *)(p), (v), (o)) == (o))
+#define SYNC_FENCE()       MemoryBarrier()
+#else
+#define SYNC_LOAD(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SYNC_STORE(p, v)   __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define SYNC_ADD(p, v)     __atomic_fetch_add((p), (v), __ATOMIC_SEQ_CST)
+#define SYNC_CAS(p, o, v)  sync_cas((p), (o), (v))
+#define SYNC_FENCE()       __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#if !defined(_MSC_VER)
+static int sync_cas(volatile int * addr, int expected, int val)
 {
-    int temp;
+    return __atomic_compare_exchange_n(addr, &expected, val, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#endif
 
-    while (1)
+#if defined(WIN32) || defined(WIN64)
+typedef struct _SYNC_BUCKET
+{
+    SRWLOCK            lock; /* zero-initialized == SRWLOCK_INIT */
+    CONDITION_VARIABLE cond; /* zero-initialized == CONDITION_VARIABLE_INIT */
+    volatile LONG      waiters;
+} SYNC_BUCKET;
+
+static SYNC_BUCKET sync_bucket[SYNC_BUCKET_NUM];
+
+static void sync_bucket_lock(SYNC_BUCKET * b)   { AcquireSRWLockExclusive(&b->lock); }
+static void sync_bucket_unlock(SYNC_BUCKET * b) { ReleaseSRWLockExclusive(&b->lock); }
+static void sync_bucket_sleep(SYNC_BUCKET * b)  { SleepConditionVariableSRW(&b->cond, &b->lock, INFINITE, 0); }
+static void sync_bucket_wake(SYNC_BUCKET * b)   { WakeAllConditionVariable(&b->cond); }
+static void sync_bucket_ready(void)             { }
+static void sync_yield(void)                    { SwitchToThread(); }
+#else
+#include <sched.h>
+
+typedef struct _SYNC_BUCKET
+{
+    pthread_mutex_t    lock;
+    pthread_cond_t     cond;
+    volatile int       waiters;
+} SYNC_BUCKET;
+
+static SYNC_BUCKET    sync_bucket[SYNC_BUCKET_NUM];
+static pthread_once_t sync_bucket_once = PTHREAD_ONCE_INIT;
+
+/* waiters is left to the static zero-initialization: writers read it without
+   waiting for this to run */
+static void sync_bucket_init(void)
+{
+    int i;
+    for(i = 0; i < SYNC_BUCKET_NUM; i++)
+    {
+        pthread_mutex_init(&sync_bucket[i].lock, NULL);
+        pthread_cond_init(&sync_bucket[i].cond, NULL);
+    }
+}
+
+static void sync_bucket_lock(SYNC_BUCKET * b)   { pthread_mutex_lock(&b->lock); }
+static void sync_bucket_unlock(SYNC_BUCKET * b) { pthread_mutex_unlock(&b->lock); }
+static void sync_bucket_sleep(SYNC_BUCKET * b)  { pthread_cond_wait(&b->cond, &b->lock); }
+static void sync_bucket_wake(SYNC_BUCKET * b)   { pthread_cond_broadcast(&b->cond); }
+static void sync_bucket_ready(void)             { pthread_once(&sync_bucket_once, sync_bucket_init); }
+static void sync_yield(void)                    { sched_yield(); }
+#endif
+
+static SYNC_BUCKET * sync_get_bucket(volatile int * addr)
+{
+    size_t h = ((size_t)addr) >> 2;
+    h ^= h >> SYNC_BUCKET_BITS;
+    h ^= h >> (SYNC_BUCKET_BITS * 2);
+    return &sync_bucket[h & (SYNC_BUCKET_NUM - 1)];
+}
+
+static void sync_pause(void)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+/* time stamp used for wait accounting: cpu cycles where a cycle counter is
+   cheaply available, otherwise the finest counter of the platform */
+static uint64_t sync_clock(void)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    return __rdtsc();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    return __builtin_ia32_rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    uint64_t t;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#elif defined(WIN32) || defined(WIN64)
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return (uint64_t)t.QuadPart;
+#else
+    return (uint64_t)clock();
+#endif
+}
+
+#define SYNC_READY(temp, val, at_least) \
+    ((temp) == -1 || ((at_least) ? (temp) >= (val) : (temp) == (val)))
+
+static int sync_wait(volatile int * addr, int val, int at_least, uint64_t * wait_cycles)
+{
+    SYNC_BUCKET * b;
+    uint64_t      t0;
+    int           temp, i;
+
+    temp = SYNC_LOAD(addr);
+    if(SYNC_READY(temp, val, at_least))
+    {
+        return temp;
+    }
+
+    t0 = sync_clock();
+
+    for(i = 0; i < SYNC_SPIN_CNT + SYNC_YIELD_CNT; i++)
+    {
+        if(i < SYNC_SPIN_CNT) sync_pause();
+        else sync_yield();
+
+        temp = SYNC_LOAD(addr);
+        if(SYNC_READY(temp, val, at_least))
+        {
+            goto END;
+        }
+    }
+
+    sync_bucket_ready();
+    b = sync_get_bucket(addr);
+
+    sync_bucket_lock(b);
+    SYNC_ADD(&b->waiters, 1);
+    while(1)
     {
-        temp = *addr; //thread safe volatile read
-        if (temp == val || temp == -1)
+        /* pairs with the fence in xevd_threadsafe_assign(): either the writer
+           sees this waiter, or this load sees the written value */
+        SYNC_FENCE();
+        temp = SYNC_LOAD(addr);
+        if(SYNC_READY(temp, val, at_least))
         {
             break;
         }
+        sync_bucket_sleep(b);
+    }
+    SYNC_ADD(&b->waiters, -1);
+    sync_bucket_unlock(b);
+
+END:
+    if(wait_cycles)
+    {
+        *wait_cycles += sync_clock() - t0;
     }
     return temp;
 }
 
+uint64_t xevd_get_cycles(void)
+{
+    return sync_clock();
+}
+
+uint64_t xevd_get_nsec(void)
+{
+#if defined(WIN32) || defined(WIN64)
+    LARGE_INTEGER t, f;
+    QueryPerformanceCounter(&t);
+    QueryPerformanceFrequency(&f);
+    return (uint64_t)((double)t.QuadPart * 1e9 / (double)f.QuadPart);
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+#endif
+}
+
+void xevd_thread_cycles(POOL_THREAD thread_id, uint64_t * busy_cycles, uint64_t * join_cycles)
+{
+    THREAD_CTX * t_context = (THREAD_CTX*)(thread_id);
+
+    *busy_cycles = t_context ? t_context->busy_cycles : 0;
+    *join_cycles = t_context ? t_context->join_cycles : 0;
+}
+
+int xevd_spinlock_wait(volatile int * addr, int val, uint64_t * wait_cycles)
+{
+    return sync_wait(addr, val, 0, wait_cycles);
+}
+
+int xevd_progress_wait(volatile int * addr, int val, uint64_t * wait_cycles)
+{
+    return sync_wait(addr, val, 1, wait_cycles);
+}
+
 void xevd_threadsafe_assign(volatile int * addr, int val)
 {
-    //thread safe volatile assign
-    *addr = val;
-}
\ No newline at end of file
+    SYNC_BUCKET * b = sync_get_bucket(addr);
+
+    SYNC_STORE(addr, val);
+    SYNC_FENCE();
+    if(SYNC_LOAD(&b->waiters) > 0)
+    {
+        sync_bucket_lock(b);
+        sync_bucket_wake(b);
+        sync_bucket_unlock(b);
+    }
+}
+
+int xevd_threadsafe_read(volatile int * addr)
+{
+    return SYNC_LOAD(addr);
+}
+
+int xevd_threadsafe_trylock(volatile int * addr)
+{
+    if(SYNC_LOAD(addr) != 0) return 0;
+    return SYNC_CAS(addr, 0, 1);
+}
+
+/******************************************************************************
+ * dynamic task distribution
+ *
+ * the calling thread and the pool threads pull task indices from one shared
+ * counter until it runs past task_cnt. a worker that finishes its task early
+ * takes the next pending one instead of idling until a fixed batch is joined.
+ ******************************************************************************/
+#define TASK_WORKER_MAX    64
+
+typedef struct _TASK_QUEUE
+{
+    THREAD_TASK        task;
+    void             * arg;
+    int                task_cnt;
+    volatile int       next;
+    volatile int       ret;
+} TASK_QUEUE;
+
+typedef struct _TASK_WORKER
+{
+    TASK_QUEUE       * q;
+    int                worker_idx;
+} TASK_WORKER;
+
+static int task_worker(void * arg)
+{
+    TASK_WORKER * w = (TASK_WORKER *)arg;
+    TASK_QUEUE  * q = w->q;
+    int           task_idx, ret;
+
+    while(1)
+    {
+        task_idx = SYNC_ADD(&q->next, 1);
+        if(task_idx >= q->task_cnt)
+        {
+            break;
+        }
+        ret = q->task(q->arg, task_idx, w->worker_idx);
+        if(ret < 0)
+        {
+            SYNC_STORE(&q->ret, ret);
+        }
+    }
+    return SYNC_LOAD(&q->ret);
+}
+
+int xevd_parallel_for(THREAD_CONTROLLER * tc, POOL_THREAD * pool, int worker_cnt, int task_cnt, THREAD_TASK task, void * arg)
+{
+    TASK_QUEUE  q;
+    TASK_WORKER w[TASK_WORKER_MAX];
+    int         i, res;
+
+    if(worker_cnt > task_cnt) worker_cnt = task_cnt;
+    if(worker_cnt > TASK_WORKER_MAX) worker_cnt = TASK_WORKER_MAX;
+    if(worker_cnt < 1) worker_cnt = 1;
+
+    q.task = task;
+    q.arg = arg;
+    q.task_cnt = task_cnt;
+    q.next = 0;
+    q.ret = 0;
+
+    for(i = 0; i < worker_cnt; i++)
+    {
+        w[i].q = &q;
+        w[i].worker_idx = i;
+    }
+    for(i = 1; i < worker_cnt; i++)
+    {
+        if(tc->run(pool[i], task_worker, (void *)&w[i]) != THREAD_SUCCESS)
+        {
+            /* remaining tasks are picked up by the threads already running */
+            break;
+        }
+    }
+    worker_cnt = i;
+
+    task_worker((void *)&w[0]);
+
+    for(i = 1; i < worker_cnt; i++)
+    {
+        tc->join(pool[i], &res);
+    }
+    return q.ret;
+}
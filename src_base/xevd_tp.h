@@ -31,6 +31,8 @@
 #ifndef _XEVD_TP_
 #define _XEVD_TP_
 
+#include <stdint.h>
+
 typedef void* POOL_THREAD;
 typedef int (*THREAD_ENTRY) (void * arg);
 typedef struct _THREAD_CONTROLLER THREAD_CONTROLLER;
@@ -84,9 +86,32 @@ THREAD_RESULT xevd_dinit_thread_controller(THREAD_CONTROLLER * tc);
 
 SYNC_OBJ xevd_get_synchronized_object();
 THREAD_RESULT xevd_release_synchornized_object(SYNC_OBJ * sobj); //sync object will be deleted
-int  xevd_spinlock_wait(volatile int * addr, int val);
+//wait until *addr == val (or -1); time spent waiting is added to *wait_cycles when not NULL
+int  xevd_spinlock_wait(volatile int * addr, int val, uint64_t * wait_cycles);
+//wait until *addr >= val (or -1)
+int  xevd_progress_wait(volatile int * addr, int val, uint64_t * wait_cycles);
 void xevd_threadsafe_assign(volatile int * addr, int val);
 int  xevd_threadsafe_decrement(SYNC_OBJ sobj, volatile int * pcnt);
+//load *addr with acquire semantics
+int  xevd_threadsafe_read(volatile int * addr);
+//set *addr from 0 to 1 without blocking; returns 1 on success. release with xevd_threadsafe_assign(addr, 0)
+int  xevd_threadsafe_trylock(volatile int * addr);
+
+//task body of xevd_parallel_for(): task_idx is the task to process, worker_idx
+//identifies the executing thread (0 is the calling thread, i uses pool[i])
+typedef int (*THREAD_TASK)(void * arg, int task_idx, int worker_idx);
+//run task for every index in [0, task_cnt) on the calling thread plus pool[1..worker_cnt-1].
+//workers pull the next pending index from a shared counter, so uneven tasks do not
+//leave threads idle until a batch is joined. indices are handed out in increasing order,
+//so a task may wait for lower-indexed ones. returns 0, or a negative result of a failed task
+int  xevd_parallel_for(THREAD_CONTROLLER * tc, POOL_THREAD * pool, int worker_cnt, int task_cnt, THREAD_TASK task, void * arg);
+
+//time stamp used by the wait, busy and join counters
+uint64_t xevd_get_cycles(void);
+//monotonic wall clock in nanoseconds, to give xevd_get_cycles() a unit
+uint64_t xevd_get_nsec(void);
+//time the pool thread spent running tasks, and time callers spent in join() for it
+void xevd_thread_cycles(POOL_THREAD thread_id, uint64_t * busy_cycles, uint64_t * join_cycles);
 
 #endif
 
@@ -99,9 +99,52 @@ int xevd_check_cpu_info()
 }
 #endif
 
+/* instruction set used by a decoder instance, selected at its creation */
+int xevd_isa_select(int isa)
+{
+    int best = XEVD_ISA_C;
+    const char * env;
+
+#if ARM_NEON
+    best = XEVD_ISA_NEON;
+#elif X86_SSE
+    int check_cpu = xevd_check_cpu_info();
+
+    if((check_cpu >> 2) & 1) best = XEVD_ISA_AVX2;
+    else if((check_cpu >> 1) & 1) best = XEVD_ISA_SSE;
+#endif
+
+    if(isa == XEVD_ISA_AUTO && (env = getenv("XEVD_ISA")) != NULL)
+    {
+        if(!strcmp(env, "c")) isa = XEVD_ISA_C;
+        else if(!strcmp(env, "sse")) isa = XEVD_ISA_SSE;
+        else if(!strcmp(env, "avx2")) isa = XEVD_ISA_AVX2;
+        else if(!strcmp(env, "neon")) isa = XEVD_ISA_NEON;
+    }
+
+    if(isa == XEVD_ISA_AUTO)
+    {
+        return best;
+    }
+    if(isa == XEVD_ISA_NEON || best == XEVD_ISA_NEON)
+    {
+        /* NEON and the x86 levels do not mix; a missing one falls to C */
+        return isa == best ? isa : XEVD_ISA_C;
+    }
+    return XEVD_MIN(isa, best);
+}
+
+/* XEVD_IMGB together with the allocator of its planes */
+typedef struct _IMGB_EXT
+{
+    XEVD_IMGB       imgb;
+    XEVD_IMGB_ALLOC alloc;
+} IMGB_EXT;
+
 static void imgb_delete(XEVD_IMGB * imgb)
 {
     int i;
+    IMGB_EXT * ext = (IMGB_EXT *)imgb;
     xevd_assert_r(imgb);
 
     if(imgb->ndata[XEVD_IMGB_SEI_SLOT] == XEVD_SEI_MAGIC && imgb->pdata[XEVD_IMGB_SEI_SLOT])
@@ -111,9 +154,16 @@ static void imgb_delete(XEVD_IMGB * imgb)
         imgb->ndata[XEVD_IMGB_SEI_SLOT] = 0;
     }
 
-    for(i=0; i<XEVD_IMGB_MAX_PLANE; i++)
+    if(ext->alloc.fn_free)
+    {
+        ext->alloc.fn_free(ext->alloc.user, imgb);
+    }
+    else
     {
-        if (imgb->baddr[i]) xevd_mfree(imgb->baddr[i]);
+        for(i=0; i<XEVD_IMGB_MAX_PLANE; i++)
+        {
+            if (imgb->baddr[i]) xevd_mfree(imgb->baddr[i]);
+        }
     }
     xevd_mfree(imgb);
 }
@@ -142,22 +192,34 @@ static int imgb_release(XEVD_IMGB * imgb)
     return refcnt;
 }
 
+/* color space of the picture buffers; it follows the size of pel */
 const int xevd_chroma_format_idc_to_imgb_cs[4] =
 {
+#if XEVD_PEL_8BIT
+    XEVD_CS_YCBCR400,
+    XEVD_CS_YCBCR420,
+    XEVD_CS_YCBCR422,
+    XEVD_CS_YCBCR444
+#else
     XEVD_CS_YCBCR400_10LE,
     XEVD_CS_YCBCR420_10LE,
     XEVD_CS_YCBCR422_10LE,
     XEVD_CS_YCBCR444_10LE
+#endif
 };
 
-XEVD_IMGB * xevd_imgb_create(int w, int h, int cs, int opt, int pad[XEVD_IMGB_MAX_PLANE], int align[XEVD_IMGB_MAX_PLANE])
+/* the planes are taken from ia when it is not NULL */
+XEVD_IMGB * xevd_imgb_create(int w, int h, int cs, int opt, int pad[XEVD_IMGB_MAX_PLANE], int align[XEVD_IMGB_MAX_PLANE]
+                           , const XEVD_IMGB_ALLOC * ia)
 {
     int i, p_size, a_size, bd;
     XEVD_IMGB * imgb;
+    IMGB_EXT  * ext;
 
-    imgb = (XEVD_IMGB *)xevd_malloc(sizeof(XEVD_IMGB));
-    xevd_assert_rv(imgb, NULL);
-    xevd_mset(imgb, 0, sizeof(XEVD_IMGB));
+    ext = (IMGB_EXT *)xevd_malloc(sizeof(IMGB_EXT));
+    xevd_assert_rv(ext, NULL);
+    xevd_mset(ext, 0, sizeof(IMGB_EXT));
+    imgb = &ext->imgb;
     imgb->imgb_active_pps_id = -1;
     imgb->imgb_active_aps_id = -1;
 
@@ -165,6 +227,13 @@ XEVD_IMGB * xevd_imgb_create(int w, int h, int cs, int opt, int pad[XEVD_IMGB_MA
     int bit_depth = (XEVD_CS_GET_BIT_DEPTH(cs));
     int idc = XEVD_CS_GET_FORMAT(cs);
     int np = idc == XEVD_CF_YCBCR400 ? 1 : 3;
+    int spl = 1; /* samples per position, 2 in the Cb/Cr plane of NV12/P010 */
+
+    if(idc == XEVD_CF_YCBCR420_NV12 || idc == XEVD_CF_YCBCR420_P010)
+    {
+        idc = XEVD_CF_YCBCR420;
+        np = 2;
+    }
 
     if(bit_depth >= 8 && bit_depth <= 14)
     {
@@ -193,17 +262,21 @@ XEVD_IMGB * xevd_imgb_create(int w, int h, int cs, int opt, int pad[XEVD_IMGB_MA
             }
             imgb->padl[i] = imgb->padr[i]=imgb->padu[i]=imgb->padb[i]=p_size;
 
-            imgb->s[i] = (imgb->aw[i] + imgb->padl[i] + imgb->padr[i]) * bd;
+            imgb->s[i] = (imgb->aw[i] + imgb->padl[i] + imgb->padr[i]) * bd * spl;
             imgb->e[i] = imgb->ah[i] + imgb->padu[i] + imgb->padb[i];
 
-            imgb->bsize[i] = imgb->s[i]*imgb->e[i];
-            imgb->baddr[i] = xevd_malloc(imgb->bsize[i]);
+            if(ia == NULL)
+            {
+                imgb->bsize[i] = imgb->s[i]*imgb->e[i];
+                imgb->baddr[i] = xevd_malloc(imgb->bsize[i]);
 
-            imgb->a[i] = ((u8*)imgb->baddr[i]) + imgb->padu[i]*imgb->s[i] +
-                imgb->padl[i]*bd;
+                imgb->a[i] = ((u8*)imgb->baddr[i]) + imgb->padu[i]*imgb->s[i] +
+                    imgb->padl[i]*bd*spl;
+            }
 
             if(i == 0)
             {
+                if(np == 2) spl = 2;
 
                 if((XEVD_GET_CHROMA_W_SHIFT(idc-10)))
                     w = (w + 1) >> (XEVD_GET_CHROMA_W_SHIFT(idc-10));
@@ -220,10 +293,38 @@ XEVD_IMGB * xevd_imgb_create(int w, int h, int cs, int opt, int pad[XEVD_IMGB_MA
         xevd_mfree(imgb);
         return NULL;
     }
+    imgb->cs = cs;
+
+    if(ia != NULL)
+    {
+        int s_min[XEVD_IMGB_MAX_PLANE], e_min[XEVD_IMGB_MAX_PLANE];
+
+        for(i = 0; i < np; i++)
+        {
+            s_min[i] = imgb->s[i];
+            e_min[i] = imgb->e[i];
+        }
+        if(XEVD_FAILED(ia->fn_alloc(ia->user, imgb)))
+        {
+            xevd_trace("picture buffer allocation of the application failed\n");
+            xevd_mfree(imgb);
+            return NULL;
+        }
+        ext->alloc = *ia;
+
+        for(i = 0; i < np; i++)
+        {
+            if(imgb->a[i] == NULL || imgb->s[i] < s_min[i] || imgb->s[i] % bd || imgb->e[i] < e_min[i])
+            {
+                xevd_trace("picture buffer of the application does not fit\n");
+                imgb_delete(imgb);
+                return NULL;
+            }
+        }
+    }
     imgb->addref = imgb_addref;
     imgb->getref = imgb_getref;
     imgb->release = imgb_release;
-    imgb->cs = cs;
     imgb->addref(imgb);
 
     return imgb;
@@ -247,7 +348,7 @@ int xevd_atomic_dec(volatile int *pcnt)
     return ret;
 }
 
-XEVD_PIC * xevd_picbuf_lc_alloc(int w, int h, int pad_l, int pad_c, int *err, int idc, int bit_depth)
+XEVD_PIC * xevd_picbuf_lc_alloc(int w, int h, int pad_l, int pad_c, int *err, int idc, int bit_depth, const XEVD_IMGB_ALLOC * ia)
 {
     XEVD_PIC *pic = NULL;
     XEVD_IMGB *imgb = NULL;
@@ -273,8 +374,8 @@ XEVD_PIC * xevd_picbuf_lc_alloc(int w, int h, int pad_l, int pad_c, int *err, in
 
 
 
-    int cs = idc == 0 ? XEVD_CS_YCBCR400_10LE : (idc == 1 ? XEVD_CS_YCBCR420_10LE : (idc == 2 ? XEVD_CS_YCBCR422_10LE : XEVD_CS_YCBCR444_10LE));
-    imgb = xevd_imgb_create(w, h, cs, opt, pad, align);
+    int cs = xevd_chroma_format_idc_to_imgb_cs[idc];
+    imgb = xevd_imgb_create(w, h, cs, opt, pad, align, ia);
 
 
     xevd_assert_gv(imgb != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
@@ -362,17 +463,19 @@ void xevd_picbuf_lc_free(XEVD_PIC *pic)
     }
 }
 
-static void picbuf_expand(pel *a, int s, int w, int h, int exp)
+/* pad the sample rows [y0, y1) of a plane horizontally; the area above and
+   below the plane is filled when the range includes its first or last row */
+static void picbuf_expand_rows(pel *a, int s, int w, int h, int exp, int y0, int y1)
 {
     int i, j;
     pel pixel;
     pel *src, *dst;
 
     /* left */
-    src = a;
-    dst = a - exp;
+    src = a + y0 * s;
+    dst = a + y0 * s - exp;
 
-    for(i = 0; i < h; i++)
+    for(i = y0; i < y1; i++)
     {
         pixel = *src; /* get boundary pixel */
         for(j = 0; j < exp; j++)
@@ -384,10 +487,10 @@ static void picbuf_expand(pel *a, int s, int w, int h, int exp)
     }
 
     /* right */
-    src = a + (w - 1);
-    dst = a + w;
+    src = a + y0 * s + (w - 1);
+    dst = a + y0 * s + w;
 
-    for(i = 0; i < h; i++)
+    for(i = y0; i < y1; i++)
     {
         pixel = *src; /* get boundary pixel */
         for(j = 0; j < exp; j++)
@@ -399,26 +502,37 @@ static void picbuf_expand(pel *a, int s, int w, int h, int exp)
     }
 
     /* upper */
-    src = a - exp;
-    dst = a - exp - (exp * s);
-
-    for(i = 0; i < exp; i++)
+    if(y0 == 0)
     {
-        xevd_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        src = a - exp;
+        dst = a - exp - (exp * s);
+
+        for(i = 0; i < exp; i++)
+        {
+            xevd_mcpy(dst, src, s*sizeof(pel));
+            dst += s;
+        }
     }
 
     /* below */
-    src = a + ((h - 1)*s) - exp;
-    dst = a + ((h - 1)*s) - exp + s;
-
-    for(i = 0; i < exp; i++)
+    if(y1 == h)
     {
-        xevd_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        src = a + ((h - 1)*s) - exp;
+        dst = a + ((h - 1)*s) - exp + s;
+
+        for(i = 0; i < exp; i++)
+        {
+            xevd_mcpy(dst, src, s*sizeof(pel));
+            dst += s;
+        }
     }
 }
 
+static void picbuf_expand(pel *a, int s, int w, int h, int exp)
+{
+    picbuf_expand_rows(a, s, w, h, exp, 0, h);
+}
+
 void xevd_picbuf_lc_expand(XEVD_PIC *pic, int exp_l, int exp_c)
 {
     picbuf_expand(pic->y, pic->s_l, pic->w_l, pic->h_l, exp_l);
@@ -982,17 +1096,47 @@ void xevd_md5_finish(XEVD_MD5 *md5, u8 digest[16])
     xevd_mset(md5, 0, sizeof(XEVD_MD5));
 }
 
+/* picture hashes are defined on 16-bit little-endian samples, so 8-bit
+   samples are widened before they are hashed */
+static void md5_update_8b(XEVD_MD5 *md5, u8 *buf, int w)
+{
+    u8 t[128];
+    int i, n;
+
+    while(w > 0)
+    {
+        n = XEVD_MIN(w, 64);
+        for(i = 0; i < n; i++)
+        {
+            t[2 * i] = buf[i];
+            t[2 * i + 1] = 0;
+        }
+        xevd_md5_update(md5, t, n * 2);
+        buf += n;
+        w -= n;
+    }
+}
+
 int xevd_md5_imgb(XEVD_IMGB *imgb, u8 digest[N_C][16])
 {
     XEVD_MD5 md5[N_C];
     int i, j;
+    int bd = XEVD_CS_GET_BYTE_DEPTH(imgb->cs);
+
     for(i = 0; i < imgb->np; i++)
     {
         xevd_md5_init(&md5[i]);
 
         for(j = imgb->y[i]; j < imgb->h[i]; j++)
         {
-            xevd_md5_update(&md5[i], ((u8 *)imgb->a[i]) + j*imgb->s[i] + imgb->x[i] , imgb->w[i] * 2);
+            if(bd == 1)
+            {
+                md5_update_8b(&md5[i], ((u8 *)imgb->a[i]) + j*imgb->s[i] + imgb->x[i], imgb->w[i]);
+            }
+            else
+            {
+                xevd_md5_update(&md5[i], ((u8 *)imgb->a[i]) + j*imgb->s[i] + imgb->x[i] , imgb->w[i] * 2);
+            }
         }
 
         xevd_md5_finish(&md5[i], digest[i]);
@@ -1478,20 +1622,125 @@ void xevd_block_copy(s16 * src, int src_stride, s16 * dst, int dst_stride, int l
     }
 }
 
+void xevd_core_buf_set(XEVD_CORE * core, XEVD_CORE_BUF * buf)
+{
+    core->buf = buf;
+    core->coef = buf->coef;
+    core->pred = buf->pred;
+    core->nb = buf->nb;
+    core->eif_tmp_buffer = buf->eif_tmp_buffer;
+}
+
+/* copy the slice state of a core; dst keeps its own scratch buffers */
+void xevd_core_copy(XEVD_CORE * dst, XEVD_CORE * src)
+{
+    XEVD_CORE_BUF * buf = dst->buf;
+
+    xevd_mcpy(dst, src, sizeof(XEVD_CORE));
+    xevd_core_buf_set(dst, buf);
+}
+
+int xevd_coef_pack(XEVD_CU_DATA * cu_data, int cup, int c, s16 * coef, int cnt)
+{
+    s16 *dst;
+    int  i, n = 0;
+
+    for(i = 0; i < cnt; i++)
+    {
+        n += (coef[i] != 0);
+    }
+    if(n == 0)
+    {
+        cu_data->coef_ofs[c][cup] = -1;
+        return XEVD_OK;
+    }
+
+    if(cu_data->coef_cnt + 1 + 2 * n > cu_data->coef_size)
+    {
+        int size = XEVD_MAX(cu_data->coef_size << 1, cu_data->coef_cnt + 1 + 2 * n);
+
+        dst = (s16 *)xevd_malloc_fast(size * sizeof(s16));
+        xevd_assert_rv(dst, XEVD_ERR_OUT_OF_MEMORY);
+        xevd_mcpy(dst, cu_data->coef, cu_data->coef_cnt * sizeof(s16));
+        xevd_mfree_fast(cu_data->coef);
+        cu_data->coef = dst;
+        cu_data->coef_size = size;
+    }
+
+    cu_data->coef_ofs[c][cup] = cu_data->coef_cnt;
+    dst = cu_data->coef + cu_data->coef_cnt;
+    *dst++ = (s16)n;
+    for(i = 0; i < cnt; i++)
+    {
+        if(coef[i])
+        {
+            *dst++ = (s16)i;
+            *dst++ = coef[i];
+        }
+    }
+    cu_data->coef_cnt += 1 + 2 * n;
+    return XEVD_OK;
+}
+
+void xevd_coef_unpack(XEVD_CU_DATA * cu_data, int cup, int c, s16 * coef, int cnt)
+{
+    int ofs = cu_data->coef_ofs[c][cup];
+    s16 *src;
+    int  n;
+
+    xevd_mset(coef, 0, cnt * sizeof(s16));
+    if(ofs < 0)
+    {
+        return;
+    }
+    src = cu_data->coef + ofs;
+    for(n = *src++; n > 0; n--, src += 2)
+    {
+        coef[src[0]] = src[1];
+    }
+}
+
 int xevd_get_luma_cup(int x_scu, int y_scu, int cu_w_scu, int cu_h_scu, int w_scu)
 {
     return (y_scu + (cu_h_scu >> 1)) * w_scu + x_scu + (cu_w_scu >> 1);
 }
 
 
+/* xevd_parallel_for() task: pad one color plane */
+static int picbuf_expand_task(void * arg, int task_idx, int worker_idx)
+{
+    XEVD_PIC * pic = (XEVD_PIC *)arg;
+
+    if(task_idx == Y_C) picbuf_expand(pic->y, pic->s_l, pic->w_l, pic->h_l, pic->pad_l);
+    else if(task_idx == U_C) picbuf_expand(pic->u, pic->s_c, pic->w_c, pic->h_c, pic->pad_c);
+    else picbuf_expand(pic->v, pic->s_c, pic->w_c, pic->h_c, pic->pad_c);
+    return XEVD_OK;
+}
+
 void xevd_picbuf_expand(XEVD_CTX * ctx, XEVD_PIC * pic)
 {
-    xevd_picbuf_lc_expand(pic, pic->pad_l, pic->pad_c);
+    xevd_parallel_for(&ctx->tc, ctx->thread_pool, ctx->tc.max_task_cnt, N_C, picbuf_expand_task, (void *)pic);
+}
+
+/* pad the CTU rows [row0, row1) of all planes of pic on the calling thread */
+void xevd_picbuf_expand_rows(XEVD_CTX * ctx, XEVD_PIC * pic, int row0, int row1)
+{
+    int y0, y1, h_shift;
+
+    y0 = row0 << ctx->log2_max_cuwh;
+    y1 = XEVD_MIN(pic->h_l, row1 << ctx->log2_max_cuwh);
+    picbuf_expand_rows(pic->y, pic->s_l, pic->w_l, pic->h_l, pic->pad_l, y0, y1);
+
+    h_shift = XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc);
+    y0 >>= h_shift;
+    y1 = (y1 == pic->h_l) ? pic->h_c : (y1 >> h_shift);
+    picbuf_expand_rows(pic->u, pic->s_c, pic->w_c, pic->h_c, pic->pad_c, y0, y1);
+    picbuf_expand_rows(pic->v, pic->s_c, pic->w_c, pic->h_c, pic->pad_c, y0, y1);
 }
 
 XEVD_PIC * xevd_picbuf_alloc(PICBUF_ALLOCATOR * pa, int * ret, int bit_depth)
 {
-    return xevd_picbuf_lc_alloc(pa->w, pa->h, pa->pad_l, pa->pad_c, ret, pa->idc, bit_depth);
+    return xevd_picbuf_lc_alloc(pa->w, pa->h, pa->pad_l, pa->pad_c, ret, pa->idc, bit_depth, pa->imgb_alloc);
 }
 
 void xevd_picbuf_free(PICBUF_ALLOCATOR * pa, XEVD_PIC * pic)
@@ -1623,7 +1872,7 @@ void xevd_set_dec_info(XEVD_CTX * ctx, XEVD_CORE * core)
 
     MCU_SET_LOGW(map_cu_mode[0], core->log2_cuw);
     MCU_SET_LOGH(map_cu_mode[0], core->log2_cuh);
-    MCU_SET_IF_SN_QP(map_scu[0], flag, ctx->slice_num, core->qp);
+    MCU_SET_IF_SN_QP(map_scu[0], flag, core->slice_num, core->qp);
     map_refi[0][REFP_0] = core->refi[REFP_0];
     map_refi[0][REFP_1] = core->refi[REFP_1];
 
@@ -1689,6 +1938,109 @@ void xevd_set_dec_info(XEVD_CTX * ctx, XEVD_CORE * core)
 #endif
 }
 
+void xevd_get_thread_stat(XEVD_CTX * ctx, XEVD_THREAD_STAT * ts)
+{
+    u64 busy, join, join_all = 0;
+    int i;
+
+    xevd_mset(ts, 0, sizeof(XEVD_THREAD_STAT));
+    ts->threads = XEVD_MAX(1, ctx->tc.max_task_cnt);
+    ts->dec_cycles = (long long)ctx->dec_cycles;
+
+    /* pool threads: tasks run minus blocking inside them */
+    for(i = 1; i < ts->threads; i++)
+    {
+        xevd_thread_cycles(ctx->thread_pool[i], &busy, &join);
+        join_all += join;
+        ts->busy_cycles[i] = (long long)(busy - XEVD_MIN(busy, ctx->wait_cycles[i]));
+        ts->wait_cycles[i] = (long long)ctx->wait_cycles[i];
+    }
+
+    /* calling thread: whole decoding time minus blocking and joins */
+    busy = ctx->wait_cycles[0] + join_all;
+    ts->busy_cycles[0] = (long long)(ctx->dec_cycles - XEVD_MIN(ctx->dec_cycles, busy));
+    ts->wait_cycles[0] = (long long)busy;
+}
+
+void xevd_perf_end(XEVD_CTX * ctx, int thread_idx, int stage, int arg, u64 beg)
+{
+    u64 end = xevd_get_cycles();
+
+    if(ctx->perf_on & XEVD_PERF_COUNT)
+    {
+        ctx->perf_cycles[thread_idx][stage] += end - beg;
+    }
+    if(ctx->perf_on & XEVD_PERF_TL)
+    {
+        xevd_tl_add(ctx, thread_idx, stage, arg, beg, end);
+    }
+}
+
+void xevd_perf_reset(XEVD_CTX * ctx, int on)
+{
+    u64 busy;
+    int i;
+
+    xevd_mset(ctx->perf_cycles, 0, sizeof(ctx->perf_cycles));
+    xevd_mset(ctx->perf_pic_beg, 0, sizeof(ctx->perf_pic_beg));
+    xevd_mset(ctx->perf_pic, 0, sizeof(ctx->perf_pic));
+    ctx->perf_pics = 0;
+    for(i = 0; i < XEVD_MAX_TASK_CNT; i++)
+    {
+        ctx->perf_wait_beg[i] = ctx->wait_cycles[i];
+        ctx->perf_join_beg[i] = 0;
+        if(i > 0 && i < ctx->tc.max_task_cnt)
+        {
+            xevd_thread_cycles(ctx->thread_pool[i], &busy, &ctx->perf_join_beg[i]);
+        }
+    }
+    ctx->perf_on = (ctx->perf_on & ~XEVD_PERF_COUNT) | (on ? XEVD_PERF_COUNT : 0);
+}
+
+/* close the per-picture counters of XEVD_PERF_STATS */
+void xevd_perf_pic_done(XEVD_CTX * ctx)
+{
+    u64 sum;
+    int i, j;
+
+    if(!(ctx->perf_on & XEVD_PERF_COUNT)) return;
+
+    for(j = 0; j < XEVD_PERF_NUM; j++)
+    {
+        sum = 0;
+        for(i = 0; i < XEVD_MAX_TASK_CNT; i++) sum += ctx->perf_cycles[i][j];
+        ctx->perf_pic[j] = sum - ctx->perf_pic_beg[j];
+        ctx->perf_pic_beg[j] = sum;
+    }
+    ctx->perf_pics++;
+}
+
+void xevd_get_perf_stats(XEVD_CTX * ctx, XEVD_PERF_STATS * ps)
+{
+    u64 busy, join;
+    int i, j;
+
+    xevd_mset(ps, 0, sizeof(XEVD_PERF_STATS));
+    ps->on = (ctx->perf_on & XEVD_PERF_COUNT) ? 1 : 0;
+    ps->pics = ctx->perf_pics;
+    ps->threads = XEVD_MAX(1, ctx->tc.max_task_cnt);
+
+    for(j = 0; j < XEVD_PERF_NUM; j++)
+    {
+        for(i = 0; i < XEVD_MAX_TASK_CNT; i++) ps->cycles[j] += (long long)ctx->perf_cycles[i][j];
+        ps->pic_cycles[j] = (long long)ctx->perf_pic[j];
+    }
+    for(i = 0; i < ps->threads; i++)
+    {
+        ps->wait_cycles[i] = (long long)(ctx->wait_cycles[i] - ctx->perf_wait_beg[i]);
+        if(i > 0)
+        {
+            xevd_thread_cycles(ctx->thread_pool[i], &busy, &join);
+            ps->join_cycles[i] = (long long)(join - ctx->perf_join_beg[i]);
+        }
+    }
+}
+
 
 int xevd_info(void * bits, int bits_size, int is_annexb, XEVD_INFO * info)
 {
@@ -1727,3 +2079,89 @@ int xevd_info(void * bits, int bits_size, int is_annexb, XEVD_INFO * info)
     return XEVD_OK;
 }
 
+int xevd_find_start_code(void * buf, int size)
+{
+    u8 * p = (u8 *)buf, * q;
+    int  i = 2;
+
+    /* memchr() is vectorized by the C library, so only 0x01 bytes are visited */
+    while(i < size)
+    {
+        q = (u8 *)memchr(p + i, 1, (size_t)(size - i));
+        if(q == NULL) break;
+        i = (int)(q - p);
+        if(p[i - 1] == 0 && p[i - 2] == 0) return i - 2;
+        /* the next 01 can end a start code at three bytes from here */
+        i += 3;
+    }
+    return size;
+}
+
+/* find the NAL unit starting at *pos of buf (fmt is XEVD_NALU_FMT_XXX).
+   returns its byte size and sets *beg to its offset and *pos past it, or 0
+   when no NAL unit is left */
+int xevd_nalu_split(u8 * buf, int size, int fmt, int * pos, int * beg)
+{
+    int i, len;
+
+    i = *pos;
+    if(fmt == XEVD_NALU_FMT_LENGTH)
+    {
+        if(i >= size) return 0;
+        xevd_assert_rv(size - i > XEVD_NAL_UNIT_LENGTH_BYTE, XEVD_ERR_MALFORMED_BITSTREAM);
+        len = (int)(((u32)buf[i] << 24) | ((u32)buf[i + 1] << 16) | ((u32)buf[i + 2] << 8) | (u32)buf[i + 3]);
+        i += XEVD_NAL_UNIT_LENGTH_BYTE;
+        xevd_assert_rv(len > 0 && len <= size - i, XEVD_ERR_MALFORMED_BITSTREAM);
+        *beg = i;
+        *pos = i + len;
+        return len;
+    }
+    xevd_assert_rv(fmt == XEVD_NALU_FMT_START_CODE, XEVD_ERR_INVALID_ARGUMENT);
+
+    i += xevd_find_start_code(buf + i, size - i);
+    if(i >= size) return 0;
+    *beg = i + 3;
+    i = *beg + xevd_find_start_code(buf + *beg, size - *beg);
+    *pos = i;
+
+    /* trailing_zero_8bits and the leading zero of a 4-byte start code */
+    while(i > *beg && buf[i - 1] == 0) i--;
+    return i - *beg;
+}
+
+int xevd_decode_nalus(XEVD id, XEVD_BITB * bitb, int fmt, XEVD_NALU_STAT * nstat, int * nstat_cnt)
+{
+    XEVD_BITB bitb_nalu;
+    int       pos = 0, beg = 0, size, cnt = 0, ret = XEVD_OK;
+
+    xevd_mcpy(&bitb_nalu, bitb, sizeof(XEVD_BITB));
+    while(1)
+    {
+        size = xevd_nalu_split((u8 *)bitb->addr, bitb->ssize, fmt, &pos, &beg);
+        if(size <= 0)
+        {
+            ret = size;
+            break;
+        }
+        if(cnt == *nstat_cnt)
+        {
+            ret = XEVD_ERR_REACHED_MAX;
+            break;
+        }
+
+        bitb_nalu.addr = (u8 *)bitb->addr + beg;
+        bitb_nalu.bsize = bitb_nalu.ssize = size;
+        xevd_mset(&nstat[cnt].stat, 0, sizeof(XEVD_STAT));
+        nstat[cnt].offset = beg;
+        nstat[cnt].size = size;
+        nstat[cnt].ret = xevd_decode(id, &bitb_nalu, &nstat[cnt].stat);
+        if(XEVD_FAILED(nstat[cnt++].ret))
+        {
+            ret = nstat[cnt - 1].ret;
+            break;
+        }
+    }
+    *nstat_cnt = cnt;
+    return ret;
+}
+
@@ -90,10 +90,11 @@ operation: if(sign == 0) return val, else if(sign == 1) return -val */
     (((idc+10)==XEVD_CF_YCBCR400) ? 1 : (((idc+10)==XEVD_CF_YCBCR420) ? 1 : 0))
 
 /* create image buffer */
-XEVD_IMGB * xevd_imgb_create(int w, int h, int cs, int opt, int pad[XEVD_IMGB_MAX_PLANE], int align[XEVD_IMGB_MAX_PLANE]);
+XEVD_IMGB * xevd_imgb_create(int w, int h, int cs, int opt, int pad[XEVD_IMGB_MAX_PLANE], int align[XEVD_IMGB_MAX_PLANE]
+                           , const XEVD_IMGB_ALLOC * ia);
 u16 xevd_get_avail_inter(int x_scu, int y_scu, int w_scu, int h_scu, int scup, int cuw, int cuh, u32 *map_scu, u8* map_tidx);
 u16 xevd_get_avail_intra(int x_scu, int y_scu, int w_scu, int h_scu, int scup, int log2_cuw, int log2_cuh, u32 *map_scu, u8* map_tidx);
-XEVD_PIC* xevd_picbuf_lc_alloc(int w, int h, int pad_l, int pad_c, int *err, int idc, int bit_depth);
+XEVD_PIC* xevd_picbuf_lc_alloc(int w, int h, int pad_l, int pad_c, int *err, int idc, int bit_depth, const XEVD_IMGB_ALLOC * ia);
 void xevd_picbuf_lc_free(XEVD_PIC *pic);
 void xevd_sei_attach(XEVD_CTX * ctx, XEVD_IMGB * imgb);
 void xevd_picbuf_lc_expand(XEVD_PIC *pic, int exp_l, int exp_c);
@@ -170,17 +171,41 @@ void xevd_eco_sbac_ctx_initialize(SBAC_CTX_MODEL *ctx, s16 *ctx_init_model, u16
 
 BOOL xevd_check_bi_applicability(int slice_type, int cuw, int cuh);
 void xevd_block_copy(s16 * src, int src_stride, s16 * dst, int dst_stride, int log2_copy_w, int log2_copy_h);
+void xevd_core_buf_set(XEVD_CORE * core, XEVD_CORE_BUF * buf);
+void xevd_core_copy(XEVD_CORE * dst, XEVD_CORE * src);
+int  xevd_coef_pack(XEVD_CU_DATA * cu_data, int cup, int c, s16 * coef, int cnt);
+void xevd_coef_unpack(XEVD_CU_DATA * cu_data, int cup, int c, s16 * coef, int cnt);
 int xevd_get_luma_cup(int x_scu, int y_scu, int cu_w_scu, int cu_h_scu, int w_scu);
 
 extern const int xevd_chroma_format_idc_to_imgb_cs[4];
 
 void xevd_picbuf_expand(XEVD_CTX * ctx, XEVD_PIC * pic);
+void xevd_picbuf_expand_rows(XEVD_CTX * ctx, XEVD_PIC * pic, int row0, int row1);
 XEVD_PIC * xevd_picbuf_alloc(PICBUF_ALLOCATOR * pa, int * ret, int bit_depth);
 void xevd_picbuf_free(PICBUF_ALLOCATOR * pa, XEVD_PIC * pic);
 int xevd_picbuf_check_signature(XEVD_PIC * pic, u8 signature[N_C][16], int bit_depth);
+int xevd_nalu_split(u8 * buf, int size, int fmt, int * pos, int * beg);
+/* decodes the NAL units of bitb one by one (xevd_decode_au()) */
+int xevd_decode_nalus(XEVD id, XEVD_BITB * bitb, int fmt, XEVD_NALU_STAT * nstat, int * nstat_cnt);
 
 /* set decoded information, such as MVs, inter_dir, etc. */
 void xevd_set_dec_info(XEVD_CTX * ctx, XEVD_CORE * core);
+void xevd_get_thread_stat(XEVD_CTX * ctx, XEVD_THREAD_STAT * ts);
+
+/* stage timing of XEVD_CFG_GET_PERF_STATS and XEVD_CFG_SET_TIMELINE; only a
+   test of perf_on when both are off */
+#define XEVD_PERF_BEG(ctx, t) \
+    ((t) = (ctx)->perf_on ? xevd_get_cycles() : 0)
+#define XEVD_PERF_END(ctx, thread_idx, stage, t) \
+    XEVD_TL_END(ctx, thread_idx, stage, -1, t)
+/* XEVD_PERF_END giving the tile, CTU or CTU row of the timeline event */
+#define XEVD_TL_END(ctx, thread_idx, stage, arg, t) \
+    {if(t) xevd_perf_end(ctx, thread_idx, stage, arg, t);}
+
+void xevd_perf_end(XEVD_CTX * ctx, int thread_idx, int stage, int arg, u64 beg);
+void xevd_perf_reset(XEVD_CTX * ctx, int on);
+void xevd_perf_pic_done(XEVD_CTX * ctx);
+void xevd_get_perf_stats(XEVD_CTX * ctx, XEVD_PERF_STATS * ps);
 
 #define XEVD_CPU_INFO_SSE2     0x7A // ((3 << 5) | 26)
 #define XEVD_CPU_INFO_SSE3     0x40 // ((2 << 5) |  0)
@@ -191,5 +216,6 @@ void xevd_set_dec_info(XEVD_CTX * ctx, XEVD_CORE * core);
 #define XEVD_CPU_INFO_AVX2     0x25 // ((1 << 5) |  5)
 
 int  xevd_check_cpu_info();
+int  xevd_isa_select(int isa);
 
 #endif /* _XEVD_UTIL_H_ */
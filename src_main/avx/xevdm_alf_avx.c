@@ -0,0 +1,364 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+   /*
+      Redistribution and use in source and binary forms, with or without
+      modification, are permitted provided that the following conditions are met:
+
+      - Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+      - Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+      - Neither the name of the copyright owner, nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+      AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+      IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+      ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+      LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+      CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+      SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+      INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+      CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+      ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+      POSSIBILITY OF SUCH DAMAGE.
+   */
+
+#include "xevdm_alf.h"
+#include "xevdm_alf_avx.h"
+
+#if X86_SSE && !XEVD_PEL_8BIT
+
+#define ALF_SHIFT          9
+#define ALF_OFFSET         (1 << (ALF_SHIFT - 1))
+
+/* coefficient order of the 7x7 diamond for each transpose index */
+static const int alf_tbl_trans_7[4][MAX_NUM_ALF_LUMA_COEFF] =
+{
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+    { 9, 4, 10, 8, 1, 5, 11, 7, 3, 0, 2, 6, 12 },
+    { 0, 3, 2, 1, 8, 7, 6, 5, 4, 9, 10, 11, 12 },
+    { 9, 8, 10, 4, 3, 7, 11, 5, 1, 0, 2, 6, 12 }
+};
+
+#define ALF_COEF_PAIR(c0, c1)  (((int)(c1) << 16) | ((c0) & 0xFFFF))
+
+#define ALF_LOAD_256(p)        _mm256_loadu_si256((const __m256i *)(p))
+#define ALF_SYM_256(p, o)      _mm256_add_epi16(ALF_LOAD_256((p) + (o)), ALF_LOAD_256((p) - (o)))
+#define ALF_LOAD_64(p)         _mm_loadl_epi64((const __m128i *)(p))
+#define ALF_SYM_64(p, o)       _mm_add_epi16(ALF_LOAD_64((p) + (o)), ALF_LOAD_64((p) - (o)))
+
+/* filter 4 samples of one row with interleaved coefficient pairs */
+static __inline __m128i alf_filter_4(__m128i * s, const __m128i * cp, int n_pair)
+{
+    __m128i sum = _mm_set1_epi32(ALF_OFFSET);
+    int k;
+
+    for (k = 0; k < n_pair; k++)
+    {
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi16(s[2 * k], s[2 * k + 1]), cp[k]));
+    }
+    sum = _mm_srai_epi32(sum, ALF_SHIFT);
+    return _mm_packs_epi32(sum, sum);
+}
+
+/* filter 16 samples of one row with interleaved coefficient pairs */
+static __inline __m256i alf_filter_16(__m256i * s, const __m256i * cp_lo, const __m256i * cp_hi, int n_pair)
+{
+    __m256i sum_lo = _mm256_set1_epi32(ALF_OFFSET);
+    __m256i sum_hi = sum_lo;
+    int k;
+
+    for (k = 0; k < n_pair; k++)
+    {
+        sum_lo = _mm256_add_epi32(sum_lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(s[2 * k], s[2 * k + 1]), cp_lo[k]));
+        sum_hi = _mm256_add_epi32(sum_hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(s[2 * k], s[2 * k + 1]), cp_hi[k]));
+    }
+    sum_lo = _mm256_srai_epi32(sum_lo, ALF_SHIFT);
+    sum_hi = _mm256_srai_epi32(sum_hi, ALF_SHIFT);
+    return _mm256_packs_epi32(sum_lo, sum_hi);
+}
+
+void xevdm_alf_derive_classification_blk_avx(ALF_CLASSIFIER ** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth)
+{
+    /* laplacian sums of 4x4 sample groups, a 4x4 block takes the 2x2 groups around it */
+    int grp[NUM_DIRECTIONS][(CLASSIFICATION_BLK_SIZE >> 2) + 1][(CLASSIFICATION_BLK_SIZE >> 2) + 1];
+    const int grp_w = (blk->width >> 2) + 1;
+    const int grp_h = (blk->height >> 2) + 1;
+    const int s = src_stride;
+    int t, q, r, d, i, j;
+
+    /* 16-bit sums of 4 rows do not hold larger samples */
+    if (bit_depth > 12)
+    {
+        xevdm_alf_derive_classification_blk(classifier, src_luma, src_stride, blk, shift, bit_depth);
+        return;
+    }
+
+    for (t = 0; t < grp_h; t++)
+    {
+        const pel * src = src_luma + (blk->y - 2 + (t << 2)) * s + blk->x - 2;
+
+        for (q = 0; q + 4 <= grp_w; q += 4)
+        {
+            __m256i acc[NUM_DIRECTIONS];
+            int sum[8];
+
+            for (d = 0; d < NUM_DIRECTIONS; d++)
+            {
+                acc[d] = _mm256_setzero_si256();
+            }
+            for (r = 0; r < 4; r++)
+            {
+                const pel * p = src + r * s + (q << 2);
+                __m256i c2 = _mm256_slli_epi16(ALF_LOAD_256(p), 1);
+
+                acc[VER] = _mm256_add_epi16(acc[VER], _mm256_abs_epi16(_mm256_sub_epi16(c2, ALF_SYM_256(p, s))));
+                acc[HOR] = _mm256_add_epi16(acc[HOR], _mm256_abs_epi16(_mm256_sub_epi16(c2, ALF_SYM_256(p, 1))));
+                acc[DIAG0] = _mm256_add_epi16(acc[DIAG0], _mm256_abs_epi16(_mm256_sub_epi16(c2, ALF_SYM_256(p, s + 1))));
+                acc[DIAG1] = _mm256_add_epi16(acc[DIAG1], _mm256_abs_epi16(_mm256_sub_epi16(c2, ALF_SYM_256(p, s - 1))));
+            }
+            for (d = 0; d < NUM_DIRECTIONS; d++)
+            {
+                _mm256_storeu_si256((__m256i *)sum, _mm256_madd_epi16(acc[d], _mm256_set1_epi16(1)));
+                for (i = 0; i < 4; i++)
+                {
+                    grp[d][t][q + i] = sum[2 * i] + sum[2 * i + 1];
+                }
+            }
+        }
+        for (; q < grp_w; q++)
+        {
+            __m128i acc[NUM_DIRECTIONS];
+            int sum[4];
+
+            for (d = 0; d < NUM_DIRECTIONS; d++)
+            {
+                acc[d] = _mm_setzero_si128();
+            }
+            for (r = 0; r < 4; r++)
+            {
+                const pel * p = src + r * s + (q << 2);
+                __m128i c2 = _mm_slli_epi16(ALF_LOAD_64(p), 1);
+
+                acc[VER] = _mm_add_epi16(acc[VER], _mm_abs_epi16(_mm_sub_epi16(c2, ALF_SYM_64(p, s))));
+                acc[HOR] = _mm_add_epi16(acc[HOR], _mm_abs_epi16(_mm_sub_epi16(c2, ALF_SYM_64(p, 1))));
+                acc[DIAG0] = _mm_add_epi16(acc[DIAG0], _mm_abs_epi16(_mm_sub_epi16(c2, ALF_SYM_64(p, s + 1))));
+                acc[DIAG1] = _mm_add_epi16(acc[DIAG1], _mm_abs_epi16(_mm_sub_epi16(c2, ALF_SYM_64(p, s - 1))));
+            }
+            for (d = 0; d < NUM_DIRECTIONS; d++)
+            {
+                _mm_storeu_si128((__m128i *)sum, _mm_madd_epi16(acc[d], _mm_set1_epi16(1)));
+                grp[d][t][q] = sum[0] + sum[1];
+            }
+        }
+    }
+
+    for (i = 0; i < blk->height; i += 4)
+    {
+        t = i >> 2;
+        for (j = 0; j < blk->width; j += 4)
+        {
+            int sum[NUM_DIRECTIONS];
+            ALF_CLASSIFIER cl;
+
+            q = j >> 2;
+            for (d = 0; d < NUM_DIRECTIONS; d++)
+            {
+                sum[d] = grp[d][t][q] + grp[d][t][q + 1] + grp[d][t + 1][q] + grp[d][t + 1][q + 1];
+            }
+            cl = alf_get_class(sum[VER], sum[HOR], sum[DIAG0], sum[DIAG1], bit_depth);
+            for (r = 0; r < 4; r++)
+            {
+                ALF_CLASSIFIER * dst = classifier[blk->y + i + r] + blk->x + j;
+                dst[0] = dst[1] = dst[2] = dst[3] = cl;
+            }
+        }
+    }
+}
+
+/* symmetric sample pairs of the 7x7 diamond in coefficient order, center last */
+#define ALF_SYM_7(s, SYM, LOAD, p, st, zero) \
+    s[0] = SYM(p, 3 * (st)); \
+    s[1] = SYM(p, 2 * (st) + 1); \
+    s[2] = SYM(p, 2 * (st)); \
+    s[3] = SYM(p, 2 * (st) - 1); \
+    s[4] = SYM(p, (st) + 2); \
+    s[5] = SYM(p, (st) + 1); \
+    s[6] = SYM(p, (st)); \
+    s[7] = SYM(p, (st) - 1); \
+    s[8] = SYM(p, (st) - 2); \
+    s[9] = SYM(p, 3); \
+    s[10] = SYM(p, 2); \
+    s[11] = SYM(p, 1); \
+    s[12] = LOAD(p); \
+    s[13] = zero
+
+/* symmetric sample pairs of the 5x5 diamond in coefficient order, center last */
+#define ALF_SYM_5(s, SYM, LOAD, p, st, zero) \
+    s[0] = SYM(p, 2 * (st)); \
+    s[1] = SYM(p, (st) + 1); \
+    s[2] = SYM(p, (st)); \
+    s[3] = SYM(p, (st) - 1); \
+    s[4] = SYM(p, 2); \
+    s[5] = SYM(p, 1); \
+    s[6] = LOAD(p); \
+    s[7] = zero
+
+void xevdm_alf_filter_blk_7_avx(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel* rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range)
+{
+    const int n_pair = (MAX_NUM_ALF_LUMA_COEFF + 1) >> 1;
+    const __m256i min = _mm256_set1_epi16((s16)clip_range->min);
+    const __m256i max = _mm256_set1_epi16((s16)clip_range->max);
+    const __m256i zero = _mm256_setzero_si256();
+    int i, j, k, ii;
+
+    CHECK(blk->y % 4, "Wrong start_h in filtering");
+    CHECK(blk->x % 4, "Wrong start_w in filtering");
+    CHECK(blk->height % 4, "Wrong end_h in filtering");
+    CHECK(blk->width % 4, "Wrong end_w in filtering");
+
+    for (i = 0; i < blk->height; i += 4)
+    {
+        const ALF_CLASSIFIER * alf_class = classifier[blk->y + i] + blk->x;
+
+        /* 4 class blocks at a time, each taking 4 lanes of the coefficient vectors */
+        for (j = 0; j + 16 <= blk->width; j += 16)
+        {
+            s16 coef[MAX_NUM_ALF_LUMA_COEFF + 1][16];
+            __m256i cp_lo[(MAX_NUM_ALF_LUMA_COEFF + 1) >> 1], cp_hi[(MAX_NUM_ALF_LUMA_COEFF + 1) >> 1];
+            __m256i s[MAX_NUM_ALF_LUMA_COEFF + 1];
+            int b, n;
+
+            for (b = 0; b < 4; b++)
+            {
+                ALF_CLASSIFIER cl = alf_class[j + (b << 2)];
+                const int * l = alf_tbl_trans_7[cl & 0x03];
+                const short * c = filter_set + ((cl >> 2) & 0x1F) * MAX_NUM_ALF_LUMA_COEFF;
+
+                for (k = 0; k < MAX_NUM_ALF_LUMA_COEFF; k++)
+                {
+                    for (n = 0; n < 4; n++)
+                    {
+                        coef[k][(b << 2) + n] = c[l[k]];
+                    }
+                }
+                for (n = 0; n < 4; n++)
+                {
+                    coef[MAX_NUM_ALF_LUMA_COEFF][(b << 2) + n] = 0;
+                }
+            }
+            for (k = 0; k < n_pair; k++)
+            {
+                __m256i c0 = _mm256_loadu_si256((const __m256i *)coef[2 * k]);
+                __m256i c1 = _mm256_loadu_si256((const __m256i *)coef[2 * k + 1]);
+                cp_lo[k] = _mm256_unpacklo_epi16(c0, c1);
+                cp_hi[k] = _mm256_unpackhi_epi16(c0, c1);
+            }
+
+            for (ii = 0; ii < 4; ii++)
+            {
+                const pel * p = rec_src + (i + ii) * src_stride + j;
+                __m256i out;
+
+                ALF_SYM_7(s, ALF_SYM_256, ALF_LOAD_256, p, src_stride, zero);
+                out = alf_filter_16(s, cp_lo, cp_hi, n_pair);
+                out = _mm256_min_epi16(_mm256_max_epi16(out, min), max);
+                _mm256_storeu_si256((__m256i *)(rec_dst + (i + ii) * dst_stride + j), out);
+            }
+        }
+        for (; j < blk->width; j += 4)
+        {
+            ALF_CLASSIFIER cl = alf_class[j];
+            const int * l = alf_tbl_trans_7[cl & 0x03];
+            const short * c = filter_set + ((cl >> 2) & 0x1F) * MAX_NUM_ALF_LUMA_COEFF;
+            __m128i cp[(MAX_NUM_ALF_LUMA_COEFF + 1) >> 1];
+            __m128i s[MAX_NUM_ALF_LUMA_COEFF + 1];
+
+            for (k = 0; k < n_pair - 1; k++)
+            {
+                cp[k] = _mm_set1_epi32(ALF_COEF_PAIR(c[l[2 * k]], c[l[2 * k + 1]]));
+            }
+            cp[k] = _mm_set1_epi32(ALF_COEF_PAIR(c[l[2 * k]], 0));
+
+            for (ii = 0; ii < 4; ii++)
+            {
+                const pel * p = rec_src + (i + ii) * src_stride + j;
+                __m128i out;
+
+                ALF_SYM_7(s, ALF_SYM_64, ALF_LOAD_64, p, src_stride, _mm_setzero_si128());
+                out = alf_filter_4(s, cp, n_pair);
+                out = _mm_min_epi16(_mm_max_epi16(out, _mm256_castsi256_si128(min)), _mm256_castsi256_si128(max));
+                _mm_storel_epi64((__m128i *)(rec_dst + (i + ii) * dst_stride + j), out);
+            }
+        }
+    }
+}
+
+void xevdm_alf_filter_blk_5_avx(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel* rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range)
+{
+    const int n_pair = (MAX_NUM_ALF_CHROMA_COEFF + 1) >> 1;
+    const __m256i min = _mm256_set1_epi16((s16)clip_range->min);
+    const __m256i max = _mm256_set1_epi16((s16)clip_range->max);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i cp[(MAX_NUM_ALF_CHROMA_COEFF + 1) >> 1];
+    __m256i s[MAX_NUM_ALF_CHROMA_COEFF + 1];
+    __m128i s4[MAX_NUM_ALF_CHROMA_COEFF + 1];
+    __m128i cp4[(MAX_NUM_ALF_CHROMA_COEFF + 1) >> 1];
+    const short * c = filter_set;
+    int i, j, k;
+
+    for (k = 0; k < n_pair - 1; k++)
+    {
+        cp[k] = _mm256_set1_epi32(ALF_COEF_PAIR(c[2 * k], c[2 * k + 1]));
+    }
+    cp[k] = _mm256_set1_epi32(ALF_COEF_PAIR(c[2 * k], 0));
+    for (k = 0; k < n_pair; k++)
+    {
+        cp4[k] = _mm256_castsi256_si128(cp[k]);
+    }
+
+    for (i = 0; i < blk->height; i++)
+    {
+        const pel * src = rec_src + i * src_stride;
+        pel * dst = rec_dst + i * dst_stride;
+
+        for (j = 0; j + 16 <= blk->width; j += 16)
+        {
+            __m256i out;
+
+            ALF_SYM_5(s, ALF_SYM_256, ALF_LOAD_256, src + j, src_stride, zero);
+            out = alf_filter_16(s, cp, cp, n_pair);
+            out = _mm256_min_epi16(_mm256_max_epi16(out, min), max);
+            _mm256_storeu_si256((__m256i *)(dst + j), out);
+        }
+        for (; j + 4 <= blk->width; j += 4)
+        {
+            __m128i out;
+
+            ALF_SYM_5(s4, ALF_SYM_64, ALF_LOAD_64, src + j, src_stride, _mm_setzero_si128());
+            out = alf_filter_4(s4, cp4, n_pair);
+            out = _mm_min_epi16(_mm_max_epi16(out, _mm256_castsi256_si128(min)), _mm256_castsi256_si128(max));
+            _mm_storel_epi64((__m128i *)(dst + j), out);
+        }
+        for (; j < blk->width; j++)
+        {
+            const pel * p = src + j;
+            int sum = ALF_OFFSET;
+
+            sum += c[0] * (p[2 * src_stride] + p[-2 * src_stride]);
+            sum += c[1] * (p[src_stride + 1] + p[-src_stride - 1]);
+            sum += c[2] * (p[src_stride] + p[-src_stride]);
+            sum += c[3] * (p[src_stride - 1] + p[-src_stride + 1]);
+            sum += c[4] * (p[2] + p[-2]);
+            sum += c[5] * (p[1] + p[-1]);
+            sum += c[6] * p[0];
+            dst[j] = clip_pel(sum >> ALF_SHIFT, *clip_range);
+        }
+    }
+}
+#endif /* X86_SSE && !XEVD_PEL_8BIT */
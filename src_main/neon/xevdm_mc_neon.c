@@ -39,7 +39,7 @@
 #include "xevdm_mc_neon.h"
 #include <assert.h>
 
-#if ARM_NEON
+#if ARM_NEON && !XEVD_PEL_8BIT
 
 #define vmadd_s16(a, b)\
     vpaddq_s32(vmull_s16(vget_low_s16(a), vget_low_s16(b)), vmull_s16(vget_high_s16(a), vget_high_s16(b)));
@@ -656,7 +656,7 @@ void mc_filter_bilin_vert_neon(s16 const* ref,
 
 
 
-void xevd_mc_dmvr_l_00_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_00_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -710,7 +710,7 @@ void xevd_mc_dmvr_l_00_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pre
     }
 }
 
-void xevd_mc_dmvr_l_n0_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_n0_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dx;
 
@@ -720,10 +720,10 @@ void xevd_mc_dmvr_l_n0_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pre
     int max = ((1 << bit_depth) - 1);
 
     int min = 0;
-    xevd_mc_filter_l_8pel_horz_clip_neon(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
+    xevd_mc_filter_l_8pel_horz_clip_neon(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
 }
 
-void xevd_mc_dmvr_l_0n_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_0n_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dy;
 
@@ -733,10 +733,10 @@ void xevd_mc_dmvr_l_0n_neon(pel* ref, int gmv_x, int gmv_y, int s_ref, int s_pre
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_l_8pel_vert_clip_neon(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
+    xevd_mc_filter_l_8pel_vert_clip_neon(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
 }
 
-void xevd_mc_dmvr_l_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L) * MAX_CU_SIZE];
     int         dx, dy;
@@ -753,8 +753,8 @@ void xevd_mc_dmvr_l_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pre
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_l_8pel_horz_no_clip_neon(ref, s_ref, buf, w, tbl_mc_l_coeff[dx], w, (h + 7), offset1, shift1);
-    xevd_mc_filter_l_8pel_vert_clip_neon(buf, w, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, offset2, shift2);
+    xevd_mc_filter_l_8pel_horz_no_clip_neon(ref, s_ref, buf, w, MC_L_COEF(coef, dx), w, (h + 7), offset1, shift1);
+    xevd_mc_filter_l_8pel_vert_clip_neon(buf, w, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, offset2, shift2);
 }
 
 
@@ -866,7 +866,7 @@ void xevdm_bl_mc_l_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred
 ****************************************************************************/
 
 
-void xevd_mc_dmvr_c_00_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_00_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -920,7 +920,7 @@ void xevd_mc_dmvr_c_00_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pre
     }
 }
 
-void xevd_mc_dmvr_c_n0_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_n0_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int       dx;
 
@@ -929,10 +929,10 @@ void xevd_mc_dmvr_c_n0_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pre
 
     int max = ((1 << bit_depth) - 1);
     int min = 0;
-    xevd_mc_filter_c_4pel_horz_neon(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+    xevd_mc_filter_c_4pel_horz_neon(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
 }
 
-void xevd_mc_dmvr_c_0n_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_0n_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dy;
 
@@ -941,10 +941,10 @@ void xevd_mc_dmvr_c_0n_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pre
 
     int max = ((1 << bit_depth) - 1);
     int min = 0;
-    xevd_mc_filter_c_4pel_vert_neon(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+    xevd_mc_filter_c_4pel_vert_neon(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
 }
 
-void xevd_mc_dmvr_c_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16* pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_C) * MAX_CU_SIZE];
     int         dx, dy;
@@ -961,11 +961,11 @@ void xevd_mc_dmvr_c_nn_neon(s16* ref, int gmv_x, int gmv_y, int s_ref, int s_pre
 
     int max = ((1 << bit_depth) - 1);
     int min = 0;
-    xevd_mc_filter_c_4pel_horz_neon(ref, s_ref, buf, w, tbl_mc_c_coeff[dx], w, (h + 3), min, max, offset1, shift1, 0);
-    xevd_mc_filter_c_4pel_vert_neon(buf, w, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, offset2, shift2, 1);
+    xevd_mc_filter_c_4pel_horz_neon(ref, s_ref, buf, w, MC_C_COEF(coef, dx), w, (h + 3), min, max, offset1, shift1, 0);
+    xevd_mc_filter_c_4pel_vert_neon(buf, w, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, offset2, shift2, 1);
 }
 
-XEVD_MC_L xevdm_tbl_dmvr_mc_l_neon[2][2] =
+XEVDM_DMVR_MC_L xevdm_tbl_dmvr_mc_l_neon[2][2] =
 {
     {
         xevd_mc_dmvr_l_00_neon, /* dx == 0 && dy == 0 */
@@ -977,7 +977,7 @@ XEVD_MC_L xevdm_tbl_dmvr_mc_l_neon[2][2] =
     }
 };
 
-XEVD_MC_C xevdm_tbl_dmvr_mc_c_neon[2][2] =
+XEVDM_DMVR_MC_C xevdm_tbl_dmvr_mc_c_neon[2][2] =
 {
     {
         xevd_mc_dmvr_c_00_neon, /* dx == 0 && dy == 0 */
@@ -990,7 +990,7 @@ XEVD_MC_C xevdm_tbl_dmvr_mc_c_neon[2][2] =
 };
 
 /* luma and chroma will remain the same */
-XEVD_MC_L xevdm_tbl_bl_mc_l_neon[2][2] =
+XEVDM_BL_MC_L xevdm_tbl_bl_mc_l_neon[2][2] =
 {
     {
         xevdm_bl_mc_l_00_neon,
@@ -41,6 +41,6 @@
 #include "xevd_mc_neon.h"
 extern XEVDM_DMVR_MC_L xevdm_tbl_dmvr_mc_l_neon[2][2];
 extern XEVDM_DMVR_MC_C xevdm_tbl_dmvr_mc_c_neon[2][2];
-extern XEVD_MC_C xevdm_tbl_bl_mc_l_neon[2][2];
+extern XEVDM_BL_MC_L xevdm_tbl_bl_mc_l_neon[2][2];
 
 #endif /* _XEVD_MC_NEON_H_ */
@@ -0,0 +1,390 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+   /*
+      Redistribution and use in source and binary forms, with or without
+      modification, are permitted provided that the following conditions are met:
+
+      - Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+      - Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+      - Neither the name of the copyright owner, nor the names of its contributors
+      may be used to endorse or promote products derived from this software
+      without specific prior written permission.
+
+      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+      AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+      IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+      ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+      LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+      CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+      SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+      INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+      CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+      ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+      POSSIBILITY OF SUCH DAMAGE.
+   */
+
+#include "xevdm_def.h"
+#include "xevdm_df.h"
+#include "xevdm_df_sse.h"
+
+#if X86_SSE
+
+/* The kernels work on one SCU edge segment at a time: lane i of p[k] (q[k])
+   holds the k-th sample before (after) the edge on the i-th line, widened to
+   32 bits so that every intermediate matches the C implementation. */
+
+#define ADDB_ABS_DIFF(a, b)    _mm_abs_epi32(_mm_sub_epi32(a, b))
+#define ADDB_CLIP(v, lo, hi)   _mm_min_epi32(_mm_max_epi32(v, lo), hi)
+#define ADDB_MUL3(v)           _mm_add_epi32(_mm_add_epi32(v, v), v)
+
+static __inline __m128i addb_apply_sse(__m128i *p, __m128i *q, __m128i d_pq, u16 alpha, u8 beta)
+{
+    const __m128i vbeta = _mm_set1_epi32(beta);
+    __m128i m;
+
+    m = _mm_cmplt_epi32(d_pq, _mm_set1_epi32(alpha));
+    m = _mm_and_si128(m, _mm_cmplt_epi32(ADDB_ABS_DIFF(p[1], p[0]), vbeta));
+    return _mm_and_si128(m, _mm_cmplt_epi32(ADDB_ABS_DIFF(q[1], q[0]), vbeta));
+}
+
+static __inline __m128i addb_delta0_sse(__m128i *p, __m128i *q, __m128i c0)
+{
+    __m128i d;
+
+    d = _mm_add_epi32(_mm_slli_epi32(_mm_sub_epi32(q[0], p[0]), 2), _mm_sub_epi32(p[1], q[1]));
+    d = _mm_srai_epi32(_mm_add_epi32(d, _mm_set1_epi32(4)), 3);
+    return ADDB_CLIP(d, _mm_sub_epi32(_mm_setzero_si128(), c0), c0);
+}
+
+static __inline __m128i addb_delta1_sse(__m128i *x, __m128i *y, __m128i c1)
+{
+    __m128i d;
+
+    d = ADDB_MUL3(_mm_add_epi32(_mm_add_epi32(x[2], x[0]), y[0]));
+    d = _mm_sub_epi32(_mm_sub_epi32(d, _mm_slli_epi32(x[1], 3)), y[1]);
+    d = _mm_srai_epi32(d, 4);
+    return ADDB_CLIP(d, _mm_sub_epi32(_mm_setzero_si128(), c1), c1);
+}
+
+/* x0' = (2 * x1 + x0 + y1 + 2) >> 2 */
+static __inline __m128i addb_chroma_strong_sse(__m128i *x, __m128i *y)
+{
+    __m128i s = _mm_add_epi32(_mm_slli_epi32(x[1], 1), x[0]);
+    return _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(s, y[1]), _mm_set1_epi32(2)), 2);
+}
+
+/* luma strong filter of x side, blended into x_out by mask m */
+static __inline void addb_luma_strong_sse(__m128i *x, __m128i *y, __m128i *x_out, __m128i m)
+{
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128i four = _mm_set1_epi32(4);
+    __m128i s, v0, v1, v2;
+
+    s = _mm_add_epi32(_mm_add_epi32(x[1], x[0]), y[0]);
+    v0 = _mm_add_epi32(_mm_add_epi32(x[2], _mm_slli_epi32(s, 1)), _mm_add_epi32(y[1], four));
+    v1 = _mm_add_epi32(_mm_add_epi32(x[2], s), two);
+    v2 = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(x[3], 1), ADDB_MUL3(x[2])), _mm_add_epi32(s, four));
+
+    x_out[0] = _mm_blendv_epi8(addb_chroma_strong_sse(x, y), _mm_srai_epi32(v0, 3), m);
+    x_out[1] = _mm_blendv_epi8(x[1], _mm_srai_epi32(v1, 2), m);
+    x_out[2] = _mm_blendv_epi8(x[2], _mm_srai_epi32(v2, 3), m);
+}
+
+static int addb_luma_sse(__m128i *p, __m128i *q, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32((1 << (bit_depth_minus8 + 8)) - 1);
+    const __m128i vbeta = _mm_set1_epi32(beta);
+    __m128i p_out[DBF_LENGTH], q_out[DBF_LENGTH];
+    __m128i d_pq, apply, ap, aq;
+    int i;
+
+    d_pq = ADDB_ABS_DIFF(p[0], q[0]);
+    apply = addb_apply_sse(p, q, d_pq, alpha, beta);
+    if (_mm_testz_si128(apply, apply))
+    {
+        return 0;
+    }
+    ap = _mm_cmplt_epi32(ADDB_ABS_DIFF(p[0], p[2]), vbeta);
+    aq = _mm_cmplt_epi32(ADDB_ABS_DIFF(q[0], q[2]), vbeta);
+    for (i = 0; i < DBF_LENGTH; i++)
+    {
+        p_out[i] = p[i];
+        q_out[i] = q[i];
+    }
+
+    if (bs == DBF_ADDB_BS_INTRA_STRONG)
+    {
+        __m128i small = _mm_cmplt_epi32(d_pq, _mm_set1_epi32((alpha >> 2) + 2));
+
+        addb_luma_strong_sse(p, q, p_out, _mm_and_si128(ap, small));
+        addb_luma_strong_sse(q, p, q_out, _mm_and_si128(aq, small));
+    }
+    else
+    {
+        const __m128i vc1 = _mm_set1_epi32(c1);
+        __m128i c0, delta0, delta1;
+
+        /* c0 = c1 + ((ap + aq) << shift), kept in u8 range as in the C code */
+        c0 = _mm_sub_epi32(zero, _mm_add_epi32(ap, aq));
+        c0 = _mm_sll_epi32(c0, _mm_cvtsi32_si128(XEVD_MAX(0, bit_depth_minus8 - 1)));
+        c0 = _mm_and_si128(_mm_add_epi32(c0, vc1), _mm_set1_epi32(0xFF));
+
+        delta0 = addb_delta0_sse(p, q, c0);
+        p_out[0] = ADDB_CLIP(_mm_add_epi32(p[0], delta0), zero, max);
+        q_out[0] = ADDB_CLIP(_mm_sub_epi32(q[0], delta0), zero, max);
+
+        delta1 = addb_delta1_sse(p, q, vc1);
+        p_out[1] = _mm_blendv_epi8(p[1], _mm_add_epi32(p[1], delta1), ap);
+        delta1 = addb_delta1_sse(q, p, vc1);
+        q_out[1] = _mm_blendv_epi8(q[1], _mm_add_epi32(q[1], delta1), aq);
+    }
+
+    for (i = 0; i < DBF_LENGTH; i++)
+    {
+        p[i] = _mm_blendv_epi8(p[i], ADDB_CLIP(p_out[i], zero, max), apply);
+        q[i] = _mm_blendv_epi8(q[i], ADDB_CLIP(q_out[i], zero, max), apply);
+    }
+    return 1;
+}
+
+static int addb_chroma_sse(__m128i *p, __m128i *q, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32((1 << (bit_depth_minus8 + 8)) - 1);
+    __m128i p0, q0, apply;
+
+    apply = addb_apply_sse(p, q, ADDB_ABS_DIFF(p[0], q[0]), alpha, beta);
+    if (_mm_testz_si128(apply, apply))
+    {
+        return 0;
+    }
+
+    if (bs == DBF_ADDB_BS_INTRA_STRONG)
+    {
+        p0 = addb_chroma_strong_sse(p, q);
+        q0 = addb_chroma_strong_sse(q, p);
+    }
+    else
+    {
+        __m128i delta0 = addb_delta0_sse(p, q, _mm_set1_epi32(c0));
+        p0 = _mm_add_epi32(p[0], delta0);
+        q0 = _mm_sub_epi32(q[0], delta0);
+    }
+
+    p[0] = _mm_blendv_epi8(p[0], ADDB_CLIP(p0, zero, max), apply);
+    q[0] = _mm_blendv_epi8(q[0], ADDB_CLIP(q0, zero, max), apply);
+    p[1] = _mm_blendv_epi8(p[1], ADDB_CLIP(p[1], zero, max), apply);
+    q[1] = _mm_blendv_epi8(q[1], ADDB_CLIP(q[1], zero, max), apply);
+    return 1;
+}
+
+/* 8 and 4 samples in 16-bit lanes, 4 samples in 32-bit lanes */
+#if XEVD_PEL_8BIT
+#define ADDB_LOAD8(p)          _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i *)(p)))
+#define ADDB_STORE8(p, v)      _mm_storel_epi64((__m128i *)(p), _mm_packus_epi16(v, v))
+#define ADDB_LOAD4(p)          _mm_cvtepu8_epi16(xevd_load_4b(p))
+#define ADDB_STORE4(p, v)      xevd_store_4b((p), _mm_packus_epi16(v, v))
+#define ADDB_LOAD4_32(p)       _mm_cvtepu8_epi32(xevd_load_4b(p))
+#define ADDB_STORE4_32(p, v)   xevd_store_4b((p), _mm_packus_epi16(_mm_packus_epi32(v, v), _mm_setzero_si128()))
+#else
+#define ADDB_LOAD8(p)          _mm_loadu_si128((__m128i *)(p))
+#define ADDB_STORE8(p, v)      _mm_storeu_si128((__m128i *)(p), v)
+#define ADDB_LOAD4(p)          _mm_loadl_epi64((__m128i *)(p))
+#define ADDB_STORE4(p, v)      _mm_storel_epi64((__m128i *)(p), v)
+#define ADDB_LOAD4_32(p)       _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i *)(p)))
+#define ADDB_STORE4_32(p, v)   _mm_storel_epi64((__m128i *)(p), _mm_packs_epi32(v, v))
+#endif
+
+/* size is 4 or, for subsampled chroma, 2 */
+static __inline __m128i addb_load_line_sse(pel *src, int size)
+{
+    if (size == 4)
+    {
+        return ADDB_LOAD4_32(src);
+    }
+    return _mm_setr_epi32(src[0], src[1], 0, 0);
+}
+
+static __inline void addb_store_line_sse(pel *dst, __m128i v, int size)
+{
+    if (size == 4)
+    {
+        ADDB_STORE4_32(dst, v);
+    }
+    else
+    {
+        dst[0] = (pel)_mm_extract_epi32(v, 0);
+        dst[1] = (pel)_mm_extract_epi32(v, 1);
+    }
+}
+
+static void deblock_scu_addb_ver_luma_sse(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8, int size)
+{
+    __m128i r[4], p[DBF_LENGTH], q[DBF_LENGTH];
+    __m128i t0, t1, t2, t3, u0, u1, u2, u3;
+    int i;
+
+    if (!bs)
+    {
+        return;
+    }
+    /* rows of p3 p2 p1 p0 q0 q1 q2 q3 transposed into columns */
+    for (i = 0; i < 4; i++)
+    {
+        r[i] = (i < size) ? ADDB_LOAD8(buf + i * stride - DBF_LENGTH) : _mm_setzero_si128();
+    }
+    t0 = _mm_unpacklo_epi16(r[0], r[1]);
+    t1 = _mm_unpacklo_epi16(r[2], r[3]);
+    t2 = _mm_unpackhi_epi16(r[0], r[1]);
+    t3 = _mm_unpackhi_epi16(r[2], r[3]);
+    u0 = _mm_unpacklo_epi32(t0, t1);
+    u1 = _mm_unpackhi_epi32(t0, t1);
+    u2 = _mm_unpacklo_epi32(t2, t3);
+    u3 = _mm_unpackhi_epi32(t2, t3);
+    p[3] = _mm_cvtepi16_epi32(u0);
+    p[2] = _mm_cvtepi16_epi32(_mm_srli_si128(u0, 8));
+    p[1] = _mm_cvtepi16_epi32(u1);
+    p[0] = _mm_cvtepi16_epi32(_mm_srli_si128(u1, 8));
+    q[0] = _mm_cvtepi16_epi32(u2);
+    q[1] = _mm_cvtepi16_epi32(_mm_srli_si128(u2, 8));
+    q[2] = _mm_cvtepi16_epi32(u3);
+    q[3] = _mm_cvtepi16_epi32(_mm_srli_si128(u3, 8));
+
+    if (!addb_luma_sse(p, q, bs, alpha, beta, c1, bit_depth_minus8))
+    {
+        return;
+    }
+
+    u0 = _mm_packs_epi32(p[3], p[2]);
+    u1 = _mm_packs_epi32(p[1], p[0]);
+    u2 = _mm_packs_epi32(q[0], q[1]);
+    u3 = _mm_packs_epi32(q[2], q[3]);
+    t0 = _mm_unpacklo_epi16(u0, u1);
+    t1 = _mm_unpackhi_epi16(u0, u1);
+    t2 = _mm_unpacklo_epi16(u2, u3);
+    t3 = _mm_unpackhi_epi16(u2, u3);
+    u0 = _mm_unpacklo_epi16(t0, t1);
+    u1 = _mm_unpackhi_epi16(t0, t1);
+    u2 = _mm_unpacklo_epi16(t2, t3);
+    u3 = _mm_unpackhi_epi16(t2, t3);
+    r[0] = _mm_unpacklo_epi64(u0, u2);
+    r[1] = _mm_unpackhi_epi64(u0, u2);
+    r[2] = _mm_unpacklo_epi64(u1, u3);
+    r[3] = _mm_unpackhi_epi64(u1, u3);
+    for (i = 0; i < size; i++)
+    {
+        ADDB_STORE8(buf + i * stride - DBF_LENGTH, r[i]);
+    }
+}
+
+static void deblock_scu_addb_hor_luma_sse(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8, int size)
+{
+    __m128i p[DBF_LENGTH], q[DBF_LENGTH];
+    int i;
+
+    if (!bs)
+    {
+        return;
+    }
+    for (i = 0; i < DBF_LENGTH; i++)
+    {
+        p[i] = addb_load_line_sse(buf - (i + 1) * stride, size);
+        q[i] = addb_load_line_sse(buf + i * stride, size);
+    }
+    if (!addb_luma_sse(p, q, bs, alpha, beta, c1, bit_depth_minus8))
+    {
+        return;
+    }
+    for (i = 0; i < DBF_LENGTH; i++)
+    {
+        addb_store_line_sse(buf - (i + 1) * stride, p[i], size);
+        addb_store_line_sse(buf + i * stride, q[i], size);
+    }
+}
+
+static void deblock_scu_addb_ver_chroma_sse(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8, int size)
+{
+    __m128i r[4], p[DBF_LENGTH_CHROMA], q[DBF_LENGTH_CHROMA];
+    __m128i t0, t1, u0, u1;
+    int i;
+
+    if (!bs)
+    {
+        return;
+    }
+    /* rows of p1 p0 q0 q1 transposed into columns */
+    for (i = 0; i < 4; i++)
+    {
+        r[i] = (i < size) ? ADDB_LOAD4(buf + i * stride - DBF_LENGTH_CHROMA) : _mm_setzero_si128();
+    }
+    t0 = _mm_unpacklo_epi16(r[0], r[1]);
+    t1 = _mm_unpacklo_epi16(r[2], r[3]);
+    u0 = _mm_unpacklo_epi32(t0, t1);
+    u1 = _mm_unpackhi_epi32(t0, t1);
+    p[1] = _mm_cvtepi16_epi32(u0);
+    p[0] = _mm_cvtepi16_epi32(_mm_srli_si128(u0, 8));
+    q[0] = _mm_cvtepi16_epi32(u1);
+    q[1] = _mm_cvtepi16_epi32(_mm_srli_si128(u1, 8));
+
+    if (!addb_chroma_sse(p, q, bs, alpha, beta, c0, bit_depth_minus8))
+    {
+        return;
+    }
+
+    u0 = _mm_packs_epi32(p[1], p[0]);
+    u1 = _mm_packs_epi32(q[0], q[1]);
+    t0 = _mm_unpacklo_epi16(u0, u1);
+    t1 = _mm_unpackhi_epi16(u0, u1);
+    r[0] = _mm_unpacklo_epi16(t0, t1);
+    r[2] = _mm_unpackhi_epi16(t0, t1);
+    r[1] = _mm_srli_si128(r[0], 8);
+    r[3] = _mm_srli_si128(r[2], 8);
+    for (i = 0; i < size; i++)
+    {
+        ADDB_STORE4(buf + i * stride - DBF_LENGTH_CHROMA, r[i]);
+    }
+}
+
+static void deblock_scu_addb_hor_chroma_sse(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8, int size)
+{
+    __m128i p[DBF_LENGTH_CHROMA], q[DBF_LENGTH_CHROMA];
+    int i;
+
+    if (!bs)
+    {
+        return;
+    }
+    for (i = 0; i < DBF_LENGTH_CHROMA; i++)
+    {
+        p[i] = addb_load_line_sse(buf - (i + 1) * stride, size);
+        q[i] = addb_load_line_sse(buf + i * stride, size);
+    }
+    if (!addb_chroma_sse(p, q, bs, alpha, beta, c0, bit_depth_minus8))
+    {
+        return;
+    }
+    for (i = 0; i < DBF_LENGTH_CHROMA; i++)
+    {
+        addb_store_line_sse(buf - (i + 1) * stride, p[i], size);
+        addb_store_line_sse(buf + i * stride, q[i], size);
+    }
+}
+
+const XEVDM_DBK_ADDB xevdm_tbl_dbk_addb_sse[DBK_MAX] =
+{
+    deblock_scu_addb_ver_luma_sse,
+    deblock_scu_addb_hor_luma_sse
+};
+
+const XEVDM_DBK_ADDB xevdm_tbl_dbk_addb_chroma_sse[DBK_MAX] =
+{
+    deblock_scu_addb_ver_chroma_sse,
+    deblock_scu_addb_hor_chroma_sse
+};
+#endif /* X86_SSE */
@@ -39,7 +39,7 @@
 #include "xevdm_mc_sse.h"
 #include <assert.h>
 
-#if X86_SSE
+#if X86_SSE && !XEVD_PEL_8BIT
 
 
 #define MAC_8TAP(c, r0, r1, r2, r3, r4, r5, r6, r7) \
@@ -664,7 +664,7 @@ static void mc_filter_bilin_vert_sse(s16 const *ref,
 
 
 
-void xevd_mc_dmvr_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -718,7 +718,7 @@ void xevd_mc_dmvr_l_00_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred
     }
 }
 
-void xevd_mc_dmvr_l_n0_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_n0_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dx;
 
@@ -728,10 +728,10 @@ void xevd_mc_dmvr_l_n0_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred
     int max = ((1 << bit_depth) - 1);
 
     int min = 0;
-    xevd_mc_filter_l_8pel_horz_clip_sse(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
+    xevd_mc_filter_l_8pel_horz_clip_sse(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0);
 }
 
-void xevd_mc_dmvr_l_0n_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_0n_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dy;
 
@@ -741,10 +741,10 @@ void xevd_mc_dmvr_l_0n_sse(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_l_8pel_vert_clip_sse(ref, s_ref, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
+    xevd_mc_filter_l_8pel_vert_clip_sse(ref, s_ref, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N);
 }
 
-void xevd_mc_dmvr_l_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*MAX_CU_SIZE];
     int         dx, dy;
@@ -761,8 +761,8 @@ void xevd_mc_dmvr_l_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred
     int max = ((1 << bit_depth) - 1);
     int min = 0;
 
-    xevd_mc_filter_l_8pel_horz_no_clip_sse(ref, s_ref, buf, w, tbl_mc_l_coeff[dx], w, (h + 7), offset1, shift1);
-    xevd_mc_filter_l_8pel_vert_clip_sse(buf, w, pred, s_pred, tbl_mc_l_coeff[dy], w, h, min, max, offset2, shift2);
+    xevd_mc_filter_l_8pel_horz_no_clip_sse(ref, s_ref, buf, w, MC_L_COEF(coef, dx), w, (h + 7), offset1, shift1);
+    xevd_mc_filter_l_8pel_vert_clip_sse(buf, w, pred, s_pred, MC_L_COEF(coef, dy), w, h, min, max, offset2, shift2);
 }
 
 
@@ -874,7 +874,7 @@ void xevdm_bl_mc_l_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred,
 ****************************************************************************/
 
 
-void xevd_mc_dmvr_c_00_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_00_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -928,7 +928,7 @@ void xevd_mc_dmvr_c_00_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred
     }
 }
 
-void xevd_mc_dmvr_c_n0_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_n0_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int       dx;
 
@@ -937,10 +937,10 @@ void xevd_mc_dmvr_c_n0_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred
 
     int max = ((1 << bit_depth) - 1);
     int min = 0;
-    xevd_mc_filter_c_4pel_horz_sse(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dx], w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+    xevd_mc_filter_c_4pel_horz_sse(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dx), w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
 }
 
-void xevd_mc_dmvr_c_0n_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_0n_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int dy;
 
@@ -949,10 +949,10 @@ void xevd_mc_dmvr_c_0n_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred
 
     int max = ((1 << bit_depth) - 1);
     int min = 0;
-    xevd_mc_filter_c_4pel_vert_sse(ref, s_ref, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+    xevd_mc_filter_c_4pel_vert_sse(ref, s_ref, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
 }
 
-void xevd_mc_dmvr_c_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_C)*MAX_CU_SIZE];
     int         dx, dy;
@@ -969,11 +969,11 @@ void xevd_mc_dmvr_c_nn_sse(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred
 
     int max = ((1 << bit_depth) - 1);
     int min = 0;
-    xevd_mc_filter_c_4pel_horz_sse(ref, s_ref, buf, w, tbl_mc_c_coeff[dx], w, (h + 3), min, max, offset1, shift1, 0);
-    xevd_mc_filter_c_4pel_vert_sse(buf, w, pred, s_pred, tbl_mc_c_coeff[dy], w, h, min, max, offset2, shift2, 1);
+    xevd_mc_filter_c_4pel_horz_sse(ref, s_ref, buf, w, MC_C_COEF(coef, dx), w, (h + 3), min, max, offset1, shift1, 0);
+    xevd_mc_filter_c_4pel_vert_sse(buf, w, pred, s_pred, MC_C_COEF(coef, dy), w, h, min, max, offset2, shift2, 1);
 }
 
-XEVD_MC_L xevdm_tbl_dmvr_mc_l_sse[2][2] =
+XEVDM_DMVR_MC_L xevdm_tbl_dmvr_mc_l_sse[2][2] =
 {
     {
         xevd_mc_dmvr_l_00_sse, /* dx == 0 && dy == 0 */
@@ -985,7 +985,7 @@ XEVD_MC_L xevdm_tbl_dmvr_mc_l_sse[2][2] =
     }
 };
 
-XEVD_MC_C xevdm_tbl_dmvr_mc_c_sse[2][2] =
+XEVDM_DMVR_MC_C xevdm_tbl_dmvr_mc_c_sse[2][2] =
 {
     {
         xevd_mc_dmvr_c_00_sse, /* dx == 0 && dy == 0 */
@@ -998,7 +998,7 @@ XEVD_MC_C xevdm_tbl_dmvr_mc_c_sse[2][2] =
 };
 
 /* luma and chroma will remain the same */
-XEVD_MC_L xevdm_tbl_bl_mc_l_sse[2][2] =
+XEVDM_BL_MC_L xevdm_tbl_bl_mc_l_sse[2][2] =
 {
     {
         xevdm_bl_mc_l_00_sse,
@@ -41,6 +41,8 @@
 #include "xevd_mc_sse.h"
 extern XEVDM_DMVR_MC_L xevdm_tbl_dmvr_mc_l_sse[2][2];
 extern XEVDM_DMVR_MC_C xevdm_tbl_dmvr_mc_c_sse[2][2];
-extern XEVD_MC_C xevdm_tbl_bl_mc_l_sse[2][2];
+extern XEVDM_BL_MC_L xevdm_tbl_bl_mc_l_sse[2][2];
+
+int dmvr_sad_mr_16b_sse(int w, int h, void * src1, void * src2, int s_src1, int s_src2, s16 delta, int bit_depth);
 
 #endif /* _XEVD_MC_H_ */
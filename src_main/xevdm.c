@@ -89,6 +89,15 @@ static XEVDM_CTX * xevdm_ctx_alloc(void)
 static void ctx_free(XEVD_CTX * ctx)
 {
     XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+    int i;
+
+    for (i = 0; i < XEVDM_DRA_OUT_POOL_SIZE; i++)
+    {
+        /* buffers still held by the application are freed on their release */
+        xevd_imgb_destroy(mctx->dra_out_pool[i]);
+    }
+    xevd_out_free(ctx);
+    xevd_mfree(mctx->dra_out);
     xevd_mfree(mctx->aps_gen_array);
     xevd_mfree(mctx->dra_array);
     xevd_mfree(ctx->sei_pend);
@@ -99,10 +108,13 @@ static XEVD_CORE * core_alloc(void)
 {
     XEVD_CORE * core;
 
-    core = (XEVD_CORE*)xevd_malloc_fast(sizeof(XEVD_CORE));
+    int size = XEVD_CORE_BUF_OFS(XEVD_CORE);
+
+    core = (XEVD_CORE*)xevd_malloc_fast(size + sizeof(XEVD_CORE_BUF));
 
     xevd_assert_rv(core, NULL);
-    xevd_mset_x64a(core, 0, sizeof(XEVD_CORE));
+    xevd_mset_x64a(core, 0, size + sizeof(XEVD_CORE_BUF));
+    xevd_core_buf_set(core, (XEVD_CORE_BUF *)((u8 *)core + size));
 
     return core;
 }
@@ -110,10 +122,13 @@ static XEVDM_CORE * xevdm_core_alloc(void)
 {
     XEVDM_CORE * core;
 
-    core = (XEVDM_CORE*)xevd_malloc_fast(sizeof(XEVDM_CORE));
+    int size = XEVD_CORE_BUF_OFS(XEVDM_CORE);
+
+    core = (XEVDM_CORE*)xevd_malloc_fast(size + sizeof(XEVD_CORE_BUF));
 
     xevd_assert_rv(core, NULL);
-    xevd_mset_x64a(core, 0, sizeof(XEVDM_CORE));
+    xevd_mset_x64a(core, 0, size + sizeof(XEVD_CORE_BUF));
+    xevd_core_buf_set(&core->core, (XEVD_CORE_BUF *)((u8 *)core + size));
 
     return core;
 }
@@ -198,9 +213,10 @@ int xevd_delete_cu_data(XEVD_CU_DATA* cu_data, int log2_cuw, int log2_cuh)
 
     for (i = 0; i < N_C; i++)
     {
-        xevd_free_1d((void**)&cu_data->coef[i], (pixel_cnt >> (!!(i) * 2)) * sizeof(s16));
+        xevd_free_1d((void**)&cu_data->coef_ofs[i], size_32b);
         xevd_free_1d((void**)&cu_data->reco[i], (pixel_cnt >> (!!(i) * 2)) * sizeof(pel));
     }
+    xevd_free_1d((void**)&cu_data->coef, cu_data->coef_size * sizeof(s16));
 
     return XEVD_OK;
 }
@@ -317,6 +333,25 @@ static int sequence_init(XEVD_CTX * ctx, XEVD_SPS * sps)
     int size;
     int ret;
     XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
+
+#if XEVD_PEL_8BIT
+    /* pictures are stored in 8-bit samples */
+    if(sps->bit_depth_luma_minus8 != 0 || sps->bit_depth_chroma_minus8 != 0)
+    {
+        xevd_trace("bit depth over 8 is not supported by 8-bit sample build\n");
+        return XEVD_ERR_UNSUPPORTED;
+    }
+    /* DRA works on 16-bit samples */
+    if(sps->tool_dra)
+    {
+        xevd_trace("DRA is not supported by 8-bit sample build\n");
+        return XEVD_ERR_UNSUPPORTED;
+    }
+#endif
+
+    /* interpolation filters of the main profile come with ADMVP */
+    ctx->mc_l_coef = sps->tool_admvp ? tbl_mc_l_coeff_main[0] : xevd_tbl_mc_l_coeff[0];
+    ctx->mc_c_coef = sps->tool_admvp ? tbl_mc_c_coeff_main[0] : xevd_tbl_mc_c_coeff[0];
     if(sps->pic_width_in_luma_samples != ctx->w || sps->pic_height_in_luma_samples != ctx->h)
     {
         /* resolution was changed */
@@ -355,6 +390,9 @@ static int sequence_init(XEVD_CTX * ctx, XEVD_SPS * sps)
     mctx->alf = new_alf(ctx->internal_codec_bit_depth);
     ADAPTIVE_LOOP_FILTER* alf = (ADAPTIVE_LOOP_FILTER*)(mctx->alf);
     xevd_alf_create(alf, ctx->w, ctx->h, ctx->max_cuwh, ctx->max_cuwh, 5, sps->chroma_format_idc, ctx->internal_codec_bit_depth);
+    alf->derive_classification_blk = mctx->fn_alf_cls_blk;
+    alf->filter_5x5_blk = mctx->fn_alf_flt5_blk;
+    alf->filter_7x7_blk = mctx->fn_alf_flt7_blk;
 
     XEVDM_SH  *msh = &mctx->sh;
     if (msh->alf_sh_param.alf_ctu_enable_flag == NULL)
@@ -458,10 +496,26 @@ static int sequence_init(XEVD_CTX * ctx, XEVD_SPS * sps)
     ctx->pa.fn_free = xevdm_picbuf_free;
     ctx->pa.w = ctx->w;
     ctx->pa.h = ctx->h;
-    ctx->pa.pad_l = PIC_PAD_SIZE_L;
-    ctx->pa.pad_c = PIC_PAD_SIZE_C;
+    /* DMVR and the affine EIF read the padded border of reference pictures
+       directly; without them motion compensation emulates the picture edges
+       and reference pictures only carry a guard band */
+    if (sps->tool_dmvr || sps->tool_affine)
+    {
+        ctx->pa.pad_l = PIC_PAD_SIZE_L;
+        ctx->pa.pad_c = PIC_PAD_SIZE_C;
+        ctx->ref_pad_l = PIC_PAD_SIZE_L;
+        ctx->ref_pad_c = PIC_PAD_SIZE_C;
+    }
+    else
+    {
+        ctx->pa.pad_l = PIC_GUARD_SIZE_L;
+        ctx->pa.pad_c = PIC_GUARD_SIZE_C;
+        ctx->ref_pad_l = 0;
+        ctx->ref_pad_c = 0;
+    }
     ctx->ref_pic_gap_length = (int)pow(2.0, sps->log2_ref_pic_gap_length);
     ctx->pa.idc = sps->chroma_format_idc;
+    ctx->pa.imgb_alloc = ctx->cdsc.imgb_alloc.fn_alloc ? &ctx->cdsc.imgb_alloc : NULL;
 
     ret = xevdm_picman_init(&mctx->dpm, MAXM_PB_SIZE, XEVD_MAX_NUM_REF_PICS, &ctx->pa);
     xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
@@ -528,11 +582,14 @@ static int slice_init(XEVD_CTX * ctx, XEVD_CORE * core, XEVD_SH * sh)
     core->y_lcu = 0;
     core->x_pel = 0;
     core->y_pel = 0;
+    core->sh = sh;
+    core->refp = ctx->refp;
+    core->num_refp = ((XEVDM_CTX *)ctx)->dpm.num_refp;
     core->qp_y = ctx->sh.qp + 6 * ctx->sps->bit_depth_luma_minus8;
     core->qp_u = xevd_qp_chroma_dynamic[0][sh->qp_u] + 6 * ctx->sps->bit_depth_chroma_minus8;
     core->qp_v = xevd_qp_chroma_dynamic[1][sh->qp_v] + 6 * ctx->sps->bit_depth_chroma_minus8;
 
-    if (ctx->tc.max_task_cnt > 1)
+    if (ctx->tc.max_task_cnt > 1 || ((XEVDM_CTX *)ctx)->lf_pipe)
     {
         xevd_mset((void *)ctx->sync_flag, 0, ctx->f_lcu * sizeof(ctx->sync_flag[0]));
         xevd_mset((void *)ctx->sync_row, 0, ctx->h_lcu * sizeof(ctx->sync_row[0]));
@@ -808,12 +865,12 @@ void xevd_get_direct_motion(XEVD_CTX * ctx, XEVD_CORE * core)
     XEVDM_CORE *mcore = (XEVDM_CORE *)core;
     if (ctx->sps->tool_admvp == 0)
     {
-        xevdm_get_motion_skip_baseline(ctx->sh.slice_type, core->scup, ctx->map_refi, ctx->map_mv, ctx->refp[0], cuw, cuh, ctx->w_scu, srefi, smvp, core->avail_cu);
+        xevdm_get_motion_skip_baseline(core->sh->slice_type, core->scup, ctx->map_refi, ctx->map_mv, core->refp[0], cuw, cuh, ctx->w_scu, srefi, smvp, core->avail_cu);
     }
     else
     {
-        xevdm_get_motion_merge_main(ctx->poc.poc_val, ctx->sh.slice_type, core->scup, ctx->map_refi, ctx->map_mv, ctx->refp[0], cuw, cuh, ctx->w_scu, ctx->h_scu, srefi, smvp, ctx->map_scu, core->avail_lr
-            , mctx->map_unrefined_mv, core->history_buffer, mcore->ibc_flag, (XEVD_REFP(*)[2])ctx->refp[0], &ctx->sh, ctx->log2_max_cuwh, ctx->map_tidx);
+        xevdm_get_motion_merge_main(ctx->poc.poc_val, core->sh->slice_type, core->scup, ctx->map_refi, ctx->map_mv, core->refp[0], cuw, cuh, ctx->w_scu, ctx->h_scu, srefi, smvp, ctx->map_scu, core->avail_lr
+            , mctx->map_unrefined_mv, core->history_buffer, mcore->ibc_flag, (XEVD_REFP(*)[2])core->refp[0], core->sh, ctx->log2_max_cuwh, ctx->map_tidx);
     }
 
     core->refi[REFP_0] = srefi[REFP_0][core->mvp_idx[REFP_0]];
@@ -822,7 +879,7 @@ void xevd_get_direct_motion(XEVD_CTX * ctx, XEVD_CORE * core)
     core->mv[REFP_0][MV_X] = smvp[REFP_0][core->mvp_idx[REFP_0]][MV_X];
     core->mv[REFP_0][MV_Y] = smvp[REFP_0][core->mvp_idx[REFP_0]][MV_Y];
 
-    if (ctx->sh.slice_type == SLICE_P)
+    if (core->sh->slice_type == SLICE_P)
     {
         core->refi[REFP_1] = REFI_INVALID;
         core->mv[REFP_1][MV_X] = 0;
@@ -853,14 +910,14 @@ void xevd_get_skip_motion(XEVD_CTX * ctx, XEVD_CORE * core)
     {
         if(ctx->sps->tool_admvp == 0)
         {
-            xevdm_get_motion(core->scup, REFP_0, ctx->map_refi, ctx->map_mv, ctx->refp, cuw, cuh, ctx->w_scu, core->avail_cu, srefi[REFP_0], smvp[REFP_0]);
+            xevdm_get_motion(core->scup, REFP_0, ctx->map_refi, ctx->map_mv, core->refp, cuw, cuh, ctx->w_scu, core->avail_cu, srefi[REFP_0], smvp[REFP_0]);
 
             core->refi[REFP_0] = srefi[REFP_0][core->mvp_idx[REFP_0]];
 
             core->mv[REFP_0][MV_X] = smvp[REFP_0][core->mvp_idx[REFP_0]][MV_X];
             core->mv[REFP_0][MV_Y] = smvp[REFP_0][core->mvp_idx[REFP_0]][MV_Y];
 
-            if (ctx->sh.slice_type == SLICE_P)
+            if (core->sh->slice_type == SLICE_P)
             {
                 core->refi[REFP_1] = REFI_INVALID;
                 core->mv[REFP_1][MV_X] = 0;
@@ -868,7 +925,7 @@ void xevd_get_skip_motion(XEVD_CTX * ctx, XEVD_CORE * core)
             }
             else
             {
-                xevdm_get_motion(core->scup, REFP_1, ctx->map_refi, ctx->map_mv, ctx->refp, cuw, cuh, ctx->w_scu, core->avail_cu, srefi[REFP_1], smvp[REFP_1]);
+                xevdm_get_motion(core->scup, REFP_1, ctx->map_refi, ctx->map_mv, core->refp, cuw, cuh, ctx->w_scu, core->avail_cu, srefi[REFP_1], smvp[REFP_1]);
 
                 core->refi[REFP_1] = srefi[REFP_1][core->mvp_idx[REFP_1]];
                 core->mv[REFP_1][MV_X] = smvp[REFP_1][core->mvp_idx[REFP_1]][MV_X];
@@ -899,7 +956,7 @@ void xevd_get_inter_motion(XEVD_CTX * ctx, XEVD_CORE * core)
         {
             if(ctx->sps->tool_admvp == 0)
             {
-                xevdm_get_motion(core->scup, inter_dir_idx, ctx->map_refi, ctx->map_mv, ctx->refp, cuw, cuh, ctx->w_scu, core->avail_cu, refi, mvp);
+                xevdm_get_motion(core->scup, inter_dir_idx, ctx->map_refi, ctx->map_mv, core->refp, cuw, cuh, ctx->w_scu, core->avail_cu, refi, mvp);
                 core->mv[inter_dir_idx][MV_X] = mvp[core->mvp_idx[inter_dir_idx]][MV_X] + core->mvd[inter_dir_idx][MV_X];
                 core->mv[inter_dir_idx][MV_Y] = mvp[core->mvp_idx[inter_dir_idx]][MV_Y] + core->mvd[inter_dir_idx][MV_Y];
             }
@@ -911,7 +968,7 @@ void xevd_get_inter_motion(XEVD_CTX * ctx, XEVD_CORE * core)
                         , mctx->map_unrefined_mv, core->history_buffer, ctx->sps->tool_hmvp, ctx->map_tidx);
                 }
 
-                xevdm_get_motion_from_mvr(core->mvr_idx, ctx->poc.poc_val, core->scup, inter_dir_idx, core->refi[inter_dir_idx], mctx->dpm.num_refp[inter_dir_idx], ctx->map_mv, ctx->map_refi, ctx->refp, \
+                xevdm_get_motion_from_mvr(core->mvr_idx, ctx->poc.poc_val, core->scup, inter_dir_idx, core->refi[inter_dir_idx], core->num_refp[inter_dir_idx], ctx->map_mv, ctx->map_refi, core->refp, \
                     cuw, cuh, ctx->w_scu, ctx->h_scu, core->avail_cu, mvp, refi, ctx->map_scu, core->avail_lr, mctx->map_unrefined_mv, core->history_buffer, ctx->sps->tool_hmvp, ctx->map_tidx);
 
                 core->mvp_idx[inter_dir_idx] = 0;
@@ -951,8 +1008,8 @@ void xevd_get_affine_motion(XEVD_CTX * ctx, XEVD_CORE * core)
         int vertex, lidx;
         int mrg_idx = core->mvp_idx[0];
 
-        xevdm_get_affine_merge_candidate(ctx->poc.poc_val, ctx->sh.slice_type, core->scup, ctx->map_refi, ctx->map_mv, ctx->refp, cuw, cuh, ctx->w_scu, ctx->h_scu, core->avail_cu, aff_refi, aff_mrg_mvp, vertex_num, ctx->map_scu, mctx->map_affine
-            , ctx->log2_max_cuwh, mctx->map_unrefined_mv, core->avail_lr, &ctx->sh, ctx->map_tidx);
+        xevdm_get_affine_merge_candidate(ctx->poc.poc_val, core->sh->slice_type, core->scup, ctx->map_refi, ctx->map_mv, core->refp, cuw, cuh, ctx->w_scu, ctx->h_scu, core->avail_cu, aff_refi, aff_mrg_mvp, vertex_num, ctx->map_scu, mctx->map_affine
+            , ctx->log2_max_cuwh, mctx->map_unrefined_mv, core->avail_lr, core->sh, ctx->map_tidx);
 
         mcore->affine_flag = vertex_num[core->mvp_idx[0]] - 1;
 
@@ -985,7 +1042,7 @@ void xevd_get_affine_motion(XEVD_CTX * ctx, XEVD_CORE * core)
             /* 0: forward, 1: backward */
             if (((core->inter_dir + 1) >> inter_dir_idx) & 1)
             {
-                xevdm_get_affine_motion_scaling(ctx->poc.poc_val, core->scup, inter_dir_idx, core->refi[inter_dir_idx], mctx->dpm.num_refp[inter_dir_idx], ctx->map_mv, ctx->map_refi, ctx->refp
+                xevdm_get_affine_motion_scaling(ctx->poc.poc_val, core->scup, inter_dir_idx, core->refi[inter_dir_idx], core->num_refp[inter_dir_idx], ctx->map_mv, ctx->map_refi, core->refp
                                             , cuw, cuh, ctx->w_scu, ctx->h_scu, core->avail_cu, affine_mvp, refi, ctx->map_scu, mctx->map_affine, vertex_num, core->avail_lr, ctx->log2_max_cuwh
                                             , mctx->map_unrefined_mv, ctx->map_tidx);
 
@@ -1182,47 +1239,21 @@ static int cu_init(XEVD_CTX *ctx, XEVD_CORE *core, int x, int y, int cuw, int cu
     return XEVD_OK;
 }
 
-static void coef_rect_to_series(XEVD_CTX * ctx, s16 *coef_src[N_C], int x, int y, int cuw, int cuh, s16 coef_dst[N_C][MAX_CU_DIM], XEVD_CORE * core)
+static void coef_rect_to_series(XEVD_CTX * ctx, XEVD_CU_DATA * cu_data, int x, int y, int cuw, int cuh, s16 coef_dst[N_C][MAX_CU_DIM], XEVD_CORE * core)
 {
-    int i, j, sidx, didx;
-
-    sidx = (x&(ctx->max_cuwh - 1)) + ((y&(ctx->max_cuwh - 1)) << ctx->log2_max_cuwh);
-    didx = 0;
+    int cup = ((y & (ctx->max_cuwh - 1)) << (ctx->log2_max_cuwh - MIN_CU_LOG2 * 2)) + ((x & (ctx->max_cuwh - 1)) >> MIN_CU_LOG2);
 
     if (xevd_check_luma(ctx, core))
     {
-        for (j = 0; j < cuh; j++)
-        {
-            for (i = 0; i < cuw; i++)
-            {
-                coef_dst[Y_C][didx++] = coef_src[Y_C][sidx + i];
-            }
-            sidx += ctx->max_cuwh;
-        }
-
+        xevd_coef_unpack(cu_data, cup, Y_C, coef_dst[Y_C], cuw * cuh);
     }
     if (xevd_check_chroma(ctx, core) && ctx->sps->chroma_format_idc)
     {
-        x >>= (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc));
-        y >>= (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc));
         cuw >>= (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc));
         cuh >>= (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc));
 
-        sidx = (x & ((ctx->max_cuwh >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) - 1)) + ((y & ((ctx->max_cuwh >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))) - 1)) << (ctx->log2_max_cuwh - (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))));
-
-        didx = 0;
-
-        for (j = 0; j < cuh; j++)
-        {
-            for (i = 0; i < cuw; i++)
-            {
-                coef_dst[U_C][didx] = coef_src[U_C][sidx + i];
-                coef_dst[V_C][didx] = coef_src[V_C][sidx + i];
-                didx++;
-            }
-            sidx += (ctx->max_cuwh >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc)));
-
-        }
+        xevd_coef_unpack(cu_data, cup, U_C, coef_dst[U_C], cuw * cuh);
+        xevd_coef_unpack(cu_data, cup, V_C, coef_dst[V_C], cuw * cuh);
     }
 }
 
@@ -1249,13 +1280,13 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
 
     core->avail_lr = xevd_check_nev_avail(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->h_scu, ctx->map_scu, ctx->map_tidx);
 
-    xevdm_get_ctx_some_flags(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->map_scu, ctx->cod_eco, ctx->map_cu_mode, core->ctx_flags, ctx->sh.slice_type, ctx->sps->tool_cm_init
+    xevdm_get_ctx_some_flags(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->map_scu, ctx->cod_eco, ctx->map_cu_mode, core->ctx_flags, core->sh->slice_type, ctx->sps->tool_cm_init
                          , ctx->sps->ibc_flag, ctx->sps->ibc_log_max_size, ctx->map_tidx, 0);
 
     /* inverse transform and dequantization */
     if(core->pred_mode != MODE_SKIP)
     {
-        coef_rect_to_series(ctx, cu_data->coef, x, y, cuw, cuh, core->coef, core);
+        coef_rect_to_series(ctx, cu_data, x, y, cuw, cuh, core->coef, core);
         xevdm_itdq_main(ctx, core);
     }
 
@@ -1291,7 +1322,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
         {
             xevd_get_affine_motion(ctx, core);
 
-            xevdm_affine_mc(x, y, ctx->w, ctx->h, cuw, cuh, core->refi, mcore->affine_mv, ctx->refp, core->pred, mcore->affine_flag + 1, core->eif_tmp_buffer, ctx->sps->bit_depth_luma_minus8 + 8, ctx->sps->bit_depth_chroma_minus8 + 8,  ctx->sps->chroma_format_idc);
+            xevdm_affine_mc(ctx, x, y, ctx->w, ctx->h, cuw, cuh, core->refi, mcore->affine_mv, core->refp, core->pred, mcore->affine_flag + 1, core->eif_tmp_buffer, ctx->sps->bit_depth_luma_minus8 + 8, ctx->sps->bit_depth_chroma_minus8 + 8,  ctx->sps->chroma_format_idc);
         }
         else
         {
@@ -1305,7 +1336,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
                 {
                     if(ctx->sps->tool_admvp == 0)
                     {
-                        xevdm_get_mv_dir(ctx->refp[0], ctx->poc.poc_val, core->scup + ((1 << (core->log2_cuw - MIN_CU_LOG2)) - 1) + ((1 << (core->log2_cuh - MIN_CU_LOG2)) - 1) * ctx->w_scu, core->scup, ctx->w_scu, ctx->h_scu, core->mv
+                        xevdm_get_mv_dir(core->refp[0], ctx->poc.poc_val, core->scup + ((1 << (core->log2_cuw - MIN_CU_LOG2)) - 1) + ((1 << (core->log2_cuh - MIN_CU_LOG2)) - 1) * ctx->w_scu, core->scup, ctx->w_scu, ctx->h_scu, core->mv
                             , ctx->sps->tool_admvp
                         );
                         core->refi[REFP_0] = 0;
@@ -1325,7 +1356,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
                     xevd_get_inter_motion(ctx, core);
                 }
             }
-            xevdm_mc(x, y, ctx->w, ctx->h, cuw, cuh, core->refi, core->mv, ctx->refp, core->pred, ctx->poc.poc_val, mcore->dmvr_template, mcore->dmvr_ref_pred_interpolated
+            xevdm_mc(ctx, x, y, ctx->w, ctx->h, cuw, cuh, core->refi, core->mv, core->refp, core->pred, ctx->poc.poc_val, mcore->dmvr_template, mcore->dmvr_ref_pred_interpolated
                    , mcore->dmvr_half_pred_interpolated, (mcore->dmvr_enable == 1) && ctx->sps->tool_dmvr, mcore->dmvr_padding_buf, &mcore->dmvr_flag, mcore->dmvr_mv
                    , ctx->sps->tool_admvp, ctx->sps->bit_depth_luma_minus8 + 8, ctx->sps->bit_depth_chroma_minus8+8, ctx->sps->chroma_format_idc);
         }
@@ -1338,7 +1369,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
 
             )
         {
-            update_history_buffer_parse_affine(core, ctx->sh.slice_type);
+            update_history_buffer_parse_affine(core, core->sh->slice_type);
         }
 
     }
@@ -1351,12 +1382,12 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
         {
             if (xevd_check_luma(ctx, core))
             {
-                xevdm_ipred(core->nb[0][0] + 2, core->nb[0][1] + cuh, core->nb[0][2] + 2, core->avail_lr, core->pred[0][Y_C], core->ipm[0], cuw, cuh, ctx->sps->bit_depth_luma_minus8 + 8);
+                xevdm_ipred(ctx, core->nb[0][0] + 2, core->nb[0][1] + cuh, core->nb[0][2] + 2, core->avail_lr, core->pred[0][Y_C], core->ipm[0], cuw, cuh, ctx->sps->bit_depth_luma_minus8 + 8);
             }
             if (xevd_check_chroma(ctx, core))
             {
-                xevdm_ipred_uv(core->nb[1][0] + 2, core->nb[1][1] + (cuh >> 1), core->nb[1][2] + 2, core->avail_lr, core->pred[0][U_C], core->ipm[1], core->ipm[0], cuw >> 1, cuh >> 1, ctx->sps->bit_depth_chroma_minus8 + 8);
-                xevdm_ipred_uv(core->nb[2][0] + 2, core->nb[2][1] + (cuh >> 1), core->nb[2][2] + 2, core->avail_lr, core->pred[0][V_C], core->ipm[1], core->ipm[0], cuw >> 1, cuh >> 1, ctx->sps->bit_depth_chroma_minus8 + 8);
+                xevdm_ipred_uv(ctx, core->nb[1][0] + 2, core->nb[1][1] + (cuh >> 1), core->nb[1][2] + 2, core->avail_lr, core->pred[0][U_C], core->ipm[1], core->ipm[0], cuw >> 1, cuh >> 1, ctx->sps->bit_depth_chroma_minus8 + 8);
+                xevdm_ipred_uv(ctx, core->nb[2][0] + 2, core->nb[2][1] + (cuh >> 1), core->nb[2][2] + 2, core->avail_lr, core->pred[0][V_C], core->ipm[1], core->ipm[0], cuw >> 1, cuh >> 1, ctx->sps->bit_depth_chroma_minus8 + 8);
             }
         }
         else
@@ -1386,7 +1417,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
 
             int constrained_intra_flag = core->pred_mode == MODE_INTRA && ctx->pps.constrained_intra_pred_flag;
 
-            xevdm_htdf(ctx->pic->y + (y * ctx->pic->s_l) + x, ctx->sh.qp, cuw, cuh, ctx->pic->s_l, core->pred_mode == MODE_INTRA, ctx->pic->y + (y * ctx->pic->s_l) + x, ctx->pic->s_l, avail_cu, core->scup, ctx->w_scu, ctx->h_scu, ctx->map_scu, constrained_intra_flag, ctx->sps->bit_depth_luma_minus8 + 8);
+            xevdm_htdf(ctx->pic->y + (y * ctx->pic->s_l) + x, core->sh->qp, cuw, cuh, ctx->pic->s_l, core->pred_mode == MODE_INTRA, ctx->pic->y + (y * ctx->pic->s_l) + x, ctx->pic->s_l, avail_cu, core->scup, ctx->w_scu, ctx->h_scu, ctx->map_scu, constrained_intra_flag, ctx->sps->bit_depth_luma_minus8 + 8);
         }
     }
 
@@ -1404,7 +1435,7 @@ static int xevd_recon_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int l
 
 }
 
-static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud);
+static int copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud);
 
 static int xevd_entropy_dec_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int log2_cuw, int log2_cuh, TREE_CONS_NEW tree_cons, int cud)
 {
@@ -1438,14 +1469,15 @@ static int xevd_entropy_dec_unit(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y,
     mcore->ats_intra_cu = mcore->ats_intra_mode_h = mcore->ats_intra_mode_v = 0;
     core->avail_lr = xevd_check_eco_nev_avail(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->h_scu, ctx->cod_eco, ctx->map_tidx);
 
-    xevdm_get_ctx_some_flags(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->map_scu, ctx->cod_eco, ctx->map_cu_mode, core->ctx_flags, ctx->sh.slice_type, ctx->sps->tool_cm_init
+    xevdm_get_ctx_some_flags(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->map_scu, ctx->cod_eco, ctx->map_cu_mode, core->ctx_flags, core->sh->slice_type, ctx->sps->tool_cm_init
                          , ctx->sps->ibc_flag, ctx->sps->ibc_log_max_size, ctx->map_tidx, 1);
 
     /* parse CU info */
     ret = xevdm_eco_cu(ctx, core);
     xevd_assert_g(ret == XEVD_OK, ERR);
 
-    copy_to_cu_data(ctx, core, cud);
+    ret = copy_to_cu_data(ctx, core, cud);
+    xevd_assert_g(ret == XEVD_OK, ERR);
     xevdm_set_dec_info(ctx, core);
     u8 *cod_eco = ctx->cod_eco + core->scup;
     xevd_mset(cod_eco, 1, (cuw >> MIN_CU_LOG2) * sizeof(u8));
@@ -1459,10 +1491,10 @@ ERR:
     return ret;
 }
 
-static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
+static int copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
 {
     XEVD_CU_DATA *cu_data;
-    int idx, size;
+    int idx, size, ret;
     int log2_cuw, log2_cuh;
     int x_in_lcu = core->x - (core->x_lcu << ctx->log2_max_cuwh);
     int y_in_lcu = core->y - (core->y_lcu << ctx->log2_max_cuwh);
@@ -1475,20 +1507,17 @@ static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
 
     if (xevd_check_luma(ctx, core))
     {
-        /* copy coef */
-        size = core->cuw * sizeof(s16);
-        s16* dst_coef = cu_data->coef[Y_C] + (y_in_lcu << ctx->log2_max_cuwh) + x_in_lcu;
-        s16* src_coef = core->coef[Y_C];
-        for (int j = 0; j < core->cuh; j++)
-        {
-            xevd_mcpy(dst_coef, src_coef, size);
-            dst_coef += ctx->max_cuwh;
-            src_coef += core->cuw;
-        }
-
         /* copy mode info */
         idx = (y_in_lcu << (ctx->log2_max_cuwh - MIN_CU_LOG2 * 2)) + (x_in_lcu >> MIN_CU_LOG2);
 
+        /* pack nonzero coef */
+        cu_data->coef_ofs[Y_C][idx] = -1;
+        if (core->is_coef[Y_C])
+        {
+            ret = xevd_coef_pack(cu_data, idx, Y_C, core->coef[Y_C], core->cuw * core->cuh);
+            xevd_assert_rv(ret == XEVD_OK, ret);
+        }
+
         cu_data->pred_mode[idx] = core->pred_mode;
         cu_data->skip_flag[idx] = core->skip_flag;
         cu_data->mmvd_flag[idx] = mcore->mmvd_flag;
@@ -1604,22 +1633,21 @@ static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
 
     if (xevd_check_chroma(ctx, core))
     {
-        size = (core->cuw >> 1) * sizeof(s16);
+        /* copy mode info */
+        idx = (y_in_lcu << (ctx->log2_max_cuwh - MIN_CU_LOG2 * 2)) + (x_in_lcu >> MIN_CU_LOG2);
+
+        /* pack nonzero coef */
+        size = (core->cuw >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) * (core->cuh >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc)));
         for (int c = U_C; c <= V_C; c++)
         {
-            s16* dst_coef = cu_data->coef[c] + (y_in_lcu << (ctx->log2_max_cuwh - 2)) + (x_in_lcu >> 1);
-            s16* src_coef = core->coef[c];
-            for (int j = 0; j < core->cuh >> 1; j++)
+            cu_data->coef_ofs[c][idx] = -1;
+            if (core->is_coef[c])
             {
-                xevd_mcpy(dst_coef, src_coef, size);
-                dst_coef += ctx->max_cuwh >> 1;
-                src_coef += core->cuw >> 1;
+                ret = xevd_coef_pack(cu_data, idx, c, core->coef[c], size);
+                xevd_assert_rv(ret == XEVD_OK, ret);
             }
         }
 
-        /* copy mode info */
-        idx = (y_in_lcu << (ctx->log2_max_cuwh - MIN_CU_LOG2 * 2)) + (x_in_lcu >> MIN_CU_LOG2);
-
         cu_data->pred_mode_chroma[idx] = core->pred_mode;
         cu_data->nnz[U_C][idx] = core->is_coef[U_C];
         cu_data->nnz[V_C][idx] = core->is_coef[V_C];
@@ -1639,6 +1667,7 @@ static void copy_to_cu_data(XEVD_CTX *ctx, XEVD_CORE *core, int cud)
             cu_data->ipm[1][idx] = core->ipm[1];
         }
     }
+    return XEVD_OK;
 }
 
 static int xevd_entropy_decode_tree(XEVD_CTX * ctx, XEVD_CORE * core, int x0, int y0, int log2_cuw, int log2_cuh, int cup, int cud, XEVD_BSR * bs, XEVD_SBAC * sbac, int next_split
@@ -1783,7 +1812,7 @@ static int xevd_entropy_decode_tree(XEVD_CTX * ctx, XEVD_CORE * core, int x0, in
 
             if ( mode_constraint_changed )
             {
-                if ( ctx->sh.slice_type == SLICE_I || xevdm_get_mode_cons_by_split(split_mode, cuw, cuh) == eOnlyIntra || ctx->sps->chroma_format_idc != 1)
+                if ( core->sh->slice_type == SLICE_I || xevdm_get_mode_cons_by_split(split_mode, cuw, cuh) == eOnlyIntra || ctx->sps->chroma_format_idc != 1)
                 {
                     mode_cons_for_child = eOnlyIntra;
                 }
@@ -1793,7 +1822,7 @@ static int xevd_entropy_decode_tree(XEVD_CTX * ctx, XEVD_CORE * core, int x0, in
                     core->x_scu = PEL2SCU(x0);
                     core->y_scu = PEL2SCU(y0);
 
-                    xevdm_get_ctx_some_flags(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->map_scu, ctx->cod_eco, ctx->map_cu_mode, core->ctx_flags, ctx->sh.slice_type, ctx->sps->tool_cm_init
+                    xevdm_get_ctx_some_flags(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->map_scu, ctx->cod_eco, ctx->map_cu_mode, core->ctx_flags, core->sh->slice_type, ctx->sps->tool_cm_init
                                          , ctx->sps->ibc_flag, ctx->sps->ibc_log_max_size, ctx->map_tidx, 1);
 
                     mode_cons_for_child = xevdm_eco_mode_constr(core->bs, core->ctx_flags[CNID_MODE_CONS]);
@@ -1838,7 +1867,7 @@ static int xevd_entropy_decode_tree(XEVD_CTX * ctx, XEVD_CORE * core, int x0, in
         TREE_TYPE tree_type = mode_cons == eOnlyIntra ? TREE_L : TREE_LC;
         assert( mode_cons != eOnlyInter || !( ctx->sps->tool_admvp && log2_cuw == 2 && log2_cuh == 2 ) );
 
-        if (ctx->sh.slice_type == SLICE_I || (ctx->sps->tool_admvp && log2_cuw == 2 && log2_cuh == 2))
+        if (core->sh->slice_type == SLICE_I || (ctx->sps->tool_admvp && log2_cuw == 2 && log2_cuh == 2))
         {
             mode_cons = eOnlyIntra;
         }
@@ -1920,7 +1949,7 @@ static int xevd_recon_tree(XEVD_CTX * ctx, XEVD_CORE * core, int x, int y, int c
         TREE_TYPE tree_type = tree_cons.mode_cons == eOnlyIntra ? (tree_cons.tree_type == TREE_C ? TREE_C : TREE_L) : TREE_LC;
         assert(tree_cons.mode_cons != eOnlyInter || !(ctx->sps->tool_admvp && XEVD_CONV_LOG2(cuw) == 2 && XEVD_CONV_LOG2(cuh) == 2));
 
-        if (ctx->sh.slice_type == SLICE_I || (ctx->sps->tool_admvp && XEVD_CONV_LOG2(cuw) == 2 && XEVD_CONV_LOG2(cuh) == 2))
+        if (core->sh->slice_type == SLICE_I || (ctx->sps->tool_admvp && XEVD_CONV_LOG2(cuw) == 2 && XEVD_CONV_LOG2(cuh) == 2))
         {
             tree_cons.mode_cons = eOnlyIntra;
         }
@@ -2045,68 +2074,367 @@ static void deblock_tree(XEVD_CTX * ctx, XEVD_PIC * pic, int x, int y, int cuw,
     mcore->tree_cons = ( TREE_CONS ) { FALSE, tree_cons.tree_type, tree_cons.mode_cons }; //TODO:Tim further refactor //TODO:Tim could it be removed? tree_constrain_for_child?
 }
 
+/* deblock the CTU row core->y_lcu of the tile core->tile_num, filtering the
+   edges of core->deblock_is_hor. the COD flags of the row and of its left
+   and right neighbours are cleared and the unrefined MVs copied beforehand */
 int xevdm_deblock(void * arg)
 {
     xevd_assert(arg != NULL);
     XEVD_CORE  * core = (XEVD_CORE *)arg;
     XEVD_CTX   * ctx = core->ctx;
-    int          tile_idx;
-    int          i, j;
+    XEVD_TILE  * tile = ctx->tile + core->tile_num;
+    int          x_l, x_r, i;
+
+    x_l = tile->ctba_rs_first % ctx->w_lcu;
+    x_r = x_l + tile->w_ctb;
+    for (i = x_l; i < x_r; i++)
+    {
+        deblock_tree(ctx, ctx->pic, (i << ctx->log2_max_cuwh), (core->y_lcu << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0, core->deblock_is_hor
+                   , (TREE_CONS_NEW) { TREE_LC, eAll }, core, ctx->pps.loop_filter_across_tiles_enabled_flag);
+    }
+
+    return XEVD_OK;
+}
+
+/* set the deblocking parameters of the picture, clear the COD flags of the
+   CTU rows [t_lcu, b_lcu) and keep the MVs of the CUs not refined by DMVR */
+static void deblock_prepare(XEVD_CTX * ctx, int t_lcu, int b_lcu)
+{
     XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
-    tile_idx = core->tile_num;
+    int         scu_in_lcu_wh = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
+    int         t_scu = t_lcu * scu_in_lcu_wh;
+    int         b_scu = XEVD_MIN((int)ctx->h_scu, b_lcu * scu_in_lcu_wh);
+    int         k1;
+
     ctx->pic->pic_deblock_alpha_offset = ctx->sh.sh_deblock_alpha_offset;
     ctx->pic->pic_deblock_beta_offset = ctx->sh.sh_deblock_beta_offset;
     ctx->pic->pic_qp_u_offset = ctx->sh.qp_u_offset;
     ctx->pic->pic_qp_v_offset = ctx->sh.qp_v_offset;
 
-    int x_l, x_r, y_l, y_r, l_scu, r_scu, t_scu, b_scu;
-    u32 k1;
-    int scu_in_lcu_wh = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
+    for (k1 = t_scu * ctx->w_scu; k1 < b_scu * (int)ctx->w_scu; k1++)
+    {
+        MCU_CLR_COD(ctx->map_scu[k1]);
+
+        if (!MCU_GET_DMVRF(ctx->map_scu[k1]))
+        {
+            mctx->map_unrefined_mv[k1][REFP_0][MV_X] = ctx->map_mv[k1][REFP_0][MV_X];
+            mctx->map_unrefined_mv[k1][REFP_0][MV_Y] = ctx->map_mv[k1][REFP_0][MV_Y];
+            mctx->map_unrefined_mv[k1][REFP_1][MV_X] = ctx->map_mv[k1][REFP_1][MV_X];
+            mctx->map_unrefined_mv[k1][REFP_1][MV_Y] = ctx->map_mv[k1][REFP_1][MV_Y];
+        }
+    }
+}
 
-    x_l = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
-    y_l = (ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
-    x_r = x_l + ctx->tile[tile_idx].w_ctb;
-    y_r = y_l + ctx->tile[tile_idx].h_ctb;
-    l_scu = x_l * scu_in_lcu_wh;
-    r_scu = XEVD_CLIP3(0, ctx->w_scu, x_r*scu_in_lcu_wh);
-    t_scu = y_l * scu_in_lcu_wh;
-    b_scu = XEVD_CLIP3(0, ctx->h_scu, y_r*scu_in_lcu_wh);
+/*****************************************************************************
+ * in-loop filtering of the picture
+ *
+ * deblocking (vertical then horizontal edges), ALF (copy to the temporary
+ * buffers, then filtering) and padding run in one xevd_parallel_for() rather
+ * than a parallel pass per stage joined before the next. the work of a stage
+ * is split in units of one CTU row of one tile column (padding: one CTU row
+ * of the picture). tasks are taken stage by stage in raster order of the
+ * units, and a task waits only for the units whose samples it reads or
+ * changes (see lf_unit_task()), which always come earlier. so a thread done
+ * with the last units of a stage goes on with the next stage of the rows
+ * already complete instead of waiting for the whole picture.
+ * ctx->sync_flag, free once the picture is reconstructed, counts the stages
+ * done by every unit
+ *****************************************************************************/
+enum
+{
+    LF_DBK_VER,
+    LF_DBK_HOR,
+    LF_ALF_COPY,
+    LF_ALF_FILT,
+    LF_PAD
+};
+
+typedef struct _LF_TASK
+{
+    XEVD_CTX   * ctx;
+    /* LF_XXX of the stages run for the picture, in order */
+    int          stage[LF_PAD + 1];
+    int          stage_cnt;
+    /* units per stage: tile columns x CTU rows */
+    int          unit_cnt;
+} LF_TASK;
+
+/* wait until the units of tile columns [c0, c1] and CTU rows [y0, y1] have
+   done cnt stages */
+static void lf_unit_wait(XEVD_CTX * ctx, int c0, int c1, int y0, int y1, int cnt, int worker_idx)
+{
+    int c, y;
 
-    for (j = t_scu; j < b_scu; j++)
+    c0 = XEVD_MAX(c0, 0);
+    c1 = XEVD_MIN(c1, ctx->w_tile - 1);
+    y0 = XEVD_MAX(y0, 0);
+    y1 = XEVD_MIN(y1, ctx->h_lcu - 1);
+    for (y = y0; y <= y1; y++)
     {
-        for (i = l_scu; i < r_scu; i++)
+        for (c = c0; c <= c1; c++)
         {
-            k1 = i + j * ctx->w_scu;
-            MCU_CLR_COD(ctx->map_scu[k1]);
+            xevd_progress_wait(&ctx->sync_flag[y * ctx->w_tile + c], cnt, &ctx->wait_cycles[worker_idx]);
+        }
+    }
+}
 
-            if (!MCU_GET_DMVRF(ctx->map_scu[k1]))
-            {
-                mctx->map_unrefined_mv[k1][REFP_0][MV_X] = ctx->map_mv[k1][REFP_0][MV_X];
-                mctx->map_unrefined_mv[k1][REFP_0][MV_Y] = ctx->map_mv[k1][REFP_0][MV_Y];
-                mctx->map_unrefined_mv[k1][REFP_1][MV_X] = ctx->map_mv[k1][REFP_1][MV_X];
-                mctx->map_unrefined_mv[k1][REFP_1][MV_Y] = ctx->map_mv[k1][REFP_1][MV_Y];
-            }
+/* xevd_parallel_for() task: run stage task_idx / unit_cnt on a unit */
+static int lf_unit_task(void * arg, int task_idx, int worker_idx)
+{
+    LF_TASK    * t = (LF_TASK *)arg;
+    XEVD_CTX   * ctx = t->ctx;
+    XEVDM_CTX  * mctx = (XEVDM_CTX *)ctx;
+    XEVD_CORE  * core;
+    XEVD_TILE  * tile;
+    int          s = task_idx / t->unit_cnt;
+    int          u = task_idx % t->unit_cnt;
+    int          c = u % ctx->w_tile;
+    int          y = u / ctx->w_tile;
+    int          tile_idx, y_tile, scu;
+    u64          t_perf, wait_beg = ctx->wait_cycles[worker_idx];
+
+    if (t->stage[s] == LF_PAD)
+    {
+        /* u is the CTU row; the last stage changes the rows next to it */
+        if (s > 0)
+        {
+            lf_unit_wait(ctx, 0, ctx->w_tile - 1, u - 1, u + 1, s, worker_idx);
         }
+        XEVD_TL_BLOCKED(ctx, worker_idx, u, wait_beg);
+        XEVD_PERF_BEG(ctx, t_perf);
+        xevd_picbuf_expand_rows(ctx, ctx->pic, u, u + 1);
+        XEVD_TL_END(ctx, worker_idx, XEVD_PERF_PAD, u, t_perf);
+        return XEVD_OK;
     }
 
-    /* horizontal filtering */
-    for (j = y_l; j < y_r; j++)
+    /* tile of the unit and its row in the tile */
+    scu = PEL2SCU((ctx->tile[c].ctba_rs_first % ctx->w_lcu) << ctx->log2_max_cuwh) + PEL2SCU(y << ctx->log2_max_cuwh) * ctx->w_scu;
+    tile_idx = ctx->map_tidx[scu];
+    tile = ctx->tile + tile_idx;
+    y_tile = y - tile->ctba_rs_first / ctx->w_lcu;
+
+    switch (t->stage[s])
     {
-        for (i = x_l; i < x_r; i++)
+    case LF_DBK_VER:
+        /* the edge with the left column is filtered by this unit, once the
+           left unit has set its COD flags, as in decoding order */
+        lf_unit_wait(ctx, c - 1, c - 1, y, y, s + 1, worker_idx);
+        break;
+    case LF_DBK_HOR:
+        /* vertical edges of the units around change the samples read here;
+           the edge with the row above changes the bottom of that row, which
+           its own horizontal edges use */
+        lf_unit_wait(ctx, c - 1, c + 1, y - 1, y + 1, s, worker_idx);
+        lf_unit_wait(ctx, c, c, y - 1, y - 1, s + 1, worker_idx);
+        break;
+    case LF_ALF_COPY:
+        /* deblocking of the edge with the next row changes the bottom rows */
+        if (s > 0)
         {
-            deblock_tree(ctx, ctx->pic, (i << ctx->log2_max_cuwh), (j << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0, core->deblock_is_hor
-                       , (TREE_CONS_NEW) { TREE_LC, eAll }, core, ctx->pps.loop_filter_across_tiles_enabled_flag);
+            lf_unit_wait(ctx, c - 1, c + 1, y, y + 1, s, worker_idx);
         }
+        break;
+    case LF_ALF_FILT:
+        /* the filter reads the copy of the rows above and below */
+        lf_unit_wait(ctx, c, c, y - 1, y + 1, s, worker_idx);
+        break;
+    }
+    XEVD_TL_BLOCKED(ctx, worker_idx, u, wait_beg);
+
+    XEVD_PERF_BEG(ctx, t_perf);
+    switch (t->stage[s])
+    {
+    case LF_DBK_VER:
+    case LF_DBK_HOR:
+        core = ctx->core_mt[worker_idx];
+        core->ctx = ctx;
+        core->tile_num = tile_idx;
+        core->y_lcu = y;
+        core->deblock_is_hor = (t->stage[s] == LF_DBK_HOR);
+        core->filter_across_boundary = 0;
+        ctx->fn_deblock((void *)core);
+        XEVD_TL_END(ctx, worker_idx, XEVD_PERF_DEBLOCK, u, t_perf);
+        break;
+    case LF_ALF_COPY:
+        call_dec_alf_process_rows((ADAPTIVE_LOOP_FILTER *)mctx->alf, tile_idx, worker_idx, y_tile, y_tile + 1, 0, 0);
+        XEVD_TL_END(ctx, worker_idx, XEVD_PERF_ALF, u, t_perf);
+        break;
+    case LF_ALF_FILT:
+        call_dec_alf_process_rows((ADAPTIVE_LOOP_FILTER *)mctx->alf, tile_idx, worker_idx, 0, 0, y_tile, y_tile + 1);
+        XEVD_TL_END(ctx, worker_idx, XEVD_PERF_ALF, u, t_perf);
+        break;
     }
 
+    xevd_threadsafe_assign(&ctx->sync_flag[u], s + 1);
     return XEVD_OK;
 }
 
-int xevd_alf(XEVD_CTX * ctx, XEVD_PIC * pic)
+/* deblock, ALF-filter and pad the reconstructed picture */
+static int lf_pic(XEVD_CTX * ctx)
 {
     XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
-    ADAPTIVE_LOOP_FILTER* p = (ADAPTIVE_LOOP_FILTER*)(mctx->alf);
-    int ret = call_dec_alf_process_aps(p, ctx, pic);
+    LF_TASK     t;
+    int         ret, task_cnt;
+
+    t.ctx = ctx;
+    t.stage_cnt = 0;
+    t.unit_cnt = ctx->w_tile * ctx->h_lcu;
+
+    if (ctx->sh.deblocking_filter_on)
+    {
+        deblock_prepare(ctx, 0, ctx->h_lcu);
+        t.stage[t.stage_cnt++] = LF_DBK_VER;
+        t.stage[t.stage_cnt++] = LF_DBK_HOR;
+    }
+    if (mctx->sh.alf_on)
+    {
+        ret = call_dec_alf_rows_begin((ADAPTIVE_LOOP_FILTER *)mctx->alf, ctx, ctx->pic);
+        xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
+        if (((ADAPTIVE_LOOP_FILTER *)mctx->alf)->rows_on)
+        {
+            t.stage[t.stage_cnt++] = LF_ALF_COPY;
+            t.stage[t.stage_cnt++] = LF_ALF_FILT;
+        }
+    }
+    task_cnt = t.stage_cnt * t.unit_cnt;
+    if (ctx->ref_pad_l)
+    {
+        /* one task per CTU row: the last stage has unit_cnt tasks, of which
+           h_lcu are used */
+        t.stage[t.stage_cnt++] = LF_PAD;
+        task_cnt += ctx->h_lcu;
+    }
+    if (task_cnt == 0)
+    {
+        return XEVD_OK;
+    }
+
+    xevd_mset((void *)ctx->sync_flag, 0, t.unit_cnt * sizeof(ctx->sync_flag[0]));
+    return xevd_parallel_for(&ctx->tc, ctx->thread_pool, ctx->tc.max_task_cnt, task_cnt, lf_unit_task, (void *)&t);
+}
+
+/*****************************************************************************
+ * in-loop filtering by CTU rows
+ *
+ * instead of deblocking, ALF and padding the whole picture after the last CTU
+ * is reconstructed, the rows are filtered while reconstruction goes on, so the
+ * samples are still in cache. filter step s (one per row, plus two to drain)
+ * deblocks row s, copies row s-1 to the ALF buffer and ALF-filters and pads
+ * row s-2. it runs once rows up to s+1 are reconstructed: the next row reads
+ * the unfiltered bottom samples of a row for intra prediction and its
+ * deblocking changes them again, and ALF reads three rows of either
+ * neighbour. steps are run in order by whichever thread holds lf_pipe_lock.
+ * only pictures made of a single tile (and therefore a single slice) without
+ * IBC are filtered this way; others use the picture-level passes.
+ *****************************************************************************/
+static void lf_pipe_deblock_row(XEVD_CTX * ctx, XEVD_CORE * core, int y_lcu)
+{
+    deblock_prepare(ctx, y_lcu, y_lcu + 1);
+
+    core->tile_num = 0;
+    core->y_lcu = y_lcu;
+    for (core->deblock_is_hor = 0; core->deblock_is_hor <= 1; core->deblock_is_hor++)
+    {
+        ctx->fn_deblock((void *)core);
+    }
+}
+
+/* number of leading CTU rows whose reconstruction is complete */
+static int lf_pipe_rows_ready(XEVD_CTX * ctx)
+{
+    XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
+    int         rows = xevd_threadsafe_read(&mctx->lf_pipe_rows);
+
+    while (rows < ctx->h_lcu && xevd_threadsafe_read(&ctx->sync_flag[(rows + 1) * ctx->w_lcu - 1]) == THREAD_TERMINATED)
+    {
+        rows++;
+    }
+    return rows;
+}
+
+static int lf_pipe_step_ready(XEVD_CTX * ctx)
+{
+    XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
+    int         step = xevd_threadsafe_read(&mctx->lf_pipe_step);
+
+    return step < ctx->h_lcu + 2 && XEVD_MIN(step + 2, ctx->h_lcu) <= lf_pipe_rows_ready(ctx);
+}
+
+static void lf_pipe_step(XEVD_CTX * ctx, int thread_idx)
+{
+    XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
+    int         step = xevd_threadsafe_read(&mctx->lf_pipe_step);
+    int         row;
+    u64         t_perf;
+
+    if (step < ctx->h_lcu && ctx->sh.deblocking_filter_on)
+    {
+        XEVD_PERF_BEG(ctx, t_perf);
+        lf_pipe_deblock_row(ctx, mctx->lf_core, step);
+        XEVD_TL_END(ctx, thread_idx, XEVD_PERF_DEBLOCK, step, t_perf);
+    }
+
+    row = step - 2;
+    if (mctx->sh.alf_on)
+    {
+        XEVD_PERF_BEG(ctx, t_perf);
+        call_dec_alf_process_rows((ADAPTIVE_LOOP_FILTER *)mctx->alf, 0, 0, XEVD_MAX(step - 1, 0), XEVD_MIN(step, ctx->h_lcu), XEVD_MAX(row, 0), row + 1);
+        XEVD_TL_END(ctx, thread_idx, XEVD_PERF_ALF, row, t_perf);
+    }
+    if (row >= 0)
+    {
+        if (ctx->ref_pad_l)
+        {
+            XEVD_PERF_BEG(ctx, t_perf);
+            xevd_picbuf_expand_rows(ctx, ctx->pic, row, row + 1);
+            XEVD_TL_END(ctx, thread_idx, XEVD_PERF_PAD, row, t_perf);
+        }
+    }
+
+    xevd_threadsafe_assign(&mctx->lf_pipe_rows, lf_pipe_rows_ready(ctx));
+    xevd_threadsafe_assign(&mctx->lf_pipe_step, step + 1);
+}
+
+/* run the filter steps made possible by the rows reconstructed so far. a
+   thread finding the lock taken leaves its rows to the holder, which checks
+   for ready steps again after releasing it */
+static void lf_pipe_run(XEVD_CTX * ctx, int thread_idx)
+{
+    XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
+
+    while (lf_pipe_step_ready(ctx))
+    {
+        if (!xevd_threadsafe_trylock(&mctx->lf_pipe_lock))
+        {
+            break;
+        }
+        while (lf_pipe_step_ready(ctx))
+        {
+            lf_pipe_step(ctx, thread_idx);
+        }
+        xevd_threadsafe_assign(&mctx->lf_pipe_lock, 0);
+    }
+}
+
+static int lf_pipe_begin(XEVD_CTX * ctx)
+{
+    XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
+    int         ret = XEVD_OK;
+
+    mctx->lf_pipe_on = mctx->lf_pipe && ctx->w_tile * ctx->h_tile == 1 && !ctx->sps->ibc_flag;
+    if (!mctx->lf_pipe_on)
+    {
+        return XEVD_OK;
+    }
+
+    mctx->lf_pipe_lock = 0;
+    xevd_threadsafe_assign(&mctx->lf_pipe_step, 0);
+    xevd_threadsafe_assign(&mctx->lf_pipe_rows, 0);
+    mctx->lf_core->ctx = ctx;
+    if (mctx->sh.alf_on)
+    {
+        ret = call_dec_alf_rows_begin((ADAPTIVE_LOOP_FILTER *)mctx->alf, ctx, ctx->pic);
+    }
     return ret;
 }
 
@@ -2373,8 +2701,10 @@ int xevd_tile_eco(void * arg)
     int         lcu_cnt_in_tile = 0;
     int         tile_idx;
     XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
+    u64         t_perf;
     xevd_assert(arg != NULL);
 
+    XEVD_PERF_BEG(ctx, t_perf);
     tile_idx = core->tile_num;
     col_bd = 0;
     if (tile_idx % (ctx->pps.num_tile_columns_minus1 + 1))
@@ -2392,7 +2722,7 @@ int xevd_tile_eco(void * arg)
         col_bd = 0;
     }
 
-    xevdm_eco_sbac_reset(bs, ctx->sh.slice_type, ctx->sh.qp, ctx->sps->tool_cm_init);
+    xevdm_eco_sbac_reset(bs, core->sh->slice_type, core->sh->qp, ctx->sps->tool_cm_init);
     tile = &(ctx->tile[tile_idx]);
     core->x_lcu = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
     core->y_lcu = (ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
@@ -2406,10 +2736,11 @@ int xevd_tile_eco(void * arg)
         xevd_assert_rv(core->lcu_num < ctx->f_lcu, XEVD_ERR_UNEXPECTED);
 
         core->split_mode = &ctx->map_split[core->lcu_num];
+        ctx->map_cu_data[core->lcu_num].coef_cnt = 0;
         mcore->suco_flag = &mctx->map_suco[core->lcu_num];
 
-        XEVD_ALF_SLICE_PARAM* alf_slice_param = &(mctx->sh.alf_sh_param);
-        if ((alf_slice_param->is_ctb_alf_on) && (mctx->sh.alf_on))
+        XEVD_ALF_SLICE_PARAM* alf_slice_param = &(mcore->msh->alf_sh_param);
+        if ((alf_slice_param->is_ctb_alf_on) && (mcore->msh->alf_on))
         {
             XEVD_TRACE_COUNTER;
             XEVD_TRACE_STR("Usage of ALF: ");
@@ -2417,11 +2748,11 @@ int xevd_tile_eco(void * arg)
             XEVD_TRACE_INT((int)(*(alf_slice_param->alf_ctu_enable_flag + core->lcu_num)));
             XEVD_TRACE_STR("\n");
         }
-        if ((mctx->sh.alf_chroma_map_signalled) && (mctx->sh.alf_on))
+        if ((mcore->msh->alf_chroma_map_signalled) && (mcore->msh->alf_on))
         {
             *(alf_slice_param->alf_ctu_enable_flag_chroma + core->lcu_num) = xevd_sbac_decode_bin(bs, sbac, sbac->ctx.alf_ctb_flag);
         }
-        if ((mctx->sh.alf_chroma2_map_signalled) && (mctx->sh.alf_on))
+        if ((mcore->msh->alf_chroma2_map_signalled) && (mcore->msh->alf_on))
         {
             *(alf_slice_param->alf_ctu_enable_flag_chroma2 + core->lcu_num) = xevd_sbac_decode_bin(bs, sbac, sbac->ctx.alf_ctb_flag);
         }
@@ -2436,7 +2767,7 @@ int xevd_tile_eco(void * arg)
             xevd_threadsafe_assign(&ctx->sync_row[core->y_lcu], THREAD_TERMINATED);
             xevd_assert_gv(xevd_eco_tile_end_flag(bs, sbac) == 1, ret, XEVD_ERR, ERR);
             /*Decode zero bits after processing of last tile in slice*/
-            if (core->tile_num == ctx->num_tiles_in_slice - 1)
+            if (mcore->last_tile_in_slice)
             {
                 ret = xevd_eco_cabac_zero_word(bs);
                 xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
@@ -2455,6 +2786,7 @@ int xevd_tile_eco(void * arg)
 
     clear_tile_cod_map(ctx, core);
 
+    XEVD_TL_END(ctx, core->thread_idx, XEVD_PERF_ENTROPY, core->tile_num, t_perf);
     return XEVD_OK;
 ERR:
     return ret;
@@ -2469,6 +2801,7 @@ int xevd_ctu_row_rec_mt(void * arg)
     int         ret;
     int         lcu_cnt_in_tile = 0;
     int         tile_idx;
+    u64         t_perf, wait_beg;
 
     xevd_assert(arg != NULL);
     XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
@@ -2483,14 +2816,16 @@ int xevd_ctu_row_rec_mt(void * arg)
     //LCU decoding with in a tile
     while (ctx->tile[tile_idx].f_ctb > 0)
     {
-        if (ctx->num_tiles_in_slice == 1 && ctx->tc.max_task_cnt > 2)
+        wait_beg = ctx->wait_cycles[core->thread_idx];
+        if (ctx->tc.max_task_cnt > 2 && ctx->tile_cnt == 1)
         {
-            xevd_spinlock_wait(&ctx->sync_row[core->y_lcu], THREAD_TERMINATED);
+            xevd_spinlock_wait(&ctx->sync_row[core->y_lcu], THREAD_TERMINATED, &ctx->wait_cycles[core->thread_idx]);
         }
-        if (core->y_lcu != sp_y_lcu && core->x_lcu < (sp_x_lcu + ctx->tile[tile_idx].w_ctb - 1))
+        if (core->y_lcu != sp_y_lcu)
         {
-            /* up-right CTB */
-            xevd_spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED);
+            /* up-right CTB, or the one above in the last column of the tile */
+            int x_ofs = core->x_lcu < (sp_x_lcu + ctx->tile[tile_idx].w_ctb - 1) ? 1 : 0;
+            xevd_spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + x_ofs], THREAD_TERMINATED, &ctx->wait_cycles[core->thread_idx]);
         }
 
         xevd_assert_rv(core->lcu_num < ctx->f_lcu, XEVD_ERR_UNEXPECTED);
@@ -2501,14 +2836,24 @@ int xevd_ctu_row_rec_mt(void * arg)
             xevd_assert_rv(ret == XEVD_OK, ret);
         }
 
+        XEVD_TL_BLOCKED(ctx, core->thread_idx, core->lcu_num, wait_beg);
+
+        XEVD_PERF_BEG(ctx, t_perf);
         ret = xevd_recon_tree(ctx, core, (core->x_lcu << ctx->log2_max_cuwh), (core->y_lcu << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh
                             , 0, 0, (TREE_CONS_NEW) { TREE_LC, eAll });
         xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
+        XEVD_TL_END(ctx, core->thread_idx, XEVD_PERF_RECON, core->lcu_num, t_perf);
 
         xevd_threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
         xevd_threadsafe_decrement(ctx->sync_block, (volatile s32 *)&ctx->tile[tile_idx].f_ctb);
 
-        if (ctx->tc.max_task_cnt > 2 && ctx->num_tiles_in_slice == 1)
+        if (mctx->lf_pipe_on && core->x_lcu == ctx->w_lcu - 1)
+        {
+            /* a CTU row is complete */
+            lf_pipe_run(ctx, core->thread_idx);
+        }
+
+        if (ctx->tc.max_task_cnt > 2 && ctx->tile_cnt == 1)
         {
             core->lcu_num = mt_get_next_ctu_num(ctx, core, ctx->tc.task_num_in_tile[0] - 1);
         }
@@ -2532,14 +2877,16 @@ int xevd_tile_mt(void * arg)
     XEVD_CTX   * ctx = core->ctx;
     int          res, ret = XEVD_OK;
     int          thread_idx = core->thread_idx + ctx->tc.tile_task_num;
-    xevd_mset((void *)ctx->sync_row, 0, ctx->tile[core->tile_num].h_ctb * sizeof(ctx->sync_row[0]));
-    if (ctx->tc.max_task_cnt > 2 && ctx->num_tiles_in_slice == 1)
+    u64          t_perf;
+    if (ctx->tc.max_task_cnt > 2 && ctx->tile_cnt == 1)
     {
+        xevd_mset((void *)ctx->sync_row, 0, ctx->tile[0].h_ctb * sizeof(ctx->sync_row[0]));
         for (int thread_cnt = 1; thread_cnt < ctx->tc.task_num_in_tile[0]; thread_cnt++)
         {
-            if (thread_cnt < ctx->tile[0].h_ctb)
+            /* thread_cnt reconstructs the rows from thread_cnt - 1 */
+            if (thread_cnt <= ctx->tile[0].h_ctb)
             {
-                xevd_mcpy(ctx->core_mt[thread_idx], core, sizeof(XEVD_CORE));
+                xevd_core_copy(ctx->core_mt[thread_idx], core);
                 ctx->core_mt[thread_idx]->x_lcu = ((ctx->tile[0].ctba_rs_first) % ctx->w_lcu);               //entry point lcu's x location
                 ctx->core_mt[thread_idx]->y_lcu = ((ctx->tile[0].ctba_rs_first) / ctx->w_lcu) + thread_cnt - 1; // entry point lcu's y location //MULTICORE_ENT_RECON
                 ctx->core_mt[thread_idx]->lcu_num = ctx->core_mt[thread_idx]->y_lcu * ctx->w_lcu + ctx->core_mt[thread_idx]->x_lcu;
@@ -2550,10 +2897,11 @@ int xevd_tile_mt(void * arg)
         }
         ret = xevd_tile_eco(arg);
         xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
+        XEVD_PERF_BEG(ctx, t_perf);
         thread_idx = core->thread_idx + ctx->tc.tile_task_num;
         for (int thread_cnt = 1; thread_cnt < ctx->tc.task_num_in_tile[0]; thread_cnt++)
         {
-            if (thread_cnt < ctx->tile[0].h_ctb)
+            if (thread_cnt <= ctx->tile[0].h_ctb)
             {
                 ctx->tc.join(ctx->thread_pool[thread_idx], &res);
                 if (XEVD_FAILED(res))
@@ -2563,9 +2911,14 @@ int xevd_tile_mt(void * arg)
             }
             thread_idx += ctx->tc.tile_task_num;
         }
+        XEVD_TL_END(ctx, core->thread_idx, XEVD_TL_JOIN, core->tile_num, t_perf);
     }
     else
     {
+    /* a tile goes to whichever worker is free, so it is reconstructed by
+       that worker and the row threads it owns, one pool slot every
+       tile_task_num from its own */
+    ctx->tc.task_num_in_tile[core->tile_num] = XEVD_MAX(1, (ctx->tc.max_task_cnt - 1 - core->thread_idx) / ctx->tc.tile_task_num + 1);
 
     xevd_tile_eco(arg);
     xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
@@ -2574,7 +2927,7 @@ int xevd_tile_mt(void * arg)
     {
         if (thread_cnt < ctx->tile[core->tile_num].h_ctb)
         {
-            xevd_mcpy(ctx->core_mt[thread_idx], core, sizeof(XEVD_CORE));
+            xevd_core_copy(ctx->core_mt[thread_idx], core);
             ctx->core_mt[thread_idx]->x_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);               //entry point lcu's x location
             ctx->core_mt[thread_idx]->y_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu) + thread_cnt; // entry point lcu's y location
             ctx->core_mt[thread_idx]->lcu_num = ctx->core_mt[thread_idx]->y_lcu * ctx->w_lcu + ctx->core_mt[thread_idx]->x_lcu;
@@ -2588,6 +2941,7 @@ int xevd_tile_mt(void * arg)
     core->y_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu);
     xevd_ctu_row_rec_mt(arg);
 
+    XEVD_PERF_BEG(ctx, t_perf);
     thread_idx = core->thread_idx + ctx->tc.tile_task_num;
     for (int thread_cnt = 1; thread_cnt < ctx->tc.task_num_in_tile[core->tile_num]; thread_cnt++)
     {
@@ -2601,23 +2955,87 @@ int xevd_tile_mt(void * arg)
         }
         thread_idx += ctx->tc.tile_task_num;
     }
+    XEVD_TL_END(ctx, core->thread_idx, XEVD_TL_JOIN, core->tile_num, t_perf);
     }
     return ret;
 }
 
+typedef struct _SLICE_TILE_TASK
+{
+    XEVD_CTX   * ctx;
+    XEVD_CORE  * core;
+    XEVDM_SH   * msh;
+    XEVD_BSR   * bs;
+    XEVD_SBAC  * sbac;
+    u16        * tile_in_slice;
+    int          num_tiles;
+    int          last_worker; /* worker that decoded the last tile of the slice */
+} SLICE_TILE_TASK;
+
+/* set up the worker's core and bitstream at the entry point of the
+   order-th tile of the slice and decode the tile */
+static int dec_slice_tile(SLICE_TILE_TASK * t, int order, int worker_idx)
+{
+    XEVD_CTX        * ctx = t->ctx;
+    XEVD_CORE       * core_mt = ctx->core_mt[worker_idx];
+    XEVD_SH         * sh = t->core->sh;
+    int               tile_idx = t->tile_in_slice[order];
+
+    xevd_core_copy(core_mt, t->core);
+
+    core_mt->ctx = ctx;
+    core_mt->bs = &ctx->bs_mt[worker_idx];
+    core_mt->sbac = &ctx->sbac_dec_mt[worker_idx];
+    core_mt->tile_num = tile_idx;
+    core_mt->thread_idx = worker_idx;
+    ((XEVDM_CORE *)core_mt)->msh = t->msh;
+    ((XEVDM_CORE *)core_mt)->last_tile_in_slice = (order == t->num_tiles - 1);
+    if (order == t->num_tiles - 1)
+    {
+        t->last_worker = worker_idx;
+    }
+
+    ctx->tile[tile_idx].qp_prev_eco = sh->qp;
+    ctx->tile[tile_idx].qp = sh->qp;
+
+    xevd_mcpy(core_mt->bs, t->bs, sizeof(XEVD_BSR));
+    xevd_mcpy(core_mt->sbac, t->sbac, sizeof(XEVD_SBAC));
+    SET_SBAC_DEC(core_mt->bs, core_mt->sbac);
+    if (order != 0)
+    {
+        int offset = 0;
+        for (int i = 0; i < order; i++)
+        {
+            offset += sh->entry_point_offset_minus1[i] + 1;
+        }
+        /* bs changed according to marker in bs; the bytes already cached in
+           the code can be more than the offset, so seek from the read position */
+        core_mt->bs->cur = core_mt->bs->beg + XEVD_BSR_GET_READ_BYTE(core_mt->bs) + offset;
+        core_mt->bs->code = 0;
+        core_mt->bs->leftbits = 0;
+    }
+
+    return xevd_tile_mt((void *)core_mt);
+}
+
+/* xevd_parallel_for() task: decode the task_idx-th tile of the slice */
+static int dec_slice_tile_task(void * arg, int task_idx, int worker_idx)
+{
+    return dec_slice_tile((SLICE_TILE_TASK *)arg, task_idx, worker_idx);
+}
+
 int xevdm_dec_slice(XEVD_CTX * ctx, XEVD_CORE * core)
 {
     XEVD_BSR   * bs;
     XEVD_SBAC  * sbac;
     XEVD_TILE  * tile;
-    XEVD_CORE  * core_mt;
     XEVD_BSR     bs_temp;
     XEVD_SBAC    sbac_temp;
+    SLICE_TILE_TASK task;
 
     int         ret;
-    int         res = 0;
-    int         lcu_cnt_in_tile = 0;
-    int         col_bd = 0;
+    int         tile_idx;
+    int         num_tiles_in_slice = ctx->num_tiles_in_slice;
 
     bs   = &ctx->bs;
     sbac = GET_SBAC_DEC(bs);
@@ -2626,97 +3044,168 @@ int xevdm_dec_slice(XEVD_CTX * ctx, XEVD_CORE * core)
 
     ctx->sh.qp_prev_eco = ctx->sh.qp;
 
-    int tile_idx;
-    int thread_idx;
-    int num_tiles_in_slice = ctx->num_tiles_in_slice;
-    int tile_start_num, num_tiles_proc;
-    int tile_cnt = 0;
-
-    tile_start_num = 0;
+    task.ctx = ctx;
+    task.core = core;
+    task.msh = &((XEVDM_CTX *)ctx)->sh;
+    task.bs = &bs_temp;
+    task.sbac = &sbac_temp;
+    task.tile_in_slice = ctx->tile_in_slice;
+    task.num_tiles = num_tiles_in_slice;
+    task.last_worker = 0;
+
+    /* tile workers take the next undecoded tile of the slice as soon as they
+       finish one; each keeps its own set of CTU row threads (see xevd_tile_mt) */
+    ret = xevd_parallel_for(&ctx->tc, ctx->thread_pool, ctx->tc.tile_task_num, num_tiles_in_slice, dec_slice_tile_task, (void *)&task);
+    xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
 
-    while (num_tiles_in_slice)
+    for (tile_idx = 0; tile_idx < num_tiles_in_slice; tile_idx++)
     {
-        num_tiles_proc = num_tiles_in_slice > ctx->tc.tile_task_num ? ctx->tc.tile_task_num : num_tiles_in_slice;
-        core_mt = ctx->core_mt[num_tiles_proc - 1];
-
-        for (thread_idx = num_tiles_proc - 1; thread_idx >= 0; thread_idx--)
-        {
-            tile_idx = ctx->tile_in_slice[tile_start_num + thread_idx];
-            xevd_mcpy(ctx->core_mt[thread_idx], core, sizeof(XEVD_CORE));
-            core_mt = ctx->core_mt[thread_idx];
-
-            core_mt->ctx = ctx;
-            core_mt->bs = &core_mt->ctx->bs_mt[thread_idx];
-            core_mt->sbac = &core_mt->ctx->sbac_dec_mt[thread_idx];
-            core_mt->tile_num = tile_idx;
-            core_mt->thread_idx = thread_idx;
+        tile = &(ctx->tile[ctx->tile_in_slice[tile_idx]]);
+        ctx->num_ctb -= (tile->w_ctb * tile->h_ctb);
+    }
 
-            ctx->tile[tile_idx].qp_prev_eco = ctx->sh.qp;
-            ctx->tile[tile_idx].qp = ctx->sh.qp;
+    /* the slice ends where its last tile does */
+    xevd_mcpy(&ctx->bs, ctx->core_mt[task.last_worker]->bs, sizeof(XEVD_BSR));
+    xevd_mcpy(&ctx->sbac_dec, ctx->core_mt[task.last_worker]->sbac, sizeof(XEVD_SBAC));
+    return XEVD_OK;
 
-            xevd_mcpy(core_mt->bs, &bs_temp, sizeof(XEVD_BSR));
-            xevd_mcpy(core_mt->sbac, &sbac_temp, sizeof(XEVD_SBAC));
-            SET_SBAC_DEC(core_mt->bs, core_mt->sbac);
-            tile_cnt = ctx->tile_order_slice[tile_idx];
-            if (tile_cnt != 0)
-            {
-                int offset = 0;
-                for (int i = 0; i < tile_cnt; i++)
-                {
-                    offset += ctx->sh.entry_point_offset_minus1[i] + 1;
-                }
-                int seek = offset - (core_mt->bs->leftbits >> 3);
-                int leftbits = seek - (seek / 4) * 4;
-                core_mt->bs->cur = core_mt->bs->cur + (seek / 4) * 4;          //bs changed according to marker in bs
-                core_mt->bs->leftbits = 0;
-                if (leftbits)
-                {
-                    u32  dummy;
-                    xevd_bsr_read(core_mt->bs, &dummy, leftbits << 3);
-                }
-            }
+ERR:
+    return ret;
+}
 
-            if (thread_idx > 0)
-            {
-                ret = ctx->tc.run(ctx->thread_pool[thread_idx], xevd_tile_mt, (void *)core_mt);
-                xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
-            }
-        }
+/* keep the slice whose header was just parsed until the other slices of the
+   picture are received; its NAL unit is copied since the caller can reuse
+   the bitstream buffer */
+static int au_slice_add(XEVD_CTX * ctx)
+{
+    XEVDM_CTX      * mctx = (XEVDM_CTX *)ctx;
+    XEVDM_AU_SLICE * s;
+    XEVD_BSR       * bs = &ctx->bs;
+    XEVD_TILE      * tile;
+    int              i;
 
-        ret = xevd_tile_mt((void *)core_mt);
-        xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
+    if (mctx->au_slice_cnt == mctx->au_slice_max)
+    {
+        int max = mctx->au_slice_max ? mctx->au_slice_max * 2 : 4;
 
-        for (thread_idx = 1; thread_idx < num_tiles_proc; thread_idx++)
+        s = (XEVDM_AU_SLICE *)xevd_malloc(sizeof(XEVDM_AU_SLICE) * max);
+        xevd_assert_rv(s, XEVD_ERR_OUT_OF_MEMORY);
+        xevd_mset(s, 0, sizeof(XEVDM_AU_SLICE) * max);
+        if (mctx->au_slice)
         {
-            ret = ctx->tc.join(ctx->thread_pool[thread_idx], &res);
-            xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
+            xevd_mcpy(s, mctx->au_slice, sizeof(XEVDM_AU_SLICE) * mctx->au_slice_max);
+            xevd_mfree(mctx->au_slice);
         }
+        mctx->au_slice = s;
+        mctx->au_slice_max = max;
+    }
+    s = &mctx->au_slice[mctx->au_slice_cnt];
 
-        for (tile_idx = tile_start_num; tile_idx < tile_start_num + num_tiles_proc; tile_idx++)
+    if (s->nalu_size < bs->size)
+    {
+        if (s->nalu)
         {
-            tile = &(ctx->tile[ctx->tile_in_slice[tile_idx]]);
-            ctx->num_ctb -= (tile->w_ctb * tile->h_ctb);
+            xevd_mfree(s->nalu);
         }
-        num_tiles_in_slice -= (num_tiles_proc);
-        tile_start_num += num_tiles_proc;
+        s->nalu_size = 0;
+        s->nalu = (u8 *)xevd_malloc(bs->size);
+        xevd_assert_rv(s->nalu, XEVD_ERR_OUT_OF_MEMORY);
+        s->nalu_size = bs->size;
     }
+    xevd_mcpy(s->nalu, bs->beg, bs->size);
 
-    if (ctx->num_tiles_in_slice > 1)
+    xevd_mcpy(&s->bs, bs, sizeof(XEVD_BSR));
+    s->bs.beg = s->nalu;
+    s->bs.cur = s->nalu + (bs->cur - bs->beg);
+    s->bs.end = s->nalu + (bs->end - bs->beg);
+    xevd_mcpy(&s->sbac, GET_SBAC_DEC(bs), sizeof(XEVD_SBAC));
+
+    xevd_mcpy(&s->sh, &ctx->sh, sizeof(XEVD_SH));
+    s->sh.qp_prev_eco = s->sh.qp;
+    xevd_mcpy(&s->msh, &mctx->sh, sizeof(XEVDM_SH));
+    xevd_mcpy(s->refp, ctx->refp, sizeof(s->refp));
+    xevd_mcpy(s->num_refp, mctx->dpm.num_refp, sizeof(s->num_refp));
+    xevd_mcpy(&s->core, ctx->core, sizeof(XEVD_CORE));
+    s->num_tiles = ctx->num_tiles_in_slice;
+    xevd_mcpy(s->tile_in_slice, ctx->tile_in_slice, sizeof(u16) * s->num_tiles);
+    mctx->au_slice_cnt++;
+
+    for (i = 0; i < s->num_tiles; i++)
     {
-        xevd_mcpy(&ctx->bs, ctx->core_mt[ctx->tc.max_task_cnt-1]->bs, sizeof(XEVD_BSR));
-        xevd_mcpy(&ctx->sbac_dec, ctx->core_mt[ctx->tc.max_task_cnt-1]->sbac, sizeof(XEVD_SBAC));
+        tile = &(ctx->tile[s->tile_in_slice[i]]);
+        ctx->num_ctb -= (tile->w_ctb * tile->h_ctb);
     }
-    else if (!(num_tiles_in_slice == 1 && ctx->tc.max_task_cnt > 1))
+
+    /* the slice data is read from the copy */
+    bs->cur = bs->end + 1;
+    bs->code = 0;
+    bs->leftbits = 0;
+    return XEVD_OK;
+}
+
+/* xevd_parallel_for() task: decode the task_idx-th tile of the picture,
+   counting the tiles of the kept slices in decoding order */
+static int au_tile_task(void * arg, int task_idx, int worker_idx)
+{
+    XEVDM_CTX      * mctx = (XEVDM_CTX *)arg;
+    XEVDM_AU_SLICE * s = mctx->au_slice;
+    SLICE_TILE_TASK  task;
+
+    while (task_idx >= s->num_tiles)
     {
-        xevd_mcpy(&ctx->bs, ctx->core_mt[0]->bs, sizeof(XEVD_BSR));
-        xevd_mcpy(&ctx->sbac_dec, ctx->core_mt[0]->sbac, sizeof(XEVD_SBAC));
+        task_idx -= s->num_tiles;
+        s++;
     }
-    return XEVD_OK;
 
-ERR:
+    task.ctx = (XEVD_CTX *)mctx;
+    task.core = &s->core;
+    task.msh = &s->msh;
+    task.bs = &s->bs;
+    task.sbac = &s->sbac;
+    task.tile_in_slice = s->tile_in_slice;
+    task.num_tiles = s->num_tiles;
+    return dec_slice_tile(&task, task_idx, worker_idx);
+}
+
+/* decode the tiles of all the kept slices of the picture at once */
+static int au_dec(XEVD_CTX * ctx)
+{
+    XEVDM_CTX      * mctx = (XEVDM_CTX *)ctx;
+    XEVDM_AU_SLICE * s;
+    int              i, ret, num_tiles = 0;
+
+    for (i = 0; i < mctx->au_slice_cnt; i++)
+    {
+        s = &mctx->au_slice[i];
+        s->core.sh = &s->sh;
+        s->core.refp = s->refp;
+        s->core.num_refp = s->num_refp;
+        num_tiles += s->num_tiles;
+    }
+
+    ret = xevd_parallel_for(&ctx->tc, ctx->thread_pool, ctx->tc.tile_task_num, num_tiles, au_tile_task, (void *)mctx);
+    mctx->au_slice_cnt = 0;
     return ret;
 }
 
+static void au_slice_free(XEVDM_CTX * mctx)
+{
+    for (int i = 0; i < mctx->au_slice_max; i++)
+    {
+        if (mctx->au_slice[i].nalu)
+        {
+            xevd_mfree(mctx->au_slice[i].nalu);
+        }
+    }
+    if (mctx->au_slice)
+    {
+        xevd_mfree(mctx->au_slice);
+        mctx->au_slice = NULL;
+    }
+    mctx->au_slice_cnt = 0;
+    mctx->au_slice_max = 0;
+}
+
 int xevd_malloc_1d(void** dst, int size)
 {
     if(*dst == NULL)
@@ -2813,9 +3302,13 @@ int xevd_create_cu_data(XEVD_CU_DATA *cu_data, int log2_cuw, int log2_cuh)
 
     for(i = 0; i < N_C; i++)
     {
-        ret = xevd_malloc_1d((void**)&cu_data->coef[i], (pixel_cnt >> (!!(i)* 2)) * sizeof(s16));
+        ret = xevd_malloc_1d((void**)&cu_data->coef_ofs[i], size_32b);
         ret = xevd_malloc_1d((void**)&cu_data->reco[i], (pixel_cnt >> (!!(i)* 2)) * sizeof(pel));
     }
+    /* sparse coef grows on demand while parsing */
+    cu_data->coef_size = pixel_cnt >> 1;
+    cu_data->coef_cnt = 0;
+    ret = xevd_malloc_1d((void**)&cu_data->coef, cu_data->coef_size * sizeof(s16));
 
     return ret;
 }
@@ -2840,6 +3333,10 @@ int xevdm_ready(XEVD_CTX *ctx)
         core = (XEVD_CORE *)mcore;
         ctx->core_mt[i] = core;
     }
+
+    mcore = xevdm_core_alloc();
+    xevd_assert_gv(mcore != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
+    ((XEVDM_CTX *)ctx)->lf_core = (XEVD_CORE *)mcore;
     return XEVD_OK;
 ERR:
     if (core)
@@ -2866,6 +3363,14 @@ void xevdm_flush(XEVD_CTX * ctx)
             ctx->core_mt[i] = NULL;
         }
     }
+
+    if(((XEVDM_CTX *)ctx)->lf_core)
+    {
+        core_free(((XEVDM_CTX *)ctx)->lf_core);
+        ((XEVDM_CTX *)ctx)->lf_core = NULL;
+    }
+
+    au_slice_free((XEVDM_CTX *)ctx);
 }
 
 static int clear_map(XEVD_CTX * ctx)
@@ -2892,7 +3397,9 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
     XEVDM_SH  *msh = &mctx->sh;
     XEVD_NALU *nalu = &ctx->nalu;
     int        ret;
+    u64        t_perf;
 
+    XEVD_PERF_BEG(ctx, t_perf);
     ret = XEVD_OK;
     /* set error status */
     ctx->bs_err = bitb->err;
@@ -3001,6 +3508,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
         if (slice_num == 0)
         {
             clear_map(ctx);
+            mctx->au_slice_cnt = 0;
             xevd_mset(msh->alf_sh_param.alf_ctu_enable_flag, 1, N_C * ctx->f_lcu * sizeof(u8));
         }
 
@@ -3085,6 +3593,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
         xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
 
         ctx->slice_num = slice_num;
+        ctx->core->slice_num = slice_num;
         slice_num++;
 
         if (!sps->tool_rpl)
@@ -3122,6 +3631,9 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
             size = sizeof(s16) * ctx->f_scu * REFP_NUM * MV_D;
             xevd_mset_x64a(mctx->map_unrefined_mv, 0, size);
 
+            ret = lf_pipe_begin(ctx);
+            xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
+
             ctx->pic->imgb->imgb_active_pps_id = ctx->pps.pps_pic_parameter_set_id;
             if (ctx->sps->tool_dra)
             {
@@ -3132,92 +3644,54 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
             }
         }
 
-        /* decode slice layer */
-        ret = ctx->fn_dec_slice(ctx, ctx->core);
+        XEVD_PERF_END(ctx, 0, XEVD_PERF_PARSE, t_perf);
+
+        /* decode slice layer; a picture whose first slices were kept is
+           completed the same way when the mode is turned off meanwhile */
+        if (mctx->au_mode || mctx->au_slice_cnt > 0)
+        {
+            ret = au_slice_add(ctx);
+            xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
+
+            if (ctx->num_ctb == 0)
+            {
+                /* all the slices of the picture are received */
+                ret = au_dec(ctx);
+            }
+        }
+        else
+        {
+            ret = ctx->fn_dec_slice(ctx, ctx->core);
+        }
         xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
 
+        if (mctx->lf_pipe_on)
+        {
+            /* filter the rows left when reconstruction finished */
+            lf_pipe_run(ctx, 0);
+            xevd_assert_rv(xevd_threadsafe_read(&mctx->lf_pipe_step) == ctx->h_lcu + 2, XEVD_ERR_UNEXPECTED);
+        }
+
         if (ctx->num_ctb == 0)
         {
-            /* deblocking filter */
-            if(ctx->sh.deblocking_filter_on)
+            /* deblocking filter, adaptive loop filter and padding */
+            if (!mctx->lf_pipe_on)
             {
 #if TRACE_DBF
                 XEVD_TRACE_SET(1);
 #endif
-                u32 k = 0;
-                int i, j, res;
-                int num_tiles_in_pic, tile_start_num, num_tiles_proc;
-                XEVD_CORE * core_mt;
-
-                for(int is_hor_edge = 0 ; is_hor_edge <= 1 ; is_hor_edge++)
-                {
-                    for (u32 i = 0; i < ctx->f_scu; i++)
-                    {
-                        MCU_CLR_COD(ctx->map_scu[i]);
-                    }
-
-                    k = 0;
-                    res = 0;
-                    num_tiles_in_pic = ctx->w_tile * ctx->h_tile;
-                    while (num_tiles_in_pic)
-                    {
-                        if(num_tiles_in_pic > ctx->tc.max_task_cnt)
-                        {
-                            tile_start_num = k;
-                            num_tiles_proc = ctx->tc.max_task_cnt;
-                        }
-                        else
-                        {
-                            tile_start_num = k;
-                            num_tiles_proc = num_tiles_in_pic;
-                        }
-
-                        for(j = 1; j < num_tiles_proc; j++)
-                        {
-                            i = tile_start_num + j - 1;
-                            core_mt = ctx->core_mt[j];
-                            core_mt->ctx = ctx;
-                            core_mt->tile_num = i;
-                            core_mt->filter_across_boundary = 0;
-                            core_mt->deblock_is_hor = is_hor_edge;
-                            ret = ctx->tc.run(ctx->thread_pool[j], ctx->fn_deblock, (void *)core_mt);
-                            xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
-                            k++;
-                        }
-                        j = tile_start_num + num_tiles_proc - 1;
-                        core_mt = ctx->core_mt[0];
-                        core_mt->ctx = ctx;
-                        core_mt->tile_num = j;
-                        core_mt->filter_across_boundary = 0;
-                        core_mt->deblock_is_hor = is_hor_edge;
-                        ret = ctx->fn_deblock((void *)core_mt);
-                        xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
-                        k++;
-                        for(i = 1; i<num_tiles_proc; i++)
-                        {
-                            ret = ctx->tc.join(ctx->thread_pool[i], &res);
-                        }
-                        num_tiles_in_pic -= (num_tiles_proc);
-                    }
-                }
+                ret = lf_pic(ctx);
+                xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
 #if TRACE_DBF
                 XEVD_TRACE_SET(0);
 #endif
             }
-
-            /* adaptive loop filter */
-            if( mctx->sh.alf_on )
-            {
-                ret = mctx->fn_alf(ctx,  ctx->pic);
-                xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
-            }
-
-            /* expand pixels to padding area */
-            ctx->fn_picbuf_expand(ctx, ctx->pic);
+            mctx->lf_pipe_on = 0;
 
             /* put decoded picture to DPB */
             ret = xevdm_picman_put_pic(&mctx->dpm, ctx->pic, ctx->nalu.nal_unit_type_plus1 - 1 == XEVD_NUT_IDR, ctx->poc.poc_val, ctx->nalu.nuh_temporal_id, 1, ctx->refp, ctx->slice_ref_flag, sps->tool_rpl, ctx->ref_pic_gap_length);
             xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
+            xevd_perf_pic_done(ctx);
         }
 
         if(ctx->pic_cnt == 0) {
@@ -3248,12 +3722,14 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
     else if (nalu->nal_unit_type_plus1 - 1 == XEVD_NUT_SEI)
     {
         ret = xevd_eco_sei(ctx, bs);
+        XEVD_PERF_END(ctx, 0, XEVD_PERF_PARSE, t_perf);
 
         if (ctx->pic_sign_exist)
         {
             if (ctx->use_pic_sign)
             {
                 int compare_md5 = 1;
+                XEVD_PERF_BEG(ctx, t_perf);
                 SIG_PARAM_DRA *effective_dra_control;
                 if (ctx->pps.pic_dra_enabled_flag)
                 {
@@ -3266,7 +3742,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
                     effective_dra_control = NULL;
                 }
                 XEVD_IMGB *imgb_sig = NULL;
-                imgb_sig = xevd_imgb_generate(ctx->w, ctx->h, ctx->pa.pad_l, ctx->pa.pad_c, ctx->pa.idc, ctx->internal_codec_bit_depth);
+                imgb_sig = xevd_imgb_generate(ctx->w, ctx->h, ctx->pa.pad_l, ctx->pa.pad_c, ctx->pa.idc, XEVD_CS_GET_BIT_DEPTH(ctx->pic->imgb->cs), NULL);
                 xevd_imgb_cpy(imgb_sig, ctx->pic->imgb);  // store copy of the reconstructed picture in DPB
 
                 if (ctx->pps.pic_dra_enabled_flag)
@@ -3283,6 +3759,7 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
                 ret = xevdm_picbuf_check_signature(ctx->pic, ctx->pic_sign, imgb_sig, compare_md5);
                 xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
                 xevd_imgb_destroy(imgb_sig);
+                XEVD_PERF_END(ctx, 0, XEVD_PERF_MD5, t_perf);
 
                 ctx->pic_sign_exist = 0;
             }
@@ -3296,6 +3773,11 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
     {
         assert(!"wrong NALU type");
     }
+    if (nalu->nal_unit_type_plus1 - 1 >= XEVD_NUT_SPS && nalu->nal_unit_type_plus1 - 1 != XEVD_NUT_SEI)
+    {
+        /* parameter sets; slices and SEI have stopped the clock already */
+        XEVD_PERF_END(ctx, 0, XEVD_PERF_PARSE, t_perf);
+    }
 
     make_stat(ctx, nalu->nal_unit_type_plus1 - 1, stat);
 
@@ -3307,45 +3789,126 @@ int xevd_dec_nalu(XEVD_CTX * ctx, XEVD_BITB * bitb, XEVD_STAT * stat)
     return ret;
 }
 
-/* DRA frame level init and apply DRA*/
-int xevd_apply_filter(XEVD_CTX *ctx, XEVD_IMGB *imgb)
+/* get the output DRA mapping of src, NULL when src is not mapped */
+static int dra_out_get(XEVD_CTX *ctx, XEVD_IMGB *src, DRA_CONTROL **dra_out)
 {
-    if (imgb) {
+    XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+    int pps_dra_id = src->imgb_active_aps_id;
+    SIG_PARAM_DRA *dra_param;
+    DRA_CONTROL *dra;
 
-        XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+    *dra_out = NULL;
+    if (!ctx->sps->tool_dra || pps_dra_id < 0 || pps_dra_id >= 32)
+    {
+        return XEVD_OK;
+    }
 
-        int pps_dra_id = (imgb)->imgb_active_aps_id;
+    dra_param = mctx->dra_array + pps_dra_id;
+    xevd_assert(dra_param->signal_dra_flag == 1);
 
-        SIG_PARAM_DRA *g_dra_control = mctx->dra_array;
-        DRA_CONTROL g_dra_control_effective;
+    if (mctx->dra_out == NULL)
+    {
+        mctx->dra_out = (DRA_CONTROL *)xevd_malloc(sizeof(DRA_CONTROL));
+        xevd_assert_rv(mctx->dra_out != NULL, XEVD_ERR_OUT_OF_MEMORY);
+        xevd_mset(mctx->dra_out, 0, sizeof(DRA_CONTROL));
+    }
+    dra = mctx->dra_out;
 
-        if ((pps_dra_id > -1) && (pps_dra_id < 32))
-        {
-            g_dra_control_effective.flag_enabled = 1;
-        }
-        else
-        {
-            g_dra_control_effective.flag_enabled = 0;
-        }
-        int sps_dra_enable_flag = ctx->sps->tool_dra;
+    /* the LUTs are built again only when the signalled parameters change */
+    if (!dra->flag_enabled || dra->internal_bd != ctx->internal_codec_bit_depth
+        || xevd_mcmp(&dra->signalled_dra, dra_param, sizeof(SIG_PARAM_DRA)))
+    {
+        xevd_mcpy(&dra->signalled_dra, dra_param, sizeof(SIG_PARAM_DRA));
+        xevd_init_dra(dra, ctx->internal_codec_bit_depth);
+        dra->flag_enabled = 1;
+    }
+    *dra_out = dra;
+    return XEVD_OK;
+}
 
-        if ((sps_dra_enable_flag == 1) && (pps_dra_id >= 0))
-        {
-            // Assigned effective DRA controls as specified by PPS
-            xevd_assert((pps_dra_id > -1) && (pps_dra_id < 32) && ((g_dra_control + pps_dra_id)->signal_dra_flag == 1));
-            xevd_mcpy(&(g_dra_control_effective.signalled_dra), (g_dra_control + pps_dra_id), sizeof(SIG_PARAM_DRA));
+/* DRA mapping of a row of 4:2:0 samples for the output conversion */
+static void dra_out_row(void *arg, XEVD_IMGB *src, int c, int x, int y, int w, pel *row)
+{
+    DRA_CONTROL *dra = (DRA_CONTROL *)arg;
+    pel *s = (pel *)((u8 *)src->a[c] + y * src->s[c]) + x;
+    pel *ref;
 
-            if (g_dra_control_effective.flag_enabled)
-            {
-                xevd_init_dra(&g_dra_control_effective, ctx->internal_codec_bit_depth);
+    if (c == Y_C)
+    {
+        xevd_apply_dra_luma_row(row, s, w, dra->luma_inv_scale_lut);
+    }
+    else
+    {
+        ref = (pel *)((u8 *)src->a[Y_C] + (y << 1) * src->s[Y_C]) + (x << 1);
+        xevd_apply_dra_chroma_row(row, s, ref, w, 1, dra->int_chroma_inv_scale_lut[c - 1]);
+    }
+}
+
+/* DRA frame level init and apply DRA: src is mapped into dst in one pass,
+   or just copied when DRA is not used by the picture */
+int xevd_apply_filter(XEVD_CTX *ctx, XEVD_IMGB *dst, XEVD_IMGB *src)
+{
+    DRA_CONTROL *dra;
+    int ret, i;
+
+    ret = dra_out_get(ctx, src, &dra);
+    xevd_assert_rv(XEVD_SUCCEEDED(ret), ret);
+    if (dra == NULL)
+    {
+        xevd_imgb_cpy(dst, src);
+        return XEVD_OK;
+    }
+
+    /* chroma is mapped with the luma of src, so the order does not matter */
+    xevd_apply_dra_chroma_plane(dst, src, dra, 1, TRUE);
+    xevd_apply_dra_chroma_plane(dst, src, dra, 2, TRUE);
+    xevd_apply_dra_luma_plane(dst, src, dra, 0, TRUE);
 
-                xevd_apply_dra_chroma_plane(imgb, imgb, &g_dra_control_effective, 1, TRUE);
-                xevd_apply_dra_chroma_plane(imgb, imgb, &g_dra_control_effective, 2, TRUE);
-                xevd_apply_dra_luma_plane(imgb, imgb, &g_dra_control_effective, 0, TRUE);
+    for (i = 0; i < XEVD_TS_NUM; i++)
+    {
+        dst->ts[i] = src->ts[i];
+    }
+    dst->imgb_active_aps_id = src->imgb_active_aps_id;
+    dst->imgb_active_pps_id = src->imgb_active_pps_id;
+    return XEVD_OK;
+}
+
+/* get a buffer for a DRA mapped output picture; the pooled buffers are
+   reused once the application has released them */
+static XEVD_IMGB * dra_out_imgb_get(XEVD_CTX *ctx)
+{
+    XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+    XEVD_IMGB *imgb;
+    int cs = XEVD_CS_SET(ctx->pa.idc + 10, ctx->internal_codec_bit_depth, 0);
+    int i;
+
+    for (i = 0; i < XEVDM_DRA_OUT_POOL_SIZE; i++)
+    {
+        imgb = mctx->dra_out_pool[i];
+        if (imgb != NULL)
+        {
+            if (1 != imgb->getref(imgb))
+            {
+                continue; /* still used by the application */
             }
+            if (imgb->cs == cs && imgb->w[0] == ctx->w && imgb->h[0] == ctx->h && imgb->padl[0] == ctx->pa.pad_l)
+            {
+                imgb->addref(imgb);
+                return imgb;
+            }
+            /* the sequence has changed */
+            xevd_imgb_destroy(imgb);
         }
+        imgb = xevd_imgb_generate(ctx->w, ctx->h, ctx->pa.pad_l, ctx->pa.pad_c, ctx->pa.idc, ctx->internal_codec_bit_depth, ctx->pa.imgb_alloc);
+        mctx->dra_out_pool[i] = imgb;
+        if (imgb != NULL)
+        {
+            imgb->addref(imgb);
+        }
+        return imgb;
     }
-    return XEVD_OK;
+    /* every pooled buffer is in use */
+    return xevd_imgb_generate(ctx->w, ctx->h, ctx->pa.pad_l, ctx->pa.pad_c, ctx->pa.idc, ctx->internal_codec_bit_depth, ctx->pa.imgb_alloc);
 }
 
 int xevd_pull_frm(XEVD_CTX *ctx, XEVD_IMGB **imgb)
@@ -3353,8 +3916,11 @@ int xevd_pull_frm(XEVD_CTX *ctx, XEVD_IMGB **imgb)
     int ret;
     XEVD_PIC *pic;
 
+    u64 t_perf;
+
     *imgb = NULL;
     XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+    XEVD_PERF_BEG(ctx, t_perf);
     pic = xevdm_picman_out_pic(&mctx->dpm, &ret);
 
     if(pic)
@@ -3372,13 +3938,41 @@ int xevd_pull_frm(XEVD_CTX *ctx, XEVD_IMGB **imgb)
             (*imgb)->crop_t = ctx->sps->picture_crop_top_offset;
             (*imgb)->crop_b = ctx->sps->picture_crop_bottom_offset;
         }
+        XEVD_PERF_END(ctx, 0, XEVD_PERF_OUTPUT, t_perf);
 
-        if (ctx->sps->tool_dra) {
-            XEVD_IMGB * imgb_dra = NULL;
-            imgb_dra = xevd_imgb_generate(ctx->w, ctx->h, ctx->pa.pad_l, ctx->pa.pad_c, ctx->pa.idc, ctx->internal_codec_bit_depth);
-            xevd_imgb_cpy(imgb_dra, *imgb);
+        if (ctx->cdsc.out_cs != XEVD_CS_UNKNOWN)
+        {
+            /* the DRA mapping is done row by row within the conversion */
+            DRA_CONTROL *dra = NULL;
+            XEVD_PERF_BEG(ctx, t_perf);
+            ret = dra_out_get(ctx, *imgb, &dra);
+            if (XEVD_FAILED(ret))
+            {
+                (*imgb)->release(*imgb);
+                *imgb = NULL;
+                return ret;
+            }
+            ret = xevd_out_pull(ctx, imgb, dra ? dra_out_row : NULL, dra);
+            XEVD_PERF_END(ctx, 0, dra ? XEVD_PERF_DRA : XEVD_PERF_OUTPUT, t_perf);
+        }
+        else if (ctx->sps->tool_dra) {
+            XEVD_PERF_BEG(ctx, t_perf);
+            XEVD_IMGB * imgb_dra = dra_out_imgb_get(ctx);
+            int ret_dra = (imgb_dra == NULL) ? XEVD_ERR_OUT_OF_MEMORY : xevd_apply_filter(ctx, imgb_dra, *imgb);
+            XEVD_PERF_END(ctx, 0, XEVD_PERF_DRA, t_perf);
+            if (XEVD_FAILED(ret_dra))
+            {
+                if (imgb_dra) imgb_dra->release(imgb_dra);
+                (*imgb)->release(*imgb);
+                *imgb = NULL;
+                return ret_dra;
+            }
+            imgb_dra->crop_idx = (*imgb)->crop_idx;
+            imgb_dra->crop_l = (*imgb)->crop_l;
+            imgb_dra->crop_r = (*imgb)->crop_r;
+            imgb_dra->crop_t = (*imgb)->crop_t;
+            imgb_dra->crop_b = (*imgb)->crop_b;
             (*imgb)->release(*imgb);
-            xevd_apply_filter(ctx, imgb_dra);
             *imgb = imgb_dra;
         }
     }
@@ -3387,84 +3981,95 @@ int xevd_pull_frm(XEVD_CTX *ctx, XEVD_IMGB **imgb)
 
 int xevdm_platform_init(XEVD_CTX *ctx)
 {
+    XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+
+    ctx->isa             = xevd_isa_select(ctx->cdsc.isa);
+
+    mctx->fn_itrans      = xevdm_itrans_map_tbl;
+    mctx->fn_itx         = &xevdm_tbl_itx;
+    mctx->fn_dmvr_mc_l   = xevdm_tbl_dmvr_mc_l;
+    mctx->fn_dmvr_mc_c   = xevdm_tbl_dmvr_mc_c;
+    mctx->fn_bl_mc_l     = xevdm_tbl_bl_mc_l;
+    mctx->fn_alf_cls_blk = xevdm_alf_derive_classification_blk;
+    mctx->fn_alf_flt5_blk = xevdm_alf_filter_blk_5;
+    mctx->fn_alf_flt7_blk = xevdm_alf_filter_blk_7;
+    mctx->fn_dbk_addb    = &xevdm_tbl_dbk_addb;
+    mctx->fn_dbk_addb_chroma = &xevdm_tbl_dbk_addb_chroma;
+    ctx->fn_mc_l         = xevd_tbl_mc_l;
+    ctx->fn_mc_c         = xevd_tbl_mc_c;
+    ctx->fn_average_no_clip = &xevd_average_16b_no_clip;
+    ctx->fn_out          = &xevd_tbl_out;
+    ctx->fn_itxb         = &xevd_tbl_itxb;
+    ctx->fn_ipred_ang    = ipred_ang;
+    ctx->fn_ipred_bi     = xevd_ipred_bi;
+    ctx->fn_ipred_plane  = xevd_ipred_plane;
+    ctx->fn_dbk          = &xevd_tbl_dbk;
+    ctx->fn_dbk_chroma   = &xevd_tbl_dbk_chroma;
+
 #if ARM_NEON
-    xevd_func_itrans     = xevdm_itrans_map_tbl_neon;
-    xevdm_fn_itx         = &xevdm_tbl_itx_neon;
-    xevdm_func_dmvr_mc_l = xevdm_tbl_dmvr_mc_l_neon;
-    xevdm_func_dmvr_mc_c = xevdm_tbl_dmvr_mc_c_neon;
-    xevdm_func_bl_mc_l   = xevdm_tbl_bl_mc_l_neon;
-    xevd_func_mc_l       = xevd_tbl_mc_l_neon;
-    xevd_func_mc_c       = xevd_tbl_mc_c_neon;
-    xevd_func_average_no_clip = &xevd_average_16b_no_clip_neon;
-    ctx->fn_itxb         = &xevd_tbl_itxb_neon;
-    ctx->fn_dbk          = &xevd_tbl_dbk_neon;
-    ctx->fn_dbk_chroma   = &xevd_tbl_dbk_chroma_neon;
-#else
-#if X86_SSE
-    int check_cpu, support_sse, support_avx, support_avx2;
-
-    check_cpu = xevd_check_cpu_info();
-    support_sse = (check_cpu >> 1) & 1;
-    support_avx = check_cpu & 1;
-    support_avx2 = (check_cpu >> 2) & 1;
-
-    if (support_avx2)
-    {
-        xevd_func_itrans     = xevdm_itrans_map_tbl_sse;
-        xevdm_fn_itx          = &xevdm_tbl_itx_avx;
-        xevdm_func_dmvr_mc_l = xevdm_tbl_dmvr_mc_l_sse;
-        xevdm_func_dmvr_mc_c = xevdm_tbl_dmvr_mc_c_sse;
-        xevdm_func_bl_mc_l   = xevdm_tbl_bl_mc_l_sse;
-        xevd_func_mc_l       = xevd_tbl_mc_l_avx;
-        xevd_func_mc_c       = xevd_tbl_mc_c_avx;
-        xevd_func_average_no_clip = xevd_average_16b_no_clip_sse;
+    if (ctx->isa == XEVD_ISA_NEON)
+    {
+        mctx->fn_itrans      = xevdm_itrans_map_tbl_neon;
+        mctx->fn_itx         = &xevdm_tbl_itx_neon;
+        ctx->fn_itxb         = &xevd_tbl_itxb_neon;
+#if !XEVD_PEL_8BIT
+        mctx->fn_dmvr_mc_l   = xevdm_tbl_dmvr_mc_l_neon;
+        mctx->fn_dmvr_mc_c   = xevdm_tbl_dmvr_mc_c_neon;
+        mctx->fn_bl_mc_l     = xevdm_tbl_bl_mc_l_neon;
+        ctx->fn_mc_l         = xevd_tbl_mc_l_neon;
+        ctx->fn_mc_c         = xevd_tbl_mc_c_neon;
+        ctx->fn_average_no_clip = &xevd_average_16b_no_clip_neon;
+        ctx->fn_dbk          = &xevd_tbl_dbk_neon;
+        ctx->fn_dbk_chroma   = &xevd_tbl_dbk_chroma_neon;
+#endif
+    }
+#elif X86_SSE
+    if (ctx->isa == XEVD_ISA_AVX2)
+    {
+        mctx->fn_itrans      = xevdm_itrans_map_tbl_sse;
+        mctx->fn_itx         = &xevdm_tbl_itx_avx;
         ctx->fn_itxb         = &xevd_tbl_itxb_avx;
+        mctx->fn_dbk_addb    = &xevdm_tbl_dbk_addb_sse;
+        mctx->fn_dbk_addb_chroma = &xevdm_tbl_dbk_addb_chroma_sse;
+        ctx->fn_mc_l         = xevd_tbl_mc_l_avx;
+        ctx->fn_mc_c         = xevd_tbl_mc_c_avx;
+        ctx->fn_average_no_clip = &xevd_average_16b_no_clip_sse;
         ctx->fn_dbk          = &xevd_tbl_dbk_sse;
         ctx->fn_dbk_chroma   = &xevd_tbl_dbk_chroma_sse;
+#if !XEVD_PEL_8BIT
+        mctx->fn_dmvr_mc_l   = xevdm_tbl_dmvr_mc_l_sse;
+        mctx->fn_dmvr_mc_c   = xevdm_tbl_dmvr_mc_c_sse;
+        mctx->fn_bl_mc_l     = xevdm_tbl_bl_mc_l_sse;
+        mctx->fn_alf_cls_blk = xevdm_alf_derive_classification_blk_avx;
+        mctx->fn_alf_flt5_blk = xevdm_alf_filter_blk_5_avx;
+        mctx->fn_alf_flt7_blk = xevdm_alf_filter_blk_7_avx;
+        ctx->fn_ipred_ang    = xevd_ipred_ang_sse;
+        ctx->fn_ipred_bi     = xevd_ipred_bi_sse;
+        ctx->fn_ipred_plane  = xevd_ipred_plane_sse;
+        ctx->fn_out          = &xevd_tbl_out_avx;
+#endif
     }
-    else if (support_sse)
+    else if (ctx->isa == XEVD_ISA_SSE)
     {
-        xevd_func_itrans     = xevdm_itrans_map_tbl_sse;
-        xevdm_fn_itx          = &xevdm_tbl_itx;
-        xevdm_func_dmvr_mc_l = xevdm_tbl_dmvr_mc_l_sse;
-        xevdm_func_dmvr_mc_c = xevdm_tbl_dmvr_mc_c_sse;
-        xevdm_func_bl_mc_l   = xevdm_tbl_bl_mc_l_sse;
-        xevd_func_mc_l       = xevd_tbl_mc_l_sse;
-        xevd_func_mc_c       = xevd_tbl_mc_c_sse;
-        xevd_func_average_no_clip = &xevd_average_16b_no_clip_sse;
+        mctx->fn_itrans      = xevdm_itrans_map_tbl_sse;
         ctx->fn_itxb         = &xevd_tbl_itxb_sse;
+        mctx->fn_dbk_addb    = &xevdm_tbl_dbk_addb_sse;
+        mctx->fn_dbk_addb_chroma = &xevdm_tbl_dbk_addb_chroma_sse;
+        ctx->fn_mc_l         = xevd_tbl_mc_l_sse;
+        ctx->fn_mc_c         = xevd_tbl_mc_c_sse;
+        ctx->fn_average_no_clip = &xevd_average_16b_no_clip_sse;
         ctx->fn_dbk          = &xevd_tbl_dbk_sse;
         ctx->fn_dbk_chroma   = &xevd_tbl_dbk_chroma_sse;
-    }
-    else
-    {
-        xevd_func_itrans     = xevdm_itrans_map_tbl;
-        xevdm_fn_itx          = &xevdm_tbl_itx;
-        xevdm_func_dmvr_mc_l = xevdm_tbl_dmvr_mc_l;
-        xevdm_func_dmvr_mc_c = xevdm_tbl_dmvr_mc_c;
-        xevdm_func_bl_mc_l   = xevdm_tbl_bl_mc_l;
-        xevd_func_mc_l       = xevd_tbl_mc_l;
-        xevd_func_mc_c       = xevd_tbl_mc_c;
-        xevd_func_average_no_clip = &xevd_average_16b_no_clip;
-        ctx->fn_itxb         = &xevd_tbl_itxb;
-        ctx->fn_dbk          = &xevd_tbl_dbk;
-        ctx->fn_dbk_chroma   = &xevd_tbl_dbk_chroma;
-    }
-#else
-    {
-        xevd_func_itrans     = xevdm_itrans_map_tbl;
-        xevdm_fn_itx         = &xevdm_tbl_itx;
-        xevdm_func_dmvr_mc_l = xevdm_tbl_dmvr_mc_l;
-        xevdm_func_dmvr_mc_c = xevdm_tbl_dmvr_mc_c;
-        xevdm_func_bl_mc_l   = xevdm_tbl_bl_mc_l;
-        xevd_func_mc_l       = xevd_tbl_mc_l;
-        xevd_func_mc_c       = xevd_tbl_mc_c;
-        xevd_func_average_no_clip = &xevd_average_16b_no_clip;
-        ctx->fn_itxb         = &xevd_tbl_itxb;
-        ctx->fn_dbk          = &xevd_tbl_dbk;
-        ctx->fn_dbk_chroma   = &xevd_tbl_dbk_chroma;
-    }
+#if !XEVD_PEL_8BIT
+        mctx->fn_dmvr_mc_l   = xevdm_tbl_dmvr_mc_l_sse;
+        mctx->fn_dmvr_mc_c   = xevdm_tbl_dmvr_mc_c_sse;
+        mctx->fn_bl_mc_l     = xevdm_tbl_bl_mc_l_sse;
+        ctx->fn_ipred_ang    = xevd_ipred_ang_sse;
+        ctx->fn_ipred_bi     = xevd_ipred_bi_sse;
+        ctx->fn_ipred_plane  = xevd_ipred_plane_sse;
+        ctx->fn_out          = &xevd_tbl_out_sse;
 #endif
+    }
 #endif
     ctx->fn_ready         = xevdm_ready;
     ctx->fn_flush         = xevdm_flush;
@@ -3497,7 +4102,6 @@ void xevdm_platform_deinit(XEVD_CTX * ctx)
     if (mctx->alf != NULL)
     {
         delete_alf(mctx->alf);
-        mctx->fn_alf = NULL;
     }
 
     ctx->fn_picbuf_expand = NULL;
@@ -3522,6 +4126,9 @@ XEVD xevd_create(XEVD_CDSC * cdsc, int * err)
     xevd_assert_gv(ctx != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
     xevd_mcpy(&ctx->cdsc, cdsc, sizeof(XEVD_CDSC));
     xevd_assert_gv(!(cdsc->threads > XEVD_MAX_TASK_CNT), ret, XEVD_ERR_THREAD_ALLOCATION, ERR);
+    xevd_assert_gv(cdsc->isa >= XEVD_ISA_AUTO && cdsc->isa <= XEVD_ISA_NEON, ret, XEVD_ERR_INVALID_ARGUMENT, ERR);
+    xevd_assert_gv(!cdsc->imgb_alloc.fn_alloc == !cdsc->imgb_alloc.fn_free, ret, XEVD_ERR_INVALID_ARGUMENT, ERR);
+    xevd_assert_gv(XEVD_SUCCEEDED(xevd_out_cs_check(cdsc->out_cs)), ret, XEVD_ERR_UNSUPPORTED_COLORSPACE, ERR);
     ret = xevd_init_thread_controller(&ctx->tc, cdsc->threads);
     xevd_assert_g(XEVD_SUCCEEDED(ret), ERR);
     //initialize the threads to NULL
@@ -3556,7 +4163,6 @@ XEVD xevd_create(XEVD_CDSC * cdsc, int * err)
         xevd_assert_g(ret == XEVD_OK, ERR);
     }
 
-    mctx->fn_alf = xevd_alf;
 
     XEVD_ALF_SLICE_PARAM alf_control;
     XEVD_ALF_SLICE_PARAM *aps_alf_control = &alf_control;
@@ -3619,7 +4225,10 @@ void xevd_delete(XEVD id)
     XEVD_CTX *ctx;
     XEVD_ID_TO_CTX_R(id, ctx);
     XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+
+    if(ctx->async) xevd_async_stop(id);
     sequence_deinit(ctx);
+    xevd_tl_set(ctx, NULL);
 
 #if ENC_DEC_TRACE
     fclose(fp_trace);
@@ -3668,6 +4277,28 @@ int xevd_config(XEVD id, int cfg, void * buf, int * size)
         ctx->use_pic_sign = (*((int *)buf)) ? 1 : 0;
         break;
 
+    case XEVD_CFG_SET_LOOP_FILTER_PIPELINE:
+        ((XEVDM_CTX *)ctx)->lf_pipe = (*((int *)buf)) ? 1 : 0;
+        break;
+
+    case XEVD_CFG_SET_AU_MODE:
+        ((XEVDM_CTX *)ctx)->au_mode = (*((int *)buf)) ? 1 : 0;
+        break;
+
+    case XEVD_CFG_SET_PERF_STATS:
+        xevd_perf_reset(ctx, (*((int *)buf)) ? 1 : 0);
+        break;
+
+    case XEVD_CFG_SET_TIMELINE:
+        xevd_assert_rv(*size == sizeof(XEVD_TIMELINE), XEVD_ERR_INVALID_ARGUMENT);
+        return xevd_tl_set(ctx, (XEVD_TIMELINE *)buf);
+
+    case XEVD_CFG_SET_OUTPUT_CS:
+        xevd_assert_rv(*size == sizeof(int), XEVD_ERR_INVALID_ARGUMENT);
+        xevd_assert_rv(XEVD_SUCCEEDED(xevd_out_cs_check(*((int *)buf))), XEVD_ERR_UNSUPPORTED_COLORSPACE);
+        ctx->cdsc.out_cs = *((int *)buf);
+        break;
+
     /* get config ************************************************************/
     case XEVD_CFG_GET_CODEC_BIT_DEPTH:
         xevd_assert_rv(*size == sizeof(int), XEVD_ERR_INVALID_ARGUMENT);
@@ -3708,6 +4339,30 @@ int xevd_config(XEVD id, int cfg, void * buf, int * size)
         *((int *)buf) = ctx->max_coding_delay;
         break;
 
+    case XEVD_CFG_GET_WAIT_CYCLES:
+        xevd_assert_rv(*size == sizeof(long long), XEVD_ERR_INVALID_ARGUMENT);
+        *((long long *)buf) = 0;
+        for(t0 = 0; t0 < XEVD_MAX_TASK_CNT; t0++)
+        {
+            *((long long *)buf) += (long long)ctx->wait_cycles[t0];
+        }
+        break;
+
+    case XEVD_CFG_GET_ISA:
+        xevd_assert_rv(*size == sizeof(int), XEVD_ERR_INVALID_ARGUMENT);
+        *((int *)buf) = ctx->isa;
+        break;
+
+    case XEVD_CFG_GET_THREAD_STAT:
+        xevd_assert_rv(*size == sizeof(XEVD_THREAD_STAT), XEVD_ERR_INVALID_ARGUMENT);
+        xevd_get_thread_stat(ctx, (XEVD_THREAD_STAT *)buf);
+        break;
+
+    case XEVD_CFG_GET_PERF_STATS:
+        xevd_assert_rv(*size == sizeof(XEVD_PERF_STATS), XEVD_ERR_INVALID_ARGUMENT);
+        xevd_get_perf_stats(ctx, (XEVD_PERF_STATS *)buf);
+        break;
+
     default:
         xevd_assert_rv(0, XEVD_ERR_UNSUPPORTED);
     }
@@ -3717,6 +4372,8 @@ int xevd_config(XEVD id, int cfg, void * buf, int * size)
 int xevd_decode(XEVD id, XEVD_BITB * bitb, XEVD_STAT * stat)
 {
     XEVD_CTX *ctx;
+    u64       t0;
+    int       ret;
 
     XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
     XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
@@ -3749,15 +4406,45 @@ int xevd_decode(XEVD id, XEVD_BITB * bitb, XEVD_STAT * stat)
 
     xevd_assert_rv(ctx->fn_dec_cnk, XEVD_ERR_UNEXPECTED);
 
-    return ctx->fn_dec_cnk(ctx, bitb, stat);
+    t0 = xevd_get_cycles();
+    ret = ctx->fn_dec_cnk(ctx, bitb, stat);
+    if(ctx->perf_on & XEVD_PERF_TL)
+    {
+        xevd_tl_add(ctx, 0, XEVD_TL_DECODE, ctx->nalu.nal_unit_type_plus1 - 1, t0, xevd_get_cycles());
+        xevd_tl_flush(ctx);
+    }
+    ctx->dec_cycles += xevd_get_cycles() - t0;
+    return ret;
+}
+
+int xevd_decode_au(XEVD id, XEVD_BITB * bitb, int fmt, XEVD_NALU_STAT * nstat, int * nstat_cnt)
+{
+    XEVD_CTX  *ctx;
+    XEVDM_CTX *mctx;
+    u8         au_mode;
+    int        ret;
+
+    XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
+    xevd_assert_rv(bitb && nstat && nstat_cnt, XEVD_ERR_INVALID_ARGUMENT);
+    mctx = (XEVDM_CTX *)ctx;
+
+    /* the slices of the buffer are decoded together */
+    au_mode = mctx->au_mode;
+    mctx->au_mode = 1;
+    ret = xevd_decode_nalus(id, bitb, fmt, nstat, nstat_cnt);
+    mctx->au_mode = au_mode;
+    return ret;
 }
 
 int xevd_pull(XEVD id, XEVD_IMGB ** imgb)
 {
     XEVD_CTX *ctx;
+    int       ret;
 
     XEVD_ID_TO_CTX_RV(id, ctx, XEVD_ERR_INVALID_ARGUMENT);
     xevd_assert_rv(ctx->fn_pull, XEVD_ERR_UNKNOWN);
 
-    return ctx->fn_pull(ctx, imgb);
+    ret = ctx->fn_pull(ctx, imgb);
+    xevd_tl_flush(ctx);
+    return ret;
 }
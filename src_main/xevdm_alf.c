@@ -35,19 +35,15 @@
 
 #include "xevdm_alf.h"
 
-static void alf_derive_classification_blk(ALF_CLASSIFIER ** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth)
+void xevdm_alf_derive_classification_blk(ALF_CLASSIFIER ** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth)
 {
-    static const int th[16] = { 0, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4 };
     const int stride = src_stride;
     const pel * src = src_luma;
-    const int max_act = 15;
 
     int fl = 2;
     int flP1 = fl + 1;
     int fl2 = 2 * fl;
 
-    int main_dir, sec_dir, dir_temp_hv, dir_temp_d;
-
     int pix_y;
     int height = blk->height + fl2;
     int width = blk->width + fl2;
@@ -77,10 +73,10 @@ static void alf_derive_classification_blk(ALF_CLASSIFIER ** classifier, const pe
             const pel * y_up = src2 + pix_y;
             const pel * y_up2 = src3 + pix_y;
 
-            const pel y0 = y[0] << 1;
-            const pel y1 = y[1] << 1;
-            const pel y_up0 = y_up[0] << 1;
-            const pel y_up1 = y_up[1] << 1;
+            const s16 y0 = y[0] << 1;
+            const s16 y1 = y[1] << 1;
+            const s16 y_up0 = y_up[0] << 1;
+            const s16 y_up1 = y_up[1] << 1;
 
             y_ver[j] = abs(y0 - y_down[0] - y_up[0]) + abs(y1 - y_down[1] - y_up[1]) + abs(y_up0 - y[0] - y_up2[0]) + abs(y_up1 - y[1] - y_up2[1]);
             y_hor[j] = abs(y0 - y[1] - y[-1]) + abs(y1 - y[2] - y[0]) + abs(y_up0 - y_up[1] - y_up[-1]) + abs(y_up1 - y_up[2] - y_up[0]);
@@ -133,68 +129,6 @@ static void alf_derive_classification_blk(ALF_CLASSIFIER ** classifier, const pe
             int sum_h = y_hor[j] + y_hor2[j] + y_hor4[j] + y_hor6[j];
             int sum_d0 = y_dig0[j] + y_dig02[j] + y_dig04[j] + y_dig06[j];
             int sum_d1 = y_dig1[j] + y_dig12[j] + y_dig14[j] + y_dig16[j];
-            int temp_act = sum_v + sum_h;
-            int activity = (pel)XEVD_CLIP3(0, max_act, temp_act >> (bit_depth - 2));
-            int class_idx = th[activity];
-            int hv1, hv0, d1, d0, hvd1, hvd0;
-
-            if (sum_v > sum_h)
-            {
-                hv1 = sum_v;
-                hv0 = sum_h;
-                dir_temp_hv = 1;
-            }
-            else
-            {
-                hv1 = sum_h;
-                hv0 = sum_v;
-                dir_temp_hv = 3;
-            }
-            if (sum_d0 > sum_d1)
-            {
-                d1 = sum_d0;
-                d0 = sum_d1;
-                dir_temp_d = 0;
-            }
-            else
-            {
-                d1 = sum_d1;
-                d0 = sum_d0;
-                dir_temp_d = 2;
-            }
-            if (d1*hv0 > hv1*d0)
-            {
-                hvd1 = d1;
-                hvd0 = d0;
-                main_dir = dir_temp_d;
-                sec_dir = dir_temp_hv;
-            }
-            else
-            {
-                hvd1 = hv1;
-                hvd0 = hv0;
-                main_dir = dir_temp_hv;
-                sec_dir = dir_temp_d;
-            }
-
-            int directionStrength = 0;
-            if (hvd1 > 2 * hvd0)
-            {
-                directionStrength = 1;
-            }
-            if (hvd1 * 2 > 9 * hvd0)
-            {
-                directionStrength = 2;
-            }
-
-            if (directionStrength)
-            {
-                class_idx += (((main_dir & 0x1) << 1) + directionStrength) * 5;
-            }
-
-            static const int trans_tbl[8] = { 0, 1, 0, 2, 2, 3, 1, 3 };
-            int trans_idx = trans_tbl[main_dir * 2 + (sec_dir >> 1)];
-
             int y_offset = i + pos_y;
             int x_offset = j + pos_x;
 
@@ -202,12 +136,12 @@ static void alf_derive_classification_blk(ALF_CLASSIFIER ** classifier, const pe
             ALF_CLASSIFIER *cl1 = classifier[y_offset + 1] + x_offset;
             ALF_CLASSIFIER *cl2 = classifier[y_offset + 2] + x_offset;
             ALF_CLASSIFIER *cl3 = classifier[y_offset + 3] + x_offset;
-            cl0[0] = cl0[1] = cl0[2] = cl0[3] = cl1[0] = cl1[1] = cl1[2] = cl1[3] = cl2[0] = cl2[1] = cl2[2] = cl2[3] = cl3[0] = cl3[1] = cl3[2] = cl3[3] = ((class_idx << 2) + trans_idx) & 0xFF;
+            cl0[0] = cl0[1] = cl0[2] = cl0[3] = cl1[0] = cl1[1] = cl1[2] = cl1[3] = cl2[0] = cl2[1] = cl2[2] = cl2[3] = cl3[0] = cl3[1] = cl3[2] = cl3[3] = alf_get_class(sum_v, sum_h, sum_d0, sum_d1, bit_depth);
         }
     }
 }
 
-static void alf_filter_blk_7(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel* rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range)
+void xevdm_alf_filter_blk_7(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel* rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range)
 {
     const BOOL is_chroma = FALSE;
 
@@ -241,7 +175,7 @@ static void alf_filter_blk_7(ALF_CLASSIFIER** classifier, pel * rec_dst, const i
     int dst_stride2 = dst_stride * cls_size_y;
     int src_stride2 = src_stride * cls_size_y;
 
-    pel filter_coef[MAX_NUM_ALF_LUMA_COEFF];
+    short filter_coef[MAX_NUM_ALF_LUMA_COEFF];
     img_y_pad0 = src;
     img_y_pad1 = img_y_pad0 + src_stride;
     img_y_pad2 = img_y_pad0 - src_stride;
@@ -336,7 +270,7 @@ static void alf_filter_blk_7(ALF_CLASSIFIER** classifier, pel * rec_dst, const i
     }
 }
 
-static void alf_filter_blk_5(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel* rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range)
+void xevdm_alf_filter_blk_5(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel* rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range)
 {
     const int start_h = blk->y;
     const int end_h = blk->y + blk->height;
@@ -363,7 +297,7 @@ static void alf_filter_blk_5(ALF_CLASSIFIER** classifier, pel * rec_dst, const i
     int dst_stride2 = dst_stride * cls_size_y;
     int src_stride2 = src_stride * cls_size_y;
 
-    pel filter_coef[MAX_NUM_ALF_LUMA_COEFF];
+    short filter_coef[MAX_NUM_ALF_LUMA_COEFF];
     img_y_pad0 = src;
     img_y_pad1 = img_y_pad0 + src_stride;
     img_y_pad2 = img_y_pad0 - src_stride;
@@ -441,9 +375,9 @@ void xevd_alf_init(ADAPTIVE_LOOP_FILTER * alf, int bit_depth)
         alf->ctu_enable_flag[compIdx] = NULL;
     }
 
-    alf->derive_classification_blk = alf_derive_classification_blk;
-    alf->filter_5x5_blk = alf_filter_blk_5;
-    alf->filter_7x7_blk = alf_filter_blk_7;
+    alf->derive_classification_blk = xevdm_alf_derive_classification_blk;
+    alf->filter_5x5_blk = xevdm_alf_filter_blk_5;
+    alf->filter_7x7_blk = xevdm_alf_filter_blk_7;
 }
 
 ADAPTIVE_LOOP_FILTER * new_alf(int bit_depth)
@@ -800,20 +734,26 @@ typedef struct _XEVD_ALF_TMP
     ALF_SLICE_PARAM      *alf_slice_param;
     int                 tile_idx;
     int                 tsk_num;
+    /* CTU rows of the tile, relative to its first row, copied to the
+       temporary buffer ([copy_beg, copy_end)) and then filtered ([filt_beg, filt_end)) */
+    int                 copy_beg;
+    int                 copy_end;
+    int                 filt_beg;
+    int                 filt_end;
 } XEVD_ALF_TMP;
 
-static void alf_copy_and_extend_tile(pel* tmp_yuv, const int s, const pel* rec, const int s2, const int w, const int h, const int m)
+static void alf_copy_and_extend_tile(pel* tmp_yuv, const int s, const pel* rec, const int s2, const int w, const int h, const int m, const int y0, const int y1)
 {
     //copy
-    for (int j = 0; j < h; j++)
+    for (int j = y0; j < y1; j++)
     {
         xevd_mcpy(tmp_yuv + j * s, rec + j * s2, sizeof(pel) * w);
     }
 
     //extend
-    pel * p = tmp_yuv;
+    pel * p = tmp_yuv + y0 * s;
     // do left and right margins
-    for (int y = 0; y < h; y++)
+    for (int y = y0; y < y1; y++)
     {
         for (int x = 0; x < m; x++)
         {
@@ -823,20 +763,24 @@ static void alf_copy_and_extend_tile(pel* tmp_yuv, const int s, const pel* rec,
         p += s;
     }
 
-    // p is now the (0,height) (bottom left of image within bigger picture
-    p -= (s + m);
-    // p is now the (-margin, height-1)
-    for (int y = 0; y < m; y++)
+    if (y1 == h)
     {
-        xevd_mcpy(p + (y + 1) * s, p, sizeof(pel) * (w + (m << 1)));
+        // p is now the (-margin, height-1)
+        p = tmp_yuv + (h - 1) * s - m;
+        for (int y = 0; y < m; y++)
+        {
+            xevd_mcpy(p + (y + 1) * s, p, sizeof(pel) * (w + (m << 1)));
+        }
     }
 
-    // pi is still (-marginX, height-1)
-    p -= ((h - 1) * s);
-    // pi is now (-marginX, 0)
-    for (int y = 0; y < m; y++)
+    if (y0 == 0)
     {
-        xevd_mcpy(p - (y + 1) * s, p, sizeof(pel) * (w + (m << 1)));
+        // p is now (-marginX, 0)
+        p = tmp_yuv - m;
+        for (int y = 0; y < m; y++)
+        {
+            xevd_mcpy(p - (y + 1) * s, p, sizeof(pel) * (w + (m << 1)));
+        }
     }
 }
 
@@ -893,7 +837,7 @@ static void alf_derive_classification(ADAPTIVE_LOOP_FILTER * alf, ALF_CLASSIFIER
         {
             int w = XEVD_MIN(j + CLASSIFICATION_BLK_SIZE, width) - j;
             AREA area = { j, i, w, h };
-            alf_derive_classification_blk(classifier, src_luma, src_luma_stride, &area, alf->input_bit_depth[CHANNEL_TYPE_LUMA] + 4, alf->input_bit_depth[CHANNEL_TYPE_LUMA]);
+            alf->derive_classification_blk(classifier, src_luma, src_luma_stride, &area, alf->input_bit_depth[CHANNEL_TYPE_LUMA] + 4, alf->input_bit_depth[CHANNEL_TYPE_LUMA]);
         }
     }
 }
@@ -960,12 +904,26 @@ int alf_process_tile(void * arg)
     pel * recoYuv1_tile = recYuv1 + (x_l >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + (y_l >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))) * cs->pic->s_c;
     pel * recoYuv2_tile = recYuv2 + (x_l >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + (y_l >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))) * cs->pic->s_c;
 
-    alf_copy_and_extend_tile(recLuma0_tile, s, recoYuv0_tile, cs->pic->s_l, w_tile, h_tile, m);
-    if (ctx->sps->chroma_format_idc)
+    if (input->copy_beg < input->copy_end)
     {
-        alf_copy_and_extend_tile(recLuma1_tile, s1, recoYuv1_tile, cs->pic->s_c, (w_tile >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))), (h_tile >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))), m);
-        alf_copy_and_extend_tile(recLuma2_tile, s1, recoYuv2_tile, cs->pic->s_c, (w_tile >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))), (h_tile >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))), m);
+        const int y0 = input->copy_beg << ctx->log2_max_cuwh;
+        const int y1 = XEVD_MIN(h_tile, input->copy_end << ctx->log2_max_cuwh);
+        alf_copy_and_extend_tile(recLuma0_tile, s, recoYuv0_tile, cs->pic->s_l, w_tile, h_tile, m, y0, y1);
+        if (ctx->sps->chroma_format_idc)
+        {
+            const int h_shift = XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc);
+            alf_copy_and_extend_tile(recLuma1_tile, s1, recoYuv1_tile, cs->pic->s_c, (w_tile >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))), (h_tile >> h_shift), m, y0 >> h_shift, y1 >> h_shift);
+            alf_copy_and_extend_tile(recLuma2_tile, s1, recoYuv2_tile, cs->pic->s_c, (w_tile >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))), (h_tile >> h_shift), m, y0 >> h_shift, y1 >> h_shift);
+        }
+    }
+    if (input->filt_beg >= input->filt_end)
+    {
+        return XEVD_OK;
     }
+    y_loc += input->filt_beg;
+    ctuIdx = x_loc + y_loc * ctx->w_lcu;
+    const int y_beg = y_l + (input->filt_beg << ctx->log2_max_cuwh);
+    const int y_end = XEVD_MIN(y_r, y_l + (input->filt_end << ctx->log2_max_cuwh));
 
     int l_zero_offset = (MAX_CU_SIZE + m + m) * m + m;
     int l_stride = MAX_CU_SIZE + 2 * (MAX_ALF_FILTER_LENGTH >> 1);
@@ -978,7 +936,7 @@ int alf_process_tile(void * arg)
     pel *p_buffer_cr = l_buffer_cr + l_zero_offset_chroma;
     pel *p_buffer_cb = l_buffer_cb + l_zero_offset_chroma;
 
-    for (int yPos = y_l; yPos < y_r; yPos += ctx->max_cuwh)
+    for (int yPos = y_beg; yPos < y_end; yPos += ctx->max_cuwh)
     {
         for (int xPos = x_l; xPos < x_r; xPos += ctx->max_cuwh)
         {
@@ -1001,7 +959,7 @@ int alf_process_tile(void * arg)
             {
                 int dstPos = i * l_stride - l_zero_offset;
                 int srcPos_offset = xPos + yPos * s;
-                int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                int stride = width + m + m;
                 xevd_mcpy(p_buffer + dstPos + m, tmpYuv + srcPos_offset + (i - m) * s, sizeof(pel) * (stride - 2 * m));
                 for (int j = 0; j < m; j++)
                 {
@@ -1029,7 +987,7 @@ int alf_process_tile(void * arg)
             {
                 int dstPos = i * l_stride - l_zero_offset;
                 int srcPos_offset = xPos + yPos * s;
-                int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                int stride = width + m + m;
                 if (availableT)
                     xevd_mcpy(p_buffer + dstPos, tmpYuv + srcPos_offset - (m - i) * s - m, sizeof(pel) * stride);
                 else
@@ -1040,7 +998,7 @@ int alf_process_tile(void * arg)
             {
                 int dstPos = i * l_stride - l_zero_offset;
                 int srcPos_offset = xPos + yPos * s;
-                int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                int stride = width + m + m;
                 if (availableB)
                 {
                     xevd_mcpy(p_buffer + dstPos, tmpYuv + srcPos_offset + (i - m) * s - m, sizeof(pel) * stride);
@@ -1063,7 +1021,7 @@ int alf_process_tile(void * arg)
                 {
                     int dstPos = i * l_stride_chroma - l_zero_offset_chroma;
                     int srcPos_offset = (xPos >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + (yPos >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))) * s1;
-                    int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + m + m);
+                    int stride = (width >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + m + m;
                     xevd_mcpy(p_buffer_cb + dstPos + m, tmpYuv1 + srcPos_offset + (i - m) * s1, sizeof(pel) * (stride - 2 * m));
                     xevd_mcpy(p_buffer_cr + dstPos + m, tmpYuv2 + srcPos_offset + (i - m) * s1, sizeof(pel) * (stride - 2 * m));
                     for (int j = 0; j < m; j++)
@@ -1095,7 +1053,7 @@ int alf_process_tile(void * arg)
                 {
                     int dstPos = i * l_stride_chroma - l_zero_offset_chroma;
                     int srcPos_offset = (xPos >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + (yPos >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))) * s1;
-                    int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + m + m);
+                    int stride = (width >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + m + m;
                     if (availableT)
                     {
                         xevd_mcpy(p_buffer_cb + dstPos, tmpYuv1 + srcPos_offset - (m - i) * s1 - m, sizeof(pel) * stride);
@@ -1117,7 +1075,7 @@ int alf_process_tile(void * arg)
                 {
                     int dstPos = i * l_stride_chroma - l_zero_offset_chroma;
                     int srcPos_offset = (xPos >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + (yPos >> (XEVD_GET_CHROMA_H_SHIFT(ctx->sps->chroma_format_idc))) * s1;
-                    int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + m + m);
+                    int stride = (width >> (XEVD_GET_CHROMA_W_SHIFT(ctx->sps->chroma_format_idc))) + m + m;
                     if (availableB)
                     {
                         xevd_mcpy(p_buffer_cb + dstPos, tmpYuv1 + srcPos_offset + (i - m) * s1 - m, sizeof(pel) * stride);
@@ -1164,11 +1122,12 @@ int alf_process_tile(void * arg)
     return XEVD_OK;
 }
 
-void alf_process(ADAPTIVE_LOOP_FILTER *alf, CODING_STRUCTURE* cs, ALF_SLICE_PARAM* alf_slice_param)
+/* prepare the filters of alf_slice_param; returns FALSE when no component is filtered */
+static BOOL alf_process_init(ADAPTIVE_LOOP_FILTER *alf, CODING_STRUCTURE* cs, ALF_SLICE_PARAM* alf_slice_param)
 {
     if (!alf_slice_param->enable_flag[Y_C] && !alf_slice_param->enable_flag[U_C] && !alf_slice_param->enable_flag[V_C])
     {
-        return;
+        return FALSE;
     }
 
     XEVD_CTX* ctx = (XEVD_CTX*)(cs->ctx);
@@ -1187,87 +1146,47 @@ void alf_process(ADAPTIVE_LOOP_FILTER *alf, CODING_STRUCTURE* cs, ALF_SLICE_PARA
     {
         alf_recon_coef(alf, alf_slice_param, CHANNEL_TYPE_CHROMA, FALSE, FALSE);
     }
+    return TRUE;
+}
 
-    int ii;
-    const int h = cs->pic->h_l;
-    const int w = cs->pic->w_l;
-    const int m = MAX_ALF_FILTER_LENGTH >> 1;
-    const int s = w + m + m;
-    int col_bd = 0;
-    u32 k = 0;
-    ii = 0;
-    int num_tiles_in_slice = ctx->w_tile * ctx->h_tile;
-    XEVD_ALF_TMP alf_tmp[DEC_XEVD_MAX_TASK_CNT];
-    int i;
-    int(*tile_alf)(void * arg) = alf_process_tile;
-    int res = 0;
-    int j;
-    int tile_start_num, num_tiles_proc;
-    int        ret;
-    ret = XEVD_OK;
-
-    while (num_tiles_in_slice)
-    {
-        if (num_tiles_in_slice > ctx->tc.max_task_cnt)
-        {
-            tile_start_num = k;
-            num_tiles_proc = ctx->tc.max_task_cnt;
-        }
-        else
-        {
-            tile_start_num = k;
-            num_tiles_proc = num_tiles_in_slice;
-        }
-        for (j = 1; j < num_tiles_proc; j++)
-        {
-            alf_tmp[j].alf_slice_param = alf_slice_param;
-            alf_tmp[j].cs = cs;
-            alf_tmp[j].alf = alf;
-            alf_tmp[j].tile_idx = tile_start_num + j - 1;
+/* set up filtering of pic by CTU rows of its tiles. the CTU enable flags are
+   read in place, as the slice data parser fills them ahead of the rows being
+   filtered */
+int call_dec_alf_rows_begin(ADAPTIVE_LOOP_FILTER* alf, XEVD_CTX * ctx, XEVD_PIC * pic)
+{
+    XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
+    ALF_SLICE_PARAM * alf_slice_param = &alf->rows_param;
 
-            alf_tmp[j].tsk_num = j;
+    alf->rows_cs.ctx = (void *)ctx;
+    alf->rows_cs.pic = pic;
+    alf_load_paramline_from_aps_buffer2(alf, alf_slice_param, mctx->sh.aps_id_y, mctx->sh.aps_id_ch, mctx->sh.alf_chroma_idc);
+    alf_slice_param->is_ctb_alf_on = mctx->sh.alf_sh_param.is_ctb_alf_on;
+    alf_slice_param->alf_ctb_flag = mctx->sh.alf_sh_param.alf_ctu_enable_flag;
+    alf->rows_on = alf_process_init(alf, &alf->rows_cs, alf_slice_param);
 
-            ret = ctx->tc.run(ctx->thread_pool[j], tile_alf, (void *)(&alf_tmp[j]));
-            k++;
-        }
-        j = tile_start_num + num_tiles_proc - 1;
-        i = ctx->tile_in_slice[j];
-        alf_tmp[0].alf_slice_param = alf_slice_param;
-        alf_tmp[0].cs = cs;
-        alf_tmp[0].alf = alf;
-        alf_tmp[0].tile_idx = j;
-        alf_tmp[0].tsk_num = 0;
-
-        ret = tile_alf((void *)(&alf_tmp[0]));
-        k++;
-        for (i = 1; i < num_tiles_proc; i++)
-        {
-            ret = ctx->tc.join(ctx->thread_pool[i], &res);
-        }
-        num_tiles_in_slice -= (num_tiles_proc);
-    }
+    return XEVD_OK;
 }
 
-int call_dec_alf_process_aps(ADAPTIVE_LOOP_FILTER* alf, XEVD_CTX * ctx, XEVD_PIC * pic)
+/* copy the deblocked CTU rows [copy_beg, copy_end) of a tile to the temporary
+   buffers and filter its rows [filt_beg, filt_end), whose neighbouring rows in
+   the tile must have been copied already. rows are counted from the top of
+   the tile; worker_idx selects the classifier buffer */
+void call_dec_alf_process_rows(ADAPTIVE_LOOP_FILTER* alf, int tile_idx, int worker_idx, int copy_beg, int copy_end, int filt_beg, int filt_end)
 {
-    CODING_STRUCTURE cs;
-    cs.ctx = (void *)ctx;
-    cs.pic = pic;
-    XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
-    ALF_SLICE_PARAM alf_slice_param;
-    alf_slice_param.alf_ctb_flag = (u8 *)malloc(N_C * ctx->f_lcu * sizeof(u8));
-    if (alf_slice_param.alf_ctb_flag == NULL)
-        return XEVD_ERR;
-    xevd_mset(alf_slice_param.alf_ctb_flag, 0, N_C * ctx->f_lcu * sizeof(u8));
-    // load filter from buffer
-    alf_load_paramline_from_aps_buffer2(alf, &(alf_slice_param), mctx->sh.aps_id_y, mctx->sh.aps_id_ch, mctx->sh.alf_chroma_idc);
-
-    // load filter map buffer
-    alf_slice_param.is_ctb_alf_on = mctx->sh.alf_sh_param.is_ctb_alf_on;
-    xevd_mcpy(alf_slice_param.alf_ctb_flag, mctx->sh.alf_sh_param.alf_ctu_enable_flag, N_C * ctx->f_lcu * sizeof(u8));
-    alf_process(alf, &cs, &alf_slice_param);
-    if (alf_slice_param.alf_ctb_flag)
-        free(alf_slice_param.alf_ctb_flag);
+    XEVD_ALF_TMP alf_tmp;
 
-    return XEVD_OK;
+    if (!alf->rows_on)
+    {
+        return;
+    }
+    alf_tmp.alf = alf;
+    alf_tmp.cs = &alf->rows_cs;
+    alf_tmp.alf_slice_param = &alf->rows_param;
+    alf_tmp.tile_idx = tile_idx;
+    alf_tmp.tsk_num = worker_idx;
+    alf_tmp.copy_beg = copy_beg;
+    alf_tmp.copy_end = copy_end;
+    alf_tmp.filt_beg = filt_beg;
+    alf_tmp.filt_end = filt_end;
+    alf_process_tile((void *)&alf_tmp);
 }
@@ -118,6 +118,74 @@ static __inline int clip_pel(const int a, const CLIP_RANGE clip_range)
     return XEVD_CLIP3(clip_range.min, clip_range.max, a);
 }
 
+/* class and transpose index of a 4x4 block from the laplacian sums of its 8x8 window */
+static __inline ALF_CLASSIFIER alf_get_class(int sum_v, int sum_h, int sum_d0, int sum_d1, int bit_depth)
+{
+    static const int th[16] = { 0, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4 };
+    static const int trans_tbl[8] = { 0, 1, 0, 2, 2, 3, 1, 3 };
+    const int max_act = 15;
+    int main_dir, sec_dir, dir_temp_hv, dir_temp_d;
+    int temp_act = sum_v + sum_h;
+    int activity = (pel)XEVD_CLIP3(0, max_act, temp_act >> (bit_depth - 2));
+    int class_idx = th[activity];
+    int hv1, hv0, d1, d0, hvd1, hvd0;
+    int direction_strength = 0;
+
+    if (sum_v > sum_h)
+    {
+        hv1 = sum_v;
+        hv0 = sum_h;
+        dir_temp_hv = 1;
+    }
+    else
+    {
+        hv1 = sum_h;
+        hv0 = sum_v;
+        dir_temp_hv = 3;
+    }
+    if (sum_d0 > sum_d1)
+    {
+        d1 = sum_d0;
+        d0 = sum_d1;
+        dir_temp_d = 0;
+    }
+    else
+    {
+        d1 = sum_d1;
+        d0 = sum_d0;
+        dir_temp_d = 2;
+    }
+    if (d1*hv0 > hv1*d0)
+    {
+        hvd1 = d1;
+        hvd0 = d0;
+        main_dir = dir_temp_d;
+        sec_dir = dir_temp_hv;
+    }
+    else
+    {
+        hvd1 = hv1;
+        hvd0 = hv0;
+        main_dir = dir_temp_hv;
+        sec_dir = dir_temp_d;
+    }
+
+    if (hvd1 > 2 * hvd0)
+    {
+        direction_strength = 1;
+    }
+    if (hvd1 * 2 > 9 * hvd0)
+    {
+        direction_strength = 2;
+    }
+    if (direction_strength)
+    {
+        class_idx += (((main_dir & 0x1) << 1) + direction_strength) * 5;
+    }
+
+    return ((class_idx << 2) + trans_tbl[main_dir * 2 + (sec_dir >> 1)]) & 0xFF;
+}
+
 typedef struct CODING_STRUCTURE
 {
     void    * ctx;
@@ -380,12 +448,24 @@ struct _ADAPTIVE_LOOP_FILTER
     BOOL                strore2_alf_buf_flag;
     BOOL                reset_alf_buf_flag;
     ALF_FILTER_SHAPE    filter_shapes[N_C][2];
+    /* state of filtering the current picture by CTU rows of its tiles */
+    CODING_STRUCTURE    rows_cs;
+    ALF_SLICE_PARAM     rows_param;
+    BOOL                rows_on;
 
     void(*derive_classification_blk)(ALF_CLASSIFIER** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth);
     void(*filter_5x5_blk)(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range);
     void(*filter_7x7_blk)(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range);
 };
 
+void xevdm_alf_derive_classification_blk(ALF_CLASSIFIER ** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth);
+void xevdm_alf_filter_blk_7(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel* rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range);
+void xevdm_alf_filter_blk_5(ALF_CLASSIFIER** classifier, pel * rec_dst, const int dst_stride, const pel* rec_src, const int src_stride, const AREA* blk, const u8 comp_id, short* filter_set, const CLIP_RANGE* clip_range);
+
+#if X86_SSE
+#include "xevdm_alf_avx.h"
+#endif
+
 ADAPTIVE_LOOP_FILTER* new_alf(int bit_depth);
 void delete_alf(ADAPTIVE_LOOP_FILTER* alf);
 
@@ -394,7 +474,8 @@ void xevd_alf_destroy(ADAPTIVE_LOOP_FILTER * alf);
 void xevd_alf_init(ADAPTIVE_LOOP_FILTER * alf, int bit_depth);
 void xevd_alf_init_filter_shape(void * filter_shape, int size);
 
-int call_dec_alf_process_aps(ADAPTIVE_LOOP_FILTER* alf, XEVD_CTX * ctx, XEVD_PIC * pic);
+int call_dec_alf_rows_begin(ADAPTIVE_LOOP_FILTER* alf, XEVD_CTX * ctx, XEVD_PIC * pic);
+void call_dec_alf_process_rows(ADAPTIVE_LOOP_FILTER* alf, int tile_idx, int worker_idx, int copy_beg, int copy_end, int filt_beg, int filt_end);
 void store_dec_aps_to_buffer(XEVD_CTX * ctx);
 #endif
 
@@ -275,6 +275,8 @@ typedef struct _XEVD_ALF_FILTER_SHAPE
 /* maximum picture buffer size */
 #define DRA_FRAME 1
 #define MAXM_PB_SIZE                       (XEVD_MAX_NUM_REF_PICS + EXTRA_FRAME + DRA_FRAME)
+/* number of recycled output buffers of DRA mapped pictures */
+#define XEVDM_DRA_OUT_POOL_SIZE            8
 
 #define MODE_SKIP_MMVD                     4
 #define MODE_DIR_MMVD                      5
@@ -516,6 +518,19 @@ typedef struct _TREE_CONS_NEW
 #error "EIF_MV_PRECISION_BILINEAR is to small"
 #endif
 
+typedef void(*XEVDM_DMVR_MC_L) (pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef);
+typedef void(*XEVDM_DMVR_MC_C) (pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef);
+typedef void(*XEVDM_BL_MC_L) (pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth);
+typedef void(*XEVD_ITX)(s16* coef, s16* t, int shift, int line);
+
+struct AREA;
+struct CLIP_RANGE;
+typedef void(*XEVDM_ALF_CLS)(u8 ** classifier, const pel * src_luma, const int src_stride, const struct AREA * blk, const int shift, int bit_depth);
+typedef void(*XEVDM_ALF_FLT)(u8 ** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const struct AREA * blk, const u8 comp_id, short * filter_set, const struct CLIP_RANGE * clip_range);
+
+/* ADDB deblocking of one SCU edge segment of size lines */
+typedef void(*XEVDM_DBK_ADDB)(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c, int bit_depth_minus8, int size);
+
 typedef struct _XEVDM_CTX XEVDM_CTX;
 
 typedef struct _XEVDM_CORE
@@ -558,7 +573,31 @@ typedef struct _XEVDM_CORE
 
     TREE_CONS      tree_cons;
 
+    /* slice header extension of the slice being decoded */
+    XEVDM_SH     * msh;
+    /* the tile being parsed is the last one of the slice */
+    u8             last_tile_in_slice;
 } XEVDM_CORE;
+
+/* slice kept until all the slices of the picture are received
+   (XEVD_CFG_SET_AU_MODE) */
+typedef struct _XEVDM_AU_SLICE
+{
+    /* copy of the NAL unit */
+    u8             * nalu;
+    int              nalu_size;
+    /* bitstream reader and arithmetic decoder after the slice header */
+    XEVD_BSR         bs;
+    XEVD_SBAC        sbac;
+    XEVD_SH          sh;
+    XEVDM_SH         msh;
+    XEVD_REFP        refp[XEVD_MAX_NUM_REF_PICS][REFP_NUM];
+    u8               num_refp[REFP_NUM];
+    /* core state at the start of the slice */
+    XEVD_CORE        core;
+    int              num_tiles;
+    u16              tile_in_slice[MAX_NUM_TILES_COL * MAX_NUM_TILES_ROW];
+} XEVDM_AU_SLICE;
 /******************************************************************************
 * CONTEXT used for decoding process.
 *
@@ -579,6 +618,10 @@ struct _XEVDM_CTX
     void                  * pps_dra_params;
     XEVD_APS_GEN          * aps_gen_array;
     SIG_PARAM_DRA         * dra_array;
+    /* DRA mapping of the output pictures, rebuilt when the parameters change */
+    struct _DRA_CONTROL   * dra_out;
+    /* recycled buffers of the DRA mapped output pictures */
+    XEVD_IMGB             * dra_out_pool[XEVDM_DRA_OUT_POOL_SIZE];
     s8(*map_suco)[NUM_CU_DEPTH][NUM_BLOCK_SHAPE][MAX_CU_CNT_IN_LCU];
 
 
@@ -588,8 +631,39 @@ struct _XEVDM_CTX
     /* ats_inter info map */
     u8                    * map_ats_inter;
 
-    /* function address of ALF */
-    int(*fn_alf)(XEVD_CTX * ctx, XEVD_PIC * pic);
+    /* main profile kernels, selected with the ones of bctx */
+    INV_TRANS           *(*fn_itrans)[5];
+    XEVD_ITX             (*fn_itx)[MAX_TR_LOG2];
+    XEVDM_DMVR_MC_L      (*fn_dmvr_mc_l)[2];
+    XEVDM_DMVR_MC_C      (*fn_dmvr_mc_c)[2];
+    XEVDM_BL_MC_L        (*fn_bl_mc_l)[2];
+    XEVDM_ALF_CLS          fn_alf_cls_blk;
+    XEVDM_ALF_FLT          fn_alf_flt5_blk;
+    XEVDM_ALF_FLT          fn_alf_flt7_blk;
+    const XEVDM_DBK_ADDB (*fn_dbk_addb)[DBK_MAX];
+    const XEVDM_DBK_ADDB (*fn_dbk_addb_chroma)[DBK_MAX];
+
+    /* in-loop filtering by CTU rows while the picture is reconstructed
+       (XEVD_CFG_SET_LOOP_FILTER_PIPELINE) */
+    u8                      lf_pipe;
+    /* the current picture is filtered by CTU rows */
+    u8                      lf_pipe_on;
+    /* held by the thread running filter steps */
+    volatile s32            lf_pipe_lock;
+    /* next filter step, see lf_pipe_step(). written by the lock holder and
+       read by every reconstruction thread */
+    volatile s32            lf_pipe_step;
+    /* number of CTU rows known to be reconstructed */
+    volatile s32            lf_pipe_rows;
+    /* core used for deblocking of the rows */
+    XEVD_CORE             * lf_core;
+
+    /* slices of a picture are decoded together once all of them are
+       received (XEVD_CFG_SET_AU_MODE) */
+    u8                      au_mode;
+    XEVDM_AU_SLICE        * au_slice;
+    int                     au_slice_cnt;
+    int                     au_slice_max;
 };
 
 /* prototypes of internal functions */
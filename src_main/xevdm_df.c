@@ -569,16 +569,16 @@ static void deblock_line_check(u16 alpha, u8 beta, pel *p, pel* q, u8 *ap, u8 *a
     *aq = (XEVD_ABS(q[0] - q[2]) < beta) ? 1 : 0;
 }
 
-static pel deblock_line_normal_delta0(u8 c0, pel* p, pel* q)
+static s16 deblock_line_normal_delta0(u8 c0, pel* p, pel* q)
 {
     // This part of code wrote according to AdaptiveDeblocking Filter by P.List, and etc. IEEE transactions on circuits and ... Vol. 13, No. 7, 2003
     // and inconsists with code in JM 19.0
-    return XEVD_CLIP3(-(pel)c0, (pel)c0, (4 * (q[0] - p[0]) + p[1] - q[1] + 4) >> 3);
+    return XEVD_CLIP3(-(s16)c0, (s16)c0, (4 * (q[0] - p[0]) + p[1] - q[1] + 4) >> 3);
 }
 
-static pel deblock_line_normal_delta1(u8 c1, pel* x, pel* y)
+static s16 deblock_line_normal_delta1(u8 c1, pel* x, pel* y)
 {
-    return XEVD_CLIP3(-(pel)c1, (pel)c1, ((((x[2] + x[0] + y[0]) * 3) - 8 * x[1] - y[1])) >> 4);
+    return XEVD_CLIP3(-(s16)c1, (s16)c1, ((((x[2] + x[0] + y[0]) * 3) - 8 * x[1] - y[1])) >> 4);
 }
 
 static void deblock_scu_line_luma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
@@ -652,7 +652,7 @@ static void deblock_scu_line_luma(pel *buf, int stride, u8 bs, u16 alpha, u8 bet
         else
         {
             u8 c0;
-            pel delta0, delta1;
+            s16 delta0, delta1;
             int pel_max = (1 << (bit_depth_minus8 + 8)) - 1;
             c0 = c1 + ((ap + aq) << XEVD_MAX(0, (bit_depth_minus8 + 8) - 9));
 #if TRACE_DBF
@@ -754,7 +754,7 @@ static void deblock_scu_line_chroma(pel *buf, int stride, u8 bs, u16 alpha, u8 b
         }
         else
         {
-            pel delta0;
+            s16 delta0;
             int pel_max = (1 << (bit_depth_minus8+8)) - 1;
             delta0 = deblock_line_normal_delta0(c0, p, q);
             p_out[0] = XEVD_CLIP3(0, pel_max, p[0] + delta0);
@@ -779,45 +779,55 @@ static void deblock_scu_line_chroma(pel *buf, int stride, u8 bs, u16 alpha, u8 b
     XEVD_TRACE_STR("\n");
 #endif
 }
-static void deblock_scu_addb_ver_luma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+static void deblock_scu_addb_ver_luma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8, int size)
 {
     u8 i;
     pel *cur_buf = buf;
-    for (i = 0; i < MIN_CU_SIZE; ++i, cur_buf += stride)
+    for (i = 0; i < size; ++i, cur_buf += stride)
     {
         deblock_scu_line_luma(cur_buf, 1, bs, alpha, beta, c1, bit_depth_minus8);
     }
 }
-static void deblock_scu_addb_hor_luma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+static void deblock_scu_addb_hor_luma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8, int size)
 {
     u8 i;
     pel *cur_buf = buf;
-    for (i = 0; i < MIN_CU_SIZE; ++i, ++cur_buf)
+    for (i = 0; i < size; ++i, ++cur_buf)
     {
         deblock_scu_line_luma(cur_buf, stride, bs, alpha, beta, c1, bit_depth_minus8);
     }
 }
-static void deblock_scu_addb_ver_chroma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8, int chroma_format_idc)
+static void deblock_scu_addb_ver_chroma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8, int size)
 {
     u8 i;
     pel *cur_buf = buf;
-    int size = (MIN_CU_SIZE >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)));
-    for(i = 0; i <size; ++i, cur_buf += stride)
+    for(i = 0; i < size; ++i, cur_buf += stride)
     {
         deblock_scu_line_chroma(cur_buf, 1, bs, alpha, beta, c0, bit_depth_minus8);
     }
 }
-static void deblock_scu_addb_hor_chroma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8, int chroma_format_idc)
+static void deblock_scu_addb_hor_chroma(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8, int size)
 {
     u8 i;
     pel *cur_buf = buf;
-    int size = (MIN_CU_SIZE >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)));
     for(i = 0; i < size; ++i, ++cur_buf)
     {
         deblock_scu_line_chroma(cur_buf, stride, bs, alpha, beta, c0, bit_depth_minus8);
     }
 }
 
+const XEVDM_DBK_ADDB xevdm_tbl_dbk_addb[DBK_MAX] =
+{
+    deblock_scu_addb_ver_luma,
+    deblock_scu_addb_hor_luma
+};
+
+const XEVDM_DBK_ADDB xevdm_tbl_dbk_addb_chroma[DBK_MAX] =
+{
+    deblock_scu_addb_ver_chroma,
+    deblock_scu_addb_hor_chroma
+};
+
 static u32* deblock_set_coded_block(u32* map_scu, int w, int h, int w_scu)
 {
     int i, j;
@@ -832,7 +842,7 @@ static u32* deblock_set_coded_block(u32* map_scu, int w, int h, int w_scu)
     return map_scu;
 }
 
-static void deblock_addb_cu_hor(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, int cuh, u32 *map_scu, s8(*map_refi)[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D]
+static void deblock_addb_cu_hor(XEVDM_CTX *mctx, XEVD_PIC *pic, int x_pel, int y_pel, int cuw, int cuh, u32 *map_scu, s8(*map_refi)[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D]
                              , int w_scu, int log2_max_cuwh, XEVD_REFP(*refp)[REFP_NUM], int ats_inter_mode, TREE_CONS tree_cons, u8* map_tidx
                              , int boundary_filtering, u8* map_ats_inter, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 {
@@ -879,8 +889,12 @@ static void deblock_addb_cu_hor(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, in
 
     if (align_8_8_grid  && y_pel > 0 && (no_boundary))
     {
+        u8  bs[MAX_CU_SIZE >> MIN_CU_LOG2];
+        u32 bs_mask = 0;
 
-        for (i = 0; i < (cuw >> MIN_CU_LOG2); ++i)
+        /* derive the boundary strength of the whole edge first, then filter
+           only the SCUs having a non-zero one */
+        for (i = 0; i < w; ++i)
         {
 #if TRACE_DBF
             XEVD_TRACE_COUNTER;
@@ -896,14 +910,24 @@ static void deblock_addb_cu_hor(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, in
             XEVD_TRACE_INT(tree_cons.mode_cons);
             XEVD_TRACE_STR("\n");
 #endif
+            int cur_x_pel = x_pel + (i << MIN_CU_LOG2);
+            u8 ats_present = map_ats_inter[i] || map_ats_inter[i - w_scu];
+            bs[i] = get_bs(map_scu[i], cur_x_pel, y_pel, map_scu[i - w_scu], cur_x_pel, y_pel - 1, log2_max_cuwh, map_refi[i]
+                         , map_refi[i - w_scu], map_mv[i], map_mv[i - w_scu], refp, ats_present);
+            if (bs[i])
+            {
+                bs_mask |= (u32)1 << i;
+            }
+        }
 
+        for (i = 0; bs_mask; ++i, bs_mask >>= 1)
+        {
+            if (!(bs_mask & 1))
+            {
+                continue;
+            }
             t = (i << MIN_CU_LOG2);
-            int cur_x_pel = x_pel + t;
-            u8 current_ats = map_ats_inter[i];
-            u8 neighbor_ats = map_ats_inter[i - w_scu];
-            u8 ats_present = current_ats || neighbor_ats;
-            u8 bs_cur = get_bs(map_scu[i], cur_x_pel, y_pel, map_scu[i - w_scu], cur_x_pel, y_pel - 1, log2_max_cuwh, map_refi[i]
-                             , map_refi[i - w_scu], map_mv[i], map_mv[i - w_scu], refp, ats_present);
+            u8 bs_cur = bs[i];
             qp = (MCU_GET_QP(map_scu[i]) + MCU_GET_QP(map_scu[i - w_scu]) + 1) >> 1;
 
             indexA = get_index(qp, pic->pic_deblock_alpha_offset);            //! \todo Add offset for IndexA
@@ -915,7 +939,7 @@ static void deblock_addb_cu_hor(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, in
 
             if (xevd_check_luma_fn(tree_cons))
             {
-                deblock_scu_addb_hor_luma(y + t, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
+                (*mctx->fn_dbk_addb)[DBK_HOR](y + t, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8, MIN_CU_SIZE);
             }
             if(xevd_check_chroma_fn(tree_cons) && (chroma_format_idc != 0))
             {
@@ -927,7 +951,7 @@ static void deblock_addb_cu_hor(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, in
                 beta = BETA_TABLE[indexB] << bitdepth_scale;
                 c1 = CLIP_TAB[indexA][bs_cur];
                 c0 = (c1 + 1) << XEVD_MAX(0, (bit_depth_chroma - 9));
-                deblock_scu_addb_hor_chroma(u + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8, chroma_format_idc);
+                (*mctx->fn_dbk_addb_chroma)[DBK_HOR](u + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8, MIN_CU_SIZE >> w_shift);
 
                 int qp_v = XEVD_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
                 indexA = get_index(xevd_qp_chroma_dynamic[1][qp_v], pic->pic_deblock_alpha_offset);
@@ -936,7 +960,7 @@ static void deblock_addb_cu_hor(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, in
                 beta = BETA_TABLE[indexB] << bitdepth_scale;
                 c1 = CLIP_TAB[indexA][bs_cur];
                 c0 = (c1 + 1) << XEVD_MAX(0, (bit_depth_chroma - 9));
-                deblock_scu_addb_hor_chroma(v + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8, chroma_format_idc);
+                (*mctx->fn_dbk_addb_chroma)[DBK_HOR](v + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8, MIN_CU_SIZE >> w_shift);
             }
         }
     }
@@ -944,18 +968,25 @@ static void deblock_addb_cu_hor(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, in
     map_scu = deblock_set_coded_block(map_scu_tmp, w, h, w_scu);
 }
 
-static void deblock_addb_cu_ver_yuv(XEVD_PIC *pic, int x_pel, int y_pel, int log2_max_cuwh, pel *y, pel* u, pel *v, int s_l, int s_c, int cuh
+static void deblock_addb_cu_ver_yuv(XEVDM_CTX *mctx, XEVD_PIC *pic, int x_pel, int y_pel, int log2_max_cuwh, pel *y, pel* u, pel *v, int s_l, int s_c, int cuh
                                   , u32 *map_scu, s8(*map_refi)[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D], int w_scu, XEVD_REFP(*refp)[REFP_NUM]
                                   , int ats_inter_mode, TREE_CONS tree_cons, u8* map_ats_inter, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 {
-    int i, qp;
+    int i, j, qp;
     int h = cuh >> MIN_CU_LOG2;
     u8 indexA, indexB;
     u16 alpha;
     u8 beta;
     u8 c0, c1;
+    u8 bs[MAX_CU_SIZE >> MIN_CU_LOG2];
+    u32 bs_mask = 0;
     const int bitdepth_scale = (bit_depth_luma - 8);
-    for (i = 0; i < h; i++)
+    const int size_c = MIN_CU_SIZE >> XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc);
+    const int s_c_scu = s_c << (MIN_CU_LOG2 - XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc));
+
+    /* derive the boundary strength of the whole edge first, then filter
+       only the SCUs having a non-zero one */
+    for (i = 0, j = 0; i < h; i++, j += w_scu)
     {
 #if TRACE_DBF
         XEVD_TRACE_COUNTER;
@@ -971,69 +1002,65 @@ static void deblock_addb_cu_ver_yuv(XEVD_PIC *pic, int x_pel, int y_pel, int log
         XEVD_TRACE_INT(tree_cons.mode_cons);
         XEVD_TRACE_STR("\n");
 #endif
-
+        int cur_y_pel = y_pel + (i << MIN_CU_LOG2);
+        u8 ats_present = map_ats_inter[j] || map_ats_inter[j - 1];
+        bs[i] = get_bs(map_scu[j], x_pel, cur_y_pel, map_scu[j - 1], x_pel - 1, cur_y_pel, log2_max_cuwh
+                     , map_refi[j], map_refi[j - 1], map_mv[j], map_mv[j - 1], refp, ats_present);
+        if (bs[i])
         {
-            int cur_y_pel = y_pel + (i << MIN_CU_LOG2);
-            u8 current_ats = map_ats_inter[0];
-            u8 neighbor_ats = map_ats_inter[-1];
-            u8 ats_present = current_ats || neighbor_ats;
-            u8 bs_cur = get_bs(map_scu[0], x_pel, cur_y_pel, map_scu[-1], x_pel - 1, cur_y_pel, log2_max_cuwh
-                             , map_refi[0], map_refi[-1], map_mv[0], map_mv[-1], refp, ats_present);
-            qp = (MCU_GET_QP(map_scu[0]) + MCU_GET_QP(map_scu[-1]) + 1) >> 1;
-
-            //neb_w = 1 << MCU_GET_LOGW(map_cu[-1]);
+            bs_mask |= (u32)1 << i;
+        }
+    }
 
-            if (xevd_check_luma_fn(tree_cons))
-            {
-                indexA = get_index(qp, pic->pic_deblock_alpha_offset);            //! \todo Add offset for IndexA
-                indexB = get_index(qp, pic->pic_deblock_beta_offset);            //! \todo Add offset for IndexB
+    for (i = 0; bs_mask; i++, bs_mask >>= 1, y += (s_l << MIN_CU_LOG2), u += s_c_scu, v += s_c_scu, map_scu += w_scu)
+    {
+        u8 bs_cur = bs[i];
+        if (!(bs_mask & 1))
+        {
+            continue;
+        }
+        qp = (MCU_GET_QP(map_scu[0]) + MCU_GET_QP(map_scu[-1]) + 1) >> 1;
 
-                alpha = ALPHA_TABLE[indexA] << bitdepth_scale;
-                beta = BETA_TABLE[indexB] << bitdepth_scale;
-                c1 = CLIP_TAB[indexA][bs_cur] << XEVD_MAX(0, (bit_depth_luma - 9));
+        if (xevd_check_luma_fn(tree_cons))
+        {
+            indexA = get_index(qp, pic->pic_deblock_alpha_offset);            //! \todo Add offset for IndexA
+            indexB = get_index(qp, pic->pic_deblock_beta_offset);            //! \todo Add offset for IndexB
 
-                deblock_scu_addb_ver_luma(y, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
-            }
-            if(xevd_check_chroma_fn(tree_cons) && (chroma_format_idc != 0))
-            {
-                int qp_u = XEVD_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
-                indexA = get_index(xevd_qp_chroma_dynamic[0][qp_u], pic->pic_deblock_alpha_offset);
-                indexB = get_index(xevd_qp_chroma_dynamic[0][qp_u], pic->pic_deblock_beta_offset);
+            alpha = ALPHA_TABLE[indexA] << bitdepth_scale;
+            beta = BETA_TABLE[indexB] << bitdepth_scale;
+            c1 = CLIP_TAB[indexA][bs_cur] << XEVD_MAX(0, (bit_depth_luma - 9));
 
-                alpha = ALPHA_TABLE[indexA] << bitdepth_scale;
-                beta = BETA_TABLE[indexB] << bitdepth_scale;
+            (*mctx->fn_dbk_addb)[DBK_VER](y, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8, MIN_CU_SIZE);
+        }
+        if(xevd_check_chroma_fn(tree_cons) && (chroma_format_idc != 0))
+        {
+            int qp_u = XEVD_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
+            indexA = get_index(xevd_qp_chroma_dynamic[0][qp_u], pic->pic_deblock_alpha_offset);
+            indexB = get_index(xevd_qp_chroma_dynamic[0][qp_u], pic->pic_deblock_beta_offset);
 
-                c1 = CLIP_TAB[indexA][bs_cur];
-                c0 = (c1 + 1) << XEVD_MAX(0, (bit_depth_chroma - 9));
-                deblock_scu_addb_ver_chroma(u, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8, chroma_format_idc);
+            alpha = ALPHA_TABLE[indexA] << bitdepth_scale;
+            beta = BETA_TABLE[indexB] << bitdepth_scale;
 
-                int qp_v = XEVD_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
-                indexA = get_index(xevd_qp_chroma_dynamic[1][qp_v], pic->pic_deblock_alpha_offset);
-                indexB = get_index(xevd_qp_chroma_dynamic[1][qp_v], pic->pic_deblock_beta_offset);
+            c1 = CLIP_TAB[indexA][bs_cur];
+            c0 = (c1 + 1) << XEVD_MAX(0, (bit_depth_chroma - 9));
+            (*mctx->fn_dbk_addb_chroma)[DBK_VER](u, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8, size_c);
 
-                alpha = ALPHA_TABLE[indexA] << bitdepth_scale;
-                beta = BETA_TABLE[indexB] << bitdepth_scale;
+            int qp_v = XEVD_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
+            indexA = get_index(xevd_qp_chroma_dynamic[1][qp_v], pic->pic_deblock_alpha_offset);
+            indexB = get_index(xevd_qp_chroma_dynamic[1][qp_v], pic->pic_deblock_beta_offset);
 
-                c1 = CLIP_TAB[indexA][bs_cur];
-                c0 = (c1 + 1) << XEVD_MAX(0, (bit_depth_chroma - 9));
+            alpha = ALPHA_TABLE[indexA] << bitdepth_scale;
+            beta = BETA_TABLE[indexB] << bitdepth_scale;
 
-                deblock_scu_addb_ver_chroma(v, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8, chroma_format_idc);
-            }
+            c1 = CLIP_TAB[indexA][bs_cur];
+            c0 = (c1 + 1) << XEVD_MAX(0, (bit_depth_chroma - 9));
 
-            y += (s_l << MIN_CU_LOG2);
-            u += (s_c << (MIN_CU_LOG2 - (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))));
-            v += (s_c << (MIN_CU_LOG2 - (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))));
-            map_scu += w_scu;
-            map_refi += w_scu;
-            map_mv += w_scu;
-            map_ats_inter += w_scu;
-            //map_cu += w_scu;
+            (*mctx->fn_dbk_addb_chroma)[DBK_VER](v, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8, size_c);
         }
     }
-
 }
 
-static void deblock_addb_cu_ver(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, int cuh, u32 *map_scu, s8(*map_refi)[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D]
+static void deblock_addb_cu_ver(XEVDM_CTX *mctx, XEVD_PIC *pic, int x_pel, int y_pel, int cuw, int cuh, u32 *map_scu, s8(*map_refi)[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D]
                               , int w_scu, int log2_max_cuwh, u32  *map_cu, XEVD_REFP(*refp)[REFP_NUM], int ats_inter_mode, TREE_CONS tree_cons, u8* map_tidx
                               , int boundary_filtering, u8* map_ats_inter, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 {
@@ -1090,7 +1117,7 @@ static void deblock_addb_cu_ver(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, in
 
     if (align_8_8_grid && x_pel > 0 && MCU_GET_COD(map_scu[-1]) && (no_boundary))
     {
-        deblock_addb_cu_ver_yuv(pic, x_pel, y_pel, log2_max_cuwh, y, u, v, s_l, s_c, cuh, map_scu, map_refi, map_mv, w_scu, refp, ats_inter_mode
+        deblock_addb_cu_ver_yuv(mctx, pic, x_pel, y_pel, log2_max_cuwh, y, u, v, s_l, s_c, cuh, map_scu, map_refi, map_mv, w_scu, refp, ats_inter_mode
                               , tree_cons, map_ats_inter, bit_depth_luma, bit_depth_chroma, chroma_format_idc);
     }
 
@@ -1127,7 +1154,7 @@ static void deblock_addb_cu_ver(XEVD_PIC *pic, int x_pel, int y_pel, int cuw, in
         map_refi += w;
         map_mv += w;
         map_ats_inter += w;
-        deblock_addb_cu_ver_yuv(pic, x_pel + cuw, y_pel, log2_max_cuwh, y, u, v, s_l, s_c, cuh, map_scu, map_refi, map_mv, w_scu, refp, ats_inter_mode
+        deblock_addb_cu_ver_yuv(mctx, pic, x_pel + cuw, y_pel, log2_max_cuwh, y, u, v, s_l, s_c, cuh, map_scu, map_refi, map_mv, w_scu, refp, ats_inter_mode
                               , tree_cons, map_ats_inter, bit_depth_luma, bit_depth_chroma, chroma_format_idc);
     }
 
@@ -1138,11 +1165,12 @@ void xevdm_deblock_cu_hor(  XEVD_CTX *ctx, XEVD_PIC *pic, int x_pel, int y_pel,
                        , int w_scu, int log2_max_cuwh, XEVD_REFP(*refp)[REFP_NUM], int ats_inter_mode, TREE_CONS tree_cons, u8* map_tidx
                         , int boundary_filtering, int tool_addb, u8* map_ats_inter, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 
-  
 {
+    XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+
     if (ctx->sps->tool_addb)
     {
-        deblock_addb_cu_hor(pic, x_pel, y_pel, cuw, cuh, map_scu, map_refi, map_mv, w_scu, log2_max_cuwh, refp, ats_inter_mode, tree_cons
+        deblock_addb_cu_hor(mctx, pic, x_pel, y_pel, cuw, cuh, map_scu, map_refi, map_mv, w_scu, log2_max_cuwh, refp, ats_inter_mode, tree_cons
                            , map_tidx, boundary_filtering, map_ats_inter, bit_depth_luma, bit_depth_chroma, chroma_format_idc);
     }
     else
@@ -1155,9 +1183,11 @@ void xevdm_deblock_cu_ver(XEVD_CTX *ctx, XEVD_PIC *pic, int x_pel, int y_pel, in
                         , int w_scu, int log2_max_cuwh, u32  *map_cu, XEVD_REFP(*refp)[REFP_NUM], int ats_inter_mode, TREE_CONS tree_cons, u8* map_tidx
                         , int boundary_filtering, int tool_addb, u8* map_ats_inter, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
 {
+    XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
+
     if (tool_addb)
     {
-        deblock_addb_cu_ver(pic, x_pel, y_pel, cuw, cuh, map_scu, map_refi, map_mv, w_scu, log2_max_cuwh, map_cu, refp, ats_inter_mode
+        deblock_addb_cu_ver(mctx, pic, x_pel, y_pel, cuw, cuh, map_scu, map_refi, map_mv, w_scu, log2_max_cuwh, map_cu, refp, ats_inter_mode
                           , tree_cons, map_tidx, boundary_filtering, map_ats_inter, bit_depth_luma, bit_depth_chroma, chroma_format_idc);
     }
     else
@@ -37,6 +37,12 @@
 #define _XEVDM_DF_H_
 #include "xevd_df.h"
 
+extern const XEVDM_DBK_ADDB xevdm_tbl_dbk_addb[DBK_MAX];
+extern const XEVDM_DBK_ADDB xevdm_tbl_dbk_addb_chroma[DBK_MAX];
+#if X86_SSE
+#include "xevdm_df_sse.h"
+#endif
+
 
 void xevdm_deblock_cu_hor(XEVD_CTX *ctx, XEVD_PIC *pic, int x_pel, int y_pel, int cuw, int cuh, u32 *map_scu, s8(*map_refi)[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D], int w_scu, int log2_max_cuwh, XEVD_REFP(*refp)[REFP_NUM]
                         , int ats_inter_mode, TREE_CONS tree_cons, u8* map_tidx, int boundary_filtering, int tool_addb, u8* map_ats_inter, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc);
@@ -269,85 +269,82 @@ void xevd_init_dra(DRA_CONTROL *dra_mapping, int bit_depth)
 }
 
 /* DRA applicaton (sample processing) functions are listed below: */
+void xevd_apply_dra_luma_row(pel *dst, pel *src, int w, const int *lut)
+{
+    int k;
+
+    for (k = 0; k < w; k++)
+    {
+        dst[k] = (pel)lut[src[k]];
+    }
+}
 void xevd_apply_dra_luma_plane(XEVD_IMGB * dst, XEVD_IMGB * src, DRA_CONTROL *dra_mapping, int plane_id, int backward_map)
 {
-    short* src_plane;
-    short* dst_plane;
-    short src_value, dst_value;
-    int i, k, j;
+    pel* src_plane;
+    pel* dst_plane;
+    const int* lut;
+    int i, j;
 
+    lut = (backward_map == TRUE) ? dra_mapping->luma_inv_scale_lut : dra_mapping->luma_scale_lut;
     for (i = plane_id; i <= plane_id; i++)
     {
-        src_plane = (short*)src->a[i];
-        dst_plane = (short*)dst->a[i];
+        src_plane = (pel*)src->a[i];
+        dst_plane = (pel*)dst->a[i];
         for (j = 0; j < src->h[i]; j++)
         {
-            for (k = 0; k < src->w[i]; k++)
-            {
-                src_value = src_plane[k];
-
-                dst_value = dst_plane[k];
-                if (backward_map == TRUE)
-                    dst_value = dra_mapping->luma_inv_scale_lut[src_value];
-                else
-                    dst_value = dra_mapping->luma_scale_lut[src_value];
-                dst_plane[k] = dst_value;
-            }
-            src_plane = (short*)((unsigned char *)src_plane + src->s[i]);
-            dst_plane = (short*)((unsigned char *)dst_plane + dst->s[i]);
+            xevd_apply_dra_luma_row(dst_plane, src_plane, src->w[i], lut);
+            src_plane = (pel*)((unsigned char *)src_plane + src->s[i]);
+            dst_plane = (pel*)((unsigned char *)dst_plane + dst->s[i]);
         }
     }
 }
-void xevd_apply_dra_chroma_plane(XEVD_IMGB * dst, XEVD_IMGB * src, DRA_CONTROL *dra_mapping, int plane_id, int backward_map)
+/* ref is the luma row of the chroma row src, sampled every 1 << c_shift */
+void xevd_apply_dra_chroma_row(pel *dst, pel *src, pel *ref, int w, int c_shift, const int *lut)
 {
     int round_offset = 1 << (DRA_INVSCALE_NUMFBITS - 1);
     int offset_value = 0;
     int int_scale = 1;
-    double scale = 0;
+    short ref_value, src_value;
+    int k;
 
-    short* ref_plane;
-    short* src_plane;
-    short* dst_plane;
-    short ref_value, src_value, dst_value;
-    int i, k, j;
+    for (k = 0; k < w; k++)
+    {
+        ref_value = ref[k << c_shift];
+        ref_value = (ref_value < 0) ? 0 : ref_value;
+        src_value = src[k] - 512;
+        int_scale = lut[ref_value];
+        offset_value = (src_value < 0) ? -src_value : src_value;
+        offset_value = (offset_value * int_scale + round_offset) >> DRA_INVSCALE_NUMFBITS;
+        if (src_value < 0)
+        {
+            offset_value *= -1;
+        }
+        dst[k] = (pel)(512 + offset_value);
+    }
+}
+void xevd_apply_dra_chroma_plane(XEVD_IMGB * dst, XEVD_IMGB * src, DRA_CONTROL *dra_mapping, int plane_id, int backward_map)
+{
+    pel* ref_plane;
+    pel* src_plane;
+    pel* dst_plane;
+    const int* lut;
+    int i, j;
     int c_shift = (plane_id == 0) ? 0 : 1;
 
     for (i = plane_id; i <= plane_id; i++)
     {
-        ref_plane = (short*)src->a[0]; //luma reference
-        src_plane = (short*)src->a[i];
-        dst_plane = (short*)dst->a[i];
+        ref_plane = (pel*)src->a[0]; //luma reference
+        src_plane = (pel*)src->a[i];
+        dst_plane = (pel*)dst->a[i];
+        lut = (backward_map == TRUE) ? dra_mapping->int_chroma_inv_scale_lut[i - 1] : dra_mapping->int_chroma_scale_lut[i - 1];
 
         for (j = 0; j < src->h[i]; j++)
         {
-            for (k = 0; k < src->w[i]; k++)
-            {
-                ref_value = ref_plane[k << c_shift];
-                ref_value = (ref_value < 0) ? 0 : ref_value;
-                src_value = src_plane[k];
-                dst_value = dst_plane[k];
-                src_value = src_value - 512;
-                offset_value = src_value;
-                if (backward_map == TRUE)
-                    int_scale = (dra_mapping->int_chroma_inv_scale_lut[i - 1][ref_value]);
-                else
-                    int_scale = (dra_mapping->int_chroma_scale_lut[i - 1][ref_value]);
-                if (src_value < 0)
-                {
-                    offset_value *= -1;
-                }
-                offset_value = (offset_value * int_scale + round_offset) >> DRA_INVSCALE_NUMFBITS;
-                if (src_value < 0)
-                {
-                    offset_value *= -1;
-                }
-                dst_value = 512 + offset_value;
-
-                dst_plane[k] = dst_value;
-            }
-            ref_plane = (short*)((unsigned char *)ref_plane + (dst->s[0] << c_shift));
-            src_plane = (short*)((unsigned char *)src_plane + src->s[i]);
-            dst_plane = (short*)((unsigned char *)dst_plane + dst->s[i]);
+            xevd_apply_dra_chroma_row(dst_plane, src_plane, ref_plane, src->w[i], c_shift, lut);
+            /* the luma reference is read from src, also when dst differs */
+            ref_plane = (pel*)((unsigned char *)ref_plane + (src->s[0] << c_shift));
+            src_plane = (pel*)((unsigned char *)src_plane + src->s[i]);
+            dst_plane = (pel*)((unsigned char *)dst_plane + dst->s[i]);
         }
     }
 }
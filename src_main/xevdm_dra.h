@@ -130,6 +130,8 @@ typedef struct _DRA_CONTROL
 void xevd_init_dra(DRA_CONTROL *dra_mapping, int bit_depth);
 
 /* DRA applicaton (sample processing) functions are listed below: */
+void xevd_apply_dra_luma_row(pel *dst, pel *src, int w, const int *lut);
+void xevd_apply_dra_chroma_row(pel *dst, pel *src, pel *ref, int w, int c_shift, const int *lut);
 void xevd_apply_dra_luma_plane(XEVD_IMGB * dst, XEVD_IMGB * src, DRA_CONTROL *dra_mapping, int plane_id, int backward_map);
 void xevd_apply_dra_chroma_plane(XEVD_IMGB * dst, XEVD_IMGB * src, DRA_CONTROL *dra_mapping, int plane_id, int backward_map);
 
@@ -42,7 +42,7 @@
 
 static u32 sbac_decode_bin_ep(XEVD_BSR * bs, XEVD_SBAC * sbac)
 {
-    u32 bin, t0;
+    u32 bin;
 
     sbac->range >>= 1;
 
@@ -57,32 +57,11 @@ static u32 sbac_decode_bin_ep(XEVD_BSR * bs, XEVD_SBAC * sbac)
     }
 
     sbac->range <<= 1;
-#if TRACE_HLS
-    xevd_bsr_read1_trace(bs, &t0, 0);
-#else
-    xevd_bsr_read1(bs, &t0);
-#endif
-    sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
+    sbac->value = ((sbac->value << 1) | xevd_bsr_read_bits(bs, 1)) & 0xFFFF;
 
     return bin;
 }
 
-static u32 sbac_decode_bins_ep(XEVD_BSR *bs, XEVD_SBAC *sbac, int num_bin)
-{
-    int bin = 0;
-    u32 value = 0;
-
-    for(bin = num_bin - 1; bin >= 0; bin--)
-    {
-        if(sbac_decode_bin_ep(bs, sbac))
-        {
-            value += (1 << bin);
-        }
-    }
-
-    return value;
-}
-
 static u32 sbac_read_unary_sym(XEVD_BSR * bs, XEVD_SBAC * sbac, SBAC_CTX_MODEL * model, u32 num_ctx)
 {
     u32 ctx_idx = 0;
@@ -435,26 +414,16 @@ static void xevdm_parse_positionLastXY(XEVD_BSR *bs, XEVD_SBAC *sbac, int* last_
     // last_sig_coeff_x_suffix
     if (pos_x > 3)
     {
-        tmp = 0;
         cnt = (pos_x - 2) >> 1;
-        for (i = cnt - 1; i >= 0; i--)
-        {
-            last = sbac_decode_bin_ep(bs, sbac);
-            tmp += last << i;
-        }
+        tmp = xevd_sbac_decode_bins_ep(bs, sbac, cnt);
 
         pos_x = g_min_in_group[pos_x] + tmp;
     }
     // last_sig_coeff_y_suffix
     if (pos_y > 3)
     {
-        tmp = 0;
         cnt = (pos_y - 2) >> 1;
-        for (i = cnt - 1; i >= 0; i--)
-        {
-            last = sbac_decode_bin_ep(bs, sbac);
-            tmp += last << i;
-        }
+        tmp = xevd_sbac_decode_bins_ep(bs, sbac, cnt);
         pos_y = g_min_in_group[pos_y] + tmp;
     }
 
@@ -467,23 +436,15 @@ static int xevdm_parse_coef_remain_exgolomb(XEVD_BSR *bs, XEVD_SBAC *sbac, int r
     int prefix = 0;
     int code_word = 0;
 
-    do
-    {
-        prefix++;
-        code_word = sbac_decode_bin_ep(bs, sbac);
-    } while (code_word);
-
-    code_word = 1 - code_word;
-    prefix -= code_word;
-    code_word = 0;
+    prefix = xevd_sbac_decode_unary_ep(bs, sbac, 0, (u32)-1);
     if (prefix < g_go_rice_range[rparam])
     {
-        code_word = sbac_decode_bins_ep(bs, sbac, rparam);
+        code_word = xevd_sbac_decode_bins_ep(bs, sbac, rparam);
         symbol = (prefix << rparam) + code_word;
     }
     else
     {
-        code_word = sbac_decode_bins_ep(bs, sbac, prefix - g_go_rice_range[rparam] + rparam);
+        code_word = xevd_sbac_decode_bins_ep(bs, sbac, prefix - g_go_rice_range[rparam] + rparam);
         symbol = (((1 << (prefix - g_go_rice_range[rparam])) + g_go_rice_range[rparam] - 1) << rparam) + code_word;
     }
 
@@ -675,7 +636,7 @@ static int xevdm_eco_adcc(XEVD_CTX * ctx, XEVD_BSR *bs, XEVD_SBAC *sbac, s16 *co
                         }
                     }
                 }
-                coef_signs_group = sbac_decode_bins_ep(bs, sbac, num_nz);
+                coef_signs_group = xevd_sbac_decode_bins_ep(bs, sbac, num_nz);
                 coef_signs_group <<= 32 - num_nz;
 
                 for (idx = 0; idx < num_nz; idx++)
@@ -768,12 +729,11 @@ void xevdm_eco_mmvd_data(XEVD_CTX * ctx, XEVD_CORE * core)
 {
     XEVD_SBAC *sbac;
     XEVD_BSR   *bs;
-    XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
-    int        type = mctx->sh.mmvd_group_enable_flag && !(1 << (core->log2_cuw + core->log2_cuh) <= NUM_SAMPLES_BLOCK);
+    XEVDM_CORE * mcore = (XEVDM_CORE *)core;
+    int        type = mcore->msh->mmvd_group_enable_flag && !(1 << (core->log2_cuw + core->log2_cuh) <= NUM_SAMPLES_BLOCK);
     int        parse_idx = 0;
     int        temp = 0;
     int        temp_t;
-    XEVDM_CORE * mcore = (XEVDM_CORE *)core;
     bs = core->bs;
     sbac = GET_SBAC_DEC(bs);
 
@@ -894,8 +854,8 @@ int xevdm_eco_coef(XEVD_CTX * ctx, XEVD_CORE * core)
                 core->qp = GET_QP(ctx->tile[core->tile_num].qp_prev_eco, dqp);
                 core->qp_y = GET_LUMA_QP(core->qp, ctx->sps->bit_depth_luma_minus8);
             }
-            qp_i_cb = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + ctx->sh.qp_u_offset);
-            qp_i_cr = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + ctx->sh.qp_v_offset);
+            qp_i_cb = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + core->sh->qp_u_offset);
+            qp_i_cr = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + core->sh->qp_v_offset);
             core->qp_u = xevd_qp_chroma_dynamic[0][qp_i_cb] + 6 * ctx->sps->bit_depth_chroma_minus8;
             core->qp_v = xevd_qp_chroma_dynamic[1][qp_i_cr] + 6 * ctx->sps->bit_depth_chroma_minus8;
 
@@ -986,23 +946,13 @@ int xevdm_eco_coef(XEVD_CTX * ctx, XEVD_CORE * core)
 void xevdm_eco_sbac_reset(XEVD_BSR * bs, u8 slice_type, u8 slice_qp, int sps_cm_init_flag)
 {
     int i;
-    u32 t0;
     XEVD_SBAC    * sbac;
     XEVD_SBAC_CTX * sbac_ctx;
     sbac = GET_SBAC_DEC(bs);
     sbac_ctx = &sbac->ctx;
     /* Initialization of the internal variables */
     sbac->range = 16384;
-    sbac->value = 0;
-    for(i = 0; i < 14; i++)
-    {
-#if TRACE_HLS
-        xevd_bsr_read1_trace(bs, &t0, 0);
-#else
-        xevd_bsr_read1(bs, &t0);
-#endif
-        sbac->value = ((sbac->value << 1) | t0) & 0xFFFF;
-    }
+    sbac->value = xevd_bsr_read_bits(bs, 14);
 
     xevd_mset(sbac_ctx, 0x00, sizeof(XEVD_SBAC_CTX));
 
@@ -1149,7 +1099,7 @@ void xevdm_eco_inter_pred_idc(XEVD_CTX * ctx, XEVD_CORE * core)
     bs = core->bs;
     sbac = GET_SBAC_DEC(bs);
 
-    if (xevdm_check_bi_applicability(ctx->sh.slice_type, 1 << core->log2_cuw, 1 << core->log2_cuh, ctx->sps->tool_admvp))
+    if (xevdm_check_bi_applicability(core->sh->slice_type, 1 << core->log2_cuw, 1 << core->log2_cuh, ctx->sps->tool_admvp))
     {
         tmp = xevd_sbac_decode_bin(bs, sbac, sbac->ctx.inter_dir);
     }
@@ -1503,7 +1453,7 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
     }
 
 
-    xevdm_get_ctx_some_flags(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->map_scu, ctx->cod_eco, ctx->map_cu_mode, core->ctx_flags, ctx->sh.slice_type, ctx->sps->tool_cm_init
+    xevdm_get_ctx_some_flags(core->x_scu, core->y_scu, cuw, cuh, ctx->w_scu, ctx->map_scu, ctx->cod_eco, ctx->map_cu_mode, core->ctx_flags, core->sh->slice_type, ctx->sps->tool_cm_init
                          , ctx->sps->ibc_flag, ctx->sps->ibc_log_max_size, ctx->map_tidx, 1);
 
     if ( !xevd_check_only_intra(ctx, core) )
@@ -1540,7 +1490,7 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
                 if(!ctx->sps->tool_admvp)
                 {
                     core->mvp_idx[REFP_0] = xevd_eco_mvp_idx(bs, sbac);
-                    if(ctx->sh.slice_type == SLICE_B)
+                    if(core->sh->slice_type == SLICE_B)
                     {
                         core->mvp_idx[REFP_1] = xevd_eco_mvp_idx(bs, sbac);
                     }
@@ -1561,8 +1511,8 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
             int qp_i_cb, qp_i_cr;
             core->qp = ctx->tile[core->tile_num].qp_prev_eco;
             core->qp_y = GET_LUMA_QP(core->qp, ctx->sps->bit_depth_luma_minus8);
-            qp_i_cb = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + ctx->sh.qp_u_offset);
-            qp_i_cr = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + ctx->sh.qp_v_offset);
+            qp_i_cb = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + core->sh->qp_u_offset);
+            qp_i_cr = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + core->sh->qp_v_offset);
             core->qp_u = xevd_qp_chroma_dynamic[0][qp_i_cb] + 6 * ctx->sps->bit_depth_chroma_minus8;
             core->qp_v = xevd_qp_chroma_dynamic[1][qp_i_cr] + 6 * ctx->sps->bit_depth_chroma_minus8;
         }
@@ -1570,10 +1520,10 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
         {
 
             int qp_i_cb, qp_i_cr;
-            core->qp = ctx->sh.qp;
+            core->qp = core->sh->qp;
             core->qp_y = GET_LUMA_QP(core->qp, ctx->sps->bit_depth_luma_minus8);
-            qp_i_cb = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + ctx->sh.qp_u_offset);
-            qp_i_cr = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + ctx->sh.qp_v_offset);
+            qp_i_cb = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + core->sh->qp_u_offset);
+            qp_i_cr = XEVD_CLIP3(-6 * ctx->sps->bit_depth_chroma_minus8, 57, core->qp + core->sh->qp_v_offset);
             core->qp_u = xevd_qp_chroma_dynamic[0][qp_i_cb] + 6 * ctx->sps->bit_depth_chroma_minus8;
             core->qp_v = xevd_qp_chroma_dynamic[1][qp_i_cr] + 6 * ctx->sps->bit_depth_chroma_minus8;
         }
@@ -1595,7 +1545,7 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
 #endif
             }
 
-            if (ctx->sh.slice_type == SLICE_B && ctx->sps->tool_admvp == 0)
+            if (core->sh->slice_type == SLICE_B && ctx->sps->tool_admvp == 0)
             {
                 xevd_eco_direct_mode_flag(ctx, core);
             }
@@ -1641,7 +1591,7 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
             }
             else
             {
-                if (ctx->sh.slice_type == SLICE_B)
+                if (core->sh->slice_type == SLICE_B)
                 {
                 xevdm_eco_inter_pred_idc(ctx, core); /* inter_pred_idc */
                 }
@@ -1660,7 +1610,7 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
                         if (((core->inter_dir + 1) >> inter_dir_idx) & 1)
                         {
                             XEVDM_CTX *mctx = (XEVDM_CTX *)ctx;
-                            core->refi[inter_dir_idx] = xevd_eco_refi(bs, sbac, mctx->dpm.num_refp[inter_dir_idx]);
+                            core->refi[inter_dir_idx] = xevd_eco_refi(bs, sbac, core->num_refp[inter_dir_idx]);
                             core->mvp_idx[inter_dir_idx] = xevdm_eco_affine_mvp_idx(bs, sbac);
                             mcore->affine_bzero[inter_dir_idx] = xevdm_eco_affine_mvd_flag(ctx, core, inter_dir_idx);
 
@@ -1700,7 +1650,7 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
                             if (ctx->sps->tool_admvp == 0)
                             {
 
-                                core->refi[inter_dir_idx] = xevd_eco_refi(bs, sbac, mctx->dpm.num_refp[inter_dir_idx]);
+                                core->refi[inter_dir_idx] = xevd_eco_refi(bs, sbac, core->num_refp[inter_dir_idx]);
                                 core->mvp_idx[inter_dir_idx] = xevd_eco_mvp_idx(bs, sbac);
                                 xevd_eco_get_mvd(bs, sbac, core->mvd[inter_dir_idx]);
                             }
@@ -1708,7 +1658,7 @@ int xevdm_eco_cu(XEVD_CTX * ctx, XEVD_CORE * core)
                             {
                                 if (core->bi_idx != BI_FL0 && core->bi_idx != BI_FL1)
                                 {
-                                    core->refi[inter_dir_idx] = xevd_eco_refi(bs, sbac, mctx->dpm.num_refp[inter_dir_idx]);
+                                    core->refi[inter_dir_idx] = xevd_eco_refi(bs, sbac, core->num_refp[inter_dir_idx]);
                                 }
                                 if (core->bi_idx != BI_FL0 + inter_dir_idx)
                                 {
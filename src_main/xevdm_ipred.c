@@ -71,7 +71,7 @@ void xevdm_get_nbr(int x, int y, int cuw, int cuh, pel *src, int s_src, u16 avai
         }
         else
         {
-            xevd_mset_16b(up + i * unit_size, up[i * unit_size - 1], unit_size);
+            xevd_mset_pel(up + i * unit_size, up[i * unit_size - 1], unit_size);
         }
     }
 
@@ -86,13 +86,13 @@ void xevdm_get_nbr(int x, int y, int cuw, int cuh, pel *src, int s_src, u16 avai
             }
             else
             {
-                xevd_mset_16b(up - (i + 1) * unit_size, up[-i * unit_size], unit_size);
+                xevd_mset_pel(up - (i + 1) * unit_size, up[-i * unit_size], unit_size);
             }
         }
     }
     else
     {
-        xevd_mset_16b(up - cuh, up[0], cuh);
+        xevd_mset_pel(up - cuh, up[0], cuh);
     }
 
     src--;
@@ -112,7 +112,7 @@ void xevdm_get_nbr(int x, int y, int cuw, int cuh, pel *src, int s_src, u16 avai
         }
         else
         {
-            xevd_mset_16b(left + i * unit_size, left[i * unit_size - 1], unit_size);
+            xevd_mset_pel(left + i * unit_size, left[i * unit_size - 1], unit_size);
             src += (s_src * unit_size);
         }
     }
@@ -139,7 +139,7 @@ void xevdm_get_nbr(int x, int y, int cuw, int cuh, pel *src, int s_src, u16 avai
         }
         else
         {
-            xevd_mset_16b(right + i * unit_size, right[i * unit_size - 1], unit_size);
+            xevd_mset_pel(right + i * unit_size, right[i * unit_size - 1], unit_size);
             src += (s_src * unit_size);
         }
     }
@@ -238,7 +238,7 @@ void xevdm_ipred_dc(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *ds
 
 /* intra prediction for baseline profile */
 
-void xevdm_ipred(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int ipm, int w, int h, int bit_depth)
+void xevdm_ipred(XEVD_CTX * ctx, pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int ipm, int w, int h, int bit_depth)
 {
     switch(ipm)
     {
@@ -252,19 +252,19 @@ void xevdm_ipred(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst,
             xevdm_ipred_dc(src_le, src_up, src_ri, avail_lr, dst, w, h);
             break;
         case IPD_PLN:
-            xevd_ipred_plane(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+            ctx->fn_ipred_plane(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
 
         case IPD_BI:
-            xevd_ipred_bi(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+            ctx->fn_ipred_bi(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         default:
-            ipred_ang(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+            ctx->fn_ipred_ang(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
             break;
     }
 }
 
-void xevdm_ipred_uv(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int ipm_c, int ipm, int w, int h, int bit_depth)
+void xevdm_ipred_uv(XEVD_CTX * ctx, pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int ipm_c, int ipm, int w, int h, int bit_depth)
 {
     if(ipm_c == IPD_DM_C && XEVD_IPRED_CHK_CONV(ipm))
     {
@@ -277,10 +277,10 @@ void xevdm_ipred_uv(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *ds
             switch(ipm)
             {
                 case IPD_PLN:
-                    xevd_ipred_plane(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+                    ctx->fn_ipred_plane(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
                     break;
                 default:
-                    ipred_ang(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+                    ctx->fn_ipred_ang(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
                     break;
             }
             break;
@@ -296,7 +296,7 @@ void xevdm_ipred_uv(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *ds
             break;
 
         case IPD_BI_C:
-            xevd_ipred_bi(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
+            ctx->fn_ipred_bi(src_le, src_up, src_ri, avail_lr, dst, w, h, bit_depth);
             break;
         default:
             xevd_trace("\n illegal chroma intra prediction mode\n");
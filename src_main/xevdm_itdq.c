@@ -70,13 +70,11 @@ INV_TRANS *xevdm_itrans_map_tbl[16][5] =
     { NULL, xevdm_itrans_ats_intra_DCT8_B4, xevdm_itrans_ats_intra_DCT8_B8, xevdm_itrans_ats_intra_DCT8_B16, xevdm_itrans_ats_intra_DCT8_B32 },
     { NULL, xevdm_itrans_ats_intra_DST7_B4, xevdm_itrans_ats_intra_DST7_B8, xevdm_itrans_ats_intra_DST7_B16, xevdm_itrans_ats_intra_DST7_B32 },
 };
-INV_TRANS *(*xevd_func_itrans)[5];
-void xevdm_itrans_ats_intra(s16 *coef, int log2_cuw, int log2_cuh, u8 ats_mode, int skip_w, int skip_h
+void xevdm_itrans_ats_intra(XEVD_CTX * ctx, s16 *coef, int log2_cuw, int log2_cuh, u8 ats_mode, int skip_w, int skip_h
     , int bit_depth
 
 );
 
-XEVD_ITX(*xevdm_fn_itx)[MAX_TR_LOG2];
 
 void xevdm_init_multi_tbl()
 {
@@ -158,7 +156,7 @@ void xevd_init_multi_inv_tbl()
     }
 }
 
-void xevdm_it_MxN_ats_intra(s16 *coef, int tuw, int tuh, int bit_depth, const int max_log2_tr_dynamic_range, u8 ats_intra_tridx, int skip_w, int skip_h);
+void xevdm_it_MxN_ats_intra(XEVD_CTX * ctx, s16 *coef, int tuw, int tuh, int bit_depth, const int max_log2_tr_dynamic_range, u8 ats_intra_tridx, int skip_w, int skip_h);
 
 void xevdm_itrans_ats_intra_DST7_B4(s16 *coef, s16 *block, int shift, int line, int skip_line, int skip_line_2)
 {
@@ -403,7 +401,7 @@ void xevdm_itrans_ats_intra_DCT8_B32(s16 *coef, s16 *block, int shift, int line,
     }
 }
 
-void xevdm_it_MxN_ats_intra(s16 *coef, int tuw, int tuh, int bit_depth, const int max_log2_tr_dynamic_range, u8 ats_intra_tridx, int skip_w, int skip_h)
+void xevdm_it_MxN_ats_intra(XEVD_CTX * ctx, s16 *coef, int tuw, int tuh, int bit_depth, const int max_log2_tr_dynamic_range, u8 ats_intra_tridx, int skip_w, int skip_h)
 {
     const int TRANSFORM_MATRIX_SHIFT = 6;
     const int shift_1st = TRANSFORM_MATRIX_SHIFT + 1;
@@ -412,12 +410,13 @@ void xevdm_it_MxN_ats_intra(s16 *coef, int tuw, int tuh, int bit_depth, const in
     const u8 log2_minus1_h = XEVD_CONV_LOG2(tuh) - 1;
     s16 t[MAX_TR_DIM]; /* temp buffer */
     u8  t_idx_h = 0, t_idx_v = 0;
+    INV_TRANS *(*fn_itrans)[5] = ((XEVDM_CTX *)ctx)->fn_itrans;
 
     t_idx_h = xevd_tbl_tr_subset_intra[ats_intra_tridx >> 1];
     t_idx_v = xevd_tbl_tr_subset_intra[ats_intra_tridx & 1];
 
-    xevd_func_itrans[t_idx_v][log2_minus1_h](coef, t, shift_1st, tuw, skip_w, skip_h);
-    xevd_func_itrans[t_idx_h][log2_minus1_w](t, coef, shift_2nd, tuh, 0, skip_w);
+    fn_itrans[t_idx_v][log2_minus1_h](coef, t, shift_1st, tuw, skip_w, skip_h);
+    fn_itrans[t_idx_h][log2_minus1_w](t, coef, shift_2nd, tuh, 0, skip_w);
 }
 
 void xevdm_itx_pb2(s16 *src, s16 *dst, int shift, int line)
@@ -710,8 +709,10 @@ static void xevdm_itrans(XEVD_CTX * ctx, s16 *coef, int log2_cuw, int log2_cuh,
     if(iqt_flag)
     {
         s16 t[MAX_TR_DIM]; /* temp buffer */
-        (*xevdm_fn_itx)[log2_cuh - 1](coef, t, ITX_SHIFT1, 1 << log2_cuw);
-        (*xevdm_fn_itx)[log2_cuw - 1](t, coef, ITX_SHIFT2(bit_depth), 1 << log2_cuh);
+        XEVD_ITX (*fn_itx)[MAX_TR_LOG2] = ((XEVDM_CTX *)ctx)->fn_itx;
+
+        (*fn_itx)[log2_cuh - 1](coef, t, ITX_SHIFT1, 1 << log2_cuw);
+        (*fn_itx)[log2_cuw - 1](t, coef, ITX_SHIFT2(bit_depth), 1 << log2_cuh);
 
     }
     else
@@ -723,12 +724,36 @@ static void xevdm_itrans(XEVD_CTX * ctx, s16 *coef, int log2_cuw, int log2_cuh,
 }
 
 
-void xevdm_itrans_ats_intra(s16* coef, int log2_w, int log2_h, u8 ats_mode, int skip_w, int skip_h, int bit_depth)
+void xevdm_itrans_ats_intra(XEVD_CTX * ctx, s16* coef, int log2_w, int log2_h, u8 ats_mode, int skip_w, int skip_h, int bit_depth)
 {
-    xevdm_it_MxN_ats_intra(coef, (1 << log2_w), (1 << log2_h), bit_depth, 15, ats_mode, skip_w, skip_h);
+    xevdm_it_MxN_ats_intra(ctx, coef, (1 << log2_w), (1 << log2_h), bit_depth, 15, ats_mode, skip_w, skip_h);
 }
 
 
+/* inverse DCT-II of a block whose only nonzero coefficient is DC */
+static void xevdm_itrans_dc(s16 *coef, int log2_w, int log2_h, int iqt_flag, int bit_depth)
+{
+    int i;
+    s64 dc;
+    s16 val;
+
+    if(iqt_flag)
+    {
+        dc = ITX_CLIP((64 * coef[0] + (1 << (ITX_SHIFT1 - 1))) >> ITX_SHIFT1);
+        dc = (64 * dc + (1 << (ITX_SHIFT2(bit_depth) - 1))) >> ITX_SHIFT2(bit_depth);
+    }
+    else
+    {
+        dc = ((s64)(64 * 64) * coef[0] + (1 << (ITX_SHIFT1 + ITX_SHIFT2(bit_depth) - 1))) >> (ITX_SHIFT1 + ITX_SHIFT2(bit_depth));
+    }
+    val = ITX_CLIP(dc);
+
+    for(i = 0; i < (1 << (log2_w + log2_h)); i++)
+    {
+        coef[i] = val;
+    }
+}
+
 void xevdm_itdq(XEVD_CTX * ctx, s16 *coef, int log2_w, int log2_h, int scale, int iqt_flag, u8 ats_intra_cu, u8 ats_mode, int bit_depth)
 {
     s32 offset;
@@ -752,37 +777,43 @@ void xevdm_itdq(XEVD_CTX * ctx, s16 *coef, int log2_w, int log2_h, int scale, in
     shift += ns_shift;
     offset = (shift == 0) ? 0 : (1 << (shift - 1));
 
-    xevd_dquant(coef, log2_w, log2_h, scale, offset, shift);
-
-
-
-    if(ats_intra_cu)
+    /* a zero level stays zero after dequantization */
+    for(j = 0; j < cuh; j++)
     {
-	    for(j = 0; j < cuh; j++)
+        for(i = 0; i < cuw; i++)
         {
-            for(i = 0; i < cuw; i++)
+            if(coef_tmp[i] != 0)
             {
-                if(coef_tmp[i] != 0)
+                if(i > max_x)
                 {
-                    if(i > max_x)
-                    {
-                        max_x = i;
-                    }
-                    if(j > max_y)
-                    {
-                        max_y = j;
-                    }
+                    max_x = i;
+                }
+                if(j > max_y)
+                {
+                    max_y = j;
                 }
             }
-            coef_tmp += cuw;
         }
+        coef_tmp += cuw;
+    }
+
+    if(ats_intra_cu)
+    {
+        xevd_dquant(coef, log2_w, log2_h, scale, offset, shift);
 
         skip_w = cuw - 1 - max_x;
         skip_h = cuh - 1 - max_y;
-        xevdm_itrans_ats_intra(coef, log2_w, log2_h, ats_mode, skip_w, skip_h, bit_depth);
+        xevdm_itrans_ats_intra(ctx, coef, log2_w, log2_h, ats_mode, skip_w, skip_h, bit_depth);
+    }
+    else if(max_x == 0 && max_y == 0)
+    {
+        s64 lev = (coef[0] * (scale * (s64)(ns_shift ? 181 : 1)) + offset) >> shift;
+        coef[0] = (s16)XEVD_CLIP(lev, -32768, 32767);
+        xevdm_itrans_dc(coef, log2_w, log2_h, iqt_flag, bit_depth);
     }
     else
     {
+        xevd_dquant(coef, log2_w, log2_h, scale, offset, shift);
         xevdm_itrans(ctx, coef, log2_w, log2_h, iqt_flag, bit_depth);
     }
 }
@@ -39,12 +39,9 @@
 #include "xevdm_def.h"
 #include "xevd_itdq.h"
 
-extern INV_TRANS *(*xevd_func_itrans)[5];
 extern INV_TRANS *xevdm_itrans_map_tbl[16][5];
 
-typedef void(*XEVD_ITX)(s16* coef, s16* t, int shift, int line);
 extern XEVD_ITX xevdm_tbl_itx[MAX_TR_LOG2];
-extern XEVD_ITX(*xevdm_fn_itx)[MAX_TR_LOG2];
 
 #if ARM_NEON
 #include "xevdm_itdq_neon.h"
@@ -63,6 +60,7 @@ void xevdm_itx_pb64(s16* src, s16* dst, int shift, int line);
 void xevdm_itdq(XEVD_CTX * ctx, s16 *coef, int log2_w, int log2_h, int scale, int iqt_flag, u8 ats_intra_cu, u8 ats_mode, int bit_depth);
 void xevdm_sub_block_itdq(XEVD_CTX * ctx, s16 coef[N_C][MAX_CU_DIM], int log2_cuw, int log2_cuh, u8 qp_y, u8 qp_u, u8 qp_v, int flag[N_C], int nnz_sub[N_C][MAX_SUB_TB_NUM], int iqt_flag
                         , u8 ats_intra_cu, u8 ats_mode, u8 ats_inter_info, int bit_depth, int chroma_format_idc);
+void xevdm_itrans_ats_intra(XEVD_CTX * ctx, s16* coef, int log2_w, int log2_h, u8 ats_mode, int skip_w, int skip_h, int bit_depth);
 void xevdm_itrans_ats_intra_DST7_B4(s16 *coeff, s16 *block, int shift, int line, int skip_line, int skip_line_2);
 void xevdm_itrans_ats_intra_DCT8_B4(s16 *coeff, s16 *block, int shift, int line, int skip_line, int skip_line_2);
 void xevdm_init_multi_tbl();
@@ -211,17 +211,13 @@ static const s16 tbl_bl_eif_32_phases_mc_l_coeff[32][2] =
   { 2,  62 }
 };
 
-XEVDM_DMVR_MC_L(*xevdm_func_dmvr_mc_l)[2];
-XEVDM_DMVR_MC_C(*xevdm_func_dmvr_mc_c)[2];
-XEVD_MC_C(*xevdm_func_bl_mc_l)[2];
-//XEVDM_DMVR_SAD *xevdm_func_dmvr_sad;
 
 /****************************************************************************
  * motion compensation for luma
  ****************************************************************************/
 
 
-void xevd_mc_dmvr_l_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -245,7 +241,7 @@ void xevd_mc_dmvr_l_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pe
     }
 }
 
-void xevd_mc_dmvr_l_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j, dx;
     s32 pt;
@@ -263,7 +259,7 @@ void xevd_mc_dmvr_l_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pe
         {
             for (j = 0; j < w; j++)
             {
-                pt = MAC_8TAP_N0(tbl_mc_l_coeff[dx], ref[j], ref[j + 1], ref[j + 2], ref[j + 3], ref[j + 4], ref[j + 5], ref[j + 6], ref[j + 7]);
+                pt = MAC_8TAP_N0(MC_L_COEF(coef, dx), ref[j], ref[j + 1], ref[j + 2], ref[j + 3], ref[j + 4], ref[j + 5], ref[j + 6], ref[j + 7]);
 
                 pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
 
@@ -274,7 +270,7 @@ void xevd_mc_dmvr_l_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pe
     }
 }
 
-void xevd_mc_dmvr_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j, dy;
     s32 pt;
@@ -292,7 +288,7 @@ void xevd_mc_dmvr_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pe
         {
             for (j = 0; j < w; j++)
             {
-                pt = MAC_8TAP_0N(tbl_mc_l_coeff[dy], ref[j], ref[s_ref + j], ref[s_ref * 2 + j], ref[s_ref * 3 + j], ref[s_ref * 4 + j], ref[s_ref * 5 + j], ref[s_ref * 6 + j], ref[s_ref * 7 + j]);
+                pt = MAC_8TAP_0N(MC_L_COEF(coef, dy), ref[j], ref[s_ref + j], ref[s_ref * 2 + j], ref[s_ref * 3 + j], ref[s_ref * 4 + j], ref[s_ref * 5 + j], ref[s_ref * 6 + j], ref[s_ref * 7 + j]);
 
                 pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
 
@@ -304,7 +300,7 @@ void xevd_mc_dmvr_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pe
     }
 }
 
-void xevd_mc_dmvr_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_l_nn(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*MAX_CU_SIZE];
     s16        *b;
@@ -334,7 +330,7 @@ void xevd_mc_dmvr_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
         {
             for (j = 0; j < w; j++)
             {
-                b[j] = MAC_8TAP_NN_S1(tbl_mc_l_coeff[dx], ref[j], ref[j + 1], ref[j + 2], ref[j + 3], ref[j + 4], ref[j + 5], ref[j + 6], ref[j + 7], offset1, shift1);
+                b[j] = MAC_8TAP_NN_S1(MC_L_COEF(coef, dx), ref[j], ref[j + 1], ref[j + 2], ref[j + 3], ref[j + 4], ref[j + 5], ref[j + 6], ref[j + 7], offset1, shift1);
             }
             ref += s_ref;
             b += w;
@@ -345,7 +341,7 @@ void xevd_mc_dmvr_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
         {
             for (j = 0; j < w; j++)
             {
-                pt = MAC_8TAP_NN_S2(tbl_mc_l_coeff[dy], b[j], b[j + w], b[j + w * 2], b[j + w * 3], b[j + w * 4], b[j + w * 5], b[j + w * 6], b[j + w * 7], offset2, shift2);
+                pt = MAC_8TAP_NN_S2(MC_L_COEF(coef, dy), b[j], b[j + w], b[j + w * 2], b[j + w * 3], b[j + w * 4], b[j + w * 5], b[j + w * 6], b[j + w * 7], offset2, shift2);
                 pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
             }
             pred += s_pred;
@@ -436,7 +432,7 @@ void xevdm_bl_mc_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel
     }
 }
 
-void xevdm_bl_mc_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevdm_bl_mc_l_nn(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*(MAX_CU_SIZE + MC_IBUF_PAD_L)];
     s16        *b;
@@ -490,7 +486,7 @@ void xevdm_bl_mc_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16
  ****************************************************************************/
 
 
-void xevd_mc_dmvr_c_00(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_00(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j;
 
@@ -515,7 +511,7 @@ void xevd_mc_dmvr_c_00(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
     }
 }
 
-void xevd_mc_dmvr_c_n0(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_n0(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int       i, j, dx;
     s32       pt;
@@ -533,7 +529,7 @@ void xevd_mc_dmvr_c_n0(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
         {
             for (j = 0; j < w; j++)
             {
-                pt = MAC_4TAP_N0(tbl_mc_c_coeff[dx], ref[j], ref[j + 1], ref[j + 2], ref[j + 3]);
+                pt = MAC_4TAP_N0(MC_C_COEF(coef, dx), ref[j], ref[j + 1], ref[j + 2], ref[j + 3]);
                 pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
             }
             pred += s_pred;
@@ -542,7 +538,7 @@ void xevd_mc_dmvr_c_n0(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
     }
 }
 
-void xevd_mc_dmvr_c_0n(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     int i, j, dy;
     s32       pt;
@@ -560,7 +556,7 @@ void xevd_mc_dmvr_c_0n(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
         {
             for (j = 0; j < w; j++)
             {
-                pt = MAC_4TAP_0N(tbl_mc_c_coeff[dy], ref[j], ref[s_ref + j], ref[s_ref * 2 + j], ref[s_ref * 3 + j]);
+                pt = MAC_4TAP_0N(MC_C_COEF(coef, dy), ref[j], ref[s_ref + j], ref[s_ref * 2 + j], ref[s_ref * 3 + j]);
                 pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
             }
             pred += s_pred;
@@ -569,7 +565,7 @@ void xevd_mc_dmvr_c_0n(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
     }
 }
 
-void xevd_mc_dmvr_c_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+void xevd_mc_dmvr_c_nn(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16 * coef)
 {
     s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_C)*MAX_CU_SIZE];
     s16        *b;
@@ -600,7 +596,7 @@ void xevd_mc_dmvr_c_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
         {
             for (j = 0; j < w; j++)
             {
-                b[j] = MAC_4TAP_NN_S1(tbl_mc_c_coeff[dx], ref[j], ref[j + 1], ref[j + 2], ref[j + 3], offset1, shift1);
+                b[j] = MAC_4TAP_NN_S1(MC_C_COEF(coef, dx), ref[j], ref[j + 1], ref[j + 2], ref[j + 3], offset1, shift1);
             }
             ref += s_ref;
             b += w;
@@ -611,7 +607,7 @@ void xevd_mc_dmvr_c_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
         {
             for (j = 0; j < w; j++)
             {
-                pt = MAC_4TAP_NN_S2(tbl_mc_c_coeff[dy], b[j], b[j + w], b[j + 2 * w], b[j + 3 * w],offset2, shift2);
+                pt = MAC_4TAP_NN_S2(MC_C_COEF(coef, dy), b[j], b[j + w], b[j + 2 * w], b[j + 3 * w],offset2, shift2);
                 pred[j] = XEVD_CLIP3(0, (1 << bit_depth) - 1, pt);
             }
             pred += s_pred;
@@ -622,7 +618,7 @@ void xevd_mc_dmvr_c_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s1
 
 
 
-XEVD_MC_L xevdm_tbl_dmvr_mc_l[2][2] =
+XEVDM_DMVR_MC_L xevdm_tbl_dmvr_mc_l[2][2] =
 {
   {
     xevd_mc_dmvr_l_00, /* dx == 0 && dy == 0 */
@@ -634,7 +630,7 @@ XEVD_MC_L xevdm_tbl_dmvr_mc_l[2][2] =
   }
 };
 
-XEVD_MC_C xevdm_tbl_dmvr_mc_c[2][2] =
+XEVDM_DMVR_MC_C xevdm_tbl_dmvr_mc_c[2][2] =
 {
   {
     xevd_mc_dmvr_c_00, /* dx == 0 && dy == 0 */
@@ -648,7 +644,7 @@ XEVD_MC_C xevdm_tbl_dmvr_mc_c[2][2] =
 
 
 /* luma and chroma will remain the same */
-XEVD_MC_L xevdm_tbl_bl_mc_l[2][2] =
+XEVDM_BL_MC_L xevdm_tbl_bl_mc_l[2][2] =
 {
     {
         xevdm_bl_mc_l_00,
@@ -1185,7 +1181,7 @@ void copy_to_dst(int w, int h, pel *src, pel *dst, int s_stride, int d_stride)
     }
 }
 
-void predict_new_line(int x, int y, int pic_w, int pic_h, const XEVD_PIC *ref_pic, const s16(*mv), const s16(*mv_current), pel *preds_array, const s16(*mv_offsets), int stride, int w, int h
+void predict_new_line(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, const XEVD_PIC *ref_pic, const s16(*mv), const s16(*mv_current), pel *preds_array, const s16(*mv_offsets), int stride, int w, int h
     , BOOL all_sides
     , int bit_depth_luma, int bit_depth_chroma)
 {
@@ -1211,7 +1207,7 @@ void predict_new_line(int x, int y, int pic_w, int pic_h, const XEVD_PIC *ref_pi
             qpel_gmv_y = (y << 2) + mv_t[MV_Y];
             pred_buffer_offset = -REF_PRED_EXTENTION_PEL_COUNT * stride + REF_PRED_EXTENTION_PEL_COUNT * w;
 
-            xevdm_bl_mc_l(ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array + pred_buffer_offset, REF_PRED_EXTENTION_PEL_COUNT, h + (REF_PRED_EXTENTION_PEL_COUNT << 1), bit_depth_luma);
+            xevdm_bl_mc_l((XEVDM_CTX *)ctx, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array + pred_buffer_offset, REF_PRED_EXTENTION_PEL_COUNT, h + (REF_PRED_EXTENTION_PEL_COUNT << 1), bit_depth_luma);
         }
         // go left
 
@@ -1226,7 +1222,7 @@ void predict_new_line(int x, int y, int pic_w, int pic_h, const XEVD_PIC *ref_pi
             qpel_gmv_y = (y << 2) + mv_t[MV_Y];
             pred_buffer_offset = -REF_PRED_EXTENTION_PEL_COUNT * stride - REF_PRED_EXTENTION_PEL_COUNT;
 
-            xevdm_bl_mc_l(ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array + pred_buffer_offset, REF_PRED_EXTENTION_PEL_COUNT, h + (REF_PRED_EXTENTION_PEL_COUNT << 1), bit_depth_luma);
+            xevdm_bl_mc_l((XEVDM_CTX *)ctx, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array + pred_buffer_offset, REF_PRED_EXTENTION_PEL_COUNT, h + (REF_PRED_EXTENTION_PEL_COUNT << 1), bit_depth_luma);
         }
     }
 
@@ -1246,7 +1242,7 @@ void predict_new_line(int x, int y, int pic_w, int pic_h, const XEVD_PIC *ref_pi
             qpel_gmv_y = (y << 2) + mv_t[MV_Y];
             pred_buffer_offset = REF_PRED_EXTENTION_PEL_COUNT * stride * h - REF_PRED_EXTENTION_PEL_COUNT;
 
-            xevdm_bl_mc_l(ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array + pred_buffer_offset, w + (REF_PRED_EXTENTION_PEL_COUNT << 1), REF_PRED_EXTENTION_PEL_COUNT, bit_depth_luma);
+            xevdm_bl_mc_l((XEVDM_CTX *)ctx, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array + pred_buffer_offset, w + (REF_PRED_EXTENTION_PEL_COUNT << 1), REF_PRED_EXTENTION_PEL_COUNT, bit_depth_luma);
 
         }
         // go up
@@ -1261,7 +1257,7 @@ void predict_new_line(int x, int y, int pic_w, int pic_h, const XEVD_PIC *ref_pi
             qpel_gmv_y = (y << 2) + mv_t[MV_Y];
             pred_buffer_offset = -REF_PRED_EXTENTION_PEL_COUNT * stride - REF_PRED_EXTENTION_PEL_COUNT;
 
-            xevdm_bl_mc_l(ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array + pred_buffer_offset, w + (REF_PRED_EXTENTION_PEL_COUNT << 1), REF_PRED_EXTENTION_PEL_COUNT, bit_depth_luma);
+            xevdm_bl_mc_l((XEVDM_CTX *)ctx, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array + pred_buffer_offset, w + (REF_PRED_EXTENTION_PEL_COUNT << 1), REF_PRED_EXTENTION_PEL_COUNT, bit_depth_luma);
 
         }
     }
@@ -1543,7 +1539,7 @@ static void prefetch_for_mc(int x, int y,int pu_x, int pu_y, int pu_w, int pu_h,
 
 
 
-void final_paddedMC_forDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*inital_mv)[MV_D], s32(*refined_mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[REFP_NUM][N_C][MAX_CU_DIM]
+void final_paddedMC_forDMVR(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*inital_mv)[MV_D], s32(*refined_mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[REFP_NUM][N_C][MAX_CU_DIM]
     , int sub_pred_offset_x
     , int sub_pred_offset_y
     , int cu_pred_stride
@@ -1608,7 +1604,7 @@ void final_paddedMC_forDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8
         pel *src = dmvr_padding_buf[i][0] + offset + sub_pred_offset_x + sub_pred_offset_y * PAD_BUFFER_STRIDE;;
         pel *temp = pred[i][Y_C] + sub_pred_offset_x + sub_pred_offset_y * cu_pred_stride;
 
-        xevdm_dmvr_mc_l(src, qpel_gmv_x, qpel_gmv_y, PAD_BUFFER_STRIDE, cu_pred_stride, temp, w, h, bit_depth_luma);
+        xevdm_dmvr_mc_l((XEVDM_CTX *)ctx, src, qpel_gmv_x, qpel_gmv_y, PAD_BUFFER_STRIDE, cu_pred_stride, temp, w, h, bit_depth_luma);
 
         filter_size = NTAPS_CHROMA;
         num_extra_pixel_left_for_filter = ((filter_size >> 1) - 1);
@@ -1621,13 +1617,13 @@ void final_paddedMC_forDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8
             src = dmvr_padding_buf[i][1] + offset + (sub_pred_offset_x >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))) + (sub_pred_offset_y >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc))) * PAD_BUFFER_STRIDE;
             temp = pred[i][U_C] + (sub_pred_offset_x >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))) + (sub_pred_offset_y >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc))) * (cu_pred_stride >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)));
 
-            xevdm_dmvr_mc_c(src, qpel_gmv_x, qpel_gmv_y, PAD_BUFFER_STRIDE, cu_pred_stride >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), temp, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+            xevdm_dmvr_mc_c((XEVDM_CTX *)ctx, src, qpel_gmv_x, qpel_gmv_y, PAD_BUFFER_STRIDE, cu_pred_stride >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), temp, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                           , h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
 
             src = dmvr_padding_buf[i][2] + offset + (sub_pred_offset_x >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))) + (sub_pred_offset_y >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc))) * PAD_BUFFER_STRIDE;
             temp = pred[i][V_C] + (sub_pred_offset_x >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))) + (sub_pred_offset_y >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc))) * (cu_pred_stride >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)));
 
-            xevdm_dmvr_mc_c(src, qpel_gmv_x, qpel_gmv_y, PAD_BUFFER_STRIDE, cu_pred_stride >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), temp, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+            xevdm_dmvr_mc_c((XEVDM_CTX *)ctx, src, qpel_gmv_x, qpel_gmv_y, PAD_BUFFER_STRIDE, cu_pred_stride >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), temp, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                           , h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
         }
 
@@ -1635,7 +1631,7 @@ void final_paddedMC_forDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8
 }
 
 
-static void processDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[REFP_NUM][N_C][MAX_CU_DIM], \
+static void processDMVR(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[REFP_NUM][N_C][MAX_CU_DIM], \
     int poc_c, pel *dmvr_current_template, pel dmvr_ref_pred_interpolated[REFP_NUM][(MAX_CU_SIZE + ((DMVR_NEW_VERSION_ITER_COUNT + 1) * REF_PRED_EXTENTION_PEL_COUNT)) * (MAX_CU_SIZE + ((DMVR_NEW_VERSION_ITER_COUNT + 1) * REF_PRED_EXTENTION_PEL_COUNT))]
     , pel dmvr_half_pred_interpolated[REFP_NUM][(MAX_CU_SIZE + 1) * (MAX_CU_SIZE + 1)], int iteration, pel dmvr_padding_buf[REFP_NUM][N_C][PAD_BUFFER_STRIDE * PAD_BUFFER_STRIDE]
     , s16 dmvr_mv[MAX_CU_CNT_IN_LCU][REFP_NUM][MV_D], int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
@@ -1671,7 +1667,7 @@ static void processDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8 ref
     qpel_gmv_x = (x << 2) + tempMv[MV_X];
     qpel_gmv_y = (y << 2) + tempMv[MV_Y];
 
-    xevdm_bl_mc_l(ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array[REFP_0], (w + iteration * 2), (h + iteration * 2), bit_depth_luma);
+    xevdm_bl_mc_l((XEVDM_CTX *)ctx, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array[REFP_0], (w + iteration * 2), (h + iteration * 2), bit_depth_luma);
 
 
     // REF_PIC_LIST_1
@@ -1682,7 +1678,7 @@ static void processDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8 ref
     qpel_gmv_x = (x << 2) + tempMv[MV_X];
     qpel_gmv_y = (y << 2) + tempMv[MV_Y];
 
-    xevdm_bl_mc_l(ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array[REFP_1], (w + iteration * 2), (h + iteration * 2),bit_depth_luma);
+    xevdm_bl_mc_l((XEVDM_CTX *)ctx, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, stride, preds_array[REFP_1], (w + iteration * 2), (h + iteration * 2),bit_depth_luma);
 
 
     // go to the center point
@@ -1810,7 +1806,7 @@ static void processDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8 ref
                                             { sub_pu_L1[num][MV_X], sub_pu_L1[num][MV_Y] }
             };
 
-            final_paddedMC_forDMVR(subPuStartX, subPuStartY, pic_w, pic_h, dx, dy, refi, starting_mv, dmvr_mv, refp, pred
+            final_paddedMC_forDMVR(ctx, subPuStartX, subPuStartY, pic_w, pic_h, dx, dy, refi, starting_mv, dmvr_mv, refp, pred
                 , startX
                 , startY
                 , w
@@ -1857,7 +1853,7 @@ void mv_clip(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM]
     }
 }
 
-void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[REFP_NUM][N_C][MAX_CU_DIM]
+void xevdm_mc(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16(*mv)[MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[REFP_NUM][N_C][MAX_CU_DIM]
     , int poc_c, pel *dmvr_current_template, pel dmvr_ref_pred_interpolated[REFP_NUM][(MAX_CU_SIZE + ((DMVR_NEW_VERSION_ITER_COUNT + 1) * REF_PRED_EXTENTION_PEL_COUNT)) * (MAX_CU_SIZE + ((DMVR_NEW_VERSION_ITER_COUNT + 1) * REF_PRED_EXTENTION_PEL_COUNT))]
     , pel dmvr_half_pred_interpolated[REFP_NUM][(MAX_CU_SIZE + 1) * (MAX_CU_SIZE + 1)], BOOL apply_DMVR, pel dmvr_padding_buf[REFP_NUM][N_C][PAD_BUFFER_STRIDE * PAD_BUFFER_STRIDE], u8 *cu_dmvr_flag, s16 dmvr_mv[MAX_CU_CNT_IN_LCU][REFP_NUM][MV_D]
     , int sps_admvp_flag, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc)
@@ -1912,17 +1908,6 @@ void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM
 
 
     *cu_dmvr_flag = 0;
-     if(sps_admvp_flag == 1)
-    {
-        tbl_mc_l_coeff = tbl_mc_l_coeff_main;
-        tbl_mc_c_coeff = tbl_mc_c_coeff_main;
-    }
-    else
-    {
-        tbl_mc_l_coeff = xevd_tbl_mc_l_coeff;
-        tbl_mc_c_coeff = xevd_tbl_mc_c_coeff;
-    }
-
     if (REFI_IS_VALID(refi[REFP_0]))
     {
         /* forward */
@@ -1933,7 +1918,7 @@ void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM
 
         if (!apply_DMVR)
         {
-            xevd_mc_l(mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, w, pred[0][Y_C], w, h, bit_depth_luma);
+            xevd_mc_l(ctx, mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic, (qpel_gmv_x << 2), (qpel_gmv_y << 2), w, pred[0][Y_C], w, h, bit_depth_luma);
         }
 
         if ((!REFI_IS_VALID(refi[REFP_1]) || !apply_DMVR || !dmvr_poc_condition)
@@ -1942,9 +1927,9 @@ void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM
 
             )
         {
-            xevd_mc_c(mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic->u, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_c, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+            xevd_mc_c(ctx, mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic, ref_pic->u, (qpel_gmv_x << 2), (qpel_gmv_y << 2), w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                      , pred[0][U_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
-            xevd_mc_c(mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic->v, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_c, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+            xevd_mc_c(ctx, mv_before_clipping[REFP_0][MV_X] << 2, mv_before_clipping[REFP_0][MV_Y] << 2, ref_pic, ref_pic->v, (qpel_gmv_x << 2), (qpel_gmv_y << 2), w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                      , pred[0][V_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
         }
 
@@ -1970,7 +1955,7 @@ void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM
         if (!apply_DMVR)
         {
 
-            xevd_mc_l(mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic->y, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_l, w, pred[bidx][Y_C], w, h, bit_depth_luma);
+            xevd_mc_l(ctx, mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic, (qpel_gmv_x << 2), (qpel_gmv_y << 2), w, pred[bidx][Y_C], w, h, bit_depth_luma);
 
         }
 
@@ -1981,9 +1966,9 @@ void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM
             )
         {
 
-            xevd_mc_c(mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic->u, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_c, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+            xevd_mc_c(ctx, mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic, ref_pic->u, (qpel_gmv_x << 2), (qpel_gmv_y << 2), w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                      , pred[bidx][U_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
-            xevd_mc_c(mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic->v, (qpel_gmv_x << 2), (qpel_gmv_y << 2), ref_pic->s_c, w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+            xevd_mc_c(ctx, mv_before_clipping[REFP_1][MV_X] << 2, mv_before_clipping[REFP_1][MV_Y] << 2, ref_pic, ref_pic->v, (qpel_gmv_x << 2), (qpel_gmv_y << 2), w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                      , pred[bidx][V_C], w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
 
         }
@@ -2002,7 +1987,7 @@ void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM
             if (apply_DMVR)
             {
                 *cu_dmvr_flag = 1;
-                processDMVR(x, y, pic_w, pic_h, w, h, refi, mv, refp, pred, poc_c, dmvr_current_template, dmvr_ref_pred_interpolated
+                processDMVR(ctx, x, y, pic_w, pic_h, w, h, refi, mv, refp, pred, poc_c, dmvr_current_template, dmvr_ref_pred_interpolated
                     , dmvr_half_pred_interpolated, iterations_count, dmvr_padding_buf, dmvr_mv,  bit_depth_luma,  bit_depth_chroma, chroma_format_idc);
             }
 
@@ -2014,7 +1999,7 @@ void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM
         } //if (apply_DMVR && ((poc_c - poc0)*(poc_c - poc1) < 0))
 
 
-        xevd_func_average_no_clip(pred[0][Y_C], pred[1][Y_C], pred[0][Y_C], w, w, w, w, h
+        ctx->fn_average_no_clip(pred[0][Y_C], pred[1][Y_C], pred[0][Y_C], w, w, w, w, h
 
             , bit_depth_luma
 
@@ -2025,10 +2010,10 @@ void xevdm_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM
 
         if(chroma_format_idc)
         {
-            xevd_func_average_no_clip(pred[0][U_C], pred[1][U_C], pred[0][U_C], w, w, w, w, h
+            ctx->fn_average_no_clip(pred[0][U_C], pred[1][U_C], pred[0][U_C], w, w, w, w, h
             , bit_depth_chroma
         );
-            xevd_func_average_no_clip(pred[0][V_C], pred[1][V_C], pred[0][V_C], w, w, w, w, h
+            ctx->fn_average_no_clip(pred[0][V_C], pred[1][V_C], pred[0][V_C], w, w, w, w, h
             , bit_depth_chroma
 
         );
@@ -2149,7 +2134,7 @@ static void eif_derive_mv_clip_range(int x, int y, int cuw, int cuh, int dmv_hor
     }
 }
 
-void xevdm_affine_mc_l(int x, int y, int pic_w, int pic_h, int cuw, int cuh, s16 ac_mv[VER_NUM][MV_D], XEVD_PIC* ref_pic, pel pred[MAX_CU_DIM], int vertex_num, pel* tmp_buffer
+void xevdm_affine_mc_l(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, int cuw, int cuh, s16 ac_mv[VER_NUM][MV_D], XEVD_PIC* ref_pic, pel pred[MAX_CU_DIM], int vertex_num, s16* tmp_buffer
 
     , int bit_depth_luma, int bit_depth_chroma
                      , int chroma_format_idc
@@ -2249,15 +2234,15 @@ void xevdm_affine_mc_l(int x, int y, int pic_w, int pic_h, int cuw, int cuh, s16
             qpel_gmv_x = ((x + w) << mc_prec) + mv_scale_tmp_hor;
             qpel_gmv_y = ((y + h) << mc_prec) + mv_scale_tmp_ver;
 
-            xevd_mc_l(mv_scale_tmp_hor_ori, mv_scale_tmp_ver_ori, ref_pic->y, qpel_gmv_x, qpel_gmv_y, ref_pic->s_l, cuw, (pred_y + w), sub_w, sub_h, bit_depth_luma);
+            xevd_mc_l(ctx, mv_scale_tmp_hor_ori, mv_scale_tmp_ver_ori, ref_pic, qpel_gmv_x, qpel_gmv_y, cuw, (pred_y + w), sub_w, sub_h, bit_depth_luma);
 
         }
         pred_y += (cuw * sub_h);
     }
 }
 
-void xevdm_affine_mc_lc(int x, int y, int pic_w, int pic_h, int cuw, int cuh, s16 ac_mv[VER_NUM][MV_D], XEVD_PIC* ref_pic, pel pred[N_C][MAX_CU_DIM], int vertex_num
-    , int sub_w, int sub_h, pel* tmp_buffer_for_eif, BOOL mem_band_conditions_for_eif_are_satisfied
+void xevdm_affine_mc_lc(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, int cuw, int cuh, s16 ac_mv[VER_NUM][MV_D], XEVD_PIC* ref_pic, pel pred[N_C][MAX_CU_DIM], int vertex_num
+    , int sub_w, int sub_h, s16* tmp_buffer_for_eif, BOOL mem_band_conditions_for_eif_are_satisfied
 
     , int bit_depth_luma, int bit_depth_chroma
                       , int chroma_format_idc
@@ -2370,13 +2355,13 @@ void xevdm_affine_mc_lc(int x, int y, int pic_w, int pic_h, int cuw, int cuh, s1
             qpel_gmv_x = ((x + w) << mc_prec) + mv_scale_tmp_hor;
             qpel_gmv_y = ((y + h) << mc_prec) + mv_scale_tmp_ver;
 
-            xevd_mc_l(mv_scale_tmp_hor_ori, mv_scale_tmp_ver_ori, ref_pic->y, qpel_gmv_x, qpel_gmv_y, ref_pic->s_l, cuw, (pred_y + w), sub_w, sub_h, bit_depth_luma);
+            xevd_mc_l(ctx, mv_scale_tmp_hor_ori, mv_scale_tmp_ver_ori, ref_pic, qpel_gmv_x, qpel_gmv_y, cuw, (pred_y + w), sub_w, sub_h, bit_depth_luma);
 
             if(chroma_format_idc)
             {
-                xevd_mc_c(mv_scale_tmp_hor_ori, mv_scale_tmp_ver_ori, ref_pic->u, qpel_gmv_x, qpel_gmv_y, ref_pic->s_c, cuw >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+                xevd_mc_c(ctx, mv_scale_tmp_hor_ori, mv_scale_tmp_ver_ori, ref_pic, ref_pic->u, qpel_gmv_x, qpel_gmv_y, cuw >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                          , pred_u + (w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))), sub_w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), sub_h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
-                xevd_mc_c(mv_scale_tmp_hor_ori, mv_scale_tmp_ver_ori, ref_pic->v, qpel_gmv_x, qpel_gmv_y, ref_pic->s_c, cuw >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
+                xevd_mc_c(ctx, mv_scale_tmp_hor_ori, mv_scale_tmp_ver_ori, ref_pic, ref_pic->v, qpel_gmv_x, qpel_gmv_y, cuw >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))
                          , pred_v + (w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc))), sub_w >> (XEVD_GET_CHROMA_W_SHIFT(chroma_format_idc)), sub_h >> (XEVD_GET_CHROMA_H_SHIFT(chroma_format_idc)), bit_depth_chroma);
             }
 
@@ -2425,13 +2410,13 @@ static BOOL can_mv_clipping_occurs(int block_width, int block_height, int mv0[MV
     return mv_clip_occurs[MV_X] || mv_clip_occurs[MV_Y];
 }
 
-void xevdm_eif_filter(int block_width, int block_height, pel* p_tmp_buf, int tmp_buf_stride, pel *p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth)
+void xevdm_eif_filter(int block_width, int block_height, s16* p_tmp_buf, int tmp_buf_stride, pel *p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth)
 {
-    pel* p_buf = p_tmp_buf + 1;
+    s16* p_buf = p_tmp_buf + 1;
 
     for (int y = 0; y <= block_height + 1; ++y, p_buf += tmp_buf_stride)
     {
-        pel* t = p_buf;
+        s16* t = p_buf;
 
         for (int x = 1; x <= block_width; ++x, ++t)
             t[-1] = (-t[-1] + (t[0] * 10) - t[1] + offsets[2]) >> shifts[2];
@@ -2442,18 +2427,18 @@ void xevdm_eif_filter(int block_width, int block_height, pel* p_tmp_buf, int tmp
     for (int y = 0; y < block_height; ++y, p_buf += tmp_buf_stride, p_dst += dst_stride)
     {
         pel* p_dst_buf = p_dst;
-        pel* t = p_buf;
+        s16* t = p_buf;
 
         for (int x = 0; x < block_width; ++x, ++t, ++p_dst_buf)
         {
-            pel res = (-t[-tmp_buf_stride] + (t[0] * 10) - t[tmp_buf_stride] + offsets[3]) >> shifts[3];
+            s16 res = (-t[-tmp_buf_stride] + (t[0] * 10) - t[tmp_buf_stride] + offsets[3]) >> shifts[3];
 
             *p_dst_buf = XEVD_MIN((1 << bit_depth) - 1, XEVD_MAX(0, res));
         }
     }
 }
 
-void xevdm_eif_bilinear_clip(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], int mv_max[MV_D], int mv_min[MV_D], pel* p_ref, int ref_stride, pel* p_dst, int dst_stride, int shifts[4], int offsets[4]
+void xevdm_eif_bilinear_clip(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], int mv_max[MV_D], int mv_min[MV_D], pel* p_ref, int ref_stride, s16* p_dst, int dst_stride, int shifts[4], int offsets[4]
     , int bit_depth
 
 )
@@ -2462,7 +2447,7 @@ void xevdm_eif_bilinear_clip(int block_width, int block_height, int mv0[MV_D], i
 
     const pel fracMask = (1 << EIF_MV_PRECISION_BILINEAR) - 1;
 
-    pel* p_buf = p_dst;
+    s16* p_buf = p_dst;
 
     int shift1 = XEVD_MIN(4, bit_depth - 8);
     int shift2 = XEVD_MAX(8, 20 - bit_depth);
@@ -2489,8 +2474,8 @@ void xevdm_eif_bilinear_clip(int block_width, int block_height, int mv0[MV_D], i
 
             pel* r = p_ref + yInt * ref_stride + xInt;
 
-            pel s1 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[xFrac], r[0], r[1], offset1, shift1);
-            pel s2 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[xFrac], r[ref_stride], r[ref_stride + 1], offset1, shift1);
+            s16 s1 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[xFrac], r[0], r[1], offset1, shift1);
+            s16 s2 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[xFrac], r[ref_stride], r[ref_stride + 1], offset1, shift1);
             p_buf[x + 1] = MAC_BL_NN_S2(tbl_bl_eif_32_phases_mc_l_coeff[yFrac], s1, s2, offset2, shift2);
 
 
@@ -2498,13 +2483,13 @@ void xevdm_eif_bilinear_clip(int block_width, int block_height, int mv0[MV_D], i
     }
 }
 
-void xevdm_eif_bilinear_no_clip(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], pel* p_ref, int ref_stride, pel* p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth)
+void xevdm_eif_bilinear_no_clip(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], pel* p_ref, int ref_stride, s16* p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth)
 {
     int mv[MV_D] = { mv0[MV_X], mv0[MV_Y] };
 
     const pel fracMask = (1 << EIF_MV_PRECISION_BILINEAR) - 1;
 
-    pel* p_buf = p_dst;
+    s16* p_buf = p_dst;
 
     int shift1 = XEVD_MIN(4, bit_depth - 8);
     int shift2 = XEVD_MAX(8, 20 - bit_depth);
@@ -2531,8 +2516,8 @@ void xevdm_eif_bilinear_no_clip(int block_width, int block_height, int mv0[MV_D]
 
             pel* r = p_ref + yInt * ref_stride + xInt;
 
-            pel s1 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[xFrac], r[0], r[1], offset1, shift1);
-            pel s2 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[xFrac], r[ref_stride], r[ref_stride + 1], offset1, shift1);
+            s16 s1 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[xFrac], r[0], r[1], offset1, shift1);
+            s16 s2 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[xFrac], r[ref_stride], r[ref_stride + 1], offset1, shift1);
             p_buf[x + 1] = MAC_BL_NN_S2(tbl_bl_eif_32_phases_mc_l_coeff[yFrac], s1, s2, offset2, shift2);
 
 
@@ -2541,7 +2526,7 @@ void xevdm_eif_bilinear_no_clip(int block_width, int block_height, int mv0[MV_D]
 }
 
 void xevdm_eif_mc(int block_width, int block_height, int x, int y, int mv_scale_hor, int mv_scale_ver, int dmv_hor_x, int dmv_hor_y, int dmv_ver_x, int dmv_ver_y,
-    int hor_max, int ver_max, int hor_min, int ver_min, pel* p_ref, int ref_stride, pel *p_dst, int dst_stride, pel* p_tmp_buf, char affine_mv_prec, s8 comp
+    int hor_max, int ver_max, int hor_min, int ver_min, pel* p_ref, int ref_stride, pel *p_dst, int dst_stride, s16* p_tmp_buf, char affine_mv_prec, s8 comp
     , int bit_depth
                 , int chroma_format_idc
 )
@@ -2603,7 +2588,7 @@ void xevdm_eif_mc(int block_width, int block_height, int x, int y, int mv_scale_
     xevdm_eif_filter(block_width, block_height, p_tmp_buf, tmp_buf_stride, p_dst, dst_stride, shifts, offsets, bit_depth);
 }
 
-void xevdm_affine_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16 mv[REFP_NUM][VER_NUM][MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[2][N_C][MAX_CU_DIM], int vertex_num, pel* tmp_buffer
+void xevdm_affine_mc(XEVD_CTX * ctx, int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16 mv[REFP_NUM][VER_NUM][MV_D], XEVD_REFP(*refp)[REFP_NUM], pel pred[2][N_C][MAX_CU_DIM], int vertex_num, s16* tmp_buffer
     , int bit_depth_luma, int bit_depth_chroma
                    , int chroma_format_idc
 )
@@ -2623,7 +2608,7 @@ void xevdm_affine_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[R
     {
         /* forward */
         ref_pic = refp[refi[REFP_0]][REFP_0].pic;
-        xevdm_affine_mc_lc(x, y, pic_w, pic_h, w, h, mv[REFP_0], ref_pic, pred[0], vertex_num, sub_w, sub_h, tmp_buffer, mem_band_conditions_for_eif_are_satisfied
+        xevdm_affine_mc_lc(ctx, x, y, pic_w, pic_h, w, h, mv[REFP_0], ref_pic, pred[0], vertex_num, sub_w, sub_h, tmp_buffer, mem_band_conditions_for_eif_are_satisfied
             ,  bit_depth_luma,  bit_depth_chroma
                          , chroma_format_idc
         );
@@ -2635,7 +2620,7 @@ void xevdm_affine_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[R
     {
         /* backward */
         ref_pic = refp[refi[REFP_1]][REFP_1].pic;
-        xevdm_affine_mc_lc(x, y, pic_w, pic_h, w, h, mv[REFP_1], ref_pic, pred[bidx], vertex_num, sub_w, sub_h, tmp_buffer, mem_band_conditions_for_eif_are_satisfied
+        xevdm_affine_mc_lc(ctx, x, y, pic_w, pic_h, w, h, mv[REFP_1], ref_pic, pred[bidx], vertex_num, sub_w, sub_h, tmp_buffer, mem_band_conditions_for_eif_are_satisfied
             ,  bit_depth_luma,  bit_depth_chroma
                          , chroma_format_idc
 
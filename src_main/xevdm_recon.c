@@ -66,7 +66,7 @@ void xevdm_recon(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec,
             assert(ats_inter_idx >= 1 && ats_inter_idx <= 4);
             int tu0_w, tu0_h;
             int tu1_w;
-            pel resi;
+            s16 resi;
             if (!is_ats_inter_horizontal(ats_inter_idx))
             {
                 tu0_w = is_ats_inter_quad_size(ats_inter_idx) ? (cuw / 4) : (cuw / 2);
@@ -193,7 +193,7 @@ typedef struct
 
 static tHtdfOffset Scan[4] = { { 0,0 },{ 0,1 },{ 1,0 },{ 1,1 } };
 
-void xevdm_htdf_filter_block(pel *block, pel *acc_block, const u8 *tbl, int stride_block, int stride_acc, int width, int height, int tbl_thr_log2, int bit_depth)
+void xevdm_htdf_filter_block(pel *block, s16 *acc_block, const u8 *tbl, int stride_block, int stride_acc, int width, int height, int tbl_thr_log2, int bit_depth)
 {
     const int p0 = Scan[0].r*stride_block + Scan[0].c;
     const int p1 = Scan[1].r*stride_block + Scan[1].c;
@@ -212,7 +212,7 @@ void xevdm_htdf_filter_block(pel *block, pel *acc_block, const u8 *tbl, int stri
     for (int r = 0; r < height - 1; ++r)
     {
         pel *in = &block[r*stride_block];
-        pel *out = &acc_block[r*stride_acc];
+        s16 *out = &acc_block[r*stride_acc];
 
         for (int c = 0; c < width - 1; ++c, in++, out++)
         {
@@ -257,7 +257,7 @@ void xevdm_htdf_filter_block(pel *block, pel *acc_block, const u8 *tbl, int stri
 
 static void filter_block_luma(pel *block, const u8 HTDF_table[HTDF_LUT_QP_NUM][1 << HTDF_LUT_SIZE_LOG2], int width, int height, int stride, int qp, int bit_depth)
 {
-    pel acc_block[(MAX_CU_SIZE + 2)*(MAX_CU_SIZE + 2)];
+    s16 acc_block[(MAX_CU_SIZE + 2)*(MAX_CU_SIZE + 2)];
 
     xevd_mset(acc_block, 0, stride*height * sizeof(*acc_block));
 
@@ -296,7 +296,7 @@ BOOL xevdm_htdf_skip_condition(int width, int height, int IntraBlockFlag, int *q
     return FALSE;
 }
 
-void xevdm_htdf(s16* rec, int qp, int w, int h, int s, BOOL intra_block_flag, pel* rec_pic, int s_pic, int avail_cu
+void xevdm_htdf(pel* rec, int qp, int w, int h, int s, BOOL intra_block_flag, pel* rec_pic, int s_pic, int avail_cu
     , int scup, int w_scu, int h_scu, u32 * map_scu, int constrained_intra_pred
     , int bit_depth)
 {
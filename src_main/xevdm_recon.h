@@ -40,6 +40,6 @@
 
 void xevdm_recon(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, u8 ats_inter_info, int bit_depth);
 void xevdm_recon_yuv(int x, int y, int cuw, int cuh, s16 coef[N_C][MAX_CU_DIM], pel pred[N_C][MAX_CU_DIM], int nnz[N_C], XEVD_PIC *pic, u8 ats_inter_info, TREE_CONS tree_cons, int bit_depth, int chroma_format_idc);
-void xevdm_htdf(s16* rec, int qp, int w, int h, int s, BOOL intra_block_flag, pel* rec_pic, int s_pic, int avail_cu, int scup, int w_scu, int h_scu, u32 * map_scu, int constrained_intra_pred, int bit_depth);
+void xevdm_htdf(pel* rec, int qp, int w, int h, int s, BOOL intra_block_flag, pel* rec_pic, int s_pic, int avail_cu, int scup, int w_scu, int h_scu, u32 * map_scu, int constrained_intra_pred, int bit_depth);
 
 #endif /* _XEVD_RECON_H_ */
@@ -41,7 +41,7 @@
 #define TX_SHIFT1(log2_size, bd)   ((log2_size) - 1 + bd - 8)
 #define TX_SHIFT2(log2_size)   ((log2_size) + 6)
 
-XEVD_PIC * xevdm_picbuf_alloc_exp(int w, int h, int pad_l, int pad_c, int *err, int idc, int bitdepth)
+XEVD_PIC * xevdm_picbuf_alloc_exp(int w, int h, int pad_l, int pad_c, int *err, int idc, int bitdepth, const XEVD_IMGB_ALLOC * ia)
 {
     XEVD_PIC *pic = NULL;
     XEVD_IMGB *imgb = NULL;
@@ -65,8 +65,8 @@ XEVD_PIC * xevdm_picbuf_alloc_exp(int w, int h, int pad_l, int pad_c, int *err,
     pad[1] = pad_c;
     pad[2] = pad_c;
 
-    int cs = idc == 0 ? XEVD_CS_YCBCR400_10LE : (idc == 1 ? XEVD_CS_YCBCR420_10LE : (idc == 2 ? XEVD_CS_YCBCR422_10LE : XEVD_CS_YCBCR444_10LE));
-    imgb = xevd_imgb_create(w, h, cs, opt, pad, align);
+    int cs = xevd_chroma_format_idc_to_imgb_cs[idc];
+    imgb = xevd_imgb_create(w, h, cs, opt, pad, align, ia);
     xevd_assert_gv(imgb != NULL, ret, XEVD_ERR_OUT_OF_MEMORY, ERR);
 
     /* set XEVD_PIC */
@@ -157,12 +157,12 @@ void xevdm_picbuf_free(PICBUF_ALLOCATOR* pa, XEVD_PIC *pic)
     }
 }
 
-XEVD_IMGB * xevd_imgb_generate(int w, int h, int padl, int padc, int idc, int bit_depth)
+XEVD_IMGB * xevd_imgb_generate(int w, int h, int padl, int padc, int idc, int bit_depth, const XEVD_IMGB_ALLOC * ia)
 {
     XEVD_IMGB *imgb = NULL;
     int align[XEVD_IMGB_MAX_PLANE] = { MIN_CU_SIZE, MIN_CU_SIZE >> 1, MIN_CU_SIZE >> 1 };
     int pad[XEVD_IMGB_MAX_PLANE] = { padl, padc, padc, };
-    imgb = xevd_imgb_create(w, h, XEVD_CS_SET(idc + 10, bit_depth, 0), 0, pad, align);
+    imgb = xevd_imgb_create(w, h, XEVD_CS_SET(idc + 10, bit_depth, 0), 0, pad, align, ia);
     if (imgb == NULL)
     {
         xevd_trace("Cannot generate image buffer\n");
@@ -3941,7 +3941,7 @@ BOOL xevd_signal_mode_cons(TREE_CONS* parent, TREE_CONS* cur_split)
 
 XEVD_PIC * xevdm_picbuf_alloc(PICBUF_ALLOCATOR * pa, int * ret, int bitdepth)
 {
-    return xevdm_picbuf_alloc_exp(pa->w, pa->h, pa->pad_l, pa->pad_c, ret, pa->idc, bitdepth);
+    return xevdm_picbuf_alloc_exp(pa->w, pa->h, pa->pad_l, pa->pad_c, ret, pa->idc, bitdepth, pa->imgb_alloc);
 }
 
 #if HDR_MD5_CHECK
@@ -4309,11 +4309,11 @@ void xevdm_set_dec_info(XEVD_CTX * ctx, XEVD_CORE * core)
             if(ctx->pps.cu_qp_delta_enabled_flag)
             {
                 MCU_RESET_QP(map_scu[j]);
-                MCU_SET_IF_SN_QP(map_scu[j], flag, ctx->slice_num, core->qp);
+                MCU_SET_IF_SN_QP(map_scu[j], flag, core->slice_num, core->qp);
             }
             else
             {
-                MCU_SET_IF_SN_QP(map_scu[j], flag, ctx->slice_num, ctx->tile[core->tile_num].qp);
+                MCU_SET_IF_SN_QP(map_scu[j], flag, core->slice_num, ctx->tile[core->tile_num].qp);
             }
 
             map_refi[j][REFP_0] = core->refi[REFP_0];
@@ -4635,7 +4635,7 @@ void xevd_draw_partition(XEVD_CTX * ctx, XEVD_PIC * pic)
     int * ret = NULL;
     char file_name[256];
 
-    tmp = xevdm_picbuf_alloc_exp(ctx->w, ctx->h, pic->pad_l, pic->pad_c, ret, ctx->param.chroma_format_idc);
+    tmp = xevdm_picbuf_alloc_exp(ctx->w, ctx->h, pic->pad_l, pic->pad_c, ret, ctx->param.chroma_format_idc, NULL);
 
     cpy_pic(pic, tmp);
 
@@ -4687,28 +4687,28 @@ void xevdm_get_mmvd_motion(XEVD_CTX * ctx, XEVD_CORE * core)
     XEVDM_CORE * mcore = (XEVDM_CORE *)core;
     for (int k = 0; k < XEVD_MAX_NUM_ACTIVE_REF_FRAME; k++)
     {
-        REF_SET[0][k] = ctx->refp[k][0].poc;
-        REF_SET[1][k] = ctx->refp[k][1].poc;
+        REF_SET[0][k] = core->refp[k][0].poc;
+        REF_SET[1][k] = core->refp[k][1].poc;
     }
 
     cuw = (1 << core->log2_cuw);
     cuh = (1 << core->log2_cuh);
     XEVDM_CTX * mctx = (XEVDM_CTX *)ctx;
-    xevdm_get_mmvd_mvp_list(ctx->map_refi, ctx->refp[0], ctx->map_mv, ctx->w_scu, ctx->h_scu, core->scup, core->avail_cu, core->log2_cuw, core->log2_cuh, ctx->sh.slice_type, real_mv, ctx->map_scu, REF_SET, core->avail_lr
-        , ctx->poc.poc_val, mctx->dpm.num_refp
-        , core->history_buffer, ctx->sps->tool_admvp, &ctx->sh, ctx->log2_max_cuwh, ctx->map_tidx, mcore->mmvd_idx);
+    xevdm_get_mmvd_mvp_list(ctx->map_refi, core->refp[0], ctx->map_mv, ctx->w_scu, ctx->h_scu, core->scup, core->avail_cu, core->log2_cuw, core->log2_cuh, core->sh->slice_type, real_mv, ctx->map_scu, REF_SET, core->avail_lr
+        , ctx->poc.poc_val, core->num_refp
+        , core->history_buffer, ctx->sps->tool_admvp, core->sh, ctx->log2_max_cuwh, ctx->map_tidx, mcore->mmvd_idx);
 
     core->mv[REFP_0][MV_X] = real_mv[mcore->mmvd_idx][0][MV_X];
     core->mv[REFP_0][MV_Y] = real_mv[mcore->mmvd_idx][0][MV_Y];
     core->refi[REFP_0] = real_mv[mcore->mmvd_idx][0][2];
 
-    if (ctx->sh.slice_type == SLICE_B)
+    if (core->sh->slice_type == SLICE_B)
     {
         core->refi[REFP_1] = real_mv[mcore->mmvd_idx][1][2];
         core->mv[REFP_1][MV_X] = real_mv[mcore->mmvd_idx][1][MV_X];
         core->mv[REFP_1][MV_Y] = real_mv[mcore->mmvd_idx][1][MV_Y];
     }
-    else if(ctx->sh.slice_type == SLICE_P)
+    else if(core->sh->slice_type == SLICE_P)
     {
         core->refi[REFP_1] = REFI_INVALID;
     }
@@ -44,7 +44,7 @@
 
 u16 xevdm_get_avail_inter(int x_scu, int y_scu, int w_scu, int h_scu, int scup, int cuw, int cuh, u32 *map_scu, u8* map_tidx);
 u16 xevdm_get_avail_ibc(int x_scu, int y_scu, int w_scu, int h_scu, int scup, int cuw, int cuh, u32 * map_scu, u8* map_tidx);
-XEVD_PIC* xevdm_picbuf_alloc_exp(int w, int h, int pad_l, int pad_c, int *err, int idc, int bitdepth);
+XEVD_PIC* xevdm_picbuf_alloc_exp(int w, int h, int pad_l, int pad_c, int *err, int idc, int bitdepth, const XEVD_IMGB_ALLOC * ia);
 void xevdm_picbuf_free(PICBUF_ALLOCATOR* pa, XEVD_PIC *pic);
 
 void xevdm_get_mmvd_mvp_list(s8(*map_refi)[REFP_NUM], XEVD_REFP refp[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D], int w_scu, int h_scu, int scup, u16 avail, int cuw, int cuh, int slice_t, int real_mv[][2][3], u32 *map_scu, int REF_SET[][XEVD_MAX_NUM_ACTIVE_REF_FRAME], u16 avail_lr
@@ -168,7 +168,7 @@ u8 xevd_check_only_intra(XEVD_CTX *ctx, XEVD_CORE * core);
 u8 xevd_check_only_inter(XEVD_CTX *ctx, XEVD_CORE * core);
 u8 xevd_check_all_preds(XEVD_CTX *ctx, XEVD_CORE * core);
 MODE_CONS xevd_derive_mode_cons(XEVD_CTX *ctx, int scup);
-XEVD_IMGB * xevd_imgb_generate(int w, int h, int padl, int padc, int idc, int bit_depth);
+XEVD_IMGB * xevd_imgb_generate(int w, int h, int padl, int padc, int idc, int bit_depth, const XEVD_IMGB_ALLOC * ia);
 void xevd_imgb_destroy(XEVD_IMGB *imgb);
 void xevd_imgb_cpy(XEVD_IMGB * dst, XEVD_IMGB * src);
 #endif /* _XEVD_UTIL_H_ */